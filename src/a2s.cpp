@@ -0,0 +1,1005 @@
+//===-- a2s.cpp - A2S server query engine implementation ------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of the A2S client. All queries share a single non-blocking
+///    UDP socket serviced by one I/O thread, which sends requests in batches,
+///    drains all available responses at once, handles challenges and split
+///    responses, and adapts the number of queries in flight to the observed
+///    loss rate. Socket I/O uses Winsock event objects on Windows and poll(2)
+///    with an eventfd elsewhere.
+///
+//===----------------------------------------------------------------------===//
+#include "a2s.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+
+#ifdef _WIN32
+#include <process.h>
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::a2s {
+
+namespace {
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Header value of single-packet messages.
+constexpr std::uint32_t hdr_single = 0xFFFFFFFF;
+/// Header value of split-packet messages.
+constexpr std::uint32_t hdr_split = 0xFFFFFFFE;
+/// Flag in split packet ID indicating that the payload is bzip2-compressed.
+constexpr std::uint32_t split_compressed = 0x80000000;
+/// S2C_CHALLENGE message type.
+constexpr std::uint8_t s2c_challenge = 0x41;
+/// A2S_INFO request message type.
+constexpr std::uint8_t a2s_info_req = 0x54;
+/// A2S_INFO response message type.
+constexpr std::uint8_t a2s_info_resp = 0x49;
+/// A2S_RULES request message type.
+constexpr std::uint8_t a2s_rules_req = 0x56;
+/// A2S_RULES response message type.
+constexpr std::uint8_t a2s_rules_resp = 0x45;
+/// Payload of A2S_INFO requests following the message type.
+constexpr std::string_view a2s_info_payload{"Source Engine Query", 20};
+/// Application ID of The Ship, whose A2S_INFO responses have extra fields.
+constexpr std::uint16_t the_ship_app_id = 2400;
+
+/// A2S_INFO extra data flag indicating presence of the game port.
+constexpr std::uint8_t edf_port = 0x80;
+/// A2S_INFO extra data flag indicating presence of the server's Steam ID.
+constexpr std::uint8_t edf_steam_id = 0x10;
+/// A2S_INFO extra data flag indicating presence of SourceTV details.
+constexpr std::uint8_t edf_source_tv = 0x40;
+/// A2S_INFO extra data flag indicating presence of server tags.
+constexpr std::uint8_t edf_keywords = 0x20;
+/// A2S_INFO extra data flag indicating presence of the full game ID.
+constexpr std::uint8_t edf_game_id = 0x01;
+
+/// Time to wait for a response to a single request.
+constexpr std::chrono::milliseconds attempt_timeout{1000};
+/// Number of timed out attempts after which the query fails.
+constexpr int max_timeouts = 2;
+/// Maximum number of packets sent per I/O loop iteration.
+constexpr int send_batch_size = 64;
+/// Lower bound of the in-flight query limit.
+constexpr double min_in_flight = 16;
+/// Initial value of the in-flight query limit.
+constexpr double initial_in_flight = 64;
+/// Upper bound of the in-flight query limit.
+constexpr double max_in_flight = 1024;
+/// Length of the window over which loss rate is evaluated.
+constexpr std::chrono::milliseconds loss_window{250};
+
+//===-- Types -------------------------------------------------------------===//
+
+using clock = std::chrono::steady_clock;
+
+/// Types of queries.
+enum class query_type : std::uint8_t { info, rules };
+
+/// State of queries of the same type to a single server address. Concurrent
+///    queries share the request and its result, since A2S responses carry no
+///    request identifier.
+struct target {
+  /// IPv4 address and port of the server, in network byte order.
+  sockaddr_in addr;
+  /// Type of the queries.
+  query_type type;
+  /// Handles of the queries waiting for the result.
+  std::vector<int> query_ids;
+  /// Last challenge number received from the server, or `-1`.
+  std::int32_t challenge;
+  /// Number of attempts that have timed out.
+  int timeouts;
+  /// Value indicating whether the target counts towards in-flight limit.
+  bool started;
+  /// Value indicating whether a request has to be (re)sent.
+  bool need_send;
+  /// Time point at which the last request has been sent.
+  clock::time_point sent_time;
+  /// Time point after which current attempt is considered timed out.
+  clock::time_point deadline;
+  /// ID of the split response being assembled.
+  std::uint32_t split_id;
+  /// Number of received split response fragments.
+  std::size_t num_fragments;
+  /// Split response fragments.
+  std::vector<std::string> fragments;
+};
+
+/// Completed query result waiting for dispatch.
+struct completion {
+  /// Query handle.
+  int id;
+  /// Query result handler.
+  a2s::handler *_Nonnull result_handler;
+  /// Type of the query.
+  query_type type;
+  /// Value indicating whether the query succeeded.
+  bool success;
+  /// Received rules, for A2S_RULES queries.
+  std::vector<rule> rules;
+  /// Received server information, for A2S_INFO queries.
+  server_info info;
+};
+
+/// Sequential reader of little-endian values and null-terminated strings from
+///    a message payload. Reads past the end of the payload yield empty values
+///    and clear @ref ok.
+class payload_reader {
+  /// The payload.
+  std::span<const std::uint8_t> data;
+  /// Current position in @ref data.
+  std::size_t pos{};
+
+public:
+  /// Value indicating whether all reads so far have succeeded.
+  bool ok{true};
+
+  constexpr payload_reader(std::span<const std::uint8_t> data) noexcept
+      : data{data} {}
+
+  /// Check whether the whole payload has been read.
+  constexpr bool at_end() const noexcept { return pos >= data.size(); }
+
+  /// Read an integer.
+  template <typename T> T num() noexcept {
+    if (data.size() - pos < sizeof(T)) {
+      ok = false;
+      pos = data.size();
+      return {};
+    }
+    T res{};
+    for (std::size_t i{}; i < sizeof(T); ++i) {
+      res |= static_cast<T>(static_cast<T>(data[pos + i]) << (i * 8));
+    }
+    pos += sizeof(T);
+    return res;
+  }
+
+  /// Read a null-terminated string.
+  std::string str() {
+    const auto rest{data.subspan(pos)};
+    const auto end{std::ranges::find(rest, 0)};
+    if (end == rest.end()) {
+      ok = false;
+      pos = data.size();
+      return {};
+    }
+    const auto len{static_cast<std::size_t>(end - rest.begin())};
+    pos += len + 1;
+    return {reinterpret_cast<const char *>(rest.data()), len};
+  }
+};
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Mutex protecting all engine state below.
+static std::mutex mtx;
+/// Value indicating whether the I/O thread is running.
+static bool running;
+#ifdef _WIN32
+/// The UDP socket used for all queries.
+static SOCKET sock{INVALID_SOCKET};
+/// Event signaled when @ref sock becomes readable.
+static HANDLE sock_event;
+/// Event signaled when new queries are submitted or the engine is stopped.
+static HANDLE wake_event;
+#else  // def _WIN32
+/// The UDP socket used for all queries.
+static int sock{-1};
+/// eventfd descriptor signaled when new queries are submitted or the engine is
+///    stopped.
+static int wake_fd{-1};
+#endif // def _WIN32 else
+/// Handle that will be assigned to the next query.
+static int next_id{query_base};
+/// Map of query handles to their handlers and target keys.
+static std::unordered_map<int, std::pair<handler *, std::uint64_t>> queries;
+/// Map of target keys (see @ref target_key) to their states.
+static std::unordered_map<std::uint64_t, target> targets;
+/// Keys of targets that haven't been started yet, in submission order.
+static std::deque<std::uint64_t> queued;
+/// Number of started targets.
+static std::size_t num_in_flight;
+/// Current limit for @ref num_in_flight.
+static double in_flight_limit{initial_in_flight};
+/// Number of successful targets in current loss window.
+static int window_successes;
+/// Number of timed out attempts in current loss window.
+static int window_timeouts;
+/// Start of current loss window.
+static clock::time_point window_start;
+/// Results waiting for @ref dispatch.
+static std::deque<completion> completions;
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Read a little-endian integer from a byte buffer.
+template <typename T>
+static constexpr T load_le(const std::uint8_t *_Nonnull ptr) noexcept {
+  T res{};
+  for (std::size_t i{}; i < sizeof(T); ++i) {
+    res |= static_cast<T>(ptr[i]) << (i * 8);
+  }
+  return res;
+}
+
+/// Get the key identifying a target in @ref targets.
+///
+/// @param addr_key
+///    Address key of the server, `(ip << 16) | port` in host byte order.
+/// @param type
+///    Type of the queries.
+/// @return The target key.
+static constexpr std::uint64_t target_key(std::uint64_t addr_key,
+                                          query_type type) noexcept {
+  return addr_key | (static_cast<std::uint64_t>(type) << 48);
+}
+
+/// Find the started target of specified type for a server address. Must be
+///    called with @ref mtx locked.
+///
+/// @param addr_key
+///    Address key of the server, `(ip << 16) | port` in host byte order.
+/// @param type
+///    Type of the queries.
+/// @return Iterator pointing to the target in @ref targets, or the end
+///    iterator if there is no such started target.
+static decltype(targets)::iterator find_started(std::uint64_t addr_key,
+                                                query_type type) {
+  const auto it{targets.find(target_key(addr_key, type))};
+  return it != targets.end() && it->second.started ? it : targets.end();
+}
+
+/// Finish all queries of the target and remove it. Must be called with @ref mtx
+///    locked.
+///
+/// @param it
+///    Iterator pointing to the target in @ref targets.
+/// @param success
+///    Value indicating whether the queries succeeded.
+/// @param [in, out] rules
+///    Rules received from the server, for A2S_RULES queries.
+/// @param [in] info
+///    Information received from the server, for A2S_INFO queries.
+static void finish_target(decltype(targets)::iterator it, bool success,
+                          std::vector<rule> &&rules = {},
+                          const server_info &info = {}) {
+  auto &tgt{it->second};
+  for (auto id_it{tgt.query_ids.begin()}; id_it != tgt.query_ids.end();
+       ++id_it) {
+    const auto query_it{queries.find(*id_it)};
+    if (query_it == queries.end()) {
+      continue;
+    }
+    completions.emplace_back(
+        *id_it, query_it->second.first, tgt.type, success,
+        std::next(id_it) == tgt.query_ids.end() ? std::move(rules) : rules,
+        info);
+    queries.erase(query_it);
+  }
+  if (tgt.started) {
+    --num_in_flight;
+  }
+  if (success) {
+    ++window_successes;
+  }
+  targets.erase(it);
+}
+
+/// Parse an A2S_INFO response.
+///
+/// @param payload
+///    Message payload, starting with the message type.
+/// @param [out] info
+///    Variable that receives parsed server information.
+/// @return Value indicating whether the response is well-formed.
+static bool parse_info(std::span<const std::uint8_t> payload,
+                       server_info &info) {
+  // Skip message type and protocol version
+  payload_reader reader{payload.subspan(std::min<std::size_t>(payload.size(),
+                                                              2))};
+  info.name = reader.str();
+  info.map = reader.str();
+  info.folder = reader.str();
+  info.game = reader.str();
+  info.app_id = reader.num<std::uint16_t>();
+  info.players = reader.num<std::uint8_t>();
+  info.max_players = reader.num<std::uint8_t>();
+  info.bots = reader.num<std::uint8_t>();
+  // Skip server type and environment
+  reader.num<std::uint16_t>();
+  info.password = reader.num<std::uint8_t>();
+  info.vac = reader.num<std::uint8_t>();
+  if (info.app_id == the_ship_app_id) {
+    // Skip mode, witnesses and duration
+    reader.num<std::uint16_t>();
+    reader.num<std::uint8_t>();
+  }
+  info.version = reader.str();
+  if (!reader.ok || payload.size() < 2) {
+    return false;
+  }
+  if (reader.at_end()) {
+    return true;
+  }
+  const auto edf{reader.num<std::uint8_t>()};
+  if (edf & edf_port) {
+    info.game_port = reader.num<std::uint16_t>();
+  }
+  if (edf & edf_steam_id) {
+    info.steam_id = reader.num<std::uint64_t>();
+  }
+  if (edf & edf_source_tv) {
+    reader.num<std::uint16_t>();
+    reader.str();
+  }
+  if (edf & edf_keywords) {
+    info.keywords = reader.str();
+  }
+  if (edf & edf_game_id) {
+    info.game_id = reader.num<std::uint64_t>();
+  }
+  return reader.ok;
+}
+
+/// Parse an A2S_RULES response.
+///
+/// @param payload
+///    Message payload, starting with the message type.
+/// @param [out] rules
+///    Vector that receives parsed rules.
+/// @return Value indicating whether the response is well-formed.
+static bool parse_rules(std::span<const std::uint8_t> payload,
+                        std::vector<rule> &rules) {
+  if (payload.size() < 3) {
+    return false;
+  }
+  const auto num_rules{load_le<std::uint16_t>(&payload[1])};
+  const std::string_view data{reinterpret_cast<const char *>(&payload[3]),
+                              payload.size() - 3};
+  rules.reserve(num_rules);
+  // Some servers truncate the rules list to fit the response size limit,
+  //    keep the rules that were parsed entirely
+  for (std::size_t pos{}; rules.size() < num_rules;) {
+    const auto key_end{data.find('\0', pos)};
+    if (key_end == std::string_view::npos) {
+      break;
+    }
+    const auto value_end{data.find('\0', key_end + 1)};
+    if (value_end == std::string_view::npos) {
+      break;
+    }
+    rules.emplace_back(std::string{data.substr(pos, key_end - pos)},
+                       std::string{data.substr(key_end + 1,
+                                               value_end - key_end - 1)});
+    pos = value_end + 1;
+  }
+  return true;
+}
+
+/// Process the payload of a complete message. Must be called with @ref mtx
+///    locked.
+///
+/// @param addr_key
+///    Address key of the server that sent the message.
+/// @param payload
+///    Message payload, without the leading header.
+/// @param now
+///    Current time point.
+static void process_message(std::uint64_t addr_key,
+                            std::span<const std::uint8_t> payload,
+                            clock::time_point now) {
+  if (payload.empty()) {
+    return;
+  }
+  switch (payload[0]) {
+  case s2c_challenge:
+    if (payload.size() >= 5) {
+      // The challenge is issued per client address, so it applies to queries
+      //    of both types
+      const auto challenge{load_le<std::int32_t>(&payload[1])};
+      for (const auto type : {query_type::info, query_type::rules}) {
+        if (const auto it{find_started(addr_key, type)}; it != targets.end()) {
+          it->second.challenge = challenge;
+          it->second.need_send = true;
+        }
+      }
+    }
+    return;
+  case a2s_info_resp: {
+    const auto it{find_started(addr_key, query_type::info)};
+    if (it == targets.end()) {
+      return;
+    }
+    server_info info{};
+    if (!parse_info(payload, info)) {
+      finish_target(it, false);
+      return;
+    }
+    info.ping = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now - it->second.sent_time)
+                    .count();
+    finish_target(it, true, {}, info);
+    return;
+  }
+  case a2s_rules_resp: {
+    const auto it{find_started(addr_key, query_type::rules)};
+    if (it == targets.end()) {
+      return;
+    }
+    std::vector<rule> rules;
+    if (!parse_rules(payload, rules)) {
+      finish_target(it, false);
+      return;
+    }
+    finish_target(it, true, std::move(rules));
+    return;
+  }
+  default:
+    return;
+  }
+}
+
+/// Process a received packet. Must be called with @ref mtx locked.
+///
+/// @param addr_key
+///    Address key of the server that sent the packet.
+/// @param packet
+///    Packet contents.
+/// @param now
+///    Current time point.
+static void process_packet(std::uint64_t addr_key,
+                           std::span<const std::uint8_t> packet,
+                           clock::time_point now) {
+  if (packet.size() < 5) {
+    return;
+  }
+  const auto hdr{load_le<std::uint32_t>(packet.data())};
+  if (hdr == hdr_single) {
+    process_message(addr_key, packet.subspan(4), now);
+    return;
+  }
+  if (hdr != hdr_split || packet.size() < 12) {
+    return;
+  }
+  // Rules responses are the ones that normally don't fit into a packet
+  auto it{find_started(addr_key, query_type::rules)};
+  if (it == targets.end()) {
+    it = find_started(addr_key, query_type::info);
+    if (it == targets.end()) {
+      return;
+    }
+  }
+  const auto id{load_le<std::uint32_t>(&packet[4])};
+  if (id & split_compressed) {
+    finish_target(it, false);
+    return;
+  }
+  const std::size_t total{packet[8]};
+  const std::size_t num{packet[9]};
+  if (!total || num >= total) {
+    return;
+  }
+  auto &tgt{it->second};
+  if (tgt.split_id != id || tgt.fragments.size() != total) {
+    tgt.split_id = id;
+    tgt.num_fragments = 0;
+    tgt.fragments.assign(total, {});
+  }
+  auto &fragment{tgt.fragments[num]};
+  if (!fragment.empty()) {
+    return;
+  }
+  const auto payload{packet.subspan(12)};
+  fragment.assign(reinterpret_cast<const char *>(payload.data()),
+                  payload.size());
+  if (++tgt.num_fragments < total) {
+    return;
+  }
+  std::string msg;
+  for (const auto &frag : tgt.fragments) {
+    msg.append(frag);
+  }
+  tgt.fragments.clear();
+  if (msg.size() < 4 ||
+      load_le<std::uint32_t>(reinterpret_cast<const std::uint8_t *>(
+          msg.data())) != hdr_single) {
+    finish_target(it, false);
+    return;
+  }
+  process_message(addr_key,
+                  std::span{reinterpret_cast<const std::uint8_t *>(msg.data()),
+                            msg.size()}
+                      .subspan(4),
+                  now);
+}
+
+/// Update @ref in_flight_limit based on the loss rate in the last window. Must
+///    be called with @ref mtx locked.
+static void adapt_limit(clock::time_point now) {
+  if (now - window_start < loss_window) {
+    return;
+  }
+  const auto total{window_successes + window_timeouts};
+  if (total) {
+    const auto loss{static_cast<double>(window_timeouts) / total};
+    // A share of timeouts is expected from servers that went offline, only
+    //    treat loss above that as congestion
+    if (loss > 0.5) {
+      in_flight_limit = std::max(min_in_flight, in_flight_limit * 0.7);
+    } else if (loss < 0.25 && num_in_flight + 1 >= in_flight_limit) {
+      in_flight_limit = std::min(max_in_flight, in_flight_limit * 1.25);
+    }
+  }
+  window_successes = 0;
+  window_timeouts = 0;
+  window_start = now;
+}
+
+/// Wake the I/O thread up.
+static void wake() {
+#ifdef _WIN32
+  SetEvent(wake_event);
+#else
+  const std::uint64_t value{1};
+  [[maybe_unused]] const auto res{write(wake_fd, &value, sizeof value)};
+#endif
+}
+
+/// Wait until the socket becomes readable, @ref wake is called, or the
+///    timeout expires.
+///
+/// @param timeout
+///    Timeout in milliseconds, or `-1` to wait indefinitely.
+static void wait_io(int timeout) {
+#ifdef _WIN32
+  const std::array handles{sock_event, wake_event};
+  WaitForMultipleObjects(handles.size(), handles.data(), FALSE,
+                         timeout < 0 ? INFINITE
+                                     : static_cast<DWORD>(timeout));
+#else  // def _WIN32
+  std::array fds{pollfd{.fd = sock, .events = POLLIN, .revents = 0},
+                 pollfd{.fd = wake_fd, .events = POLLIN, .revents = 0}};
+  if (poll(fds.data(), fds.size(), timeout) > 0 && fds[1].revents & POLLIN) {
+    std::uint64_t value;
+    [[maybe_unused]] const auto res{read(wake_fd, &value, sizeof value)};
+  }
+#endif // def _WIN32 else
+}
+
+/// Close the socket and wake objects.
+static void close_io() {
+#ifdef _WIN32
+  closesocket(sock);
+  sock = INVALID_SOCKET;
+  CloseHandle(sock_event);
+  CloseHandle(wake_event);
+  WSACleanup();
+#else
+  close(sock);
+  sock = -1;
+  close(wake_fd);
+  wake_fd = -1;
+#endif
+}
+
+/// Receive the next available datagram from the socket.
+///
+/// @param buf
+///    Buffer that receives the datagram.
+/// @param [out] from
+///    Variable that receives address of the sender.
+/// @return Size of the datagram, or `-1` if there are no more datagrams
+///    available.
+static int receive(std::span<std::uint8_t> buf, sockaddr_in &from) {
+  for (;;) {
+#ifdef _WIN32
+    int from_len{sizeof from};
+    const auto res{recvfrom(sock, reinterpret_cast<char *>(buf.data()),
+                            buf.size(), 0, reinterpret_cast<sockaddr *>(&from),
+                            &from_len)};
+    // WSAECONNRESET is reported for ICMP port unreachable messages of
+    //    previous sends, it doesn't indicate a socket failure
+    if (res == SOCKET_ERROR && WSAGetLastError() == WSAECONNRESET) {
+      continue;
+    }
+#else  // def _WIN32
+    socklen_t from_len{sizeof from};
+    const auto res{recvfrom(sock, buf.data(), buf.size(), 0,
+                            reinterpret_cast<sockaddr *>(&from), &from_len)};
+    // Same as above, for sockets that have been connected to by the kernel's
+    //    ICMP error queue handling
+    if (res < 0 && errno == ECONNREFUSED) {
+      continue;
+    }
+#endif // def _WIN32 else
+    return res < 0 ? -1 : static_cast<int>(res);
+  }
+}
+
+/// Send a request of the target to its server. Must be called with @ref mtx
+///    locked.
+///
+/// @param [in, out] tgt
+///    The target to send request of.
+/// @return Value indicating whether the request has been sent.
+static bool send_request(target &tgt) {
+  std::array<std::uint8_t, 29> req{0xFF, 0xFF, 0xFF, 0xFF};
+  std::size_t size;
+  if (tgt.type == query_type::info) {
+    req[4] = a2s_info_req;
+    std::ranges::copy(a2s_info_payload, &req[5]);
+    size = 5 + a2s_info_payload.size();
+    // Servers that don't require a challenge respond to the request without
+    //    one right away
+    if (tgt.challenge != -1) {
+      for (std::size_t i{}; i < 4; ++i) {
+        req[size + i] = static_cast<std::uint8_t>(
+            static_cast<std::uint32_t>(tgt.challenge) >> (i * 8));
+      }
+      size += 4;
+    }
+  } else {
+    req[4] = a2s_rules_req;
+    for (std::size_t i{}; i < 4; ++i) {
+      req[5 + i] = static_cast<std::uint8_t>(
+          static_cast<std::uint32_t>(tgt.challenge) >> (i * 8));
+    }
+    size = 9;
+  }
+  return sendto(sock, reinterpret_cast<const char *>(req.data()),
+                static_cast<int>(size), 0,
+                reinterpret_cast<const sockaddr *>(&tgt.addr),
+                sizeof tgt.addr) >= 0;
+}
+
+/// I/O thread procedure.
+static unsigned io_thread_proc(void *) {
+  std::array<std::uint8_t, 65536> buf;
+  for (int timeout{-1};;) {
+    wait_io(timeout);
+    const std::scoped_lock lock{mtx};
+    if (!running) {
+      close_io();
+      break;
+    }
+    auto now{clock::now()};
+    // Drain all available responses
+    for (;;) {
+      sockaddr_in from;
+      const auto res{receive(buf, from)};
+      if (res < 0) {
+        break;
+      }
+      process_packet(
+          (static_cast<std::uint64_t>(ntohl(from.sin_addr.s_addr)) << 16) |
+              ntohs(from.sin_port),
+          std::span{buf.data(), static_cast<std::size_t>(res)}, now);
+    }
+    now = clock::now();
+    // Process timeouts
+    for (auto it{targets.begin()}; it != targets.end();) {
+      auto &tgt{it->second};
+      if (!tgt.started || tgt.need_send || now < tgt.deadline) {
+        ++it;
+        continue;
+      }
+      ++window_timeouts;
+      if (++tgt.timeouts >= max_timeouts) {
+        const auto next{std::next(it)};
+        finish_target(it, false);
+        it = next;
+      } else {
+        tgt.need_send = true;
+        ++it;
+      }
+    }
+    adapt_limit(now);
+    // Start queued targets while there is room
+    while (!queued.empty() && num_in_flight < in_flight_limit) {
+      const auto it{targets.find(queued.front())};
+      queued.pop_front();
+      if (it != targets.end()) {
+        it->second.started = true;
+        it->second.need_send = true;
+        ++num_in_flight;
+      }
+    }
+    // Send pending requests
+    int num_sent{};
+    auto next_deadline{clock::time_point::max()};
+    bool send_pending{};
+    for (auto &tgt : targets | std::views::values) {
+      if (!tgt.started) {
+        continue;
+      }
+      if (tgt.need_send) {
+        if (num_sent >= send_batch_size || !send_request(tgt)) {
+          send_pending = true;
+          continue;
+        }
+        ++num_sent;
+        tgt.need_send = false;
+        tgt.sent_time = now;
+        tgt.deadline = now + attempt_timeout;
+      }
+      next_deadline = std::min(next_deadline, tgt.deadline);
+    }
+    if (send_pending || (!queued.empty() && num_in_flight < in_flight_limit)) {
+      timeout = 0;
+    } else if (next_deadline == clock::time_point::max()) {
+      timeout = queued.empty() ? -1 : loss_window.count();
+    } else {
+      timeout = std::max<int>(
+          std::chrono::ceil<std::chrono::milliseconds>(next_deadline - now)
+              .count(),
+          0);
+    }
+  } // for (int timeout{-1};;)
+  return 0;
+}
+
+/// Begin a query of specified type.
+///
+/// @param ip
+///    IPv4 address of the server, in host byte order.
+/// @param port
+///    Query port of the server, in host byte order.
+/// @param type
+///    Type of the query.
+/// @param [in, out] handler
+///    Handler that will receive query results.
+/// @return Handle for the query.
+static int begin_query(std::uint32_t ip, std::uint16_t port, query_type type,
+                       a2s::handler &handler) {
+  const std::scoped_lock lock{mtx};
+  const auto id{next_id};
+  next_id = next_id == std::numeric_limits<int>::max() ? query_base
+                                                       : next_id + 1;
+  const auto key{
+      target_key((static_cast<std::uint64_t>(ip) << 16) | port, type)};
+  queries.emplace(id, std::pair{&handler, key});
+  const auto [it, emplaced]{targets.try_emplace(key)};
+  auto &tgt{it->second};
+  if (emplaced) {
+    tgt.addr = {};
+    tgt.addr.sin_family = AF_INET;
+    tgt.addr.sin_port = htons(port);
+    tgt.addr.sin_addr.s_addr = htonl(ip);
+    tgt.type = type;
+    tgt.challenge = -1;
+    tgt.timeouts = 0;
+    tgt.started = false;
+    tgt.need_send = false;
+    tgt.split_id = 0;
+    tgt.num_fragments = 0;
+    queued.emplace_back(key);
+    wake();
+  }
+  tgt.query_ids.emplace_back(id);
+  return id;
+}
+
+} // namespace
+
+//===-- Internal functions ------------------------------------------------===//
+
+bool start() {
+  const std::scoped_lock lock{mtx};
+  if (running) {
+    return true;
+  }
+#ifdef _WIN32
+  if (sock != INVALID_SOCKET) {
+    // Previous I/O thread hasn't exited yet
+    return false;
+  }
+  WSADATA wsa_data;
+  if (WSAStartup(MAKEWORD(2, 2), &wsa_data)) {
+    return false;
+  }
+  sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (sock == INVALID_SOCKET) {
+    goto cleanup_wsa;
+  }
+  {
+    // Large receive buffer lets responses pile up between loop iterations
+    //    without being dropped by the OS
+    const int rcvbuf_size{4 * 1024 * 1024};
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF,
+               reinterpret_cast<const char *>(&rcvbuf_size),
+               sizeof rcvbuf_size);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    if (bind(sock, reinterpret_cast<const sockaddr *>(&addr), sizeof addr) ==
+        SOCKET_ERROR) {
+      goto close_sock;
+    }
+  }
+  sock_event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+  if (!sock_event) {
+    goto close_sock;
+  }
+  // WSAEventSelect also switches the socket to non-blocking mode
+  if (WSAEventSelect(sock, sock_event, FD_READ) == SOCKET_ERROR) {
+    goto close_sock_event;
+  }
+  wake_event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+  if (!wake_event) {
+    goto close_sock_event;
+  }
+  {
+    running = true;
+    window_start = clock::now();
+    const auto thread{
+        _beginthreadex(nullptr, 0, io_thread_proc, nullptr, 0, nullptr)};
+    if (thread) {
+      CloseHandle(reinterpret_cast<HANDLE>(thread));
+      return true;
+    }
+    running = false;
+  }
+  CloseHandle(wake_event);
+close_sock_event:
+  CloseHandle(sock_event);
+close_sock:
+  closesocket(sock);
+  sock = INVALID_SOCKET;
+cleanup_wsa:
+  WSACleanup();
+  return false;
+#else  // def _WIN32
+  if (sock >= 0) {
+    // Previous I/O thread hasn't exited yet
+    return false;
+  }
+  sock = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                IPPROTO_UDP);
+  if (sock < 0) {
+    return false;
+  }
+  {
+    const int rcvbuf_size{4 * 1024 * 1024};
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf_size, sizeof rcvbuf_size);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    if (bind(sock, reinterpret_cast<const sockaddr *>(&addr), sizeof addr) <
+        0) {
+      close(sock);
+      sock = -1;
+      return false;
+    }
+  }
+  wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (wake_fd < 0) {
+    close(sock);
+    sock = -1;
+    return false;
+  }
+  running = true;
+  window_start = clock::now();
+  std::thread{io_thread_proc, nullptr}.detach();
+  return true;
+#endif // def _WIN32 else
+}
+
+void stop() {
+  const std::scoped_lock lock{mtx};
+  if (!running) {
+    return;
+  }
+  running = false;
+  queries.clear();
+  targets.clear();
+  queued.clear();
+  num_in_flight = 0;
+  completions.clear();
+  wake();
+}
+
+int query_rules(std::uint32_t ip, std::uint16_t port, rules_handler &handler) {
+  return begin_query(ip, port, query_type::rules, handler);
+}
+
+int query_info(std::uint32_t ip, std::uint16_t port, info_handler &handler) {
+  return begin_query(ip, port, query_type::info, handler);
+}
+
+handler *cancel(int query) {
+  const std::scoped_lock lock{mtx};
+  const auto query_it{queries.find(query)};
+  if (query_it == queries.end()) {
+    // The query may have completed already
+    const auto it{std::ranges::find(completions, query, &completion::id)};
+    if (it == completions.end()) {
+      return nullptr;
+    }
+    const auto handler{it->result_handler};
+    completions.erase(it);
+    return handler;
+  }
+  const auto [handler, key]{query_it->second};
+  queries.erase(query_it);
+  const auto it{targets.find(key)};
+  if (it != targets.end()) {
+    auto &tgt{it->second};
+    std::erase(tgt.query_ids, query);
+    if (tgt.query_ids.empty()) {
+      if (tgt.started) {
+        --num_in_flight;
+      } else {
+        std::erase(queued, key);
+      }
+      targets.erase(it);
+    }
+  }
+  return handler;
+}
+
+void dispatch() {
+  // Results are taken one at a time, so queries cancelled by the handlers
+  //    being called are not dispatched anymore
+  for (;;) {
+    std::unique_lock lock{mtx};
+    if (completions.empty()) {
+      return;
+    }
+    auto comp{std::move(completions.front())};
+    completions.pop_front();
+    lock.unlock();
+    if (comp.type == query_type::info) {
+      const auto handler{static_cast<info_handler *>(comp.result_handler)};
+      if (comp.success) {
+        handler->info_received(comp.info);
+      } else {
+        handler->info_failed();
+      }
+    } else {
+      const auto handler{static_cast<rules_handler *>(comp.result_handler)};
+      if (comp.success) {
+        handler->rules_received(comp.rules);
+      } else {
+        handler->rules_failed();
+      }
+    }
+  }
+}
+
+} // namespace tek::game_runtime::a2s
@@ -0,0 +1,162 @@
+//===-- a2s.hpp - A2S server query engine interface -----------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the built-in A2S (Steam server query protocol) client,
+///    that performs large numbers of concurrent A2S_INFO and A2S_RULES
+///    queries over a single non-blocking UDP socket.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace tek::game_runtime::a2s {
+
+/// A single server rule key/value pair.
+struct rule {
+  /// Rule name.
+  std::string key;
+  /// Rule value.
+  std::string value;
+};
+
+/// Server information received in an A2S_INFO response.
+struct server_info {
+  /// Server name.
+  std::string name;
+  /// Name of the map currently loaded on the server.
+  std::string map;
+  /// Name of the game's directory.
+  std::string folder;
+  /// Game description.
+  std::string game;
+  /// Version of the game installed on the server.
+  std::string version;
+  /// Server tags, if the server has reported them.
+  std::string keywords;
+  /// Steam ID of the server, or `0` if the server hasn't reported it.
+  std::uint64_t steam_id;
+  /// Full game ID of the server, or `0` if the server hasn't reported it.
+  std::uint64_t game_id;
+  /// Steam application ID of the game, truncated to 16 bits.
+  std::uint16_t app_id;
+  /// Game port of the server, or `0` if the server hasn't reported it.
+  std::uint16_t game_port;
+  /// Number of players on the server.
+  int players;
+  /// Maximum number of players the server reports it can hold.
+  int max_players;
+  /// Number of bots on the server.
+  int bots;
+  /// Value indicating whether the server requires a password.
+  bool password;
+  /// Value indicating whether the server uses VAC.
+  bool vac;
+  /// Round-trip time of the request that has been answered, in milliseconds.
+  int ping;
+};
+
+/// Base class for query result handlers, which allows deleting handlers
+///    returned by @ref cancel regardless of their query type.
+class handler {
+public:
+  virtual ~handler() = default;
+};
+
+/// Interface for receiving results of A2S_RULES queries. Exactly one of the
+///    methods is called for each query that wasn't cancelled, from the thread
+///    that calls @ref dispatch.
+class rules_handler : public handler {
+public:
+  /// Called when the server has responded with its rules.
+  ///
+  /// @param [in] rules
+  ///    The list of rules received from the server.
+  virtual void rules_received(std::span<const rule> rules) = 0;
+  /// Called when the server didn't respond or its response was malformed.
+  virtual void rules_failed() = 0;
+};
+
+/// Interface for receiving results of A2S_INFO queries. Exactly one of the
+///    methods is called for each query that wasn't cancelled, from the thread
+///    that calls @ref dispatch.
+class info_handler : public handler {
+public:
+  /// Called when the server has responded with its information.
+  ///
+  /// @param [in] info
+  ///    Information received from the server.
+  virtual void info_received(const server_info &info) = 0;
+  /// Called when the server didn't respond or its response was malformed.
+  virtual void info_failed() = 0;
+};
+
+/// The lowest value of query handles returned by @ref query_rules and
+///    @ref query_info. It's chosen to not intersect with handles returned by
+///    Steam's own server query methods.
+constexpr int query_base = 0x40000000;
+
+/// Initialize the socket and start the I/O thread, if that hasn't been done
+///    yet.
+///
+/// @return Value indicating whether the engine is running.
+[[gnu::visibility("internal")]]
+bool start();
+
+/// Close the socket, making the I/O thread exit. Pending queries are dropped
+///    without notifying their handlers. Must not be called at process exit,
+///    since the I/O thread may have been terminated while holding the engine
+///    lock.
+[[gnu::visibility("internal")]]
+void stop();
+
+/// Begin an A2S_RULES query to specified server.
+///
+/// @param ip
+///    IPv4 address of the server, in host byte order.
+/// @param port
+///    Query port of the server, in host byte order.
+/// @param [in, out] handler
+///    Handler that will receive query results.
+/// @return Handle for the query, not less than @ref query_base.
+[[gnu::visibility("internal")]]
+int query_rules(std::uint32_t ip, std::uint16_t port, rules_handler &handler);
+
+/// Begin an A2S_INFO query to specified server.
+///
+/// @param ip
+///    IPv4 address of the server, in host byte order.
+/// @param port
+///    Query port of the server, in host byte order.
+/// @param [in, out] handler
+///    Handler that will receive query results.
+/// @return Handle for the query, not less than @ref query_base.
+[[gnu::visibility("internal")]]
+int query_info(std::uint32_t ip, std::uint16_t port, info_handler &handler);
+
+/// Cancel a query that hasn't been dispatched yet.
+///
+/// @param query
+///    Handle of the query to cancel.
+/// @return Pointer to the handler associated with the query, or `nullptr` if
+///    there is no such pending query.
+[[gnu::visibility("internal")]]
+handler *_Nullable cancel(int query);
+
+/// Deliver results of all completed queries to their handlers.
+[[gnu::visibility("internal")]]
+void dispatch();
+
+} // namespace tek::game_runtime::a2s
@@ -0,0 +1,180 @@
+//===-- call_results.cpp - synthetic Steam API call results ---------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of the store of synthetic Steam API call results.
+///
+//===----------------------------------------------------------------------===//
+#include "call_results.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "metrics.hpp"
+#include "steam_api.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::call_results {
+
+namespace {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// State of a synthetic API call.
+struct call_state {
+  /// Call result receiver registered by the game, or `nullptr` if the game
+  ///    hasn't registered one, e.g. because it polls ISteamUtils instead.
+  steam_api::CCallbackBase *_Nullable receiver;
+  /// Value indicating whether the call has completed.
+  bool completed;
+  /// ID of the call result callback.
+  int callback;
+  /// Call result data.
+  std::vector<std::byte> data;
+};
+
+} // namespace
+
+//===-- Private variables -------------------------------------------------===//
+
+/// States of synthetic calls whose results haven't been consumed yet, keyed by
+///    API call handle.
+static std::unordered_map<std::uint64_t, call_state> calls;
+/// Handles of completed calls that have receivers, in completion order.
+static std::vector<std::uint64_t> ready;
+/// Mutex for locking concurrent access to @ref calls and @ref ready.
+static std::mutex calls_mtx;
+/// Handle of the next synthetic call.
+static std::atomic_uint64_t next_call{first_call};
+/// Number of completed synthetic calls.
+static metrics::counter completions{"steam_api.call_results.completed"};
+/// Number of results delivered to call result receivers.
+static metrics::counter deliveries{"steam_api.call_results.delivered"};
+/// Number of results fetched via ISteamUtils::GetAPICallResult.
+static metrics::counter polls{"steam_api.call_results.polled"};
+
+//===-- Internal functions ------------------------------------------------===//
+
+std::uint64_t create() {
+  const auto call{next_call.fetch_add(1, std::memory_order::relaxed)};
+  const std::scoped_lock lock{calls_mtx};
+  calls.emplace(call, call_state{.receiver = nullptr,
+                                 .completed = false,
+                                 .callback = 0,
+                                 .data = {}});
+  return call;
+}
+
+void complete(std::uint64_t call, int callback,
+              std::span<const std::byte> data) {
+  const std::scoped_lock lock{calls_mtx};
+  const auto it{calls.find(call)};
+  if (it == calls.end()) {
+    // The game has cancelled the call
+    return;
+  }
+  auto &state{it->second};
+  state.completed = true;
+  state.callback = callback;
+  state.data.assign(data.begin(), data.end());
+  if (state.receiver) {
+    ready.emplace_back(call);
+  }
+  completions.add();
+}
+
+void set_receiver(std::uint64_t call,
+                  steam_api::CCallbackBase *_Nullable receiver) {
+  const std::scoped_lock lock{calls_mtx};
+  const auto it{calls.find(call)};
+  if (it == calls.end()) {
+    return;
+  }
+  if (!receiver) {
+    calls.erase(it);
+    return;
+  }
+  auto &state{it->second};
+  if (state.completed && !state.receiver) {
+    ready.emplace_back(call);
+  }
+  state.receiver = receiver;
+}
+
+int dispatch() {
+  std::vector<std::uint64_t> batch;
+  {
+    const std::scoped_lock lock{calls_mtx};
+    if (ready.empty()) {
+      return 0;
+    }
+    batch = std::exchange(ready, {});
+  }
+  int delivered{};
+  for (const auto call : batch) {
+    call_state state;
+    {
+      const std::scoped_lock lock{calls_mtx};
+      const auto it{calls.find(call)};
+      // The game might have cancelled the call or fetched its result
+      if (it == calls.end() || !it->second.receiver) {
+        continue;
+      }
+      state = std::move(it->second);
+      calls.erase(it);
+    }
+    state.receiver->Run(state.data.data(), false, call);
+    deliveries.add();
+    ++delivered;
+  }
+  return delivered;
+}
+
+bool is_completed(std::uint64_t call, bool *failed) {
+  const std::scoped_lock lock{calls_mtx};
+  const auto it{calls.find(call)};
+  // Steam reports unknown handles as failed
+  *failed = it == calls.end();
+  return !*failed && it->second.completed;
+}
+
+bool get_result(std::uint64_t call, void *buf, int size, int callback,
+                bool *failed) {
+  const std::scoped_lock lock{calls_mtx};
+  const auto it{calls.find(call)};
+  if (it == calls.end()) {
+    *failed = true;
+    return false;
+  }
+  auto &state{it->second};
+  if (!state.completed) {
+    *failed = false;
+    return false;
+  }
+  if (state.callback != callback ||
+      size < static_cast<int>(state.data.size())) {
+    *failed = true;
+    return false;
+  }
+  std::ranges::copy(state.data, static_cast<std::byte *>(buf));
+  calls.erase(it);
+  *failed = false;
+  polls.add();
+  return true;
+}
+
+} // namespace tek::game_runtime::call_results
@@ -0,0 +1,119 @@
+//===-- call_results.hpp - synthetic Steam API call results ---------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for synthetic Steam API calls, which are completed by the
+///    runtime instead of Steam. Their results reach the game the same ways
+///    results of real calls do: via call result receivers registered by the
+///    game, or via ISteamUtils polling methods.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+#include "steam_api.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace tek::game_runtime::call_results {
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Lowest handle of synthetic API calls, way above the range used by Steam.
+constexpr std::uint64_t first_call{0xFFFF000000000000};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Check whether an API call handle belongs to a synthetic call.
+///
+/// @param call
+///    The API call handle.
+/// @return Value indicating whether @p call has been obtained from
+///    @ref create.
+constexpr bool is_synthetic(std::uint64_t call) noexcept {
+  return call >= first_call;
+}
+
+/// Create a synthetic API call. It stays pending until @ref complete is
+///    called for it.
+///
+/// @return Handle of the call.
+[[gnu::visibility("internal")]]
+std::uint64_t create();
+
+/// Complete a synthetic API call. The result is kept until it's delivered to
+///    the call result receiver registered for the call, fetched via
+///    @ref get_result, or the receiver is unregistered. May be called from any
+///    thread.
+///
+/// @param call
+///    Handle of the call.
+/// @param callback
+///    ID of the call result callback.
+/// @param data
+///    Call result data, copied into the store.
+[[gnu::visibility("internal")]]
+void complete(std::uint64_t call, int callback,
+              std::span<const std::byte> data);
+
+/// Register or unregister the call result receiver for a synthetic API call.
+///
+/// @param call
+///    Handle of the call.
+/// @param [in] receiver
+///    Pointer to the receiver, or `nullptr` to unregister the current one, in
+///    which case the call is dropped like Steam drops cancelled calls.
+[[gnu::visibility("internal")]]
+void set_receiver(std::uint64_t call,
+                  steam_api::CCallbackBase *_Nullable receiver);
+
+/// Deliver results of completed calls to their registered receivers. Must be
+///    called on the game's callback thread.
+///
+/// @return Number of delivered results.
+[[gnu::visibility("internal")]]
+int dispatch();
+
+/// Answer ISteamUtils::IsAPICallCompleted for a synthetic API call.
+///
+/// @param call
+///    Handle of the call.
+/// @param [out] failed
+///    Address of variable that receives value indicating whether the call has
+///    failed. Synthetic calls never fail, but handles whose results have been
+///    consumed or dropped are reported as failed, like Steam reports unknown
+///    handles.
+/// @return Value indicating whether the call has completed and its result
+///    hasn't been consumed yet.
+[[gnu::visibility("internal")]]
+bool is_completed(std::uint64_t call, bool *_Nonnull failed);
+
+/// Answer ISteamUtils::GetAPICallResult for a synthetic API call. On success
+///    the result is consumed, like Steam does it.
+///
+/// @param call
+///    Handle of the call.
+/// @param [out] buf
+///    Buffer that receives call result data.
+/// @param size
+///    Size of @p buf, in bytes.
+/// @param callback
+///    ID of the call result callback that the caller expects.
+/// @param [out] failed
+///    Address of variable that receives value indicating whether the call has
+///    failed or doesn't match @p callback.
+/// @return Value indicating whether the result has been copied to @p buf.
+[[gnu::visibility("internal")]]
+bool get_result(std::uint64_t call, void *_Nonnull buf, int size, int callback,
+                bool *_Nonnull failed);
+
+} // namespace tek::game_runtime::call_results
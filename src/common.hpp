@@ -10,7 +10,7 @@
 ///
 /// @file
 /// Definitions of Clang's `_Nullable`, `_Nonnull`, and `_Null_unspecified`
-///    attributes for other compilers, and inclusion of windows.h.
+///    attributes for other compilers, and inclusion of windows.h on Windows.
 ///
 //===----------------------------------------------------------------------===//
 #pragma once
@@ -29,6 +29,8 @@
 
 #endif // ndef __clang__
 
+#ifdef _WIN32
+
 // Include windows.h with API set reduced as much as possible
 #ifdef _WIN32_WINNT
 #undef _WIN32_WINNT
@@ -74,3 +76,5 @@ static inline void display_error(LPCWSTR msg) {
   MessageBoxW(nullptr, msg, L"TEK Game Runtime", MB_OK | MB_ICONERROR);
 }
 } // namespace tek::game_runtime
+
+#endif // def _WIN32
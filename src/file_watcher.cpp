@@ -0,0 +1,233 @@
+//===-- file_watcher.cpp - file change watcher implementation -------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of @ref tek::game_runtime::file_watcher.
+///
+//===----------------------------------------------------------------------===//
+#include "file_watcher.hpp"
+
+#ifdef _WIN32
+#include "common.hpp" // IWYU pragma: keep
+#else
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace tek::game_runtime {
+
+namespace {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Results of waiting for a change notification.
+enum class wait_result {
+  /// The directory containing the file has changed.
+  change,
+  /// The wait has timed out.
+  timeout,
+  /// The watcher is being stopped, or waiting has failed.
+  stop
+};
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Wait for a change notification or a stop signal.
+///
+/// @param notify
+///    Change notification handle on Windows, inotify descriptor elsewhere.
+/// @param stop
+///    Stop event handle on Windows, eventfd descriptor elsewhere.
+/// @param timeout
+///    Maximum time to wait, or a negative value to wait indefinitely.
+/// @return Result of the wait.
+static wait_result wait_change(std::intptr_t notify, std::intptr_t stop,
+                               std::chrono::milliseconds timeout) {
+#ifdef _WIN32
+  const std::array handles{reinterpret_cast<HANDLE>(stop),
+                           reinterpret_cast<HANDLE>(notify)};
+  switch (WaitForMultipleObjects(
+      handles.size(), handles.data(), FALSE,
+      timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count()))) {
+  case WAIT_OBJECT_0 + 1:
+    // Re-arm the notification for the next wait
+    return FindNextChangeNotification(handles[1]) ? wait_result::change
+                                                  : wait_result::stop;
+  case WAIT_TIMEOUT:
+    return wait_result::timeout;
+  default:
+    return wait_result::stop;
+  }
+#else  // def _WIN32
+  std::array fds{
+      pollfd{.fd = static_cast<int>(stop), .events = POLLIN, .revents = 0},
+      pollfd{.fd = static_cast<int>(notify), .events = POLLIN, .revents = 0}};
+  const auto res{poll(fds.data(), fds.size(),
+                      timeout.count() < 0 ? -1
+                                          : static_cast<int>(timeout.count()))};
+  if (res == 0) {
+    return wait_result::timeout;
+  }
+  if (res < 0 || fds[0].revents) {
+    return wait_result::stop;
+  }
+  // Drain pending events, the file itself is checked by the caller
+  alignas(inotify_event) std::array<char, 4096> buf;
+  while (read(fds[1].fd, buf.data(), buf.size()) > 0) {
+  }
+  return wait_result::change;
+#endif // def _WIN32 else
+}
+
+} // namespace
+
+//===-- file_watcher methods ----------------------------------------------===//
+
+file_watcher::file_watcher(std::filesystem::path path,
+                           std::function<void()> on_change)
+    : path{std::move(path)}, on_change{std::move(on_change)} {}
+
+file_watcher::~file_watcher() { stop(); }
+
+void file_watcher::thread_proc(std::intptr_t notify) {
+#ifdef _WIN32
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+  const auto stop{reinterpret_cast<std::intptr_t>(stop_event)};
+#else
+  const auto stop{static_cast<std::intptr_t>(stop_fd)};
+#endif
+  for (;;) {
+    if (wait_change(notify, stop, std::chrono::milliseconds{-1}) !=
+        wait_result::change) {
+      break;
+    }
+    // Wait until changes settle down
+    wait_result res;
+    do {
+      res = wait_change(notify, stop, debounce_delay);
+    } while (res == wait_result::change);
+    if (res == wait_result::stop) {
+      break;
+    }
+    // Notifications are received for the whole directory, so ensure that it's
+    //    the watched file that has changed
+    if (update_state()) {
+      on_change();
+    }
+  }
+#ifdef _WIN32
+  FindCloseChangeNotification(reinterpret_cast<HANDLE>(notify));
+#else
+  close(static_cast<int>(notify));
+#endif
+}
+
+bool file_watcher::update_state() {
+  std::error_code ec;
+  const auto time{std::filesystem::last_write_time(path, ec)};
+  if (ec) {
+    // The file may be temporarily missing while it's being replaced, the next
+    //    notification will pick it up
+    return false;
+  }
+  const auto size{std::filesystem::file_size(path, ec)};
+  if (ec) {
+    return false;
+  }
+  const std::scoped_lock lock{state_mtx};
+  if (time == last_time && size == last_size) {
+    return false;
+  }
+  last_time = time;
+  last_size = size;
+  return true;
+}
+
+bool file_watcher::start() {
+  if (thread.joinable()) {
+    return true;
+  }
+  auto dir{path.parent_path()};
+  if (dir.empty()) {
+    dir = ".";
+  }
+#ifdef _WIN32
+  const auto notify{FindFirstChangeNotificationW(
+      dir.c_str(), FALSE,
+      FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE |
+          FILE_NOTIFY_CHANGE_LAST_WRITE)};
+  if (notify == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  stop_event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+  if (!stop_event) {
+    FindCloseChangeNotification(notify);
+    return false;
+  }
+  const auto notify_val{reinterpret_cast<std::intptr_t>(notify)};
+#else  // def _WIN32
+  const auto notify{inotify_init1(IN_NONBLOCK | IN_CLOEXEC)};
+  if (notify < 0) {
+    return false;
+  }
+  // Editors often save by writing a new file and renaming it over the old
+  //    one, so the directory is watched rather than the file itself
+  if (inotify_add_watch(notify, dir.c_str(),
+                        IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+    close(notify);
+    return false;
+  }
+  stop_fd = eventfd(0, EFD_CLOEXEC);
+  if (stop_fd < 0) {
+    close(notify);
+    return false;
+  }
+  const auto notify_val{static_cast<std::intptr_t>(notify)};
+#endif // def _WIN32 else
+  update_state();
+  thread = std::thread{&file_watcher::thread_proc, this, notify_val};
+  return true;
+}
+
+void file_watcher::stop() {
+  if (!thread.joinable()) {
+    return;
+  }
+#ifdef _WIN32
+  SetEvent(stop_event);
+#else
+  const std::uint64_t val{1};
+  [[maybe_unused]] const auto res{write(stop_fd, &val, sizeof val)};
+#endif
+  thread.join();
+#ifdef _WIN32
+  CloseHandle(stop_event);
+  stop_event = nullptr;
+#else
+  close(stop_fd);
+  stop_fd = -1;
+#endif
+}
+
+void file_watcher::ignore_current() { update_state(); }
+
+} // namespace tek::game_runtime
@@ -0,0 +1,90 @@
+//===-- file_watcher.hpp - file change watcher interface ------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the file change watcher. Windows builds use directory
+///    change notifications, other platforms use inotify.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace tek::game_runtime {
+
+/// Watcher that invokes a callback on its own thread when a file is modified.
+///    Bursts of changes, like the ones that text editors produce when saving
+///    files, are coalesced into a single callback invocation.
+class [[gnu::visibility("internal")]] file_watcher {
+  /// Path to the watched file.
+  const std::filesystem::path path;
+  /// Callback to invoke when the file changes.
+  const std::function<void()> on_change;
+  /// Mutex locking concurrent access to @ref last_time and @ref last_size.
+  std::mutex state_mtx;
+  /// Last write time of the file that has been seen.
+  std::filesystem::file_time_type last_time;
+  /// Size of the file that has been seen.
+  std::uintmax_t last_size{};
+  /// Thread waiting for change notifications.
+  std::thread thread;
+#ifdef _WIN32
+  /// Handle for the event that signals the watcher thread to exit.
+  void *stop_event{};
+#else
+  /// eventfd descriptor that signals the watcher thread to exit.
+  int stop_fd{-1};
+#endif
+
+  /// Procedure for the watcher thread.
+  ///
+  /// @param notify
+  ///    Change notification handle on Windows, inotify descriptor elsewhere.
+  void thread_proc(std::intptr_t notify);
+  /// Check whether the file differs from the last seen state, and remember its
+  ///    current state.
+  ///
+  /// @return Value indicating whether the file has changed.
+  bool update_state();
+
+public:
+  /// Delay after the last change notification before invoking the callback.
+  static constexpr std::chrono::milliseconds debounce_delay{250};
+
+  /// Create a watcher for specified file. Watching doesn't begin until
+  ///    @ref start is called.
+  ///
+  /// @param path
+  ///    Path to the file to watch. Its parent directory must exist.
+  /// @param on_change
+  ///    Callback to invoke on the watcher thread when the file changes.
+  file_watcher(std::filesystem::path path, std::function<void()> on_change);
+  file_watcher(const file_watcher &) = delete;
+  file_watcher &operator=(const file_watcher &) = delete;
+  ~file_watcher();
+
+  /// Begin watching the file.
+  ///
+  /// @return Value indicating whether watching has started.
+  bool start();
+  /// Stop watching the file and wait for the watcher thread to exit. Must not
+  ///    be called from the callback.
+  void stop();
+  /// Remember current state of the file as already seen, so changes made by
+  ///    the caller itself don't trigger the callback.
+  void ignore_current();
+};
+
+} // namespace tek::game_runtime
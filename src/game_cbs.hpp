@@ -30,6 +30,14 @@ namespace tek::game_runtime {
 ///    RapidJSON document describing settings file contents.
 using settings_load_cb_t = void(const rapidjson::Document &doc);
 
+/// The callback that may be used to apply game-specific settings that support
+///    hot-reload. It runs on the settings watcher thread when the settings
+///    file changes.
+///
+/// @param [in] doc
+///    RapidJSON document describing new settings file contents.
+using settings_reload_cb_t = void(const rapidjson::Document &doc);
+
 /// The callback that may be used to save game-specific settings.
 ///
 /// @param [in, out] writer
@@ -43,18 +51,39 @@ using settings_save_cb_t =
 ///    returned, DLL loading fails.
 using dllmain_cb_t = bool();
 
+/// The callback that runs on a runtime pool thread concurrently with the
+///    original `SteamAPI_Init`. May be used for game-specific setup that only
+///    depends on settings, like scanning directories or loading cache files.
+///    It must not use Steam API, and it's guaranteed to finish before
+///    `steam_api_init_cb_t` callback runs.
+using steam_api_pre_init_cb_t = void();
+
 /// The callback that runs in SteamAPI_Init wrapper after setting up all
 ///    interface wrappers. May be used to setup game-specific Steam API method
 ///    wrappers.
 using steam_api_init_cb_t = void();
 
+/// The callback that runs in SteamGameServer_Init wrapper after setting up
+///    game server's ISteamUGC wrapper. May be used to setup game-specific
+///    method wrappers for dedicated servers.
+using steam_game_server_init_cb_t = void();
+
+/// The callback that runs in SteamAPI_RunCallbacks wrapper after the original
+///    function has dispatched Steam callbacks. May be used to deliver results
+///    of runtime's own asynchronous operations on the game's callback thread.
+using steam_api_run_callbacks_cb_t = void();
+
 namespace cbs {
 
 namespace steam {
 
 settings_load_cb_t settings_load_346110;
 settings_save_cb_t settings_save_346110;
+settings_reload_cb_t settings_reload_346110;
+steam_api_pre_init_cb_t steam_api_pre_init_346110;
 steam_api_init_cb_t steam_api_init_346110;
+steam_api_run_callbacks_cb_t steam_api_run_callbacks_346110;
+steam_game_server_init_cb_t steam_game_server_init_346110;
 
 settings_load_cb_t settings_load_2399830;
 settings_save_cb_t settings_save_2399830;
@@ -83,6 +112,24 @@ static inline settings_load_cb_t *_Nullable get_settings_load_cb() noexcept {
   return nullptr;
 }
 
+/// Get pointer to the settings reload callback for current game, if it
+///    exists.
+///
+/// @return Pointer to the callback function for current game, or `nullptr` if
+///    it doesn't exist.
+static inline settings_reload_cb_t *_Nullable
+get_settings_reload_cb() noexcept {
+  switch (g_settings.store) {
+  case store_type::steam:
+    switch (g_settings.steam->app_id) {
+    case 346110:
+      return cbs::steam::settings_reload_346110;
+    }
+    break;
+  }
+  return nullptr;
+}
+
 /// Get pointer to the settings save callback for current game, if it exists.
 ///
 /// @return Pointer to the callback function for current game, or `nullptr` if
@@ -117,6 +164,24 @@ static inline dllmain_cb_t *_Nullable get_dllmain_cb() noexcept {
   return nullptr;
 }
 
+/// Get pointer to the `SteamAPI_Init` pre-init callback for current game, if it
+///    exists.
+///
+/// @return Pointer to the callback function for current game, or `nullptr` if
+///    it doesn't exist.
+static inline steam_api_pre_init_cb_t *_Nullable
+get_steam_api_pre_init_cb() noexcept {
+  switch (g_settings.store) {
+  case store_type::steam:
+    switch (g_settings.steam->app_id) {
+    case 346110:
+      return cbs::steam::steam_api_pre_init_346110;
+    }
+    break;
+  }
+  return nullptr;
+}
+
 /// Get pointer to the `SteamAPI_Init` callback for current game, if it exists.
 ///
 /// @return Pointer to the callback function for current game, or `nullptr` if
@@ -135,4 +200,40 @@ static inline steam_api_init_cb_t *_Nullable get_steam_api_init_cb() noexcept {
   return nullptr;
 }
 
+/// Get pointer to the `SteamGameServer_Init` callback for current game, if it
+///    exists.
+///
+/// @return Pointer to the callback function for current game, or `nullptr` if
+///    it doesn't exist.
+static inline steam_game_server_init_cb_t *_Nullable
+get_steam_game_server_init_cb() noexcept {
+  switch (g_settings.store) {
+  case store_type::steam:
+    switch (g_settings.steam->app_id) {
+    case 346110:
+      return cbs::steam::steam_game_server_init_346110;
+    }
+    break;
+  }
+  return nullptr;
+}
+
+/// Get pointer to the `SteamAPI_RunCallbacks` callback for current game, if it
+///    exists.
+///
+/// @return Pointer to the callback function for current game, or `nullptr` if
+///    it doesn't exist.
+static inline steam_api_run_callbacks_cb_t *_Nullable
+get_steam_api_run_callbacks_cb() noexcept {
+  switch (g_settings.store) {
+  case store_type::steam:
+    switch (g_settings.steam->app_id) {
+    case 346110:
+      return cbs::steam::steam_api_run_callbacks_346110;
+    }
+    break;
+  }
+  return nullptr;
+}
+
 } // namespace tek::game_runtime
@@ -0,0 +1,381 @@
+//===-- http_cache.cpp - HTTP response cache implementation ---------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of the HTTP response cache.
+///
+//===----------------------------------------------------------------------===//
+#include "http_cache.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "jobs.hpp"
+#include "memory.hpp"
+#include "metrics.hpp"
+#include "shared_cache.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif // ndef _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::http_cache {
+
+namespace {
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Magic value identifying the entry file layout. Must be changed along with
+///    any change to @ref entry_header or the layout of data following it.
+constexpr std::uint32_t entry_magic{0x31434854}; // "THC1"
+/// Maximum total size of cache files, in bytes.
+constexpr std::uint64_t max_total_size{64 * 1024 * 1024};
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Header of a cache entry file. It's followed by the request key, then by
+///    headers, each as a `std::uint32_t` name length, the name, a
+///    `std::uint32_t` value length and the value, and then by the body.
+struct entry_header {
+  /// Layout magic value.
+  std::uint32_t magic;
+  /// HTTP status code of the response.
+  std::int32_t status_code;
+  /// Expiration time of the response, in seconds since Unix epoch.
+  std::int64_t expires;
+  /// Length of the request key.
+  std::uint32_t key_size;
+  /// Number of stored headers.
+  std::uint32_t num_headers;
+  /// Size of the response body.
+  std::uint32_t body_size;
+  std::uint32_t reserved;
+};
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Path to the cache directory.
+static std::filesystem::path dir_path;
+/// Approximate total size of cache files, in bytes.
+static std::atomic_uint64_t total_size;
+/// Mutex serializing @ref prune runs.
+static std::mutex prune_mtx;
+/// Number of responses written to the cache.
+static metrics::counter writes{"http_cache.writes"};
+/// Number of files evicted to keep total size under the limit.
+static metrics::counter evictions{"http_cache.evictions"};
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Get the path to the file of a cache entry.
+///
+/// @param key
+///    Key identifying the request.
+/// @return Path to the entry file.
+static std::filesystem::path entry_path(std::string_view key) {
+  return dir_path / std::format("{:016x}", shared_cache::hash_key(key));
+}
+
+/// Compare two ASCII strings case-insensitively.
+///
+/// @param a
+///    The first string.
+/// @param b
+///    The second string.
+/// @return Value indicating whether the strings are equal.
+static bool iequals(std::string_view a, std::string_view b) noexcept {
+  return std::ranges::equal(a, b, [](char l, char r) {
+    const auto lower{[](char c) {
+      return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+    }};
+    return lower(l) == lower(r);
+  });
+}
+
+/// Remove the oldest cache files until their total size is within the limit,
+///    and update @ref total_size.
+static void prune() {
+  const std::scoped_lock lock{prune_mtx};
+  /// Cache file description.
+  struct file_desc {
+    std::filesystem::path path;
+    std::filesystem::file_time_type time;
+    std::uint64_t size;
+  };
+  std::vector<file_desc> files;
+  std::uint64_t size{};
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator{dir_path, ec}) {
+    if (!entry.is_regular_file(ec)) {
+      continue;
+    }
+    const auto file_size{entry.file_size(ec)};
+    if (ec) {
+      continue;
+    }
+    files.emplace_back(entry.path(), entry.last_write_time(ec), file_size);
+    size += file_size;
+  }
+  if (size > max_total_size) {
+    std::ranges::sort(files, {}, &file_desc::time);
+    for (const auto &file : files) {
+      if (size <= max_total_size) {
+        break;
+      }
+      if (std::filesystem::remove(file.path, ec)) {
+        size -= file.size;
+        evictions.add();
+      }
+    }
+  }
+  total_size.store(size, std::memory_order::relaxed);
+}
+
+/// Write a response to its entry file.
+///
+/// @param key
+///    Key identifying the request.
+/// @param resp
+///    The response to write.
+static void write_entry(std::string_view key, const response &resp) {
+  std::vector<std::byte> buf;
+  const auto append{[&buf](const void *_Nonnull data, std::size_t size) {
+    const auto bytes{static_cast<const std::byte *>(data)};
+    buf.insert(buf.end(), bytes, bytes + size);
+  }};
+  const entry_header hdr{
+      .magic = entry_magic,
+      .status_code = resp.status_code,
+      .expires = std::chrono::duration_cast<std::chrono::seconds>(
+                     resp.expires.time_since_epoch())
+                     .count(),
+      .key_size = static_cast<std::uint32_t>(key.size()),
+      .num_headers = static_cast<std::uint32_t>(resp.headers.size()),
+      .body_size = static_cast<std::uint32_t>(resp.body.size()),
+      .reserved = 0};
+  append(&hdr, sizeof hdr);
+  append(key.data(), key.size());
+  for (const auto &[name, value] : resp.headers) {
+    const auto name_size{static_cast<std::uint32_t>(name.size())};
+    append(&name_size, sizeof name_size);
+    append(name.data(), name.size());
+    const auto value_size{static_cast<std::uint32_t>(value.size())};
+    append(&value_size, sizeof value_size);
+    append(value.data(), value.size());
+  }
+  append(resp.body.data(), resp.body.size());
+  // Write to a temporary file first so readers never see a truncated entry
+  const auto path{entry_path(key)};
+  auto tmp_path{path};
+  tmp_path += ".tmp";
+#ifdef _WIN32
+  const auto file{CreateFileW(tmp_path.c_str(), GENERIC_WRITE, 0, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  DWORD bytes_written;
+  const bool written{
+      WriteFile(file, buf.data(), buf.size(), &bytes_written, nullptr) &&
+      bytes_written == buf.size()};
+  CloseHandle(file);
+  if (!written ||
+      !MoveFileExW(tmp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+    DeleteFileW(tmp_path.c_str());
+    return;
+  }
+#else  // def _WIN32
+  const int fd{
+      ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+  if (fd < 0) {
+    return;
+  }
+  const bool written{write(fd, buf.data(), buf.size()) ==
+                     static_cast<ssize_t>(buf.size())};
+  close(fd);
+  if (!written || rename(tmp_path.c_str(), path.c_str()) != 0) {
+    unlink(tmp_path.c_str());
+    return;
+  }
+#endif // def _WIN32 else
+  writes.add();
+  if (total_size.fetch_add(buf.size(), std::memory_order::relaxed) +
+          buf.size() >
+      max_total_size) {
+    prune();
+  }
+}
+
+} // namespace
+
+//===-- Internal functions ------------------------------------------------===//
+
+void open(const std::filesystem::path &path) {
+  dir_path = path;
+  std::error_code ec;
+  std::filesystem::create_directories(dir_path, ec);
+  jobs::runtime_pool().submit(prune, jobs::priority::low);
+}
+
+std::shared_ptr<const response> get(std::string_view key) {
+  const auto path{entry_path(key)};
+  std::vector<std::byte> buf;
+#ifdef _WIN32
+  // FILE_SHARE_DELETE lets writers replace the file while it's being read
+  const auto file{CreateFileW(path.c_str(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  LARGE_INTEGER size;
+  if (GetFileSizeEx(file, &size) &&
+      static_cast<std::uint64_t>(size.QuadPart) >= sizeof(entry_header) &&
+      static_cast<std::uint64_t>(size.QuadPart) <= max_total_size) {
+    buf.resize(size.QuadPart);
+    DWORD bytes_read;
+    if (!ReadFile(file, buf.data(), buf.size(), &bytes_read, nullptr) ||
+        bytes_read != buf.size()) {
+      buf.clear();
+    }
+  }
+  CloseHandle(file);
+#else  // def _WIN32
+  const int fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (fd < 0) {
+    return nullptr;
+  }
+  const auto size{lseek(fd, 0, SEEK_END)};
+  if (size >= static_cast<off_t>(sizeof(entry_header)) &&
+      static_cast<std::uint64_t>(size) <= max_total_size) {
+    buf.resize(size);
+    if (pread(fd, buf.data(), buf.size(), 0) != size) {
+      buf.clear();
+    }
+  }
+  close(fd);
+#endif // def _WIN32 else
+  if (buf.empty()) {
+    return nullptr;
+  }
+  entry_header hdr;
+  std::ranges::copy_n(buf.cbegin(), sizeof hdr,
+                      reinterpret_cast<std::byte *>(&hdr));
+  std::span<const std::byte> rem{buf};
+  rem = rem.subspan(sizeof hdr);
+  if (hdr.magic != entry_magic || rem.size() < hdr.key_size ||
+      std::string_view{reinterpret_cast<const char *>(rem.data()),
+                       hdr.key_size} != key) {
+    return nullptr;
+  }
+  const std::chrono::system_clock::time_point expires{
+      std::chrono::seconds{hdr.expires}};
+  if (expires <= std::chrono::system_clock::now()) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return nullptr;
+  }
+  rem = rem.subspan(hdr.key_size);
+  auto resp{std::allocate_shared<response>(std::pmr::polymorphic_allocator<>{
+      &memory::resource(memory::subsystem::http_cache)})};
+  resp->status_code = hdr.status_code;
+  resp->expires = expires;
+  /// Read a length-prefixed string from @p rem.
+  const auto read_str{[&rem](std::pmr::string &str) {
+    std::uint32_t str_size;
+    if (rem.size() < sizeof str_size) {
+      return false;
+    }
+    std::ranges::copy_n(rem.begin(), sizeof str_size,
+                        reinterpret_cast<std::byte *>(&str_size));
+    rem = rem.subspan(sizeof str_size);
+    if (rem.size() < str_size) {
+      return false;
+    }
+    str.assign(reinterpret_cast<const char *>(rem.data()), str_size);
+    rem = rem.subspan(str_size);
+    return true;
+  }};
+  resp->headers.resize(hdr.num_headers);
+  for (auto &[name, value] : resp->headers) {
+    if (!read_str(name) || !read_str(value)) {
+      return nullptr;
+    }
+  }
+  if (rem.size() != hdr.body_size) {
+    return nullptr;
+  }
+  resp->body.assign(reinterpret_cast<const std::uint8_t *>(rem.data()),
+                    reinterpret_cast<const std::uint8_t *>(rem.data()) +
+                        rem.size());
+  return resp;
+}
+
+void put(std::string key, std::shared_ptr<const response> resp) {
+  jobs::runtime_pool().submit(
+      [key = std::move(key), resp = std::move(resp)] {
+        write_entry(key, *resp);
+      },
+      jobs::priority::low);
+}
+
+const std::pmr::string *find_header(const response &resp,
+                                    std::string_view name) noexcept {
+  const auto it{std::ranges::find_if(resp.headers, [name](const auto &header) {
+    return iequals(header.first, name);
+  })};
+  return it == resp.headers.end() ? nullptr : &it->second;
+}
+
+std::chrono::seconds freshness_lifetime(std::string_view cache_control) {
+  std::chrono::seconds lifetime{};
+  for (const auto &&part : cache_control | std::views::split(',')) {
+    std::string_view directive{part.begin(), part.end()};
+    directive.remove_prefix(
+        std::min(directive.find_first_not_of(" \t"), directive.size()));
+    directive.remove_suffix(
+        directive.size() -
+        std::min(directive.find_last_not_of(" \t") + 1, directive.size()));
+    if (iequals(directive, "no-store") || iequals(directive, "no-cache")) {
+      return {};
+    }
+    constexpr std::string_view max_age{"max-age="};
+    if (directive.size() > max_age.size() &&
+        iequals(directive.substr(0, max_age.size()), max_age)) {
+      const auto value{directive.substr(max_age.size())};
+      std::int64_t seconds;
+      if (std::from_chars(value.data(), value.data() + value.size(), seconds)
+              .ec == std::errc{}) {
+        lifetime = std::chrono::seconds{seconds};
+      }
+    }
+  }
+  return std::max(lifetime, std::chrono::seconds{});
+}
+
+} // namespace tek::game_runtime::http_cache
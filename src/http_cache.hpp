@@ -0,0 +1,114 @@
+//===-- http_cache.hpp - HTTP response cache interface --------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the on-disk cache of responses to HTTP GET requests that
+///    games make via ISteamHTTP. Each response is stored in its own file,
+///    named after the hash of its request key; total size of the directory is
+///    bounded, oldest files are evicted first.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+#include "memory.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::http_cache {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// HTTP response stored in the cache.
+struct response {
+  /// HTTP status code of the response.
+  int status_code;
+  /// Point in time after which the response must not be served from the
+  ///    cache. Default value indicates that the response may not be cached.
+  std::chrono::system_clock::time_point expires;
+  /// Values of response headers listed in @ref stored_headers, that were
+  ///    present in the response.
+  std::pmr::vector<std::pair<std::pmr::string, std::pmr::string>> headers{
+      &memory::resource(memory::subsystem::http_cache)};
+  /// Response body.
+  std::pmr::vector<std::uint8_t> body{
+      &memory::resource(memory::subsystem::http_cache)};
+};
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Names of response headers that are stored along with responses. Steam API
+///    doesn't allow enumerating response headers, so other ones are
+///    unavailable for responses served from the cache.
+constexpr std::array<const char *, 7> stored_headers{
+    "Content-Type", "Content-Encoding", "Content-Language", "ETag",
+    "Last-Modified", "Cache-Control",   "Date"};
+/// Maximum size of a response body that may be cached, in bytes.
+constexpr std::uint32_t max_body_size{4 * 1024 * 1024};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Set the cache directory, creating it if needed, and start a background
+///    job removing files that exceed the size limit.
+///
+/// @param path
+///    Path to the cache directory.
+[[gnu::visibility("internal")]]
+void open(const std::filesystem::path &path);
+
+/// Get a response from the cache if it's still fresh.
+///
+/// @param key
+///    Key identifying the request.
+/// @return Pointer to the response, or `nullptr` if there is no fresh
+///    response for @p key.
+[[gnu::visibility("internal")]]
+std::shared_ptr<const response> get(std::string_view key);
+
+/// Store a response in the cache. The file is written by a background job.
+///
+/// @param key
+///    Key identifying the request.
+/// @param resp
+///    The response to store. Its `expires` must be set.
+[[gnu::visibility("internal")]]
+void put(std::string key, std::shared_ptr<const response> resp);
+
+/// Find the value of a stored header of a response.
+///
+/// @param resp
+///    The response to search in.
+/// @param name
+///    Name of the header, compared case-insensitively.
+/// @return Pointer to the value of the header, or `nullptr` if the response
+///    doesn't have it.
+[[gnu::visibility("internal")]]
+const std::pmr::string *_Nullable find_header(const response &resp,
+                                              std::string_view name) noexcept;
+
+/// Get the period of time for which a response may be served from the cache,
+///    based on its `Cache-Control` header.
+///
+/// @param cache_control
+///    Value of the `Cache-Control` header.
+/// @return Freshness lifetime of the response, zero if it may not be cached.
+[[gnu::visibility("internal")]]
+std::chrono::seconds freshness_lifetime(std::string_view cache_control);
+
+} // namespace tek::game_runtime::http_cache
@@ -0,0 +1,155 @@
+//===-- id_set.hpp - immutable app ID sets --------------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Immutable sets of app IDs, laid out according to their size and density,
+///    with lookups specialized for each layout. DLC lookup wrappers pick the
+///    specialization matching the DLC lists from settings.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace tek::game_runtime {
+
+/// Layouts of app ID sets that DLC lookup wrappers are specialized for.
+enum class id_set_kind {
+  /// The set is empty.
+  empty,
+  /// IDs are compared one by one, 4 at a time with SSE2 where available.
+  linear,
+  /// IDs are bits in a bitmap covering the range between the lowest and the
+  ///    highest of them.
+  bitmap,
+  /// IDs are stored in a hash table.
+  hashed
+};
+
+/// Maximum number of IDs in a set that uses `id_set_kind::linear` layout.
+constexpr std::size_t max_linear_ids{16};
+/// Maximum number of bits in a bitmap of a set that uses
+///    `id_set_kind::bitmap` layout.
+constexpr std::uint32_t max_bitmap_bits{64 * 1024};
+
+/// Immutable set of app IDs, laid out according to its size and density.
+struct id_set {
+  /// Layout of the set.
+  id_set_kind kind;
+  /// For `id_set_kind::linear`, IDs padded with copies of the first one to a
+  ///    multiple of 4 elements.
+  std::vector<std::uint32_t> ids;
+  /// For `id_set_kind::bitmap`, the lowest ID in the set.
+  std::uint32_t base;
+  /// For `id_set_kind::bitmap`, number of bits in @ref bits.
+  std::uint32_t num_bits;
+  /// For `id_set_kind::bitmap`, the bitmap, where bit N is set if
+  ///    `base + N` is in the set.
+  std::vector<std::uint64_t> bits;
+  /// For `id_set_kind::hashed`, the hash table.
+  std::unordered_set<std::uint32_t> hash;
+
+  /// Build the set with the cheapest layout for specified IDs.
+  ///
+  /// @param [in] src
+  ///    Range of IDs to put into the set.
+  explicit id_set(std::ranges::input_range auto &&src) {
+    std::ranges::copy(src, std::back_inserter(ids));
+    std::ranges::sort(ids);
+    const auto [first, last]{std::ranges::unique(ids)};
+    ids.erase(first, last);
+    if (ids.empty()) {
+      kind = id_set_kind::empty;
+    } else if (ids.size() <= max_linear_ids) {
+      kind = id_set_kind::linear;
+      ids.resize((ids.size() + 3) & ~std::size_t{3}, ids.front());
+    } else if (ids.back() - ids.front() < max_bitmap_bits) {
+      kind = id_set_kind::bitmap;
+      base = ids.front();
+      num_bits = ids.back() - base + 1;
+      bits.resize((num_bits + 63) / 64);
+      for (const auto id : ids) {
+        bits[(id - base) / 64] |= std::uint64_t{1} << ((id - base) % 64);
+      }
+      ids.clear();
+    } else {
+      kind = id_set_kind::hashed;
+      hash.insert(ids.cbegin(), ids.cend());
+      ids.clear();
+    }
+  }
+
+  /// Check whether the set contains specified ID, assuming its layout.
+  ///
+  /// @tparam layout
+  ///    Layout of the set, must be equal to @ref kind.
+  /// @param id
+  ///    The ID to check.
+  /// @return Value indicating whether the set contains @p id.
+  template <id_set_kind layout>
+  bool contains(std::uint32_t id) const noexcept {
+    if constexpr (layout == id_set_kind::empty) {
+      return false;
+    } else if constexpr (layout == id_set_kind::linear) {
+#ifdef __SSE2__
+      const auto needle{_mm_set1_epi32(static_cast<int>(id))};
+      for (std::size_t i{}; i < ids.size(); i += 4) {
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(&ids[i])),
+                needle))) {
+          return true;
+        }
+      }
+      return false;
+#else  // def __SSE2__
+      return std::ranges::contains(ids, id);
+#endif // def __SSE2__ else
+    } else if constexpr (layout == id_set_kind::bitmap) {
+      // IDs below base wrap around and fail the range check as well
+      const auto off{id - base};
+      return off < num_bits && (bits[off / 64] >> (off % 64) & 1);
+    } else {
+      return hash.contains(id);
+    }
+  }
+
+  /// Check whether the set contains specified ID.
+  ///
+  /// @param id
+  ///    The ID to check.
+  /// @return Value indicating whether the set contains @p id.
+  bool contains(std::uint32_t id) const noexcept {
+    switch (kind) {
+    case id_set_kind::empty:
+      return false;
+    case id_set_kind::linear:
+      return contains<id_set_kind::linear>(id);
+    case id_set_kind::bitmap:
+      return contains<id_set_kind::bitmap>(id);
+    case id_set_kind::hashed:
+      return contains<id_set_kind::hashed>(id);
+    }
+    return false;
+  }
+};
+
+} // namespace tek::game_runtime
@@ -0,0 +1,435 @@
+//===-- jobs.cpp - background job system implementation -------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of the work-stealing thread pool.
+///
+//===----------------------------------------------------------------------===//
+#include "jobs.hpp"
+
+#include "log.hpp"
+
+#ifdef _WIN32
+#include "common.hpp" // IWYU pragma: keep
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::jobs {
+
+namespace {
+
+/// Mutex for locking concurrent access to the global pool list.
+constinit std::mutex pools_mtx;
+/// Pointer to the first pool in the global list.
+constinit pool *first_pool;
+/// Pool that current thread is a worker of.
+constinit thread_local pool *current_pool;
+/// Index of current thread's worker in @ref current_pool.
+constinit thread_local std::size_t current_worker;
+/// State of the job being executed on current thread.
+constinit thread_local detail::state_base *current_job;
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Job waiting for its delay to expire.
+struct delayed_task {
+  /// Time point at which the job is enqueued.
+  std::chrono::steady_clock::time_point time;
+  /// Pool to enqueue the job into.
+  pool *owner;
+  /// The job.
+  std::unique_ptr<detail::task_base> task;
+  /// Priority of the job.
+  priority prio;
+};
+
+/// State of the timer thread that enqueues delayed jobs.
+struct timer_state {
+  /// Mutex for locking concurrent access to @ref tasks.
+  std::mutex mtx;
+  /// Condition variable for waking up the timer thread.
+  std::condition_variable cv;
+  /// Delayed jobs, as a min-heap ordered by time.
+  std::vector<delayed_task> tasks;
+  /// Flag for creating the thread only once.
+  std::once_flag start_flag;
+};
+
+} // namespace
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Comparator for the min-heap of delayed jobs.
+///
+/// @param [in] a
+///    The first job to compare.
+/// @param [in] b
+///    The second job to compare.
+/// @return Value indicating whether @p a is due later than @p b.
+static bool later(const delayed_task &a, const delayed_task &b) noexcept {
+  return a.time > b.time;
+}
+
+/// Get the timer state. It's leaked, as the timer thread may be waiting on
+///    its mutex when the process exits.
+///
+/// @return Reference to the timer state.
+static timer_state &timer() {
+  static auto &instance{*new timer_state};
+  return instance;
+}
+
+/// Timer thread procedure.
+static void timer_proc() {
+  auto &t{timer()};
+  std::unique_lock lock{t.mtx};
+  for (;;) {
+    if (t.tasks.empty()) {
+      t.cv.wait(lock);
+      continue;
+    }
+    if (const auto time{t.tasks.front().time};
+        std::chrono::steady_clock::now() < time) {
+      t.cv.wait_until(lock, time);
+      continue;
+    }
+    std::ranges::pop_heap(t.tasks, later);
+    auto entry{std::move(t.tasks.back())};
+    t.tasks.pop_back();
+    // The lock is held while pushing, so pool::stop can't complete and
+    //    destroy the pool in the meantime
+    entry.owner->push(std::move(entry.task), entry.prio);
+  }
+}
+
+//===-- State methods -----------------------------------------------------===//
+
+namespace detail {
+
+void state_base::finish(bool cancelled, bool failed) {
+  decltype(continuations) conts;
+  {
+    const std::scoped_lock lock{mtx};
+    done = true;
+    was_cancelled = cancelled;
+    was_failed = failed;
+    conts = std::move(continuations);
+  }
+  cv.notify_all();
+  for (auto &[task, prio] : conts) {
+    if (cancelled || failed) {
+      task->shared->finish(true);
+    } else {
+      owner->push(std::move(task), prio);
+    }
+  }
+}
+
+void state_base::wait() {
+  std::unique_lock lock{mtx};
+  cv.wait(lock, [this] { return done; });
+}
+
+bool state_base::ready() {
+  const std::scoped_lock lock{mtx};
+  return done;
+}
+
+bool state_base::cancelled() {
+  const std::scoped_lock lock{mtx};
+  return was_cancelled;
+}
+
+bool state_base::failed() {
+  const std::scoped_lock lock{mtx};
+  return was_failed;
+}
+
+void state_base::add_continuation(std::unique_ptr<task_base> task,
+                                  priority prio) {
+  {
+    const std::scoped_lock lock{mtx};
+    if (!done) {
+      continuations.emplace_back(std::move(task), prio);
+      return;
+    }
+  }
+  if (was_cancelled || was_failed) {
+    task->shared->finish(true);
+  } else {
+    owner->push(std::move(task), prio);
+  }
+}
+
+} // namespace detail
+
+//===-- Pool methods ------------------------------------------------------===//
+
+pool::pool(std::string_view name, unsigned num_threads)
+    : name{name},
+      num_threads{num_threads
+                      ? num_threads
+                      : std::clamp(std::thread::hardware_concurrency() / 4, 1U,
+                                   2U)} {
+  const std::scoped_lock lock{pools_mtx};
+  next = first_pool;
+  first_pool = this;
+}
+
+pool::~pool() {
+  stop();
+  const std::scoped_lock lock{pools_mtx};
+  for (auto cur{&first_pool}; *cur; cur = &(*cur)->next) {
+    if (*cur == this) {
+      *cur = next;
+      break;
+    }
+  }
+}
+
+void pool::start() {
+  local.reserve(num_threads);
+  for (unsigned i{}; i < num_threads; ++i) {
+    local.emplace_back(std::make_unique<queue_set>());
+  }
+  threads.reserve(num_threads);
+  for (std::size_t i{}; i < num_threads; ++i) {
+    threads.emplace_back(&pool::worker_proc, this, i);
+  }
+}
+
+void pool::worker_proc(std::size_t idx) {
+#ifdef _WIN32
+  SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#endif
+  current_pool = this;
+  current_worker = idx;
+  for (;;) {
+    // Jobs left in queues once stopping is requested are cancelled by stop()
+    if (stopping.load(std::memory_order::relaxed)) {
+      return;
+    }
+    if (auto task{take(idx)}; task) {
+      process(std::move(task));
+      continue;
+    }
+    std::unique_lock lock{sleep_mtx};
+    sleep_cv.wait(lock, [this] {
+      return stopping.load(std::memory_order::relaxed) ||
+             queued.load(std::memory_order::relaxed);
+    });
+  }
+}
+
+std::unique_ptr<detail::task_base> pool::take(std::size_t idx) {
+  auto &own{*local[idx]};
+  for (std::size_t prio{}; prio < num_priorities; ++prio) {
+    // Own queue first, newest jobs have their data hottest in cache
+    {
+      const std::scoped_lock lock{own.mtx};
+      if (auto &queue{own.queues[prio]}; !queue.empty()) {
+        auto task{std::move(queue.back())};
+        queue.pop_back();
+        queued.fetch_sub(1, std::memory_order::relaxed);
+        return task;
+      }
+    }
+    {
+      const std::scoped_lock lock{global.mtx};
+      if (auto &queue{global.queues[prio]}; !queue.empty()) {
+        auto task{std::move(queue.front())};
+        queue.pop_front();
+        queued.fetch_sub(1, std::memory_order::relaxed);
+        return task;
+      }
+    }
+    // Steal oldest jobs from other workers, starting from the next one
+    for (std::size_t i{1}; i < local.size(); ++i) {
+      auto &victim{*local[(idx + i) % local.size()]};
+      const std::scoped_lock lock{victim.mtx};
+      if (auto &queue{victim.queues[prio]}; !queue.empty()) {
+        auto task{std::move(queue.front())};
+        queue.pop_front();
+        queued.fetch_sub(1, std::memory_order::relaxed);
+        stolen.fetch_add(1, std::memory_order::relaxed);
+        return task;
+      }
+    }
+  }
+  return nullptr;
+}
+
+void pool::process(std::unique_ptr<detail::task_base> task) {
+  auto &shared{*task->shared};
+  if (shared.cancel_requested.load(std::memory_order::relaxed)) {
+    cancelled.fetch_add(1, std::memory_order::relaxed);
+    shared.finish(true);
+    return;
+  }
+  running.fetch_add(1, std::memory_order::relaxed);
+  current_job = &shared;
+  bool job_failed{};
+  try {
+    task->run();
+  } catch (const std::exception &e) {
+    job_failed = true;
+    log::error("Job in pool \"{}\" has thrown an exception: {}", name,
+               e.what());
+  } catch (...) {
+    job_failed = true;
+    log::error("Job in pool \"{}\" has thrown an unknown exception", name);
+  }
+  current_job = nullptr;
+  running.fetch_sub(1, std::memory_order::relaxed);
+  completed.fetch_add(1, std::memory_order::relaxed);
+  if (job_failed) {
+    failed.fetch_add(1, std::memory_order::relaxed);
+  }
+  shared.finish(false, job_failed);
+}
+
+void pool::push_at(std::unique_ptr<detail::task_base> task, priority prio,
+                   std::chrono::steady_clock::time_point time) {
+  if (stopping.load(std::memory_order::relaxed)) {
+    cancelled.fetch_add(1, std::memory_order::relaxed);
+    task->shared->finish(true);
+    return;
+  }
+  auto &t{timer()};
+  std::call_once(t.start_flag, [] { std::thread{timer_proc}.detach(); });
+  {
+    const std::scoped_lock lock{t.mtx};
+    t.tasks.emplace_back(time, this, std::move(task), prio);
+    std::ranges::push_heap(t.tasks, later);
+  }
+  t.cv.notify_one();
+}
+
+void pool::push(std::unique_ptr<detail::task_base> task, priority prio) {
+  if (stopping.load(std::memory_order::relaxed)) {
+    cancelled.fetch_add(1, std::memory_order::relaxed);
+    task->shared->finish(true);
+    return;
+  }
+  std::call_once(start_flag, &pool::start, this);
+  const auto prio_idx{static_cast<std::size_t>(prio)};
+  auto &set{current_pool == this ? *local[current_worker] : global};
+  {
+    const std::scoped_lock lock{set.mtx};
+    set.queues[prio_idx].emplace_back(std::move(task));
+  }
+  submitted.fetch_add(1, std::memory_order::relaxed);
+  const auto new_queued{queued.fetch_add(1, std::memory_order::relaxed) + 1};
+  for (auto max{max_queued.load(std::memory_order::relaxed)};
+       new_queued > max && !max_queued.compare_exchange_weak(
+                               max, new_queued, std::memory_order::relaxed);) {
+  }
+  {
+    // Locking ensures that the notification isn't lost between a worker's
+    //    predicate check and its wait
+    const std::scoped_lock lock{sleep_mtx};
+  }
+  sleep_cv.notify_one();
+}
+
+void pool::stop() {
+  {
+    const std::scoped_lock lock{sleep_mtx};
+    if (stopping.load(std::memory_order::relaxed)) {
+      return;
+    }
+    stopping.store(true, std::memory_order::relaxed);
+  }
+  sleep_cv.notify_all();
+  // Take delayed jobs of this pool from the timer
+  std::vector<std::unique_ptr<detail::task_base>> remaining;
+  {
+    auto &t{timer()};
+    const std::scoped_lock lock{t.mtx};
+    for (auto &entry : t.tasks) {
+      if (entry.owner == this) {
+        remaining.emplace_back(std::move(entry.task));
+      }
+    }
+    if (!remaining.empty()) {
+      std::erase_if(t.tasks, [](const auto &entry) { return !entry.task; });
+      std::ranges::make_heap(t.tasks, later);
+    }
+  }
+  for (auto &thread : threads) {
+    if (thread.joinable() && thread.get_id() != std::this_thread::get_id()) {
+      thread.join();
+    }
+  }
+  // Cancel everything left in queues
+  const auto drain{[&remaining](queue_set &set) {
+    const std::scoped_lock lock{set.mtx};
+    for (auto &queue : set.queues) {
+      std::ranges::move(queue, std::back_inserter(remaining));
+      queue.clear();
+    }
+  }};
+  drain(global);
+  for (auto &set : local) {
+    drain(*set);
+  }
+  queued.store(0, std::memory_order::relaxed);
+  cancelled.fetch_add(remaining.size(), std::memory_order::relaxed);
+  for (auto &task : remaining) {
+    task->shared->finish(true);
+  }
+}
+
+pool_stats pool::stats() const noexcept {
+  return {.queued = queued.load(std::memory_order::relaxed),
+          .running = running.load(std::memory_order::relaxed),
+          .max_queued = max_queued.load(std::memory_order::relaxed),
+          .submitted = submitted.load(std::memory_order::relaxed),
+          .completed = completed.load(std::memory_order::relaxed),
+          .cancelled = cancelled.load(std::memory_order::relaxed),
+          .failed = failed.load(std::memory_order::relaxed),
+          .stolen = stolen.load(std::memory_order::relaxed)};
+}
+
+//===-- Functions ---------------------------------------------------------===//
+
+pool &runtime_pool() {
+  static auto &instance{*new pool{"runtime"}};
+  return instance;
+}
+
+std::vector<std::pair<std::string_view, pool_stats>> all_stats() {
+  std::vector<std::pair<std::string_view, pool_stats>> result;
+  const std::scoped_lock lock{pools_mtx};
+  for (auto cur{first_pool}; cur; cur = cur->next) {
+    result.emplace_back(cur->name, cur->stats());
+  }
+  return result;
+}
+
+bool this_job_cancelled() noexcept {
+  return current_job &&
+         current_job->cancel_requested.load(std::memory_order::relaxed);
+}
+
+} // namespace tek::game_runtime::jobs
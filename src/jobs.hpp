@@ -0,0 +1,479 @@
+//===-- jobs.hpp - background job system interface ------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the work-stealing thread pool that runs all of runtime's
+///    background work. The interface is platform-independent, only thread
+///    priority adjustment in the implementation is Windows-specific.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::jobs {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Job priorities. Jobs with higher priority are always taken first.
+enum class priority { high, normal, low };
+
+/// Number of values in @ref priority.
+constexpr std::size_t num_priorities = 3;
+
+class pool;
+
+/// Snapshot of pool queue metrics.
+struct pool_stats {
+  /// Number of jobs currently waiting in queues.
+  std::size_t queued;
+  /// Number of jobs currently being executed.
+  std::size_t running;
+  /// Highest observed value of @ref queued.
+  std::size_t max_queued;
+  /// Total number of submitted jobs.
+  std::uint64_t submitted;
+  /// Total number of jobs that have been executed.
+  std::uint64_t completed;
+  /// Total number of jobs that have been cancelled before execution.
+  std::uint64_t cancelled;
+  /// Total number of executed jobs that have thrown an exception.
+  std::uint64_t failed;
+  /// Total number of jobs that have been taken from other workers' queues.
+  std::uint64_t stolen;
+};
+
+namespace detail {
+
+class task_base;
+
+/// Type-independent part of the state shared between a job and its futures.
+class [[gnu::visibility("internal")]] state_base {
+  /// Mutex for locking concurrent access to the state.
+  std::mutex mtx;
+  /// Condition variable for waiting for the job to finish.
+  std::condition_variable cv;
+  /// Value indicating whether the job has finished or has been cancelled.
+  bool done{};
+  /// Value indicating whether the job has been cancelled.
+  bool was_cancelled{};
+  /// Value indicating whether the job has thrown an exception.
+  bool was_failed{};
+  /// Continuations to schedule when the job finishes.
+  std::vector<std::pair<std::unique_ptr<task_base>, priority>> continuations;
+
+public:
+  /// Pool that runs the job and its continuations.
+  pool *owner{};
+  /// Value indicating whether cancellation has been requested.
+  std::atomic_bool cancel_requested{};
+
+  /// Mark the job as finished, wake up waiters, and schedule or cancel
+  ///    continuations. Continuations of cancelled and failed jobs are
+  ///    cancelled, since there is no result to pass to them.
+  ///
+  /// @param cancelled
+  ///    Value indicating whether the job has been cancelled instead of being
+  ///    executed.
+  /// @param failed
+  ///    Value indicating whether the job has thrown an exception.
+  void finish(bool cancelled, bool failed = false);
+  /// Block until the job finishes.
+  void wait();
+  /// Check whether the job has finished.
+  ///
+  /// @return Value indicating whether the job has finished or has been
+  ///    cancelled.
+  bool ready();
+  /// Check whether the job has been cancelled.
+  ///
+  /// @return Value indicating whether the job has been cancelled.
+  bool cancelled();
+  /// Check whether the job has thrown an exception.
+  ///
+  /// @return Value indicating whether the job has failed.
+  bool failed();
+  /// Add a continuation to be scheduled when the job finishes. If it already
+  ///    has, the continuation is scheduled immediately.
+  ///
+  /// @param task
+  ///    Task to schedule.
+  /// @param prio
+  ///    Priority of the task.
+  void add_continuation(std::unique_ptr<task_base> task, priority prio);
+};
+
+/// Job state holding the result value.
+template <typename T> class state : public state_base {
+public:
+  /// The job's result, if it has been executed.
+  std::optional<T> value;
+};
+
+/// Job state for jobs without a result.
+template <> class state<void> : public state_base {};
+
+/// Type-erased executable job.
+class task_base {
+public:
+  /// State shared with the job's futures.
+  std::shared_ptr<state_base> shared;
+
+  explicit task_base(std::shared_ptr<state_base> shared) noexcept
+      : shared{std::move(shared)} {}
+  virtual ~task_base() = default;
+
+  /// Execute the job and store its result into @ref shared.
+  virtual void run() = 0;
+};
+
+/// Task that executes a callable without arguments.
+template <typename F, typename R> class task final : public task_base {
+  F fn;
+
+public:
+  task(std::shared_ptr<state<R>> shared, F &&fn)
+      : task_base{std::move(shared)}, fn{std::move(fn)} {}
+
+  void run() override {
+    if constexpr (std::is_void_v<R>) {
+      fn();
+    } else {
+      static_cast<state<R> &>(*shared).value.emplace(fn());
+    }
+  }
+};
+
+/// Task that executes a callable with the result of another job.
+template <typename F, typename T, typename R>
+class continuation_task final : public task_base {
+  F fn;
+  /// State of the antecedent job.
+  std::shared_ptr<state<T>> antecedent;
+
+public:
+  continuation_task(std::shared_ptr<state<R>> shared, F &&fn,
+                    std::shared_ptr<state<T>> antecedent)
+      : task_base{std::move(shared)}, fn{std::move(fn)},
+        antecedent{std::move(antecedent)} {}
+
+  void run() override {
+    if constexpr (std::is_void_v<R>) {
+      if constexpr (std::is_void_v<T>) {
+        fn();
+      } else {
+        fn(*antecedent->value);
+      }
+    } else {
+      auto &value{static_cast<state<R> &>(*shared).value};
+      if constexpr (std::is_void_v<T>) {
+        value.emplace(fn());
+      } else {
+        value.emplace(fn(*antecedent->value));
+      }
+    }
+  }
+};
+
+/// Helper for deducing result type of continuation callables.
+template <typename F, typename T> struct continuation_result {
+  using type = std::invoke_result_t<F &, T &>;
+};
+template <typename F> struct continuation_result<F, void> {
+  using type = std::invoke_result_t<F &>;
+};
+template <typename F, typename T>
+using continuation_result_t = typename continuation_result<F, T>::type;
+
+} // namespace detail
+
+/// Handle for a job's result. Copies refer to the same job.
+///
+/// @tparam T
+///    Type of the job's result.
+template <typename T> class future {
+  /// State shared with the job.
+  std::shared_ptr<detail::state<T>> shared;
+
+public:
+  future() noexcept = default;
+  explicit future(std::shared_ptr<detail::state<T>> shared) noexcept
+      : shared{std::move(shared)} {}
+
+  /// Check whether the future refers to a job.
+  ///
+  /// @return Value indicating whether the future refers to a job.
+  bool valid() const noexcept { return static_cast<bool>(shared); }
+  /// Check whether the job has finished or has been cancelled.
+  ///
+  /// @return Value indicating whether the job has finished.
+  bool ready() const { return shared->ready(); }
+  /// Block until the job finishes or is cancelled. Must not be called from a
+  ///    job running in the same pool.
+  void wait() const { shared->wait(); }
+  /// Check whether the job has been cancelled before it could be executed.
+  ///    Blocks until the job finishes.
+  ///
+  /// @return Value indicating whether the job has been cancelled.
+  bool cancelled() const {
+    shared->wait();
+    return shared->cancelled();
+  }
+  /// Check whether the job has thrown an exception instead of producing a
+  ///    result. Blocks until the job finishes.
+  ///
+  /// @return Value indicating whether the job has failed.
+  bool failed() const {
+    shared->wait();
+    return shared->failed();
+  }
+  /// Request cancellation of the job. If it hasn't started yet, it won't be
+  ///    executed; running jobs may check @ref this_job_cancelled.
+  void cancel() const noexcept {
+    shared->cancel_requested.store(true, std::memory_order::relaxed);
+  }
+  /// Block until the job finishes and get its result. The job must not have
+  ///    been cancelled and must not have failed.
+  ///
+  /// @return Reference to the job's result.
+  template <typename U = T>
+    requires(!std::is_void_v<U>)
+  U &get() const {
+    shared->wait();
+    return *shared->value;
+  }
+
+  /// Schedule a job to run in the same pool after this one finishes. If this
+  ///    job gets cancelled, the continuation is cancelled as well.
+  ///
+  /// @param fn
+  ///    Callable to execute. It receives a reference to this job's result,
+  ///    or no arguments if @p T is `void`. If this job fails, the
+  ///    continuation is cancelled.
+  /// @param prio
+  ///    Priority of the continuation.
+  /// @return Future for the continuation.
+  template <typename F>
+  auto then(F &&fn, priority prio = priority::normal) const
+      -> future<detail::continuation_result_t<std::decay_t<F>, T>> {
+    using R = detail::continuation_result_t<std::decay_t<F>, T>;
+    auto next{std::make_shared<detail::state<R>>()};
+    next->owner = shared->owner;
+    shared->add_continuation(
+        std::make_unique<detail::continuation_task<std::decay_t<F>, T, R>>(
+            next, std::decay_t<F>{std::forward<F>(fn)}, shared),
+        prio);
+    return future<R>{std::move(next)};
+  }
+};
+
+/// Work-stealing thread pool. Each worker has its own queue that it takes
+///    newest jobs from, jobs submitted from outside the pool go to a shared
+///    queue, and idle workers take oldest jobs from other workers' queues.
+///    Threads are created on first submission. Pools register themselves in
+///    the global list for @ref all_stats. Delayed jobs wait on a single
+///    process-wide timer thread rather than on the pool's workers.
+class [[gnu::visibility("internal")]] pool {
+  /// Set of per-priority job queues.
+  struct queue_set {
+    /// Mutex for locking concurrent access to @ref queues.
+    std::mutex mtx;
+    /// Job queues, indexed by priority.
+    std::array<std::deque<std::unique_ptr<detail::task_base>>, num_priorities>
+        queues;
+  };
+
+  /// Name of the pool in metrics output.
+  const std::string_view name;
+  /// Number of worker threads to create.
+  const unsigned num_threads;
+  /// Pointer to the next pool in the global list.
+  pool *next;
+  /// Queues owned by workers.
+  std::vector<std::unique_ptr<queue_set>> local;
+  /// Queue for jobs submitted from outside the pool.
+  queue_set global;
+  /// Worker threads.
+  std::vector<std::thread> threads;
+  /// Flag for creating threads only once.
+  std::once_flag start_flag;
+  /// Mutex for sleeping workers.
+  std::mutex sleep_mtx;
+  /// Condition variable for waking up sleeping workers.
+  std::condition_variable sleep_cv;
+  /// Value indicating whether the pool is being stopped. It's only set with
+  ///    @ref sleep_mtx locked, so sleeping workers don't miss it.
+  std::atomic_bool stopping{};
+  /// Number of jobs currently in queues.
+  std::atomic_size_t queued{};
+  /// Number of jobs currently being executed.
+  std::atomic_size_t running{};
+  /// Highest observed value of @ref queued.
+  std::atomic_size_t max_queued{};
+  /// Total number of submitted jobs.
+  std::atomic_uint64_t submitted{};
+  /// Total number of executed jobs.
+  std::atomic_uint64_t completed{};
+  /// Total number of cancelled jobs.
+  std::atomic_uint64_t cancelled{};
+  /// Total number of failed jobs.
+  std::atomic_uint64_t failed{};
+  /// Total number of stolen jobs.
+  std::atomic_uint64_t stolen{};
+
+  friend std::vector<std::pair<std::string_view, pool_stats>> all_stats();
+
+  /// Create worker threads.
+  void start();
+  /// Worker thread procedure.
+  ///
+  /// @param idx
+  ///    Index of the worker.
+  void worker_proc(std::size_t idx);
+  /// Take the next job to execute.
+  ///
+  /// @param idx
+  ///    Index of the worker that takes the job.
+  /// @return Pointer to the job, or `nullptr` if all queues are empty.
+  std::unique_ptr<detail::task_base> take(std::size_t idx);
+  /// Execute or cancel a job taken from a queue. Exceptions thrown by the
+  ///    job are caught, so they don't terminate the host process.
+  ///
+  /// @param task
+  ///    The job to process.
+  void process(std::unique_ptr<detail::task_base> task);
+  /// Hand a job to the timer thread, which pushes it into a queue at
+  ///    specified time.
+  ///
+  /// @param task
+  ///    The job to enqueue.
+  /// @param prio
+  ///    Priority of the job.
+  /// @param time
+  ///    Time point at which the job is enqueued.
+  void push_at(std::unique_ptr<detail::task_base> task, priority prio,
+               std::chrono::steady_clock::time_point time);
+
+public:
+  /// Create a pool.
+  ///
+  /// @param name
+  ///    Name of the pool in metrics output.
+  /// @param num_threads
+  ///    Number of worker threads. `0` means the default, which is a quarter of
+  ///    available hardware threads, clamped to [1, 2].
+  explicit pool(std::string_view name, unsigned num_threads = 0);
+  pool(const pool &) = delete;
+  pool &operator=(const pool &) = delete;
+  /// Stop the pool, see @ref stop, and remove it from the global list.
+  ~pool();
+
+  /// Put a job into a queue. Jobs submitted from the pool's own workers go
+  ///    into the worker's local queue.
+  ///
+  /// @param task
+  ///    The job to enqueue.
+  /// @param prio
+  ///    Priority of the job.
+  void push(std::unique_ptr<detail::task_base> task, priority prio);
+
+  /// Submit a job.
+  ///
+  /// @param fn
+  ///    Callable to execute. If it throws, the exception is logged and the
+  ///    job is marked as failed.
+  /// @param prio
+  ///    Priority of the job.
+  /// @return Future for the job's result.
+  template <typename F>
+  auto submit(F &&fn, priority prio = priority::normal)
+      -> future<std::invoke_result_t<std::decay_t<F> &>> {
+    using R = std::invoke_result_t<std::decay_t<F> &>;
+    auto shared{std::make_shared<detail::state<R>>()};
+    shared->owner = this;
+    push(std::make_unique<detail::task<std::decay_t<F>, R>>(
+             shared, std::decay_t<F>{std::forward<F>(fn)}),
+         prio);
+    return future<R>{std::move(shared)};
+  }
+
+  /// Submit a job that is enqueued after specified delay. No worker is
+  ///    occupied while the delay runs.
+  ///
+  /// @param delay
+  ///    Time to wait before enqueuing the job.
+  /// @param fn
+  ///    Callable to execute. If it throws, the exception is logged and the
+  ///    job is marked as failed.
+  /// @param prio
+  ///    Priority of the job.
+  /// @return Future for the job's result.
+  template <typename F>
+  auto submit_after(std::chrono::steady_clock::duration delay, F &&fn,
+                    priority prio = priority::normal)
+      -> future<std::invoke_result_t<std::decay_t<F> &>> {
+    using R = std::invoke_result_t<std::decay_t<F> &>;
+    auto shared{std::make_shared<detail::state<R>>()};
+    shared->owner = this;
+    push_at(std::make_unique<detail::task<std::decay_t<F>, R>>(
+                shared, std::decay_t<F>{std::forward<F>(fn)}),
+            prio, std::chrono::steady_clock::now() + delay);
+    return future<R>{std::move(shared)};
+  }
+
+  /// Stop and join all worker threads. Jobs that are still queued or waiting
+  ///    for their delay are cancelled, running jobs are allowed to finish.
+  void stop();
+
+  /// Get current queue metrics.
+  ///
+  /// @return Snapshot of pool metrics.
+  pool_stats stats() const noexcept;
+};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Get the pool for runtime's general background work. It's created on first
+///    use and never destroyed, because its worker threads may already be
+///    terminated with locks held by the time static destructors run on
+///    process exit.
+///
+/// @return Reference to the runtime pool.
+[[gnu::visibility("internal")]]
+pool &runtime_pool();
+
+/// Get queue metrics of all existing pools.
+///
+/// @return Pool names paired with their metrics.
+[[gnu::visibility("internal")]]
+std::vector<std::pair<std::string_view, pool_stats>> all_stats();
+
+/// Check whether cancellation has been requested for the job running on
+///    current thread.
+///
+/// @return Value indicating whether the current job should stop early.
+[[gnu::visibility("internal")]]
+bool this_job_cancelled() noexcept;
+
+} // namespace tek::game_runtime::jobs
@@ -0,0 +1,287 @@
+//===-- log.cpp - runtime logging implementation --------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of per-thread record buffers and the background log writer.
+///
+//===----------------------------------------------------------------------===//
+#include "log.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "jobs.hpp"
+#include "metrics.hpp"
+#include "settings.hpp"
+#include "utf.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif // ndef _WIN32
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::log {
+
+namespace {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Number of records in a per-thread buffer.
+constexpr std::uint32_t buffer_capacity{128};
+
+/// Single-producer single-consumer ring buffer of records written by a
+///    thread. Buffers are never freed; when a thread exits, its buffer may be
+///    claimed by a new thread.
+struct thread_buffer {
+  /// Record slots.
+  std::array<detail::record, buffer_capacity> records;
+  /// Number of records written to the buffer, only modified by the owning
+  ///    thread.
+  alignas(64) std::atomic_uint32_t head;
+  /// Number of records taken from the buffer, only modified by the writer.
+  alignas(64) std::atomic_uint32_t tail;
+  /// Value indicating whether the buffer is owned by a thread.
+  std::atomic_bool in_use;
+  /// Pointer to the next buffer in the global list.
+  thread_buffer *_Nullable next;
+};
+
+/// Per-thread handle that claims a buffer on first use and releases it when
+///    the thread exits.
+class buffer_owner {
+  /// The claimed buffer.
+  thread_buffer *_Nonnull buf;
+
+public:
+  buffer_owner() noexcept;
+  ~buffer_owner() { buf->in_use.store(false, std::memory_order::release); }
+  buffer_owner(const buffer_owner &) = delete;
+  buffer_owner &operator=(const buffer_owner &) = delete;
+
+  /// Get the claimed buffer.
+  constexpr thread_buffer &get() const noexcept { return *buf; }
+};
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Names of levels in output, indexed by @ref level values.
+constexpr std::array<std::string_view, 4> level_names{"debug", "info",
+                                                      "warning", "error"};
+/// Pointer to the first buffer in the global list.
+static constinit std::atomic<thread_buffer *> first_buffer;
+#ifdef _WIN32
+/// Handle for the log file.
+static HANDLE file{INVALID_HANDLE_VALUE};
+#else  // def _WIN32
+/// File descriptor for the log file.
+static int file{-1};
+#endif // def _WIN32 else
+/// Value indicating whether a write job has been scheduled and hasn't started
+///    taking records yet.
+static constinit std::atomic_bool write_scheduled;
+/// Mutex serializing writes to @ref file.
+static constinit std::mutex write_mtx;
+/// Number of records dropped because the writing thread's buffer was full.
+static metrics::counter dropped{"log.dropped"};
+/// Number of records written to the log file.
+static metrics::counter written{"log.written"};
+
+//===-- Private functions -------------------------------------------------===//
+
+buffer_owner::buffer_owner() noexcept {
+  // Reuse a buffer released by an exited thread if there is one
+  for (auto cur{first_buffer.load(std::memory_order::acquire)}; cur;
+       cur = cur->next) {
+    if (!cur->in_use.load(std::memory_order::relaxed) &&
+        !cur->in_use.exchange(true, std::memory_order::acquire)) {
+      buf = cur;
+      return;
+    }
+  }
+  buf = new thread_buffer{};
+  buf->in_use.store(true, std::memory_order::relaxed);
+  buf->next = first_buffer.load(std::memory_order::relaxed);
+  while (!first_buffer.compare_exchange_weak(buf->next, buf,
+                                             std::memory_order::release,
+                                             std::memory_order::relaxed)) {
+  }
+}
+
+/// Get the pool running log write jobs. It's leaked, so messages logged by
+///    static destructors still have a pool to go to.
+///
+/// @return Reference to the log pool.
+static jobs::pool &log_pool() {
+  static auto &instance{*new jobs::pool{"log", 1}};
+  return instance;
+}
+
+/// Get calling thread's buffer.
+///
+/// @return Reference to the buffer.
+static thread_buffer &local_buffer() {
+  static thread_local buffer_owner owner;
+  return owner.get();
+}
+
+/// Take all published records from all buffers, format them and write them
+///    to the log file in chronological order. Must be called with
+///    @ref write_mtx locked.
+static void write_records() {
+  std::vector<std::pair<std::chrono::system_clock::time_point, std::string>>
+      lines;
+  std::string msg;
+  for (auto buf{first_buffer.load(std::memory_order::acquire)}; buf;
+       buf = buf->next) {
+    const auto head{buf->head.load(std::memory_order::acquire)};
+    auto tail{buf->tail.load(std::memory_order::relaxed)};
+    for (; tail != head; ++tail) {
+      const auto &rec{buf->records[tail % buffer_capacity]};
+      msg.clear();
+      rec.format(msg, rec.fmt, rec.payload.data());
+      rapidjson::StringBuffer line;
+      rapidjson::Writer writer{line};
+      writer.StartObject();
+      std::string_view str{"time"};
+      writer.Key(str.data(), str.length());
+      const auto time{std::format(
+          "{:%FT%TZ}",
+          std::chrono::floor<std::chrono::milliseconds>(rec.time))};
+      writer.String(time.data(), time.length());
+      str = "level";
+      writer.Key(str.data(), str.length());
+      str = level_names[static_cast<std::size_t>(rec.lvl)];
+      writer.String(str.data(), str.length());
+      str = "thread";
+      writer.Key(str.data(), str.length());
+      writer.Uint(rec.thread_id);
+      str = "msg";
+      writer.Key(str.data(), str.length());
+      writer.String(msg.data(), msg.length());
+      writer.EndObject();
+      lines.emplace_back(rec.time,
+                         std::string{line.GetString(), line.GetSize()});
+      lines.back().second.push_back('\n');
+    }
+    buf->tail.store(tail, std::memory_order::release);
+  }
+  if (lines.empty()) {
+    return;
+  }
+  std::ranges::stable_sort(lines, {}, &decltype(lines)::value_type::first);
+  std::string out;
+  for (const auto &[time, line] : lines) {
+    out.append(line);
+  }
+#ifdef _WIN32
+  DWORD bytes_written;
+  WriteFile(file, out.data(), out.size(), &bytes_written, nullptr);
+#else  // def _WIN32
+  [[maybe_unused]] const auto res{::write(file, out.data(), out.size())};
+#endif // def _WIN32 else
+  written.add(lines.size());
+}
+
+} // namespace
+
+//===-- Internal functions ------------------------------------------------===//
+
+namespace detail {
+
+record *acquire() noexcept {
+  auto &buf{local_buffer()};
+  const auto head{buf.head.load(std::memory_order::relaxed)};
+  if (head - buf.tail.load(std::memory_order::acquire) >= buffer_capacity) {
+    dropped.add();
+    return nullptr;
+  }
+  return &buf.records[head % buffer_capacity];
+}
+
+void commit() noexcept {
+  auto &buf{local_buffer()};
+  buf.head.store(buf.head.load(std::memory_order::relaxed) + 1,
+                 std::memory_order::release);
+  // Check before exchanging to avoid contention on the flag while a write job
+  //    is already pending
+  if (!write_scheduled.load(std::memory_order::relaxed) &&
+      !write_scheduled.exchange(true, std::memory_order::acq_rel)) {
+    log_pool().submit(
+        [] {
+          write_scheduled.store(false, std::memory_order::release);
+          const std::scoped_lock lock{write_mtx};
+          write_records();
+        },
+        jobs::priority::low);
+  }
+}
+
+} // namespace detail
+
+void open() {
+  const auto &path{g_settings.log_path};
+  if (path.empty()) {
+    return;
+  }
+#ifdef _WIN32
+  file = CreateFileW(utf::to_wide(path).data(), FILE_APPEND_DATA,
+                     FILE_SHARE_READ, nullptr, OPEN_ALWAYS,
+                     FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+#else  // def _WIN32
+  file = ::open(path.data(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+  if (file < 0) {
+    return;
+  }
+#endif // def _WIN32 else
+  auto lvl{level::warning};
+  if (const auto it{std::ranges::find(level_names, g_settings.log_level)};
+      it != level_names.end()) {
+    lvl = static_cast<level>(std::distance(level_names.begin(), it));
+  } else if (g_settings.log_level == "off") {
+    lvl = level::off;
+  }
+  detail::min_level.store(lvl, std::memory_order::relaxed);
+}
+
+void flush() noexcept {
+#ifdef _WIN32
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+#else  // def _WIN32
+  if (file < 0) {
+    return;
+  }
+#endif // def _WIN32 else
+  // The write job's thread may have been terminated while holding the mutex
+  if (write_mtx.try_lock()) {
+    write_records();
+    write_mtx.unlock();
+  }
+}
+
+} // namespace tek::game_runtime::log
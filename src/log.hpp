@@ -0,0 +1,229 @@
+//===-- log.hpp - runtime logging interface -------------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the runtime log. Records are put into per-thread
+///    lock-free buffers with their arguments captured by value, and are
+///    formatted and written to the file specified by `log_path` settings
+///    option by a background job, so logging never blocks the calling thread.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace tek::game_runtime::log {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Log record severity levels.
+enum class level : std::uint8_t { debug, info, warning, error, off };
+
+namespace detail {
+
+/// String argument captured by value, truncated to fit into a record.
+struct short_string {
+  /// Length of the string.
+  std::uint8_t size;
+  /// String characters.
+  std::array<char, 47> data;
+
+  short_string(std::string_view str) noexcept
+      : size{static_cast<std::uint8_t>(std::min(str.size(), data.size()))} {
+    std::ranges::copy_n(str.begin(), size, data.begin());
+  }
+  /// Get the string as a view.
+  constexpr std::string_view view() const noexcept {
+    return {data.data(), size};
+  }
+};
+
+/// Type that an argument of type @p T is captured as.
+template <typename T>
+using stored_arg_t =
+    std::conditional_t<std::is_convertible_v<const T &, std::string_view>,
+                       short_string, T>;
+
+/// Size of the buffer for captured arguments in a record.
+constexpr std::size_t payload_size{208};
+
+/// Log record stored in a per-thread buffer.
+struct alignas(64) record {
+  /// Time the record was written at.
+  std::chrono::system_clock::time_point time;
+  /// Format string of the message. Must have static storage duration.
+  std::string_view fmt;
+  /// Function formatting the message from @ref fmt and @ref payload.
+  void (*_Nonnull format)(std::string &out, std::string_view fmt,
+                          const std::byte *_Nonnull payload);
+  /// ID of the thread that has written the record.
+  std::uint32_t thread_id;
+  /// Severity level of the record.
+  level lvl;
+  /// Captured arguments.
+  alignas(8) std::array<std::byte, payload_size> payload;
+};
+
+/// Minimum level of records that are written. Set by @ref open.
+inline std::atomic<level> min_level{level::off};
+
+/// Get ID of the calling thread.
+///
+/// @return ID of the calling thread.
+inline std::uint32_t thread_id() noexcept {
+#ifdef _WIN32
+  return GetCurrentThreadId();
+#else  // def _WIN32
+  return static_cast<std::uint32_t>(gettid());
+#endif // def _WIN32 else
+}
+
+/// Get the next free record slot in calling thread's buffer.
+///
+/// @return Pointer to the record slot, or `nullptr` if the buffer is full, in
+///    which case the record is dropped.
+[[gnu::visibility("internal")]]
+record *_Nullable acquire() noexcept;
+
+/// Publish the record obtained from @ref acquire, and schedule writing it.
+[[gnu::visibility("internal")]]
+void commit() noexcept;
+
+/// Format a record's message from its captured arguments.
+///
+/// @tparam Args
+///    Types of captured arguments.
+/// @param [out] out
+///    String to append the message to.
+/// @param fmt
+///    Format string of the message.
+/// @param [in] payload
+///    Pointer to the captured arguments.
+template <typename... Args>
+void format_record(std::string &out, std::string_view fmt,
+                   const std::byte *_Nonnull payload) {
+  std::apply(
+      [&out, fmt](const auto &...args) {
+        std::vformat_to(std::back_inserter(out), fmt,
+                        std::make_format_args(args...));
+      },
+      *std::launder(reinterpret_cast<const std::tuple<Args...> *>(payload)));
+}
+
+} // namespace detail
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Open the log file specified by `log_path` settings option and set the
+///    minimum level from `log_level`. Does nothing if `log_path` is not set.
+[[gnu::visibility("internal")]]
+void open();
+
+/// Write all pending records to the log file on calling thread. Used at
+///    process exit, when background jobs can no longer run.
+[[gnu::visibility("internal")]]
+void flush() noexcept;
+
+/// Check whether records of specified level are written.
+///
+/// @param lvl
+///    The level to check.
+/// @return Value indicating whether records of @p lvl are written.
+inline bool enabled(level lvl) noexcept {
+  return lvl >= detail::min_level.load(std::memory_order::relaxed);
+}
+
+/// Write a record to the log. Arguments are captured by value, string
+///    arguments are truncated to 47 bytes; formatting is performed later by
+///    the background writer.
+///
+/// @param lvl
+///    Severity level of the record.
+/// @param fmt
+///    Format string of the message.
+/// @param args
+///    Format arguments.
+template <typename... Args>
+void write(level lvl, std::format_string<Args...> fmt, const Args &...args) {
+  if (!enabled(lvl)) {
+    return;
+  }
+  using payload_t = std::tuple<detail::stored_arg_t<std::decay_t<Args>>...>;
+  static_assert(sizeof(payload_t) <= detail::payload_size,
+                "Log record arguments don't fit into the record");
+  static_assert(std::is_trivially_destructible_v<payload_t>,
+                "Log record arguments must be trivially destructible");
+  const auto rec{detail::acquire()};
+  if (!rec) {
+    return;
+  }
+  rec->time = std::chrono::system_clock::now();
+  rec->fmt = fmt.get();
+  rec->format =
+      detail::format_record<detail::stored_arg_t<std::decay_t<Args>>...>;
+  rec->thread_id = detail::thread_id();
+  rec->lvl = lvl;
+  std::construct_at(reinterpret_cast<payload_t *>(rec->payload.data()),
+                    args...);
+  detail::commit();
+}
+
+/// Write a debug record, see @ref write.
+template <typename... Args>
+void debug(std::format_string<Args...> fmt, const Args &...args) {
+  write(level::debug, fmt, args...);
+}
+/// Write an info record, see @ref write.
+template <typename... Args>
+void info(std::format_string<Args...> fmt, const Args &...args) {
+  write(level::info, fmt, args...);
+}
+/// Write a warning record, see @ref write.
+template <typename... Args>
+void warning(std::format_string<Args...> fmt, const Args &...args) {
+  write(level::warning, fmt, args...);
+}
+/// Write an error record, see @ref write.
+template <typename... Args>
+void error(std::format_string<Args...> fmt, const Args &...args) {
+  write(level::error, fmt, args...);
+}
+
+} // namespace tek::game_runtime::log
+
+/// Formatter for captured string arguments, which supports the same format
+///    specification as for `std::string_view`.
+template <>
+struct std::formatter<tek::game_runtime::log::detail::short_string>
+    : std::formatter<std::string_view> {
+  auto format(const tek::game_runtime::log::detail::short_string &str,
+              std::format_context &ctx) const {
+    return std::formatter<std::string_view>::format(str.view(), ctx);
+  }
+};
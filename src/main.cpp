@@ -14,14 +14,18 @@
 //===----------------------------------------------------------------------===//
 #include "common.hpp" // IWYU pragma: keep
 
+#include "a2s.hpp"
 #include "game_cbs.hpp"
+#include "log.hpp"
+#include "metrics.hpp"
+#include "remote_storage_cache.hpp"
 #include "settings.hpp"
 #include "steam_api.hpp"
 #include "tek-steamclient.hpp"
 
 namespace tek::game_runtime {
 
-extern "C" BOOL WINAPI DllMain(HINSTANCE, DWORD reason, LPVOID) {
+extern "C" BOOL WINAPI DllMain(HINSTANCE, DWORD reason, LPVOID reserved) {
   switch (reason) {
   case DLL_PROCESS_ATTACH: {
     if (!g_settings.load()) {
@@ -41,7 +45,18 @@ extern "C" BOOL WINAPI DllMain(HINSTANCE, DWORD reason, LPVOID) {
     return TRUE;
   }
   case DLL_PROCESS_DETACH:
+    // Games that don't call SteamAPI_Shutdown would otherwise lose their last
+    //    saves when the runtime is unloaded. At process exit Steam can't be
+    //    called anymore, so they're only reported
+    remote_storage_cache::flush_at_exit(reserved != nullptr);
+    // At process exit other threads have already been terminated, possibly
+    //    while holding the A2S engine lock, so it must not be touched then
+    if (!reserved) {
+      a2s::stop();
+    }
     steamclient::unload();
+    metrics::dump();
+    log::flush();
     return TRUE;
   default:
     return TRUE;
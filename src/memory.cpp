@@ -0,0 +1,149 @@
+//===-- memory.cpp - runtime memory resources implementation --------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of accounted memory resources.
+///
+//===----------------------------------------------------------------------===//
+#include "memory.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace tek::game_runtime::memory {
+
+namespace {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Memory usage counters of a subsystem.
+struct counters {
+  /// Number of bytes currently allocated.
+  std::atomic_uint64_t bytes;
+  /// Highest observed value of @ref bytes.
+  std::atomic_uint64_t peak_bytes;
+  /// Total number of allocations made.
+  std::atomic_uint64_t allocations;
+};
+
+/// Memory resource that forwards requests to upstream resource and records
+///    them into subsystem counters.
+class accounted_resource final : public std::pmr::memory_resource {
+  /// Resource that allocations are forwarded to.
+  std::pmr::memory_resource &upstream;
+  /// Counters to record allocations into.
+  counters &cnt;
+
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+    const auto ptr{upstream.allocate(bytes, alignment)};
+    cnt.allocations.fetch_add(1, std::memory_order::relaxed);
+    const auto cur{cnt.bytes.fetch_add(bytes, std::memory_order::relaxed) +
+                   bytes};
+    for (auto peak{cnt.peak_bytes.load(std::memory_order::relaxed)};
+         cur > peak && !cnt.peak_bytes.compare_exchange_weak(
+                           peak, cur, std::memory_order::relaxed);) {
+    }
+    return ptr;
+  }
+  void do_deallocate(void *ptr, std::size_t bytes,
+                     std::size_t alignment) override {
+    upstream.deallocate(ptr, bytes, alignment);
+    cnt.bytes.fetch_sub(bytes, std::memory_order::relaxed);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  accounted_resource(std::pmr::memory_resource &upstream,
+                     counters &cnt) noexcept
+      : upstream{upstream}, cnt{cnt} {}
+};
+
+/// Resources of a steady-state subsystem.
+struct pool {
+  /// Pool that serves the allocations.
+  std::pmr::synchronized_pool_resource pool_res;
+  /// Accounting layer on top of @ref pool_res.
+  accounted_resource accounted;
+
+  explicit pool(counters &cnt) : accounted{pool_res, cnt} {}
+};
+
+/// Resources of the startup arena.
+struct arena {
+  /// Accounting layer for arena's chunks.
+  accounted_resource accounted;
+  /// The arena itself.
+  std::pmr::monotonic_buffer_resource arena_res;
+
+  explicit arena(counters &cnt)
+      : accounted{*std::pmr::new_delete_resource(), cnt},
+        arena_res{16 * 1024, &accounted} {}
+};
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Usage counters, indexed by @ref subsystem values.
+constinit std::array<counters, num_subsystems> all_counters{};
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Get resources for all steady-state subsystems. They are created on first
+///    use and never destroyed.
+///
+/// @return Reference to the array of pools, indexed by @ref subsystem values.
+///    The element for `subsystem::startup` is `nullptr`.
+static const std::array<pool *, num_subsystems> &pools() {
+  static const auto instance{[] {
+    std::array<pool *, num_subsystems> result{};
+    for (std::size_t i{1}; i < num_subsystems; ++i) {
+      result[i] = new pool{all_counters[i]};
+    }
+    return result;
+  }()};
+  return instance;
+}
+
+/// Get the startup arena, creating it on first use.
+///
+/// @return Reference to the arena.
+static arena &get_arena() {
+  static auto &instance{*new arena{
+      all_counters[static_cast<std::size_t>(subsystem::startup)]}};
+  return instance;
+}
+
+} // namespace
+
+//===-- Internal functions ------------------------------------------------===//
+
+std::pmr::memory_resource &resource(subsystem sub) {
+  if (sub == subsystem::startup) {
+    return startup_arena();
+  }
+  return pools()[static_cast<std::size_t>(sub)]->accounted;
+}
+
+std::pmr::memory_resource &startup_arena() { return get_arena().arena_res; }
+
+void release_startup_arena() { get_arena().arena_res.release(); }
+
+usage get_usage(subsystem sub) noexcept {
+  const auto &cnt{all_counters[static_cast<std::size_t>(sub)]};
+  return {.bytes = cnt.bytes.load(std::memory_order::relaxed),
+          .peak_bytes = cnt.peak_bytes.load(std::memory_order::relaxed),
+          .allocations = cnt.allocations.load(std::memory_order::relaxed)};
+}
+
+} // namespace tek::game_runtime::memory
@@ -0,0 +1,118 @@
+//===-- memory.hpp - runtime memory resources interface -------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for memory resources that runtime-owned allocations are made
+///    from, so that the memory runtime adds to the game process is bounded
+///    and accounted per subsystem.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <string_view>
+
+namespace tek::game_runtime::memory {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Runtime subsystems that own memory.
+enum class subsystem {
+  /// Allocations made during initialization, served by the startup arena.
+  startup,
+  /// ISteamMatchmaking lobby data cache.
+  lobby_cache,
+  /// Server browser wrappers: rules query handlers and filter arrays.
+  server_browser,
+  /// EOS SDK wrappers: login contexts and external account info copies.
+  eos,
+  /// ISteamRemoteStorage write-back cache.
+  remote_storage,
+  /// ISteamUserStats stats and achievements cache.
+  user_stats,
+  /// ISteamHTTP response cache.
+  http_cache
+};
+
+/// Number of values in @ref subsystem.
+constexpr std::size_t num_subsystems = 7;
+
+/// Names of subsystems in metrics output, indexed by @ref subsystem values.
+constexpr std::array<std::string_view, num_subsystems> subsystem_names{
+    "startup",        "lobby_cache", "server_browser", "eos",
+    "remote_storage", "user_stats",  "http_cache"};
+
+/// Snapshot of memory usage of a subsystem.
+struct usage {
+  /// Number of bytes currently allocated.
+  std::uint64_t bytes;
+  /// Highest observed value of @ref bytes.
+  std::uint64_t peak_bytes;
+  /// Total number of allocations made.
+  std::uint64_t allocations;
+};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Get the memory resource for steady-state allocations of specified
+///    subsystem. It's a thread-safe pool resource, resources are never
+///    destroyed so objects may outlive static destructors.
+///
+/// @param sub
+///    The subsystem to get resource for.
+/// @return Reference to the resource.
+[[gnu::visibility("internal")]]
+std::pmr::memory_resource &resource(subsystem sub);
+
+/// Get the startup arena. It's a monotonic resource, deallocation is a no-op
+///    and memory is reclaimed all at once by @ref release_startup_arena. It's
+///    not thread-safe and must only be used from the thread that initializes
+///    the runtime.
+///
+/// @return Reference to the startup arena.
+[[gnu::visibility("internal")]]
+std::pmr::memory_resource &startup_arena();
+
+/// Free all memory allocated from the startup arena. Objects allocated from it
+///    must not be used afterwards.
+[[gnu::visibility("internal")]]
+void release_startup_arena();
+
+/// Get current memory usage of specified subsystem.
+///
+/// @param sub
+///    The subsystem to get usage of.
+/// @return Usage snapshot.
+[[gnu::visibility("internal")]]
+usage get_usage(subsystem sub) noexcept;
+
+//===-- Class templates ---------------------------------------------------===//
+
+/// Base class that makes objects of derived classes be allocated from
+///    specified subsystem's resource. Classes deleted via base pointers must
+///    have a virtual destructor.
+///
+/// @tparam sub
+///    Subsystem that owns the objects.
+template <subsystem sub> class pooled {
+public:
+  static void *operator new(std::size_t size) {
+    return resource(sub).allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  }
+  static void operator delete(void *ptr, std::size_t size) noexcept {
+    resource(sub).deallocate(ptr, size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+  }
+};
+
+} // namespace tek::game_runtime::memory
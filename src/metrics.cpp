@@ -0,0 +1,179 @@
+//===-- metrics.cpp - runtime metrics implementation ----------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of runtime metrics registration and output.
+///
+//===----------------------------------------------------------------------===//
+#include "metrics.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "jobs.hpp"
+#include "memory.hpp"
+#include "settings.hpp"
+#include "utf.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <rapidjson/filewritestream.h>
+#include <rapidjson/prettywriter.h>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::metrics {
+
+namespace {
+
+/// Pointer to the first counter in the global list.
+constinit counter *_Nullable first_counter;
+/// Pointer to the first distribution in the global list.
+constinit distribution *_Nullable first_distribution;
+
+} // namespace
+
+counter::counter(const char *name) noexcept
+    : name{name}, value{}, next{first_counter} {
+  first_counter = this;
+}
+
+distribution::distribution(const char *name) noexcept
+    : name{name}, count{}, next{first_distribution} {
+  first_distribution = this;
+}
+
+void distribution::add(std::uint64_t value) {
+  const std::scoped_lock lock{mtx};
+  if (samples.size() < max_samples) {
+    samples.emplace_back(value);
+  } else {
+    samples[count % max_samples] = value;
+  }
+  ++count;
+}
+
+void dump() {
+  const auto &path{g_settings.metrics_path};
+  if (path.empty()) {
+    return;
+  }
+  const std::unique_ptr<std::FILE, decltype(&std::fclose)> file{
+      _wfopen(utf::to_wide(path).data(), L"wbNS"), std::fclose};
+  if (!file) {
+    return;
+  }
+  std::array<char, 2048> write_buf;
+  rapidjson::FileWriteStream stream{file.get(), write_buf.data(),
+                                    write_buf.size()};
+  rapidjson::PrettyWriter writer{stream};
+  writer.SetIndent(' ', 2);
+  writer.StartObject();
+  std::string_view str{"counters"};
+  writer.Key(str.data(), str.length());
+  writer.StartObject();
+  for (auto cur{first_counter}; cur; cur = cur->next) {
+    writer.Key(cur->name);
+    writer.Uint64(cur->get());
+  }
+  writer.EndObject();
+  str = "distributions";
+  writer.Key(str.data(), str.length());
+  writer.StartObject();
+  for (auto cur{first_distribution}; cur; cur = cur->next) {
+    std::vector<std::uint64_t> samples;
+    std::uint64_t count;
+    {
+      const std::scoped_lock lock{cur->mtx};
+      samples = cur->samples;
+      count = cur->count;
+    }
+    std::ranges::sort(samples);
+    writer.Key(cur->name);
+    writer.StartObject();
+    str = "count";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(count);
+    if (!samples.empty()) {
+      // Nearest-rank percentiles
+      for (const auto &[key, pct] :
+           std::array<std::pair<std::string_view, std::size_t>, 3>{
+               {{"p50", 50}, {"p90", 90}, {"p99", 99}}}) {
+        writer.Key(key.data(), key.length());
+        writer.Uint64(samples[(samples.size() * pct + 99) / 100 - 1]);
+      }
+      str = "max";
+      writer.Key(str.data(), str.length());
+      writer.Uint64(samples.back());
+    }
+    writer.EndObject();
+  }
+  writer.EndObject();
+  str = "pools";
+  writer.Key(str.data(), str.length());
+  writer.StartObject();
+  for (const auto &[name, stats] : jobs::all_stats()) {
+    writer.Key(name.data(), name.length());
+    writer.StartObject();
+    str = "queued";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.queued);
+    str = "running";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.running);
+    str = "max_queued";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.max_queued);
+    str = "submitted";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.submitted);
+    str = "completed";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.completed);
+    str = "cancelled";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.cancelled);
+    str = "failed";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.failed);
+    str = "stolen";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(stats.stolen);
+    writer.EndObject();
+  }
+  writer.EndObject();
+  str = "memory";
+  writer.Key(str.data(), str.length());
+  writer.StartObject();
+  for (std::size_t i{}; i < memory::num_subsystems; ++i) {
+    const auto &name{memory::subsystem_names[i]};
+    const auto usage{memory::get_usage(static_cast<memory::subsystem>(i))};
+    writer.Key(name.data(), name.length());
+    writer.StartObject();
+    str = "bytes";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(usage.bytes);
+    str = "peak_bytes";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(usage.peak_bytes);
+    str = "allocations";
+    writer.Key(str.data(), str.length());
+    writer.Uint64(usage.allocations);
+    writer.EndObject();
+  }
+  writer.EndObject();
+  writer.EndObject();
+}
+
+} // namespace tek::game_runtime::metrics
@@ -0,0 +1,100 @@
+//===-- metrics.hpp - runtime metrics interface ---------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations of named runtime metrics that are written to a JSON file when
+///    the process exits, if `metrics_path` settings option is set.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace tek::game_runtime::metrics {
+
+/// Monotonically increasing event counter. Instances must have static storage
+///    duration, they register themselves in the global metric list on
+///    construction.
+class [[gnu::visibility("internal")]] counter {
+  /// Name of the metric in the output file.
+  const char *_Nonnull const name;
+  /// Current value of the counter.
+  std::atomic_uint64_t value;
+  /// Pointer to the next counter in the global list.
+  counter *_Nullable next;
+
+  friend void dump();
+
+public:
+  explicit counter(const char *_Nonnull name) noexcept;
+  counter(const counter &) = delete;
+  counter &operator=(const counter &) = delete;
+
+  /// Increase the value of the counter.
+  ///
+  /// @param n
+  ///    Value to add to the counter.
+  void add(std::uint64_t n = 1) noexcept {
+    value.fetch_add(n, std::memory_order::relaxed);
+  }
+  /// Get current value of the counter.
+  ///
+  /// @return Current value of the counter.
+  std::uint64_t get() const noexcept {
+    return value.load(std::memory_order::relaxed);
+  }
+};
+
+/// Distribution of sampled values, like durations or rates, that is written as
+///    sample count and percentiles. Instances must have static storage
+///    duration, they register themselves in the global metric list on
+///    construction.
+class [[gnu::visibility("internal")]] distribution {
+  /// Name of the metric in the output file.
+  const char *_Nonnull const name;
+  /// Mutex locking concurrent access to @ref samples and @ref count.
+  std::mutex mtx;
+  /// The most recent samples, at most @ref max_samples of them. Once full,
+  ///    it's used as a ring buffer.
+  std::vector<std::uint64_t> samples;
+  /// Total number of samples added.
+  std::uint64_t count;
+  /// Pointer to the next distribution in the global list.
+  distribution *_Nullable next;
+
+  friend void dump();
+
+public:
+  /// Maximum number of samples that percentiles are computed from.
+  static constexpr std::size_t max_samples{4096};
+
+  explicit distribution(const char *_Nonnull name) noexcept;
+  distribution(const distribution &) = delete;
+  distribution &operator=(const distribution &) = delete;
+
+  /// Add a sample to the distribution.
+  ///
+  /// @param value
+  ///    Value of the sample.
+  void add(std::uint64_t value);
+};
+
+/// Write current values of all metrics to the file specified by
+///    `metrics_path` settings option. Does nothing if it's not set.
+[[gnu::visibility("internal")]]
+void dump();
+
+} // namespace tek::game_runtime::metrics
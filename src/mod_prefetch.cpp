@@ -0,0 +1,142 @@
+//===-- mod_prefetch.cpp - mod file prefetcher implementation -------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of the mod file prefetcher.
+///
+//===----------------------------------------------------------------------===//
+#include "mod_prefetch.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+
+namespace tek::game_runtime::mod_prefetch {
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Read a file to the end or until the budget is exhausted.
+///
+/// @param [in] path
+///    Path to the file.
+/// @param buf
+///    Buffer to read chunks into, @ref chunk_size bytes.
+/// @param budget
+///    Maximum number of bytes to read.
+/// @return Number of bytes read, or a negative value if the file couldn't be
+///    opened.
+static std::int64_t read_file(const std::filesystem::path &path,
+                              std::byte *_Nonnull buf, std::uint64_t budget) {
+  std::uint64_t total{};
+#ifdef _WIN32
+  const auto file{CreateFileW(
+      path.c_str(), GENERIC_READ,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+      OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    return -1;
+  }
+  for (DWORD num_read;
+       total < budget &&
+       ReadFile(file, buf, chunk_size, &num_read, nullptr) && num_read;) {
+    total += num_read;
+  }
+  CloseHandle(file);
+#else  // def _WIN32
+  const int fd{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+  if (fd < 0) {
+    return -1;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  for (ssize_t num_read;
+       total < budget && (num_read = read(fd, buf, chunk_size)) > 0;) {
+    total += num_read;
+  }
+  close(fd);
+#endif // def _WIN32 else
+  return static_cast<std::int64_t>(total);
+}
+
+//===-- Internal functions ------------------------------------------------===//
+
+std::uint64_t default_budget() {
+#ifdef _WIN32
+  MEMORYSTATUSEX mem_status;
+  mem_status.dwLength = sizeof mem_status;
+  return GlobalMemoryStatusEx(&mem_status) ? mem_status.ullAvailPhys / 2 : 0;
+#else  // def _WIN32
+  const auto pages{sysconf(_SC_AVPHYS_PAGES)};
+  const auto page_size{sysconf(_SC_PAGESIZE)};
+  return pages > 0 && page_size > 0
+             ? static_cast<std::uint64_t>(pages) * page_size / 2
+             : 0;
+#endif // def _WIN32 else
+}
+
+stats run(const std::filesystem::path &base,
+          std::span<const std::uint64_t> ids, std::uint64_t budget) {
+  // Background mode lowers I/O priority of the thread too
+#ifdef _WIN32
+  SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_BEGIN);
+#elif defined(SYS_ioprio_set)
+  // IOPRIO_WHO_PROCESS with ID 0 refers to the calling thread
+  const auto prev_ioprio{syscall(SYS_ioprio_get, 1, 0)};
+  syscall(SYS_ioprio_set, 1, 0, 3 << 13); // IOPRIO_CLASS_IDLE
+#endif
+  stats result{};
+  const auto buf{std::make_unique_for_overwrite<std::byte[]>(chunk_size)};
+  for (const auto id : ids) {
+    if (!budget) {
+      break;
+    }
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it{
+             base / std::to_string(id), ec};
+         !ec && it != std::filesystem::recursive_directory_iterator{};
+         it.increment(ec)) {
+      if (!it->is_regular_file(ec)) {
+        continue;
+      }
+      const auto num_read{read_file(it->path(), buf.get(), budget)};
+      if (num_read < 0) {
+        continue;
+      }
+      budget -= std::min<std::uint64_t>(num_read, budget);
+      ++result.files;
+      result.bytes += num_read;
+      if (!budget) {
+        break;
+      }
+    }
+  }
+#ifdef _WIN32
+  SetThreadPriority(GetCurrentThread(), THREAD_MODE_BACKGROUND_END);
+#elif defined(SYS_ioprio_set)
+  if (prev_ioprio >= 0) {
+    syscall(SYS_ioprio_set, 1, 0, prev_ioprio);
+  }
+#endif
+  return result;
+}
+
+} // namespace tek::game_runtime::mod_prefetch
@@ -0,0 +1,65 @@
+//===-- mod_prefetch.hpp - mod file prefetcher interface ------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the prefetcher that reads files of installed mods into
+///    the OS page cache ahead of the game. Windows builds read with
+///    sequential scan hints in background thread mode, other platforms use
+///    the idle I/O class where available.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace tek::game_runtime::mod_prefetch {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Amounts of data read by @ref run.
+struct stats {
+  /// Number of files read.
+  std::uint64_t files;
+  /// Number of bytes read.
+  std::uint64_t bytes;
+};
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Size of reads that mod files are prefetched with.
+constexpr std::size_t chunk_size{1024 * 1024};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Get the default amount of data to prefetch, which is half of currently
+///    available physical memory, as more wouldn't stay cached anyway.
+///
+/// @return Number of bytes.
+[[gnu::visibility("internal")]]
+std::uint64_t default_budget();
+
+/// Read all files of specified mods, lowering I/O priority of the calling
+///    thread for the duration, so prefetch reads yield to the game's own ones.
+///
+/// @param base
+///    Path to the directory containing mod directories named by their IDs.
+/// @param ids
+///    IDs of the mods to prefetch, in the order they should be read.
+/// @param budget
+///    Maximum number of bytes to read.
+/// @return Amounts of data read.
+[[gnu::visibility("internal")]]
+stats run(const std::filesystem::path &base,
+          std::span<const std::uint64_t> ids, std::uint64_t budget);
+
+} // namespace tek::game_runtime::mod_prefetch
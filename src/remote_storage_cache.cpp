@@ -0,0 +1,333 @@
+//===-- remote_storage_cache.cpp - remote storage write-back cache --------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of the remote storage write-back cache.
+///
+//===----------------------------------------------------------------------===//
+#include "remote_storage_cache.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "jobs.hpp"
+#include "memory.hpp"
+#include "log.hpp"
+#include "metrics.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tek::game_runtime::remote_storage_cache {
+
+namespace {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Cached state of a remote storage file.
+struct cached_file {
+  /// Contents of the file.
+  std::pmr::vector<std::byte> data{
+      &memory::resource(memory::subsystem::remote_storage)};
+  /// Value indicating whether the file has been deleted by the game.
+  bool deleted{};
+  /// Number of the latest change made by the game.
+  std::uint64_t version{};
+  /// Number of the latest change that has been written to the backing
+  ///    storage.
+  std::uint64_t flushed_version{};
+};
+
+/// Snapshot of a pending change.
+struct pending_change {
+  std::string name;
+  std::vector<std::byte> data;
+  bool deleted;
+  std::uint64_t version;
+};
+
+} // namespace
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Functions accessing the backing storage.
+static backend storage;
+/// Cached files, keyed by file name.
+static std::pmr::map<std::pmr::string, cached_file, std::less<>> files{
+    &memory::resource(memory::subsystem::remote_storage)};
+/// Mutex for locking concurrent access to @ref files, @ref flush_scheduled,
+///    @ref retry_scheduled and @ref retry_delay.
+static std::mutex files_mtx;
+/// Value indicating whether a flush job has been submitted and hasn't started
+///    yet.
+static bool flush_scheduled;
+/// Value indicating whether a delayed flush retry has been submitted.
+static bool retry_scheduled;
+/// Delay of the next flush retry.
+static std::chrono::steady_clock::duration retry_delay{initial_retry_delay};
+/// Mutex serializing writes of pending changes to the backing storage.
+static std::mutex flush_mtx;
+/// Value indicating whether the backing storage has become unavailable, so
+///    pending changes can't be written anymore. Guarded by @ref flush_mtx.
+static bool is_shut_down;
+/// Number of read calls answered from @ref files.
+static metrics::counter read_hits{"steam_api.remote_storage.read_hits"};
+/// Number of read calls forwarded to the backing storage.
+static metrics::counter read_misses{"steam_api.remote_storage.read_misses"};
+/// Number of writes and deletions absorbed by @ref files.
+static metrics::counter writes{"steam_api.remote_storage.writes"};
+/// Number of changes written to the backing storage. The difference from
+///    @ref writes is the number of coalesced writes.
+static metrics::counter flushed_writes{
+    "steam_api.remote_storage.flushed_writes"};
+/// Number of changes that the backing storage has failed to write. They are
+///    retried with exponential backoff.
+static metrics::counter flush_failures{
+    "steam_api.remote_storage.flush_failures"};
+/// Number of flush retries.
+static metrics::counter flush_retries{"steam_api.remote_storage.flush_retries"};
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Write all pending changes to the backing storage.
+///
+/// @return Value indicating whether any of the writes has failed.
+static bool flush_changes() {
+  const std::scoped_lock flush_lock{flush_mtx};
+  if (is_shut_down) {
+    return false;
+  }
+  std::vector<pending_change> changes;
+  {
+    const std::scoped_lock lock{files_mtx};
+    for (const auto &[name, file] : files) {
+      if (file.version != file.flushed_version) {
+        changes.emplace_back(std::string{name},
+                             std::vector(file.data.begin(), file.data.end()),
+                             file.deleted, file.version);
+      }
+    }
+  }
+  if (changes.empty()) {
+    return false;
+  }
+  // Let the backing storage upload the whole batch at once where supported
+  if (storage.begin_batch) {
+    storage.begin_batch();
+  }
+  bool failed{};
+  for (const auto &change : changes) {
+    if (change.deleted) {
+      storage.remove(change.name.data());
+    } else if (!storage.write(change.name.data(), change.data)) {
+      flush_failures.add();
+      failed = true;
+      continue;
+    }
+    flushed_writes.add();
+    const std::scoped_lock lock{files_mtx};
+    const auto it{files.find(std::string_view{change.name})};
+    if (it == files.end()) {
+      continue;
+    }
+    it->second.flushed_version = change.version;
+    if (change.deleted && it->second.version == change.version) {
+      // Let further requests for the file go to the backing storage
+      files.erase(it);
+    }
+  }
+  if (storage.end_batch) {
+    storage.end_batch();
+  }
+  return failed;
+}
+
+static void retry_flush();
+
+/// Write all pending changes to the backing storage, and schedule a retry
+///    with exponential backoff if any of the writes fails.
+static void flush_and_retry() {
+  const bool failed{flush_changes()};
+  const std::scoped_lock lock{files_mtx};
+  if (!failed) {
+    retry_delay = initial_retry_delay;
+    return;
+  }
+  if (!retry_scheduled) {
+    retry_scheduled = true;
+    jobs::runtime_pool().submit_after(retry_delay, retry_flush,
+                                      jobs::priority::low);
+    retry_delay = std::min<std::chrono::steady_clock::duration>(
+        retry_delay * 2, max_retry_delay);
+  }
+}
+
+/// Job procedure for retrying a flush that has failed.
+static void retry_flush() {
+  {
+    const std::scoped_lock lock{files_mtx};
+    retry_scheduled = false;
+  }
+  flush_retries.add();
+  flush_and_retry();
+}
+
+/// Job procedure for writing pending changes in background.
+static void flush_job() {
+  {
+    const std::scoped_lock lock{files_mtx};
+    flush_scheduled = false;
+    // Changes made in the meantime are written by the retry, so backoff is
+    //    kept while the backing storage is failing
+    if (retry_scheduled) {
+      return;
+    }
+  }
+  flush_and_retry();
+}
+
+/// Submit a job writing pending changes to the backing storage, unless one is
+///    already pending. Must be called with @ref files_mtx locked.
+static void schedule_flush() {
+  if (!flush_scheduled) {
+    flush_scheduled = true;
+    jobs::runtime_pool().submit(flush_job, jobs::priority::low);
+  }
+}
+
+//===-- Internal functions ------------------------------------------------===//
+
+void init(const backend &storage) { remote_storage_cache::storage = storage; }
+
+void write(const char *name, std::span<const std::byte> data) {
+  writes.add();
+  const std::scoped_lock lock{files_mtx};
+  auto it{files.find(std::string_view{name})};
+  if (it == files.end()) {
+    it = files.try_emplace(name).first;
+  }
+  auto &entry{it->second};
+  entry.data.assign(data.begin(), data.end());
+  entry.deleted = false;
+  ++entry.version;
+  schedule_flush();
+}
+
+std::optional<std::int32_t> read(const char *name, std::span<std::byte> buf) {
+  const std::scoped_lock lock{files_mtx};
+  const auto it{files.find(std::string_view{name})};
+  if (it == files.end()) {
+    read_misses.add();
+    return {};
+  }
+  read_hits.add();
+  const auto &entry{it->second};
+  if (entry.deleted) {
+    return 0;
+  }
+  const auto num_read{std::min(entry.data.size(), buf.size())};
+  std::ranges::copy_n(entry.data.begin(), num_read, buf.begin());
+  return static_cast<std::int32_t>(num_read);
+}
+
+void fill(const char *name, std::span<const std::byte> data) {
+  const std::scoped_lock lock{files_mtx};
+  // The game might have written the file in the meantime
+  if (!files.contains(std::string_view{name})) {
+    files.try_emplace(name).first->second.data.assign(data.begin(),
+                                                      data.end());
+  }
+}
+
+std::optional<bool> remove(const char *name) {
+  const std::scoped_lock lock{files_mtx};
+  const auto it{files.find(std::string_view{name})};
+  if (it == files.end()) {
+    // Files without cached state don't have pending changes either
+    return {};
+  }
+  writes.add();
+  auto &entry{it->second};
+  const bool existed{!entry.deleted};
+  entry.data.clear();
+  entry.deleted = true;
+  ++entry.version;
+  schedule_flush();
+  return existed;
+}
+
+std::optional<bool> exists(const char *name) {
+  const std::scoped_lock lock{files_mtx};
+  if (const auto it{files.find(std::string_view{name})}; it != files.end()) {
+    return !it->second.deleted;
+  }
+  return {};
+}
+
+std::optional<std::int32_t> size(const char *name) {
+  const std::scoped_lock lock{files_mtx};
+  if (const auto it{files.find(std::string_view{name})}; it != files.end()) {
+    return static_cast<std::int32_t>(it->second.data.size());
+  }
+  return {};
+}
+
+void drop(const char *name) {
+  flush_and_retry();
+  const std::scoped_lock lock{files_mtx};
+  if (const auto it{files.find(std::string_view{name})}; it != files.end()) {
+    files.erase(it);
+  }
+}
+
+void flush() { flush_and_retry(); }
+
+void shut_down() {
+  flush_changes();
+  const std::scoped_lock lock{flush_mtx};
+  is_shut_down = true;
+}
+
+void flush_at_exit(bool process_exit) {
+  if (!storage.write) {
+    return;
+  }
+  if (!process_exit) {
+    flush_changes();
+    return;
+  }
+  // Only report what is lost, without waiting for a lock that a terminated
+  //    thread may hold
+  const std::unique_lock lock{files_mtx, std::try_to_lock};
+  if (!lock.owns_lock()) {
+    log::warning("Remote storage changes may have been lost, the game has "
+                 "exited without calling SteamAPI_Shutdown");
+    return;
+  }
+  const auto num_pending{std::ranges::count_if(files, [](const auto &entry) {
+    return entry.second.version != entry.second.flushed_version;
+  })};
+  if (num_pending) {
+    log::warning("{} remote storage changes have been lost, the game has "
+                 "exited without calling SteamAPI_Shutdown",
+                 num_pending);
+  }
+}
+
+} // namespace tek::game_runtime::remote_storage_cache
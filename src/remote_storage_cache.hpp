@@ -0,0 +1,168 @@
+//===-- remote_storage_cache.hpp - remote storage write-back cache --------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the in-memory write-back cache of ISteamRemoteStorage
+///    files. Writes and deletions made by the game are absorbed by the cache
+///    and written to the backing storage by background jobs; reads of cached
+///    files are answered from memory. The backing storage is accessed only
+///    via @ref backend functions, so the cache doesn't depend on Steam API.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace tek::game_runtime::remote_storage_cache {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Functions accessing the backing storage. They are called from background
+///    jobs and from threads that call @ref drop or @ref flush.
+struct backend {
+  /// Write a file.
+  ///
+  /// @param [in] name
+  ///    Name of the file.
+  /// @param data
+  ///    New contents of the file.
+  /// @return Value indicating whether the file has been written.
+  bool (*_Nonnull write)(const char *_Nonnull name,
+                         std::span<const std::byte> data);
+  /// Delete a file. Failures are ignored, since deletion fails only if the
+  ///    file is already missing.
+  ///
+  /// @param [in] name
+  ///    Name of the file.
+  void (*_Nonnull remove)(const char *_Nonnull name);
+  /// Begin a batch of writes, or `nullptr` if batches are not supported.
+  void (*_Nullable begin_batch)();
+  /// End a batch of writes, or `nullptr` if batches are not supported.
+  void (*_Nullable end_batch)();
+};
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Maximum size of a file that may be held in the cache, in bytes. Larger
+///    files must be written through after calling @ref drop.
+constexpr std::int32_t max_file_size{16 * 1024 * 1024};
+/// Delay before the first retry of a flush in which writes have failed.
+constexpr std::chrono::seconds initial_retry_delay{1};
+/// Upper bound of the delay between flush retries, which doubles after each
+///    failed one.
+constexpr std::chrono::minutes max_retry_delay{5};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Set the backing storage. Must be called before any other function.
+///
+/// @param [in] storage
+///    Functions accessing the backing storage.
+[[gnu::visibility("internal")]]
+void init(const backend &storage);
+
+/// Store new contents of a file and schedule writing them to the backing
+///    storage.
+///
+/// @param [in] name
+///    Name of the file.
+/// @param data
+///    New contents of the file, not larger than @ref max_file_size bytes.
+[[gnu::visibility("internal")]]
+void write(const char *_Nonnull name, std::span<const std::byte> data);
+
+/// Read a file from the cache.
+///
+/// @param [in] name
+///    Name of the file.
+/// @param buf
+///    Buffer that receives file contents.
+/// @return Number of bytes read, `0` if the file has been deleted, or empty
+///    value if the file is not cached and has to be read from the backing
+///    storage.
+[[gnu::visibility("internal")]]
+std::optional<std::int32_t> read(const char *_Nonnull name,
+                                 std::span<std::byte> buf);
+
+/// Cache complete contents of a file that have been read from the backing
+///    storage, unless the game has changed the file in the meantime.
+///
+/// @param [in] name
+///    Name of the file.
+/// @param data
+///    Contents of the file.
+[[gnu::visibility("internal")]]
+void fill(const char *_Nonnull name, std::span<const std::byte> data);
+
+/// Mark a cached file as deleted and schedule deleting it from the backing
+///    storage.
+///
+/// @param [in] name
+///    Name of the file.
+/// @return Value indicating whether the file has existed, or empty value if
+///    the file is not cached and has to be deleted from the backing storage
+///    directly.
+[[gnu::visibility("internal")]]
+std::optional<bool> remove(const char *_Nonnull name);
+
+/// Check whether a cached file exists.
+///
+/// @param [in] name
+///    Name of the file.
+/// @return Value indicating whether the file exists, or empty value if it's
+///    not cached.
+[[gnu::visibility("internal")]]
+std::optional<bool> exists(const char *_Nonnull name);
+
+/// Get size of a cached file.
+///
+/// @param [in] name
+///    Name of the file.
+/// @return Size of the file in bytes, or empty value if it's not cached.
+[[gnu::visibility("internal")]]
+std::optional<std::int32_t> size(const char *_Nonnull name);
+
+/// Write pending changes to the backing storage and drop cached state of a
+///    file, before the game accesses it in a way that bypasses the cache.
+///
+/// @param [in] name
+///    Name of the file.
+[[gnu::visibility("internal")]]
+void drop(const char *_Nonnull name);
+
+/// Write all pending changes to the backing storage, blocking until they're
+///    written. Failed writes are retried in background with exponential
+///    backoff.
+[[gnu::visibility("internal")]]
+void flush();
+
+/// Write all pending changes and stop accessing the backing storage, as it's
+///    about to become unavailable.
+[[gnu::visibility("internal")]]
+void shut_down();
+
+/// Write pending changes when the runtime is being unloaded without
+///    @ref shut_down having been called. Failed writes are not retried.
+///
+/// @param process_exit
+///    Value indicating whether the process is exiting. The backing storage is
+///    not touched then, since other threads have been terminated and Steam
+///    may already be unloaded; pending changes are only reported to the
+///    log.
+[[gnu::visibility("internal")]]
+void flush_at_exit(bool process_exit);
+
+} // namespace tek::game_runtime::remote_storage_cache
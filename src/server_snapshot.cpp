@@ -0,0 +1,206 @@
+//===-- server_snapshot.cpp - server list snapshot implementation ---------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of server list snapshot file loading and saving. The file
+///    consists of a header followed by raw request filters, gameserveritem_t
+///    records, and a verdict table, so it can be mapped and copied without any
+///    parsing.
+///
+//===----------------------------------------------------------------------===//
+#include "server_snapshot.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "steam_api.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tek::game_runtime::server_snapshot {
+
+namespace {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Snapshot file header.
+struct file_header {
+  /// File signature, must be "TGSS".
+  std::array<char, 4> magic;
+  /// File format version, must be @ref file_version.
+  std::uint32_t version;
+  /// Hash of request parameters that produced the server list.
+  std::uint64_t filter_hash;
+  /// Application ID of the request that produced the server list.
+  std::uint32_t app_id;
+  /// Number of matchmaking_kv_pair records following the header.
+  std::uint32_t num_filters;
+  /// Number of gameserveritem_t records following filter records.
+  std::uint32_t num_servers;
+  /// Number of @ref file_verdict records following server records.
+  std::uint32_t num_verdicts;
+};
+
+/// Server rules verdict record.
+struct file_verdict {
+  /// IPv4 address of the server, in host byte order.
+  std::uint32_t ip;
+  /// Query port of the server, in host byte order.
+  std::uint16_t port;
+  /// Non-zero if the server has been rejected based on its rules.
+  std::uint8_t rejected;
+  std::uint8_t reserved;
+};
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Expected value of @ref file_header::magic.
+constexpr std::array<char, 4> file_magic{'T', 'G', 'S', 'S'};
+/// Current snapshot file format version.
+constexpr std::uint32_t file_version = 2;
+
+} // namespace
+
+//===-- Functions ---------------------------------------------------------===//
+
+std::uint64_t
+hash_filters(std::uint32_t app_id,
+             std::span<const steam_api::matchmaking_kv_pair> filters) {
+  std::uint64_t hash{0xCBF29CE484222325};
+  const auto feed{[&hash](std::string_view str) {
+    for (const auto c : str) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3;
+    }
+    // Separate strings so that concatenation boundaries affect the hash
+    hash = (hash ^ 0xFF) * 0x100000001B3;
+  }};
+  feed({reinterpret_cast<const char *>(&app_id), sizeof app_id});
+  for (const auto &filter : filters) {
+    feed(filter.key.data());
+    feed(filter.value.data());
+  }
+  return hash;
+}
+
+void load(const wchar_t *path) {
+  filter_hash = 0;
+  app_id = 0;
+  filters.clear();
+  servers.clear();
+  verdicts.clear();
+  const auto file{CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  HANDLE mapping{};
+  const void *view{};
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) ||
+      static_cast<std::uint64_t>(size.QuadPart) < sizeof(file_header)) {
+    goto close_file;
+  }
+  mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    goto close_file;
+  }
+  view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    goto close_mapping;
+  }
+  {
+    const auto &hdr{*reinterpret_cast<const file_header *>(view)};
+    if (hdr.magic != file_magic || hdr.version != file_version ||
+        static_cast<std::uint64_t>(size.QuadPart) !=
+            sizeof hdr +
+                static_cast<std::uint64_t>(hdr.num_filters) *
+                    sizeof(steam_api::matchmaking_kv_pair) +
+                static_cast<std::uint64_t>(hdr.num_servers) *
+                    sizeof(steam_api::gameserveritem_t) +
+                static_cast<std::uint64_t>(hdr.num_verdicts) *
+                    sizeof(file_verdict)) {
+      goto unmap;
+    }
+    const auto filter_recs{
+        reinterpret_cast<const steam_api::matchmaking_kv_pair *>(&hdr + 1)};
+    const auto server_recs{
+        reinterpret_cast<const steam_api::gameserveritem_t *>(
+            filter_recs + hdr.num_filters)};
+    const std::span verdict_recs{
+        reinterpret_cast<const file_verdict *>(server_recs + hdr.num_servers),
+        hdr.num_verdicts};
+    filter_hash = hdr.filter_hash;
+    app_id = hdr.app_id;
+    filters.assign(filter_recs, filter_recs + hdr.num_filters);
+    servers.assign(server_recs, server_recs + hdr.num_servers);
+    verdicts.reserve(verdict_recs.size());
+    for (const auto &verdict : verdict_recs) {
+      verdicts.emplace(server_key(verdict.ip, verdict.port), verdict.rejected);
+    }
+  }
+unmap:
+  UnmapViewOfFile(view);
+close_mapping:
+  CloseHandle(mapping);
+close_file:
+  CloseHandle(file);
+}
+
+void save(const wchar_t *path) {
+  std::vector<file_verdict> verdict_recs;
+  verdict_recs.reserve(verdicts.size());
+  for (const auto &[key, rejected] : verdicts) {
+    verdict_recs.emplace_back(file_verdict{
+        .ip = static_cast<std::uint32_t>(key >> 16),
+        .port = static_cast<std::uint16_t>(key),
+        .rejected = rejected,
+        .reserved = 0});
+  }
+  const file_header hdr{
+      .magic = file_magic,
+      .version = file_version,
+      .filter_hash = filter_hash,
+      .app_id = app_id,
+      .num_filters = static_cast<std::uint32_t>(filters.size()),
+      .num_servers = static_cast<std::uint32_t>(servers.size()),
+      .num_verdicts = static_cast<std::uint32_t>(verdict_recs.size())};
+  const std::span<const std::byte> chunks[]{
+      std::as_bytes(std::span{&hdr, 1}), std::as_bytes(std::span{filters}),
+      std::as_bytes(std::span{servers}),
+      std::as_bytes(std::span{verdict_recs})};
+  // Write to a temporary file first so that a crash never leaves a truncated
+  //    snapshot behind
+  std::wstring tmp_path{path};
+  tmp_path.append(L".tmp");
+  const auto file{CreateFileW(tmp_path.data(), GENERIC_WRITE, 0, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)};
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  for (const auto chunk : chunks) {
+    DWORD bytes_written;
+    if (!WriteFile(file, chunk.data(), chunk.size(), &bytes_written, nullptr) ||
+        bytes_written != chunk.size()) {
+      CloseHandle(file);
+      DeleteFileW(tmp_path.data());
+      return;
+    }
+  }
+  CloseHandle(file);
+  if (!MoveFileExW(tmp_path.data(), path, MOVEFILE_REPLACE_EXISTING)) {
+    DeleteFileW(tmp_path.data());
+  }
+}
+
+} // namespace tek::game_runtime::server_snapshot
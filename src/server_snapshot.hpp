@@ -0,0 +1,86 @@
+//===-- server_snapshot.hpp - server list snapshot interface --------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for persistent server list snapshot, that stores the last
+///    result set of a filtered internet server list request along with server
+///    rules verdicts, so it can be displayed immediately on next request.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+#include "steam_api.hpp"
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace tek::game_runtime::server_snapshot {
+
+//===-- Variables ---------------------------------------------------------===//
+
+/// Hash of the application ID and filters of the request that produced
+///    @ref servers.
+inline std::uint64_t filter_hash;
+/// Application ID of the request that produced @ref servers.
+inline std::uint32_t app_id;
+/// Filters of the request that produced @ref servers.
+inline std::vector<steam_api::matchmaking_kv_pair> filters;
+/// Details of servers that responded to the last request.
+inline std::vector<steam_api::gameserveritem_t> servers;
+/// Server rules verdicts, keyed by @ref server_key values. `true` means that
+///    the server has been rejected based on its rules.
+inline std::unordered_map<std::uint64_t, bool> verdicts;
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Get the key identifying a server in @ref verdicts.
+///
+/// @param ip
+///    IPv4 address of the server, in host byte order.
+/// @param port
+///    Query port of the server, in host byte order.
+/// @return Key value for the server.
+constexpr std::uint64_t server_key(std::uint32_t ip, std::uint16_t port) {
+  return (static_cast<std::uint64_t>(ip) << 16) | port;
+}
+
+/// Compute the hash of server list request parameters.
+///
+/// @param app_id
+///    ID of the application to request servers for.
+/// @param filters
+///    Search filters of the request.
+/// @return FNV-1a hash of the request parameters.
+[[gnu::visibility("internal")]]
+std::uint64_t
+hash_filters(std::uint32_t app_id,
+             std::span<const steam_api::matchmaking_kv_pair> filters);
+
+/// Load the snapshot from specified file into @ref filter_hash, @ref app_id,
+///    @ref filters, @ref servers, and @ref verdicts. If the file doesn't exist
+///    or is invalid, the variables are left empty.
+///
+/// @param [in] path
+///    Path to the snapshot file.
+[[gnu::visibility("internal")]]
+void load(const wchar_t *_Nonnull path);
+
+/// Save current @ref filter_hash, @ref app_id, @ref filters, @ref servers,
+///    and @ref verdicts to specified file, replacing it atomically.
+///
+/// @param [in] path
+///    Path to the snapshot file.
+[[gnu::visibility("internal")]]
+void save(const wchar_t *_Nonnull path);
+
+} // namespace tek::game_runtime::server_snapshot
@@ -15,28 +15,45 @@
 #include "settings.hpp"
 
 #include "common.hpp" // IWYU pragma: keep
+#include "file_watcher.hpp"
 #include "game_cbs.hpp"
+#include "log.hpp"
+#include "memory.hpp"
+#include "settings_index.hpp"
+#include "steam_api.hpp"
+#include "utf.hpp"
 
 #include <array>
 #include <charconv>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <format>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <ranges>
 #include <rapidjson/document.h>
 #include <rapidjson/filereadstream.h>
 #include <rapidjson/filewritestream.h>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/reader.h>
+#include <set>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <utility>
+#include <vector>
 
 namespace tek::game_runtime {
 
 namespace {
 
+/// Size of the startup arena chunk that settings DOM is allocated from. It's
+///    enough for typical settings files, larger ones spill to the heap.
+constexpr std::size_t doc_chunk_size{64 * 1024};
+
 /// Supported methods for loading the settings.
 enum class load_type {
   /// Settings file path is received via file mapping, tek-game-runtime reads
@@ -76,6 +93,124 @@ public:
 
 /// Path to the settings file, if file-based settings loading is used.
 std::wstring file_path;
+/// Name of the `apps` member of a multi-app settings file that holds settings
+///    for this process. If empty, the whole file is the settings object.
+std::string section_name;
+/// Mutex serializing settings file writes from different threads.
+std::mutex save_mtx;
+/// Watcher for the settings file, if hot-reload is enabled. It's never
+///    destroyed, as its thread may still be running at process exit.
+file_watcher *_Nullable watcher;
+
+//===-- Settings loading --------------------------------------------------===//
+
+/// Parse the settings file, or only the section of it specified by
+///    @ref section_name if it's set.
+///
+/// @param [out] doc
+///    RapidJSON document that receives file contents.
+/// @return Value indicating whether the file has been opened and the section
+///    has been found. Parsing errors are reported via @p doc.
+static bool parse_file(rapidjson::Document &doc) {
+  if (!section_name.empty()) {
+    std::string buf;
+    if (!settings_index::read_section(file_path, section_name, buf)) {
+      return false;
+    }
+    doc.Parse<rapidjson::kParseStopWhenDoneFlag>(buf.data(), buf.size());
+    return true;
+  }
+  const std::unique_ptr<std::FILE, decltype(&std::fclose)> file{
+      _wfopen(file_path.data(), L"rbNS"), std::fclose};
+  if (!file) {
+    return false;
+  }
+  std::array<char, 2048> read_buf;
+  rapidjson::FileReadStream stream{file.get(), read_buf.data(),
+                                   read_buf.size()};
+  doc.ParseStream<rapidjson::kParseStopWhenDoneFlag>(stream);
+  return true;
+}
+
+/// Load DLC lists from settings document.
+///
+/// @param [in] doc
+///    RapidJSON document describing settings file contents.
+/// @param [out] dlc
+///    List that receives "owned" DLC app IDs and names.
+/// @param [out] installed_dlc
+///    Set that receives "installed" DLC app IDs.
+static void
+load_dlc(const rapidjson::Document &doc,
+         std::vector<std::pair<std::uint32_t, std::string>> &dlc,
+         std::set<std::uint32_t> &installed_dlc) {
+  const auto m_dlc{doc.FindMember("dlc")};
+  if (m_dlc != doc.MemberEnd() && m_dlc->value.IsObject()) {
+    dlc.reserve(m_dlc->value.MemberCount());
+    for (const auto &dlc_item : m_dlc->value.GetObject()) {
+      std::uint32_t id;
+      const std::string_view view{dlc_item.name.GetString(),
+                                  dlc_item.name.GetStringLength()};
+      if (std::from_chars(view.begin(), view.end(), id).ec != std::errc{} ||
+          !dlc_item.value.IsString()) {
+        continue;
+      }
+      dlc.emplace_back(id, std::string{dlc_item.value.GetString(),
+                                       dlc_item.value.GetStringLength()});
+    }
+  }
+  const auto m_installed_dlc{doc.FindMember("installed_dlc")};
+  if (m_installed_dlc != doc.MemberEnd() && m_installed_dlc->value.IsArray()) {
+    for (const auto &elem : m_installed_dlc->value.GetArray()) {
+      if (elem.IsUint()) {
+        installed_dlc.emplace(elem.GetUint());
+      }
+    }
+  } else {
+    for (auto id : dlc | std::views::keys) {
+      installed_dlc.emplace(id);
+    }
+  }
+}
+
+/// Re-read the settings file and apply the options that support hot-reload.
+///    Runs on the settings watcher thread. Options that are only used during
+///    initialization keep their current values.
+static void reload() {
+  rapidjson::Document doc;
+  if (!parse_file(doc) || doc.HasParseError() || !doc.IsObject()) {
+    // The file may be in the middle of being written, the next change
+    //    notification will trigger another attempt
+    return;
+  }
+  const auto m_store{doc.FindMember("store")};
+  if (m_store == doc.MemberEnd() || !m_store->value.IsString() ||
+      std::string_view{m_store->value.GetString(),
+                       m_store->value.GetStringLength()} != "steam") {
+    return;
+  }
+  const auto app_id{doc.FindMember("app_id")};
+  if (app_id == doc.MemberEnd() || !app_id->value.IsUint() ||
+      app_id->value.GetUint() != g_settings.steam->app_id) {
+    return;
+  }
+  // Parse new lists before taking the lock, so readers are only blocked for
+  //    the duration of the swap
+  std::vector<std::pair<std::uint32_t, std::string>> dlc;
+  std::set<std::uint32_t> installed_dlc;
+  load_dlc(doc, dlc, installed_dlc);
+  {
+    const std::scoped_lock lock{g_settings.steam->dlc_mtx};
+    g_settings.steam->dlc.swap(dlc);
+    g_settings.steam->installed_dlc.swap(installed_dlc);
+  }
+  steam_api::update_dlc_index();
+  // Apply game-specific options
+  const auto cb{get_settings_reload_cb()};
+  if (cb) {
+    cb(doc);
+  }
+}
 
 } // namespace
 
@@ -100,29 +235,38 @@ bool settings::load() {
   mapping.close();
   const auto hdr{reinterpret_cast<const data_header *>(mapping_view.get())};
   const auto type{hdr->type};
-  std::string data{reinterpret_cast<const char *>(hdr + 1), hdr->size};
+  auto &arena{memory::startup_arena()};
+  std::pmr::string data{reinterpret_cast<const char *>(hdr + 1), hdr->size,
+                        &arena};
   mapping_view.reset();
-  rapidjson::Document doc;
+  // Back the DOM with a chunk from the startup arena, it's discarded after
+  //    loading anyway
+  rapidjson::MemoryPoolAllocator<> doc_alloc{
+      arena.allocate(doc_chunk_size, alignof(std::max_align_t)),
+      doc_chunk_size};
+  rapidjson::Document doc{&doc_alloc};
   switch (type) {
   case load_type::file_path: {
-    if (data.empty()) {
+    // A path may be followed by '|' and the name of the section to use in a
+    //    multi-app settings file
+    std::string_view path{data};
+    if (const auto sep{path.rfind('|')}; sep != std::string_view::npos) {
+      section_name = path.substr(sep + 1);
+      path = path.substr(0, sep);
+    }
+    if (path.empty()) {
       file_path = L"tek-gr-settings.json";
     } else {
-      file_path.resize(MultiByteToWideChar(CP_UTF8, 0, data.data(), data.size(),
-                                           nullptr, 0));
-      MultiByteToWideChar(CP_UTF8, 0, data.data(), data.size(),
-                          file_path.data(), file_path.length());
+      file_path = utf::to_wide(path);
     }
-    const std::unique_ptr<std::FILE, decltype(&std::fclose)> file{
-        _wfopen(file_path.data(), L"rbNS"), std::fclose};
-    if (!file) {
-      display_error(L"Failed to load settings: unable to open settings file");
+    if (!parse_file(doc)) {
+      display_error(section_name.empty()
+                        ? L"Failed to load settings: unable to open settings "
+                          L"file"
+                        : L"Failed to load settings: unable to open settings "
+                          L"file or find the app section in it");
       return false;
     }
-    std::array<char, 2048> read_buf;
-    rapidjson::FileReadStream stream{file.get(), read_buf.data(),
-                                     read_buf.size()};
-    doc.ParseStream<rapidjson::kParseStopWhenDoneFlag>(stream);
     break;
   }
   case load_type::data:
@@ -161,33 +305,7 @@ bool settings::load() {
     } else {
       steam->spoof_app_id = 0;
     }
-    const auto dlc{doc.FindMember("dlc")};
-    if (dlc != doc.MemberEnd() && dlc->value.IsObject()) {
-      steam->dlc.reserve(dlc->value.MemberCount());
-      for (const auto &dlc_item : dlc->value.GetObject()) {
-        std::uint32_t id;
-        view = {dlc_item.name.GetString(), dlc_item.name.GetStringLength()};
-        if (std::from_chars(view.begin(), view.end(), id).ec != std::errc{} ||
-            !dlc_item.value.IsString()) {
-          continue;
-        }
-        steam->dlc.emplace_back(id,
-                                std::string{dlc_item.value.GetString(),
-                                            dlc_item.value.GetStringLength()});
-      }
-    }
-    const auto installed_dlc{doc.FindMember("installed_dlc")};
-    if (installed_dlc != doc.MemberEnd() && installed_dlc->value.IsArray()) {
-      for (const auto &elem : installed_dlc->value.GetArray()) {
-        if (elem.IsUint()) {
-          steam->installed_dlc.emplace(elem.GetUint());
-        }
-      }
-    } else {
-      for (auto id : steam->dlc | std::views::keys) {
-        steam->installed_dlc.emplace(id);
-      }
-    }
+    load_dlc(doc, steam->dlc, steam->installed_dlc);
     const auto tek_sc_path{doc.FindMember("tek_sc_path")};
     if (tek_sc_path != doc.MemberEnd() && tek_sc_path->value.IsString()) {
       steam->tek_sc_path = {tek_sc_path->value.GetString(),
@@ -197,10 +315,55 @@ bool settings::load() {
     if (auto_update_dlc != doc.MemberEnd() && auto_update_dlc->value.IsBool()) {
       steam->auto_update_dlc = auto_update_dlc->value.GetBool();
     }
+    const auto cache_lobby_data{doc.FindMember("cache_lobby_data")};
+    if (cache_lobby_data != doc.MemberEnd() &&
+        cache_lobby_data->value.IsBool()) {
+      steam->cache_lobby_data = cache_lobby_data->value.GetBool();
+    }
+    const auto cache_remote_storage{doc.FindMember("cache_remote_storage")};
+    if (cache_remote_storage != doc.MemberEnd() &&
+        cache_remote_storage->value.IsBool()) {
+      steam->cache_remote_storage = cache_remote_storage->value.GetBool();
+    }
+    const auto cache_user_stats{doc.FindMember("cache_user_stats")};
+    if (cache_user_stats != doc.MemberEnd() &&
+        cache_user_stats->value.IsBool()) {
+      steam->cache_user_stats = cache_user_stats->value.GetBool();
+    }
+    const auto shared_cache{doc.FindMember("shared_cache")};
+    if (shared_cache != doc.MemberEnd() && shared_cache->value.IsBool()) {
+      steam->shared_cache = shared_cache->value.GetBool();
+    }
+    const auto http_cache_path{doc.FindMember("http_cache_path")};
+    if (http_cache_path != doc.MemberEnd() &&
+        http_cache_path->value.IsString()) {
+      steam->http_cache_path = {http_cache_path->value.GetString(),
+                                http_cache_path->value.GetStringLength()};
+    }
   } else { // if (view == "steam")
     display_error(L"Failed to load settings: unknown store");
     return false;
   } // if (view == "steam") else
+  const auto m_metrics_path{doc.FindMember("metrics_path")};
+  if (m_metrics_path != doc.MemberEnd() && m_metrics_path->value.IsString()) {
+    metrics_path = {m_metrics_path->value.GetString(),
+                    m_metrics_path->value.GetStringLength()};
+  }
+  const auto m_log_path{doc.FindMember("log_path")};
+  if (m_log_path != doc.MemberEnd() && m_log_path->value.IsString()) {
+    log_path = {m_log_path->value.GetString(),
+                m_log_path->value.GetStringLength()};
+  }
+  const auto m_log_level{doc.FindMember("log_level")};
+  if (m_log_level != doc.MemberEnd() && m_log_level->value.IsString()) {
+    log_level = {m_log_level->value.GetString(),
+                 m_log_level->value.GetStringLength()};
+  }
+  log::open();
+  const auto m_hot_reload{doc.FindMember("hot_reload")};
+  if (m_hot_reload != doc.MemberEnd() && m_hot_reload->value.IsBool()) {
+    hot_reload = m_hot_reload->value.GetBool();
+  }
   // Load game-specific options
   const auto cb{get_settings_load_cb()};
   if (cb) {
@@ -213,8 +376,14 @@ void settings::save() {
   if (file_path.empty()) {
     return;
   }
-  const std::unique_ptr<std::FILE, decltype(&std::fclose)> file{
-      _wfopen(file_path.data(), L"wbNS"), std::fclose};
+  const std::scoped_lock lock{save_mtx};
+  // In a multi-app settings file, the section is written to a temporary file
+  //    that is deleted on close, and then spliced into the settings file
+  std::unique_ptr<std::FILE, decltype(&std::fclose)> file{
+      section_name.empty()
+          ? _wfopen(file_path.data(), L"wbNS")
+          : _wfopen(settings_index::tmp_path(file_path).c_str(), L"w+bDNT"),
+      std::fclose};
   if (!file) {
     return;
   }
@@ -236,6 +405,7 @@ void settings::save() {
   writer.String(str.data(), str.length());
   switch (store) {
   case store_type::steam: {
+    const std::shared_lock dlc_lock{steam->dlc_mtx};
     str = "app_id";
     writer.Key(str.data(), str.length());
     writer.Uint(steam->app_id);
@@ -277,15 +447,79 @@ void settings::save() {
     str = "auto_update_dlc";
     writer.Key(str.data(), str.length());
     writer.Bool(steam->auto_update_dlc);
+    str = "cache_lobby_data";
+    writer.Key(str.data(), str.length());
+    writer.Bool(steam->cache_lobby_data);
+    str = "cache_remote_storage";
+    writer.Key(str.data(), str.length());
+    writer.Bool(steam->cache_remote_storage);
+    str = "cache_user_stats";
+    writer.Key(str.data(), str.length());
+    writer.Bool(steam->cache_user_stats);
+    str = "shared_cache";
+    writer.Key(str.data(), str.length());
+    writer.Bool(steam->shared_cache);
+    if (!steam->http_cache_path.empty()) {
+      str = "http_cache_path";
+      writer.Key(str.data(), str.length());
+      writer.String(steam->http_cache_path.data(),
+                    steam->http_cache_path.length());
+    }
     break;
   } // case store_type::steam
   } // switch (store)
+  if (!metrics_path.empty()) {
+    str = "metrics_path";
+    writer.Key(str.data(), str.length());
+    writer.String(metrics_path.data(), metrics_path.length());
+  }
+  if (!log_path.empty()) {
+    str = "log_path";
+    writer.Key(str.data(), str.length());
+    writer.String(log_path.data(), log_path.length());
+  }
+  if (!log_level.empty()) {
+    str = "log_level";
+    writer.Key(str.data(), str.length());
+    writer.String(log_level.data(), log_level.length());
+  }
+  str = "hot_reload";
+  writer.Key(str.data(), str.length());
+  writer.Bool(hot_reload);
   // Save game-specific options
   const auto cb{get_settings_save_cb()};
   if (cb) {
     cb(writer);
   }
   writer.EndObject();
+  if (!section_name.empty()) {
+    stream.Flush();
+    std::string section;
+    if (std::fseek(file.get(), 0, SEEK_END) == 0) {
+      section.resize(std::ftell(file.get()));
+      std::rewind(file.get());
+      if (std::fread(section.data(), 1, section.size(), file.get()) ==
+          section.size()) {
+        settings_index::write_section(file_path, section_name, section);
+      }
+    }
+  }
+  file.reset();
+  if (watcher) {
+    // Don't reload the settings that have just been written
+    watcher->ignore_current();
+  }
+}
+
+void settings::watch() {
+  if (!hot_reload || file_path.empty() || watcher) {
+    return;
+  }
+  watcher = new file_watcher{file_path, reload};
+  if (!watcher->start()) {
+    delete watcher;
+    watcher = nullptr;
+  }
 }
 
 } // namespace tek::game_runtime
@@ -18,6 +18,7 @@
 #include <cstdint>
 #include <memory>
 #include <set>
+#include <shared_mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,6 +37,9 @@ struct steam_options {
   ///    `SteamAPI_Init` fails. After `SteamAPI_Init`, receives the effective
   ///    application ID that was used to initialize Steam API.
   std::uint32_t spoof_app_id;
+  /// Mutex guarding @ref dlc and @ref installed_dlc, which may be replaced
+  ///    by settings hot-reload while the game is running.
+  std::shared_mutex dlc_mtx;
   /// List of "owned" DLC app IDs and names.
   std::vector<std::pair<std::uint32_t, std::string>> dlc;
   /// List of "installed" app IDs.
@@ -46,6 +50,23 @@ struct steam_options {
   /// Value indicating whether to attempt to use tek-steamclient to update DLC
   ///    list.
   bool auto_update_dlc;
+  /// Value indicating whether ISteamMatchmaking lobby data getters should be
+  ///    answered from an in-memory cache.
+  bool cache_lobby_data;
+  /// Value indicating whether ISteamRemoteStorage file operations should go
+  ///    through the in-memory write-back cache.
+  bool cache_remote_storage;
+  /// Value indicating whether ISteamUserStats stats and achievements should
+  ///    be answered from an in-memory cache, with `StoreStats` calls
+  ///    coalesced.
+  bool cache_user_stats;
+  /// Value indicating whether DLC info, Steam Workshop indexes and server
+  ///    rules verdicts should be shared with other instances of the game via
+  ///    the cross-process cache.
+  bool shared_cache;
+  /// Path to the directory that responses to ISteamHTTP GET requests are
+  ///    cached in. If empty, responses are not cached.
+  std::string http_cache_path;
 };
 
 /// TEK Game Runtime settings structure.
@@ -54,13 +75,28 @@ struct [[gnu::visibility("internal")]] settings {
   store_type store;
   /// Store-specific options for `store_type::steam`.
   std::unique_ptr<steam_options> steam;
+  /// Path to the file that runtime metrics are written to at process exit. If
+  ///    empty, metrics are not written.
+  std::string metrics_path;
+  /// Path to the file that runtime log records are appended to. If empty,
+  ///    nothing is logged.
+  std::string log_path;
+  /// Name of the minimum level of log records to write: `debug`, `info`,
+  ///    `warning`, `error` or `off`. Unrecognized values mean `warning`.
+  std::string log_level;
+  /// Value indicating whether the settings file should be watched for
+  ///    changes, which are applied without restarting the game.
+  bool hot_reload;
 
   /// Load settings from the file.
   ///
   /// @return Value indicating whether loading succeeded.
   bool load();
-  /// Save current settings to the file.
+  /// Save current settings to the file. May be called from any thread.
   void save();
+  /// Start watching the settings file if @ref hot_reload is set. Does nothing
+  ///    if settings have not been loaded from a file.
+  void watch();
 };
 
 /// Global settings object.
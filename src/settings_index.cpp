@@ -0,0 +1,672 @@
+//===-- settings_index.cpp - multi-app settings file sections -------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of reading and writing sections of multi-app settings
+///    files, and of their sidecar index.
+///
+//===----------------------------------------------------------------------===//
+#include "settings_index.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "metrics.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // ndef _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace tek::game_runtime::settings_index {
+
+namespace {
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Magic value identifying the layout of settings section index files. Must be
+///    changed along with any change to @ref index_header, @ref index_entry or
+///    the layout of data following them.
+constexpr std::uint32_t index_magic{0x31495354}; // "TSI1"
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Header of a settings section index file. It's followed by
+///    @ref index_header::num_entries entries.
+struct index_header {
+  /// Layout magic value.
+  std::uint32_t magic;
+  /// Number of entries in the index.
+  std::uint32_t num_entries;
+  /// Size of the settings file that the index was built for, in bytes.
+  std::uint64_t file_size;
+  /// Last write time of the settings file that the index was built for, in
+  ///    OS-specific units.
+  std::uint64_t write_time;
+};
+
+/// Settings section index entry. It's followed by the section name.
+struct index_entry {
+  /// Offset of the section's object in the settings file, in bytes.
+  std::uint64_t offset;
+  /// Size of the section's object, in bytes.
+  std::uint64_t size;
+  /// Length of the section name.
+  std::uint32_t name_size;
+  std::uint32_t reserved;
+};
+
+/// Location of a section in a multi-app settings file.
+struct section_desc {
+  /// Name of the section.
+  std::string name;
+  /// Offset of the section's object in the file, in bytes.
+  std::uint64_t offset;
+  /// Size of the section's object, in bytes.
+  std::uint64_t size;
+};
+
+/// RAII wrapper for an open file, providing the operations needed for
+///    settings files and their sidecar files.
+class os_file {
+#ifdef _WIN32
+  /// Handle for the file.
+  HANDLE handle{INVALID_HANDLE_VALUE};
+#else  // def _WIN32
+  /// File descriptor for the file.
+  int fd{-1};
+#endif // def _WIN32 else
+
+public:
+  os_file() = default;
+  ~os_file() { close(); }
+  os_file(const os_file &) = delete;
+  os_file &operator=(const os_file &) = delete;
+
+  /// Open an existing file for reading. The file may still be replaced or
+  ///    deleted while it's open.
+  ///
+  /// @param [in] path
+  ///    Path to the file.
+  /// @return Value indicating whether the file has been opened.
+  bool open_read(const std::filesystem::path &path) {
+#ifdef _WIN32
+    handle = CreateFileW(path.c_str(), GENERIC_READ,
+                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                         nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                         nullptr);
+    return handle != INVALID_HANDLE_VALUE;
+#else  // def _WIN32
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    return fd >= 0;
+#endif // def _WIN32 else
+  }
+
+  /// Create a new file or truncate an existing one, for writing.
+  ///
+  /// @param [in] path
+  ///    Path to the file.
+  /// @return Value indicating whether the file has been created.
+  bool create(const std::filesystem::path &path) {
+#ifdef _WIN32
+    handle = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr,
+                         CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    return handle != INVALID_HANDLE_VALUE;
+#else  // def _WIN32
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    return fd >= 0;
+#endif // def _WIN32 else
+  }
+
+  /// Open or create a lock file and lock it exclusively, waiting until other
+  ///    processes and threads release it. The lock is released when the file
+  ///    is closed.
+  ///
+  /// @param [in] path
+  ///    Path to the lock file.
+  /// @return Value indicating whether the lock has been acquired.
+  bool lock(const std::filesystem::path &path) {
+#ifdef _WIN32
+    handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                         nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+      return false;
+    }
+    OVERLAPPED overlapped{};
+    return LockFileEx(handle, LOCKFILE_EXCLUSIVE_LOCK, 0, 1, 0, &overlapped);
+#else  // def _WIN32
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    return fd >= 0 && flock(fd, LOCK_EX) == 0;
+#endif // def _WIN32 else
+  }
+
+  /// Get the size and the last write time of the file.
+  ///
+  /// @param [out] size
+  ///    Variable that receives file size, in bytes.
+  /// @param [out] write_time
+  ///    Variable that receives last write time of the file, as a `FILETIME`
+  ///    value on Windows, or in nanoseconds since the epoch elsewhere.
+  /// @return Value indicating whether the information has been obtained.
+  bool get_info(std::uint64_t &size, std::uint64_t &write_time) const {
+#ifdef _WIN32
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(handle, &info)) {
+      return false;
+    }
+    size = (static_cast<std::uint64_t>(info.nFileSizeHigh) << 32) |
+           info.nFileSizeLow;
+    const auto &time{info.ftLastWriteTime};
+    write_time = (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) |
+                 time.dwLowDateTime;
+#else  // def _WIN32
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      return false;
+    }
+    size = static_cast<std::uint64_t>(st.st_size);
+    write_time = static_cast<std::uint64_t>(st.st_mtim.tv_sec) * 1000000000 +
+                 static_cast<std::uint64_t>(st.st_mtim.tv_nsec);
+#endif // def _WIN32 else
+    return true;
+  }
+
+  /// Read data from the file at specified offset.
+  ///
+  /// @param offset
+  ///    Offset to read from, in bytes.
+  /// @param [out] buf
+  ///    Buffer that receives the data; its whole size is read.
+  /// @return Value indicating whether the data has been read.
+  bool read_at(std::uint64_t offset, std::span<char> buf) const {
+#ifdef _WIN32
+    LARGE_INTEGER pos;
+    pos.QuadPart = static_cast<LONGLONG>(offset);
+    DWORD bytes_read;
+    return SetFilePointerEx(handle, pos, nullptr, FILE_BEGIN) &&
+           ReadFile(handle, buf.data(), buf.size(), &bytes_read, nullptr) &&
+           bytes_read == buf.size();
+#else  // def _WIN32
+    while (!buf.empty()) {
+      const auto res{pread(fd, buf.data(), buf.size(), offset)};
+      if (res <= 0) {
+        return false;
+      }
+      buf = buf.subspan(res);
+      offset += res;
+    }
+    return true;
+#endif // def _WIN32 else
+  }
+
+  /// Write data to the file.
+  ///
+  /// @param data
+  ///    The data to write.
+  /// @return Value indicating whether all data has been written.
+  bool write(std::string_view data) const {
+#ifdef _WIN32
+    DWORD bytes_written;
+    return WriteFile(handle, data.data(), data.size(), &bytes_written,
+                     nullptr) &&
+           bytes_written == data.size();
+#else  // def _WIN32
+    while (!data.empty()) {
+      const auto res{::write(fd, data.data(), data.size())};
+      if (res <= 0) {
+        return false;
+      }
+      data.remove_prefix(res);
+    }
+    return true;
+#endif // def _WIN32 else
+  }
+
+  /// Close the file if it's open.
+  void close() noexcept {
+#ifdef _WIN32
+    if (handle != INVALID_HANDLE_VALUE) {
+      CloseHandle(handle);
+      handle = INVALID_HANDLE_VALUE;
+    }
+#else  // def _WIN32
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+    }
+#endif // def _WIN32 else
+  }
+};
+
+} // namespace
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Number of the next temporary file created by this process.
+static constinit std::atomic_uint32_t next_tmp;
+/// Number of settings sections located via the sidecar index.
+static metrics::counter index_hits{"settings.index.hits"};
+/// Number of times the sidecar index has been rebuilt by scanning the file.
+static metrics::counter index_rebuilds{"settings.index.rebuilds"};
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Get the index of the first non-whitespace character.
+///
+/// @param text
+///    JSON text.
+/// @param pos
+///    Position to start from.
+/// @return Position of the first non-whitespace character at or after
+///    @p pos, or size of @p text if there is none.
+static std::size_t skip_ws(std::string_view text, std::size_t pos) noexcept {
+  return std::min(text.find_first_not_of(" \t\r\n", pos), text.size());
+}
+
+/// Find the end of a JSON value without parsing it.
+///
+/// @param text
+///    JSON text.
+/// @param pos
+///    Position of the first character of the value.
+/// @return Position right after the end of the value, or
+///    `std::string_view::npos` if it's malformed.
+static std::size_t skip_value(std::string_view text, std::size_t pos) noexcept {
+  if (pos >= text.size()) {
+    return std::string_view::npos;
+  }
+  switch (text[pos]) {
+  case '"':
+    for (++pos; pos < text.size(); ++pos) {
+      if (text[pos] == '\\') {
+        ++pos;
+      } else if (text[pos] == '"') {
+        return pos + 1;
+      }
+    }
+    return std::string_view::npos;
+  case '{':
+  case '[': {
+    std::size_t depth{};
+    while (pos < text.size()) {
+      switch (text[pos]) {
+      case '"':
+        pos = skip_value(text, pos);
+        if (pos == std::string_view::npos) {
+          return pos;
+        }
+        continue;
+      case '{':
+      case '[':
+        ++depth;
+        break;
+      case '}':
+      case ']':
+        if (!--depth) {
+          return pos + 1;
+        }
+      }
+      ++pos;
+    }
+    return std::string_view::npos;
+  }
+  default:
+    return std::min(text.find_first_of(",}] \t\r\n", pos), text.size());
+  }
+}
+
+/// Locate the sections of a multi-app settings file, which are the object
+///    members of its top-level `apps` member. Values are skipped over without
+///    building a DOM.
+///
+/// @param text
+///    Contents of the settings file.
+/// @param [out] sections
+///    List that receives section locations.
+/// @return Value indicating whether the file has been scanned successfully.
+static bool scan_sections(std::string_view text,
+                          std::vector<section_desc> &sections) {
+  /// Call @p member_cb for each member of the object starting at @p pos, with
+  ///    member name and positions of the start and the end of its value.
+  const auto for_each_member{[text](std::size_t pos, const auto &member_cb) {
+    if (pos >= text.size() || text[pos] != '{') {
+      return false;
+    }
+    for (pos = skip_ws(text, pos + 1); pos < text.size();) {
+      if (text[pos] == '}') {
+        return true;
+      }
+      if (text[pos] != '"') {
+        return false;
+      }
+      const auto name_end{skip_value(text, pos)};
+      if (name_end == std::string_view::npos) {
+        return false;
+      }
+      const auto name{text.substr(pos + 1, name_end - pos - 2)};
+      pos = skip_ws(text, name_end);
+      if (pos >= text.size() || text[pos] != ':') {
+        return false;
+      }
+      pos = skip_ws(text, pos + 1);
+      const auto value_end{skip_value(text, pos)};
+      if (value_end == std::string_view::npos) {
+        return false;
+      }
+      member_cb(name, pos, value_end);
+      pos = skip_ws(text, value_end);
+      if (pos < text.size() && text[pos] == ',') {
+        pos = skip_ws(text, pos + 1);
+      }
+    }
+    return false;
+  }};
+  bool apps_valid{true};
+  return for_each_member(
+             skip_ws(text, 0),
+             [&](std::string_view name, std::size_t pos, std::size_t) {
+               if (name != "apps") {
+                 return;
+               }
+               apps_valid = for_each_member(
+                   pos, [&sections, text](std::string_view app,
+                                          std::size_t begin, std::size_t end) {
+                     if (text[begin] == '{') {
+                       sections.emplace_back(std::string{app}, begin,
+                                             end - begin);
+                     }
+                   });
+             }) &&
+         apps_valid;
+}
+
+/// Get the path to a sidecar file of the settings file.
+///
+/// @param [in] path
+///    Path to the settings file.
+/// @param ext
+///    Extension of the sidecar file, appended to the settings file name.
+/// @return Path to the sidecar file.
+static std::filesystem::path sidecar_path(const std::filesystem::path &path,
+                                          std::string_view ext) {
+  auto result{path};
+  result += ext;
+  return result;
+}
+
+/// Replace a file with another one atomically, deleting the source on
+///    failure.
+///
+/// @param [in] from
+///    Path to the file that replaces @p to.
+/// @param [in] to
+///    Path to the file to replace.
+/// @return Value indicating whether the file has been replaced.
+static bool replace_file(const std::filesystem::path &from,
+                         const std::filesystem::path &to) {
+#ifdef _WIN32
+  if (MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+    return true;
+  }
+#else  // def _WIN32
+  if (::rename(from.c_str(), to.c_str()) == 0) {
+    return true;
+  }
+#endif // def _WIN32 else
+  std::error_code ec;
+  std::filesystem::remove(from, ec);
+  return false;
+}
+
+/// Read the sidecar index file, if it's up to date.
+///
+/// @param [in] path
+///    Path to the settings file.
+/// @param file_size
+///    Current size of the settings file, in bytes.
+/// @param write_time
+///    Current last write time of the settings file.
+/// @param [out] sections
+///    List that receives section locations.
+/// @return Value indicating whether a valid and up-to-date index has been
+///    read.
+static bool read_index(const std::filesystem::path &path,
+                       std::uint64_t file_size, std::uint64_t write_time,
+                       std::vector<section_desc> &sections) {
+  os_file file;
+  if (!file.open_read(sidecar_path(path, ".idx"))) {
+    return false;
+  }
+  std::uint64_t size;
+  std::uint64_t time;
+  if (!file.get_info(size, time) || size < sizeof(index_header) ||
+      size > 16 * 1024 * 1024) {
+    return false;
+  }
+  std::string buf(size, '\0');
+  if (!file.read_at(0, buf)) {
+    return false;
+  }
+  index_header hdr;
+  std::ranges::copy_n(buf.cbegin(), sizeof hdr, reinterpret_cast<char *>(&hdr));
+  if (hdr.magic != index_magic || hdr.file_size != file_size ||
+      hdr.write_time != write_time) {
+    return false;
+  }
+  std::string_view rem{buf};
+  rem.remove_prefix(sizeof hdr);
+  sections.reserve(hdr.num_entries);
+  for (std::uint32_t i{}; i < hdr.num_entries; ++i) {
+    index_entry entry;
+    if (rem.size() < sizeof entry) {
+      return false;
+    }
+    std::ranges::copy_n(rem.cbegin(), sizeof entry,
+                        reinterpret_cast<char *>(&entry));
+    rem.remove_prefix(sizeof entry);
+    if (rem.size() < entry.name_size ||
+        entry.offset + entry.size > file_size) {
+      return false;
+    }
+    sections.emplace_back(std::string{rem.substr(0, entry.name_size)},
+                          entry.offset, entry.size);
+    rem.remove_prefix(entry.name_size);
+  }
+  return true;
+}
+
+/// Write the sidecar index file. Failures are ignored, as the index is only
+///    an optimization. Must be called with the settings lock file locked.
+///
+/// @param [in] path
+///    Path to the settings file.
+/// @param file_size
+///    Size of the settings file that the index was built for, in bytes.
+/// @param write_time
+///    Last write time of the settings file that the index was built for.
+/// @param [in] sections
+///    Section locations to write.
+static void write_index(const std::filesystem::path &path,
+                        std::uint64_t file_size, std::uint64_t write_time,
+                        std::span<const section_desc> sections) {
+  std::string buf;
+  const auto append{[&buf](const void *_Nonnull data, std::size_t size) {
+    buf.append(static_cast<const char *>(data), size);
+  }};
+  const index_header hdr{.magic = index_magic,
+                         .num_entries =
+                             static_cast<std::uint32_t>(sections.size()),
+                         .file_size = file_size,
+                         .write_time = write_time};
+  append(&hdr, sizeof hdr);
+  for (const auto &section : sections) {
+    const index_entry entry{
+        .offset = section.offset,
+        .size = section.size,
+        .name_size = static_cast<std::uint32_t>(section.name.size()),
+        .reserved = 0};
+    append(&entry, sizeof entry);
+    buf.append(section.name);
+  }
+  // Write to a temporary file first so readers never see a truncated index
+  const auto idx_path{sidecar_path(path, ".idx")};
+  const auto tmp{tmp_path(idx_path)};
+  os_file file;
+  if (!file.create(tmp)) {
+    return;
+  }
+  const bool written{file.write(buf)};
+  file.close();
+  if (written) {
+    replace_file(tmp, idx_path);
+  } else {
+    std::error_code ec;
+    std::filesystem::remove(tmp, ec);
+  }
+}
+
+//===-- Internal functions ------------------------------------------------===//
+
+bool read_section(const std::filesystem::path &path, std::string_view name,
+                  std::string &buf) {
+  os_file file;
+  if (!file.open_read(path)) {
+    return false;
+  }
+  std::uint64_t file_size;
+  std::uint64_t write_time;
+  if (!file.get_info(file_size, write_time)) {
+    return false;
+  }
+  std::vector<section_desc> sections;
+  if (read_index(path, file_size, write_time, sections)) {
+    const auto it{std::ranges::find(sections, name, &section_desc::name)};
+    if (it == sections.end()) {
+      return false;
+    }
+    buf.resize(it->size);
+    if (file.read_at(it->offset, buf) && buf.starts_with('{')) {
+      index_hits.add();
+      return true;
+    }
+    sections.clear();
+  }
+  std::string text(file_size, '\0');
+  if (!file.read_at(0, text) || !scan_sections(text, sections)) {
+    return false;
+  }
+  file.close();
+  index_rebuilds.add();
+  if (os_file lock; lock.lock(sidecar_path(path, ".lock"))) {
+    // A writer may have replaced the file since it was read, in which case
+    //    it has written the index for the new version already
+    os_file cur;
+    std::uint64_t cur_size;
+    std::uint64_t cur_time;
+    if (cur.open_read(path) && cur.get_info(cur_size, cur_time) &&
+        cur_size == file_size && cur_time == write_time) {
+      write_index(path, file_size, write_time, sections);
+    }
+  }
+  const auto it{std::ranges::find(sections, name, &section_desc::name)};
+  if (it == sections.end()) {
+    return false;
+  }
+  buf.assign(text, it->offset, it->size);
+  return true;
+}
+
+bool write_section(const std::filesystem::path &path, std::string_view name,
+                   std::string_view section) {
+  // Hold the lock for the whole read-modify-write cycle, so concurrent
+  //    writers of other sections don't lose each other's changes
+  os_file lock;
+  if (!lock.lock(sidecar_path(path, ".lock"))) {
+    return false;
+  }
+  std::string text;
+  std::vector<section_desc> sections;
+  {
+    os_file file;
+    std::uint64_t file_size;
+    std::uint64_t write_time;
+    // The file may have been edited since it was loaded, so sections are
+    //    located again
+    if (!file.open_read(path) || !file.get_info(file_size, write_time)) {
+      return false;
+    }
+    text.resize(file_size);
+    if (!file.read_at(0, text) || !scan_sections(text, sections)) {
+      return false;
+    }
+  }
+  const auto it{std::ranges::find(sections, name, &section_desc::name)};
+  if (it == sections.end()) {
+    return false;
+  }
+  text.replace(it->offset, it->size, section);
+  const auto tmp{tmp_path(path)};
+  {
+    os_file file;
+    if (!file.create(tmp)) {
+      return false;
+    }
+    if (!file.write(text)) {
+      file.close();
+      std::error_code ec;
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+  }
+  if (!replace_file(tmp, path)) {
+    return false;
+  }
+  // Offsets of sections following the replaced one have changed
+  const auto delta{static_cast<std::int64_t>(section.size()) -
+                   static_cast<std::int64_t>(it->size)};
+  it->size = section.size();
+  for (auto &next : std::ranges::subrange{it + 1, sections.end()}) {
+    next.offset += delta;
+  }
+  os_file file;
+  std::uint64_t file_size;
+  std::uint64_t write_time;
+  if (file.open_read(path) && file.get_info(file_size, write_time)) {
+    write_index(path, file_size, write_time, sections);
+  }
+  return true;
+}
+
+std::filesystem::path tmp_path(const std::filesystem::path &path) {
+#ifdef _WIN32
+  const auto pid{GetCurrentProcessId()};
+#else  // def _WIN32
+  const auto pid{getpid()};
+#endif // def _WIN32 else
+  return sidecar_path(
+      path, std::format(".{}-{}.tmp", pid,
+                        next_tmp.fetch_add(1, std::memory_order::relaxed)));
+}
+
+} // namespace tek::game_runtime::settings_index
@@ -0,0 +1,69 @@
+//===-- settings_index.hpp - multi-app settings file sections -------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for multi-app settings files, in which the members of the
+///    top-level `apps` object, called sections, hold settings of different
+///    games. Section locations are cached in a sidecar `.idx` file, so a
+///    process only reads and parses its own section. Writers serialize on a
+///    sidecar `.lock` file, so concurrent processes don't lose each other's
+///    changes.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace tek::game_runtime::settings_index {
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Read the object of a section from a multi-app settings file. The section
+///    is located via the sidecar index, which is rebuilt by scanning the file
+///    if it's missing or out of date.
+///
+/// @param [in] path
+///    Path to the settings file.
+/// @param name
+///    Name of the section.
+/// @param [out] buf
+///    String that receives the section's JSON object.
+/// @return Value indicating whether the section has been read.
+[[gnu::visibility("internal")]]
+bool read_section(const std::filesystem::path &path, std::string_view name,
+                  std::string &buf);
+
+/// Replace the object of a section in a multi-app settings file, and update
+///    the sidecar index. The file is replaced atomically, so readers see
+///    either the old or the new version.
+///
+/// @param [in] path
+///    Path to the settings file.
+/// @param name
+///    Name of the section.
+/// @param section
+///    New JSON object of the section.
+/// @return Value indicating whether the section has been written.
+[[gnu::visibility("internal")]]
+bool write_section(const std::filesystem::path &path, std::string_view name,
+                   std::string_view section);
+
+/// Get a path for a temporary file next to specified file, that is unique
+///    across processes and threads.
+///
+/// @param [in] path
+///    Path to the file.
+/// @return Path for the temporary file.
+[[gnu::visibility("internal")]]
+std::filesystem::path tmp_path(const std::filesystem::path &path);
+
+} // namespace tek::game_runtime::settings_index
@@ -0,0 +1,302 @@
+//===-- shared_cache.cpp - cross-process cache implementation -------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of the cross-process cache. Windows builds use a paging
+///    file-backed named file mapping, other platforms use POSIX shared memory.
+///
+//===----------------------------------------------------------------------===//
+#include "shared_cache.hpp"
+
+#ifdef _WIN32
+#include "common.hpp" // IWYU pragma: keep
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <span>
+
+namespace tek::game_runtime::shared_cache {
+
+namespace {
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Magic value identifying the cache layout. Must be changed along with any
+///    change to @ref header or @ref slot.
+constexpr std::uint32_t magic{0x31434754}; // "TGC1"
+/// Number of record slots in the cache.
+constexpr std::size_t num_slots{1024};
+/// Number of consecutive slots that may hold a record with given hash.
+constexpr std::size_t probe_len{8};
+/// Maximum number of attempts to read a record that is being written.
+constexpr int max_read_attempts{4};
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Header of the shared memory region.
+struct header {
+  /// Layout magic value, set by the instance that creates the region.
+  std::atomic_uint32_t magic;
+  std::uint32_t reserved;
+};
+
+/// Record slot. Its fields other than @ref seq are only read via
+///    @ref read_slot, which validates them against concurrent writes.
+struct slot {
+  /// Sequence counter. It's odd while the slot is being written.
+  std::atomic_uint32_t seq;
+  /// Size of record data, in bytes.
+  std::uint32_t size;
+  /// Type of the record, or `0` if the slot is empty.
+  record_type type;
+  std::uint32_t reserved;
+  /// Key of the record.
+  std::uint64_t key;
+  /// Time at which the record has been written, in seconds since Unix epoch.
+  std::int64_t time;
+  /// Record data.
+  std::array<std::byte, max_record_size> data;
+};
+static_assert(sizeof(slot) == 1024);
+static_assert(std::atomic_uint32_t::is_always_lock_free,
+              "Shared memory atomics must be lock-free");
+
+/// Layout of the shared memory region.
+struct region {
+  header hdr;
+  std::array<slot, num_slots> slots;
+};
+
+/// Consistent copy of slot metadata.
+struct slot_meta {
+  record_type type;
+  std::uint32_t size;
+  std::uint64_t key;
+  std::int64_t time;
+};
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Pointer to the mapped shared memory region.
+static region *shared;
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Get current time in seconds since Unix epoch.
+///
+/// @return Current time in seconds since Unix epoch.
+static std::int64_t now() noexcept {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Get index of the first slot to probe for a record.
+///
+/// @param type
+///    Type of the record.
+/// @param key
+///    Key of the record.
+/// @return Index of the first slot to probe.
+static constexpr std::size_t first_slot(record_type type,
+                                        std::uint64_t key) noexcept {
+  // Mix the type into the key with the 64-bit golden ratio multiplier so that
+  //    small keys of different types don't collide
+  return ((key + static_cast<std::uint64_t>(type)) * 0x9E3779B97F4A7C15 >>
+          32) %
+         num_slots;
+}
+
+/// Read slot metadata and optionally data, validating them against concurrent
+///    writes.
+///
+/// @param s
+///    The slot to read.
+/// @param [out] meta
+///    Variable that receives slot metadata.
+/// @param buf
+///    Buffer that receives record data, if it's not empty. Data is copied only
+///    if it fits.
+/// @return Value indicating whether a consistent copy has been obtained.
+static bool read_slot(const slot &s, slot_meta &meta,
+                      std::span<std::byte> buf) noexcept {
+  for (int i{}; i < max_read_attempts; ++i) {
+    const auto seq{s.seq.load(std::memory_order::acquire)};
+    if (seq & 1) {
+      continue;
+    }
+    meta = {.type = s.type, .size = s.size, .key = s.key, .time = s.time};
+    if (!buf.empty() && meta.size <= buf.size() &&
+        meta.size <= max_record_size) {
+      std::memcpy(buf.data(), s.data.data(), meta.size);
+    }
+    std::atomic_thread_fence(std::memory_order::acquire);
+    if (s.seq.load(std::memory_order::relaxed) == seq) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Map the shared memory region.
+///
+/// @param app_id
+///    Application ID of the game.
+/// @return Pointer to the mapped region, or `nullptr` on failure.
+static void *map_region(std::uint32_t app_id) {
+#ifdef _WIN32
+  const auto name{std::format(L"tek-game-runtime-cache-{}", app_id)};
+  const auto mapping{CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr,
+                                        PAGE_READWRITE, 0, sizeof(region),
+                                        name.data())};
+  if (!mapping) {
+    return nullptr;
+  }
+  const auto view{
+      MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(region))};
+  // The view keeps the mapping alive
+  CloseHandle(mapping);
+  return view;
+#else  // def _WIN32
+  const auto name{std::format("/tek-game-runtime-cache-{}", app_id)};
+  const auto fd{shm_open(name.data(), O_RDWR | O_CREAT, 0600)};
+  if (fd < 0) {
+    return nullptr;
+  }
+  void *view{};
+  // ftruncate to the same size is a no-op for instances that didn't create
+  //    the object, and zero-fills it for the one that did
+  if (!ftruncate(fd, sizeof(region))) {
+    view = mmap(nullptr, sizeof(region), PROT_READ | PROT_WRITE, MAP_SHARED,
+                fd, 0);
+    if (view == MAP_FAILED) {
+      view = nullptr;
+    }
+  }
+  close(fd);
+  return view;
+#endif // def _WIN32 else
+}
+
+} // namespace
+
+//===-- Internal functions ------------------------------------------------===//
+
+void open(std::uint32_t app_id) {
+  if (opened) {
+    return;
+  }
+  const auto view{map_region(app_id)};
+  if (!view) {
+    return;
+  }
+  // Freshly created regions are zero-filled, which is a valid empty table, so
+  //    the first instance only has to claim the magic value
+  auto &region_ref{*reinterpret_cast<region *>(view)};
+  auto expected{std::uint32_t{}};
+  if (!region_ref.hdr.magic.compare_exchange_strong(
+          expected, magic, std::memory_order::relaxed) &&
+      expected != magic) {
+    // Region was created by an incompatible runtime version
+#ifdef _WIN32
+    UnmapViewOfFile(view);
+#else
+    munmap(view, sizeof(region));
+#endif
+    return;
+  }
+  shared = &region_ref;
+  opened = true;
+}
+
+bool get(record_type type, std::uint64_t key, std::chrono::seconds max_age,
+         std::span<std::byte> buf, std::size_t &size) {
+  if (!opened) {
+    return false;
+  }
+  const auto min_time{now() - max_age.count()};
+  const auto first{first_slot(type, key)};
+  for (std::size_t i{}; i < probe_len; ++i) {
+    const auto &s{shared->slots[(first + i) % num_slots]};
+    slot_meta meta;
+    if (!read_slot(s, meta, buf)) {
+      continue;
+    }
+    if (meta.type != type || meta.key != key) {
+      continue;
+    }
+    if (meta.time < min_time || meta.size > buf.size()) {
+      return false;
+    }
+    size = meta.size;
+    return true;
+  }
+  return false;
+}
+
+void put(record_type type, std::uint64_t key, std::span<const std::byte> data) {
+  if (!opened || data.size() > max_record_size) {
+    return;
+  }
+  // Pick the slot holding the same record, or the first empty one, or the
+  //    oldest one
+  const auto first{first_slot(type, key)};
+  slot *target{};
+  std::int64_t oldest_time{INT64_MAX};
+  for (std::size_t i{}; i < probe_len; ++i) {
+    auto &s{shared->slots[(first + i) % num_slots]};
+    slot_meta meta;
+    if (!read_slot(s, meta, {})) {
+      continue;
+    }
+    if (meta.type == type && meta.key == key) {
+      target = &s;
+      break;
+    }
+    if (meta.type == record_type{}) {
+      if (oldest_time > INT64_MIN) {
+        target = &s;
+        oldest_time = INT64_MIN;
+      }
+    } else if (meta.time < oldest_time) {
+      target = &s;
+      oldest_time = meta.time;
+    }
+  }
+  if (!target) {
+    return;
+  }
+  auto &s{*target};
+  auto seq{s.seq.load(std::memory_order::relaxed)};
+  if (seq & 1 || !s.seq.compare_exchange_strong(seq, seq + 1,
+                                                std::memory_order::acquire)) {
+    // Another instance is writing this slot, skip rather than wait
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order::release);
+  s.type = type;
+  s.size = data.size();
+  s.key = key;
+  s.time = now();
+  std::memcpy(s.data.data(), data.data(), data.size());
+  s.seq.store(seq + 2, std::memory_order::release);
+}
+
+} // namespace tek::game_runtime::shared_cache
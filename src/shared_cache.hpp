@@ -0,0 +1,108 @@
+//===-- shared_cache.hpp - cross-process cache interface ------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for the cache shared between all runtime instances of the same
+///    game on the machine. It lives in named shared memory as a fixed-size
+///    open-addressed table of records, each protected by its own seqlock, so
+///    readers never block and writers only contend for individual records.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace tek::game_runtime::shared_cache {
+
+/// Types of cached records.
+enum class record_type : std::uint32_t {
+  /// List of DLC app IDs of the game, as `std::uint32_t` values. Key is the
+  ///    game's app ID.
+  dlc_ids = 1,
+  /// DLC name in UTF-8, empty if the DLC has no name. Key is the DLC app ID.
+  dlc_name,
+  /// Steam Workshop directory index: `std::int64_t` last write time of the
+  ///    directory followed by item IDs as `std::uint64_t` values. Key is
+  ///    @ref hash_key of the directory path.
+  ws_index,
+  /// Server rules verdict, a single byte that is non-zero if the server has
+  ///    been rejected. Key is @ref hash_key of a `server_snapshot::server_key`
+  ///    value followed by a value encoding filtering settings.
+  rules_verdict,
+  /// Outcome of the last connection to a Steam CM server, a single byte that
+  ///    is non-zero if the connection has failed. Key is always 0.
+  cm_connect
+};
+
+/// Maximum size of record data, in bytes.
+constexpr std::size_t max_record_size = 992;
+
+/// Value indicating whether the cache is available.
+inline bool opened;
+
+/// Open the cache for specified game, creating it if this is the first
+///    instance. Sets @ref opened on success.
+///
+/// @param app_id
+///    Application ID of the game.
+[[gnu::visibility("internal")]]
+void open(std::uint32_t app_id);
+
+/// Get a record from the cache.
+///
+/// @param type
+///    Type of the record.
+/// @param key
+///    Key of the record.
+/// @param max_age
+///    Maximum age of the record. Older records are treated as missing.
+/// @param buf
+///    Buffer that receives record data.
+/// @param [out] size
+///    Variable that receives the size of record data.
+/// @return Value indicating whether the record has been found and fit into
+///    @p buf.
+[[gnu::visibility("internal")]]
+bool get(record_type type, std::uint64_t key, std::chrono::seconds max_age,
+         std::span<std::byte> buf, std::size_t &size);
+
+/// Put a record into the cache, replacing the existing one with the same type
+///    and key, or evicting the oldest one if there is no space. Does nothing
+///    if the cache is not opened, @p data is larger than
+///    @ref max_record_size, or the record is being written by another
+///    instance at the moment.
+///
+/// @param type
+///    Type of the record.
+/// @param key
+///    Key of the record.
+/// @param data
+///    Record data.
+[[gnu::visibility("internal")]]
+void put(record_type type, std::uint64_t key, std::span<const std::byte> data);
+
+/// Compute a record key for a string.
+///
+/// @param str
+///    The string to hash.
+/// @return FNV-1a hash of @p str.
+constexpr std::uint64_t hash_key(std::string_view str) noexcept {
+  std::uint64_t hash{0xCBF29CE484222325};
+  for (const auto c : str) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3;
+  }
+  return hash;
+}
+
+} // namespace tek::game_runtime::shared_cache
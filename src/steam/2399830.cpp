@@ -15,6 +15,8 @@
 #include "game_cbs.hpp"
 
 #include "common.hpp"
+#include "log.hpp"
+#include "memory.hpp"
 #include "steam_api.hpp"
 
 #include <algorithm>
@@ -23,6 +25,7 @@
 #include <cstdint>
 #include <dbghelp.h>
 #include <format>
+#include <memory_resource>
 #include <rapidjson/document.h>
 #include <rapidjson/filewritestream.h>
 #include <rapidjson/writer.h>
@@ -226,6 +229,14 @@ static void *_Nonnull eos_auth_iface;
 
 //===-- EOS SDK function wrappers -----------------------------------------===//
 
+/// Get allocator for @ref login_ctx objects and copies of
+///    `EOS_Connect_ExternalAccountInfo`.
+///
+/// @return Allocator using EOS subsystem's memory resource.
+static std::pmr::polymorphic_allocator<> eos_alloc() {
+  return &memory::resource(memory::subsystem::eos);
+}
+
 /// Pointer to the original `EOS_Auth_CopyIdToken_t` function.
 static EOS_Auth_CopyIdToken_t *_Nullable EOS_Auth_CopyIdToken_orig;
 /// Pointer to the original `EOS_Auth_IdToken_Release` function.
@@ -250,7 +261,8 @@ EOS_Connect_CopyProductUserInfo(void *_Nonnull handle,
   if (!res) {
     auto &info = **external_account_info;
     if (info.account_id_type != EOS_EExternalAccountType::steam) {
-      const auto copy{new EOS_Connect_ExternalAccountInfo{info}};
+      const auto copy{eos_alloc().new_object<
+          EOS_Connect_ExternalAccountInfo>(info)};
       copy->magic = EOS_Connect_ExternalAccountInfo::tgr_magic;
       copy->account_id = steam_id_str.data();
       copy->account_id_type = EOS_EExternalAccountType::steam;
@@ -271,7 +283,7 @@ static void EOS_Connect_ExternalAccountInfo_Release(
   if (info && info->magic == EOS_Connect_ExternalAccountInfo::tgr_magic) {
     const auto copy{info};
     info = info->orig;
-    delete copy;
+    eos_alloc().delete_object(copy);
   }
   EOS_Connect_ExternalAccountInfo_Release_orig(info);
 }
@@ -284,7 +296,7 @@ connect_login_complete(const EOS_Connect_LoginCallbackInfo *_Nonnull data) {
   EOS_Connect_LoginCallbackInfo data_copy{*data};
   data_copy.client_data = ctx.client_data;
   ctx.completion_delegate(&data_copy);
-  delete &ctx;
+  eos_alloc().delete_object(&ctx);
 }
 
 /// Completion handler for `EOS_Auth_Login`.
@@ -324,7 +336,7 @@ auth_login_complete(const EOS_Auth_LoginCallbackInfo *_Nonnull data) {
   } else {
     EOS_Connect_Login_orig(ctx.handle, ctx.options, ctx.client_data,
                            ctx.completion_delegate);
-    delete &ctx;
+    eos_alloc().delete_object(&ctx);
   }
 }
 
@@ -336,7 +348,7 @@ EOS_Connect_Login(void *_Nonnull handle,
                   void *_Nullable client_data,
                   EOS_Connect_OnLoginCallback *_Nonnull completion_delegate) {
   if (force_egs_auth || g_settings.steam->spoof_app_id != 2399830) {
-    const auto ctx{new login_ctx{
+    const auto ctx{eos_alloc().new_object<login_ctx>(login_ctx{
         .handle = handle,
         .options = options,
         .client_data = client_data,
@@ -348,7 +360,7 @@ EOS_Connect_Login(void *_Nonnull handle,
                     .type = EOS_ELoginCredentialType::persistent_auth,
                     .system_auth_credentials_options = nullptr,
                     .external_type = EOS_EExternalCredentialType::epic},
-        .connect_creds{*options->credentials}}};
+        .connect_creds{*options->credentials}})};
     const EOS_Auth_LoginOptions login_options{.api_version = 3,
                                               .credentials = &ctx->auth_creds,
                                               .scope_flags =
@@ -426,10 +438,9 @@ bool dllmain_2399830() {
   if (!cf_api_wrapper.empty()) {
     constexpr std::wstring_view cf_api_domain{L"api.curseforge.com"};
     if (cf_api_wrapper.length() > cf_api_domain.length()) {
-      display_error(std::format(L"The length of cf_api_wrapper string cannot "
-                                L"exceed the number of characters in \"{}\"",
-                                cf_api_domain)
-                        .data());
+      log::error("The length of cf_api_wrapper string cannot exceed the number "
+                 "of characters in \"api.curseforge.com\", it will be "
+                 "truncated");
     }
     const auto hdr{ImageNtHeader(module)};
     const std::span sections{
@@ -463,17 +474,16 @@ bool dllmain_2399830() {
     const auto str{
         reinterpret_cast<LPWSTR>(&module[rdata->VirtualAddress + idx])};
     DWORD prev_protect;
-    if (!VirtualProtect(str, cf_api_domain_raw_size, PAGE_READWRITE,
-                        &prev_protect)) {
-      display_error(
-          std::format(L"Unable to apply CF API wrapper: VirtualProtect call "
-                      L"failed with error code {}",
-                      GetLastError())
-              .data());
+    if (VirtualProtect(str, cf_api_domain_raw_size, PAGE_READWRITE,
+                       &prev_protect)) {
+      MultiByteToWideChar(CP_UTF8, 0, cf_api_wrapper.data(), -1, str,
+                          cf_api_domain.length() + 1);
+      VirtualProtect(str, cf_api_domain_raw_size, prev_protect, &prev_protect);
+    } else {
+      log::error("Unable to apply CF API wrapper: VirtualProtect call failed "
+                 "with error code {}",
+                 GetLastError());
     }
-    MultiByteToWideChar(CP_UTF8, 0, cf_api_wrapper.data(), -1, str,
-                        cf_api_domain.length() + 1);
-    VirtualProtect(str, cf_api_domain_raw_size, prev_protect, &prev_protect);
   } // if (!cf_api_wrapper.empty())
   ULONG dir_size;
   // Locate delay load descriptor for EOSSDK-Win64-Shipping.dll
@@ -14,30 +14,52 @@
 //===----------------------------------------------------------------------===//
 #include "game_cbs.hpp"
 
+#include "a2s.hpp"
 #include "common.hpp" // IWYU pragma: keep
+#include "jobs.hpp"
+#include "log.hpp"
+#include "memory.hpp"
+#include "metrics.hpp"
+#include "mod_prefetch.hpp"
+#include "server_snapshot.hpp"
+#include "shared_cache.hpp"
 #include "steam_api.hpp"
 #include "tek-steamclient.hpp"
+#include "utf.hpp"
+#include "ws_jobs.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <charconv>
+#include <chrono>
+#include <cctype>
 #include <cstddef>
 #include <cstdint>
 #include <cwchar>
+#include <deque>
 #include <filesystem>
 #include <format>
+#include <functional>
+#include <iterator>
 #include <locale>
+#include <map>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <ranges>
 #include <rapidjson/document.h>
 #include <rapidjson/filewritestream.h>
 #include <rapidjson/writer.h>
+#include <span>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <tek-steamclient/am.h>
 #include <tek-steamclient/cm.h>
+#include <tek-steamclient/error.h>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tek::game_runtime {
@@ -48,19 +70,54 @@ namespace {
 
 /// Value indicating whether BattlEye-protected servers are allowed to appear in
 ///    search results.
-static bool show_be_servers;
+static std::atomic_bool show_be_servers;
 /// Value indicating whether servers that the user cannot join are allowed to
 ///    appear in search results. For users with effective app ID 346110,
 ///    unavailable servers are servers that have a DLC map that user doesn't own
 ///    *and* don't have TEK Wrapper. For users with effective app ID different
 ///    from 346110, unavailable servers are all servers that don't have TEK
 ///    Wrapper.
-static bool show_unavailable_servers;
+static std::atomic_bool show_unavailable_servers;
 /// Path to the base directory for Steam Workshop items for the game.
 static std::string ws_dir_path;
 /// Path to the game root directory that will be used to initialize application
 ///    manager instance for Steam Workshop items.
 static std::string ws_am_path;
+/// @ref ws_dir_path converted to UTF-16 once at settings load.
+static std::wstring ws_dir_wpath;
+/// @ref ws_am_path converted to UTF-16 once at settings load.
+static std::wstring ws_am_wpath;
+/// @ref ws_dir_path with a trailing path separator, which item directory paths
+///    are formed from.
+static std::string ws_item_path_prefix;
+/// Value indicating whether server rules should be queried by the built-in A2S
+///    client instead of Steam's rate-limited server query implementation.
+static bool a2s_server_rules;
+/// Path to the server list snapshot file. If empty, server list snapshot is
+///    not used.
+static std::string server_snapshot_path;
+/// Value indicating whether internet server list and server rules should be
+///    requested in background at startup, using filters from the snapshot.
+static bool prefetch_server_list;
+/// Value indicating whether files of installed mods should be read into the
+///    OS page cache in background at startup.
+static bool prefetch_mod_files;
+/// Value indicating whether installed mods should be checked for updates in
+///    background at startup, with outdated ones downloaded.
+static bool update_mod_files;
+/// Value indicating whether favorite and history servers should be pinged in
+///    background, so the game's requests for those lists are answered at once.
+static bool probe_favorite_servers;
+/// Named mod profiles, each being a list of Steam Workshop item IDs in the
+///    order the game loads them.
+static std::map<std::string, std::vector<std::uint64_t>, std::less<>>
+    mod_profiles;
+/// Name of the mod profile whose items are exposed to the game as subscribed.
+///    If empty, all installed mods are exposed.
+static std::string mod_profile;
+/// Value indicating whether mods that the game requests when joining a server
+///    should be added to the active mod profile.
+static bool auto_mod_profile;
 
 //===-- Internal variables ------------------------------------------------===//
 
@@ -68,41 +125,589 @@ static std::string ws_am_path;
 static std::vector<std::string> unavailable_dlc;
 /// List of installed/"subscribed" Steam Workshop item IDs.
 static std::vector<std::uint64_t> mods;
-/// Mutex for locking concurrent access to @ref mods.
+/// Mutex for locking concurrent access to @ref mods and @ref active_profile.
 static std::mutex mods_mtx;
+/// Pointer to the item list of the active mod profile in @ref mod_profiles, or
+///    `nullptr` if there is no active profile.
+static std::vector<std::uint64_t> *_Nullable active_profile;
 /// Pointers to active Steam Workshop item job descriptors.
 static std::unordered_map<std::uint64_t, tek_sc_am_item_desc *> ws_descs;
-/// Mutex for locking concurrent access to @ref ws_descs.
+/// Pointers to job descriptors of background updates of items that are in
+///    @ref mods, or `nullptr` for updates whose jobs are being created.
+static std::unordered_map<std::uint64_t, tek_sc_am_item_desc *> ws_updates;
+/// Mutex for locking concurrent access to @ref ws_descs and @ref ws_updates.
 static std::mutex ws_descs_mtx;
+/// Value indicating whether the built-in A2S client has been started for
+///    server rules queries.
+static bool a2s_running;
+/// @ref server_snapshot_path converted to UTF-16.
+static std::wstring server_snapshot_wpath;
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Server index value from which indices of servers replayed from the
+///    snapshot start. It's chosen to not intersect with indices of servers
+///    returned by Steam.
+constexpr int snapshot_idx_base = 0x1000000;
+/// The lowest value of server query handles for rules queries answered from
+///    prefetched rules. It's chosen to not intersect with handles returned by
+///    Steam or by the built-in A2S client.
+constexpr int cached_query_base = 0x30000000;
+/// Period of time after the prefetch during which prefetched rules are used
+///    to answer server rules queries.
+constexpr std::chrono::minutes prefetched_rules_ttl{5};
+/// Period of time after which the startup server list request is released if
+///    no game request has attached to it.
+constexpr std::chrono::minutes prefetch_attach_timeout{5};
+/// Maximum number of servers whose rules are prefetched. Servers that respond
+///    first are taken, most of the list is never looked at before the game
+///    refreshes it anyway.
+constexpr int max_prefetched_rules{256};
+/// Maximum age of server rules verdicts from the cross-process cache that are
+///    used to reject servers without querying them.
+constexpr std::chrono::minutes shared_verdict_ttl{5};
+/// Maximum age of Steam Workshop directory index in the cross-process cache.
+///    The index is also validated against directory's last write time.
+constexpr std::chrono::hours ws_index_ttl{24};
+/// Minimum period of time between probes of the same favorite or history
+///    server.
+constexpr std::chrono::minutes probe_interval{1};
+/// Minimum period of time between starting two consecutive probes.
+constexpr std::chrono::milliseconds probe_spacing{250};
+/// Maximum number of probes in flight.
+constexpr int max_probes_in_flight{4};
+/// Period of time after which the list of favorite and history servers is
+///    re-read from Steam.
+constexpr std::chrono::minutes favorites_refresh_interval{1};
+/// `k_unFavoriteFlagFavorite` flag of favorite game entries.
+constexpr std::uint32_t favorite_flag_favorite{1};
+/// `k_unFavoriteFlagHistory` flag of favorite game entries.
+constexpr std::uint32_t favorite_flag_history{2};
+/// `EItemState` flag indicating that the item is subscribed.
+constexpr std::uint32_t item_state_subscribed{1};
+/// `EItemState` flag indicating that the item is installed.
+constexpr std::uint32_t item_state_installed{4};
+/// `EItemState` flag indicating that the item needs an update.
+constexpr std::uint32_t item_state_needs_update{8};
+/// `EItemState` flag indicating that the item is being downloaded.
+constexpr std::uint32_t item_state_downloading{16};
+/// `EItemState` flag indicating that the item is queued for download.
+constexpr std::uint32_t item_state_download_pending{32};
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Server rules query answered from prefetched rules, that is waiting to be
+///    delivered.
+struct cached_rules_query {
+  /// Server query handle.
+  int query;
+  /// Key identifying the server in @ref prefetched_rules.
+  std::uint64_t server_key;
+  /// Pointer to game's response handler.
+  steam_api::ISteamMatchmakingRulesResponse *_Nonnull handler;
+  /// Value indicating whether the server is known to be rejected from the
+  ///    cross-process cache, in which case the query fails instead.
+  bool rejected;
+};
+
+//===-- Prefetch variables ------------------------------------------------===//
+
+/// Rules received by prefetch queries, keyed by `server_snapshot::server_key`
+///    values.
+static std::unordered_map<std::uint64_t, std::vector<a2s::rule>>
+    prefetched_rules;
+/// Time point at which the prefetch has been started.
+static std::chrono::steady_clock::time_point prefetch_time;
+/// Server rules queries answered from @ref prefetched_rules, that will be
+///    delivered on next SteamAPI_RunCallbacks call, ordered by handle.
+static std::deque<cached_rules_query> cached_rules_queries;
+/// Handle value for the next query in @ref cached_rules_queries.
+static int next_cached_query{cached_query_base};
+
+//===-- Favorite server probing -------------------------------------------===//
+
+/// Favorite or history server tracked by the background prober.
+struct probed_server {
+  /// Server details received by the last successful probe or live query.
+  steam_api::gameserveritem_t details;
+  /// Time point at which the last probe has completed.
+  std::chrono::steady_clock::time_point probe_time;
+  /// Favorite flags of the server's entries.
+  std::uint32_t flags;
+  /// Value indicating whether the server has responded to the last probe.
+  bool available;
+  /// Value indicating whether a probe of the server is in flight.
+  bool pending;
+};
+
+/// Favorite and history servers, keyed by `server_snapshot::server_key`
+///    values. Only accessed on game thread.
+static std::unordered_map<std::uint64_t, probed_server> probed_servers;
+/// Time point at which the last probe has been started.
+static std::chrono::steady_clock::time_point last_probe_time;
+/// Time point at which @ref probed_servers has been last synchronized with
+///    Steam's favorite list.
+static std::chrono::steady_clock::time_point favorites_time;
+/// Number of probes in flight.
+static int probes_in_flight;
+/// Number of probes started.
+static metrics::counter probes_started{"346110.server_probe.started"};
+/// Number of probes that servers didn't respond to.
+static metrics::counter probes_failed{"346110.server_probe.failed"};
+
+/// Pointer to the original ISteamMatchmaking::GetFavoriteGameCount method.
+static steam_api::ISteamMatchmaking_GetFavoriteGameCount_t
+    *_Nullable SteamMatchmaking_GetFavoriteGameCount_orig;
+/// Pointer to the original ISteamMatchmaking::GetFavoriteGame method.
+static steam_api::ISteamMatchmaking_GetFavoriteGame_t
+    *_Nullable SteamMatchmaking_GetFavoriteGame_orig;
+/// Pointer to the original ISteamMatchmakingServers::PingServer method.
+static steam_api::ISteamMatchmakingServers_PingServer_t
+    *_Nullable SteamMatchmakingServers_PingServer_orig;
+
+/// Copy a string into a fixed-size null-terminated character array,
+///    truncating it if necessary.
+///
+/// @param str
+///    The string to copy.
+/// @param [out] arr
+///    The array to copy the string into.
+template <std::size_t n>
+static void copy_str(std::string_view str, std::array<char, n> &arr) {
+  *std::ranges::copy_n(str.cbegin(), std::min(str.size(), n - 1), arr.begin())
+       .out = '\0';
+}
+
+/// Adapter that delivers results of built-in A2S client's info queries to
+///    game's ISteamMatchmakingPingResponse handler.
+class a2s_ping_wrapper final
+    : public a2s::info_handler,
+      public memory::pooled<memory::subsystem::server_browser> {
+  /// Pointer to the underlying handler instance.
+  steam_api::ISteamMatchmakingPingResponse *const _Nonnull base;
+  /// Address of the server.
+  const steam_api::servernetadr_t adr;
+
+public:
+  constexpr a2s_ping_wrapper(
+      steam_api::ISteamMatchmakingPingResponse *_Nonnull base,
+      const steam_api::servernetadr_t &adr) noexcept
+      : base{base}, adr{adr} {}
+
+  void info_received(const a2s::server_info &info) override {
+    steam_api::gameserveritem_t details{};
+    details.net_adr = adr;
+    if (info.game_port) {
+      details.net_adr.connection_port = info.game_port;
+    }
+    details.ping = info.ping;
+    details.had_successful_response = true;
+    copy_str(info.folder, details.game_dir);
+    copy_str(info.map, details.map);
+    copy_str(info.game, details.game_description);
+    details.app_id = info.game_id ? static_cast<std::uint32_t>(info.game_id &
+                                                               0xFFFFFF)
+                                  : info.app_id;
+    details.players = info.players;
+    details.max_players = info.max_players;
+    details.bot_players = info.bots;
+    details.password = info.password;
+    details.secure = info.vac;
+    int version{};
+    std::from_chars(info.version.data(),
+                    info.version.data() + info.version.size(), version);
+    details.server_version = version;
+    copy_str(info.name, details.server_name);
+    copy_str(info.keywords, details.game_tags);
+    details.steam_id = info.steam_id;
+    base->ServerResponded(details);
+    delete this;
+  }
+  void info_failed() override {
+    base->ServerFailedToRespond();
+    delete this;
+  }
+};
+
+/// Wrapper for ISteamMatchmakingServers::PingServer, making it perform the
+///    query via built-in A2S client if it's enabled.
+static int SteamMatchmakingServers_PingServer(
+    void *_Nonnull iface, std::uint32_t ip, std::uint16_t port,
+    steam_api::ISteamMatchmakingPingResponse *_Nonnull response_handler) {
+  if (a2s_running) {
+    return a2s::query_info(
+        ip, port,
+        *new a2s_ping_wrapper{
+            response_handler,
+            {.connection_port = port, .query_port = port, .ip = ip}});
+  }
+  return SteamMatchmakingServers_PingServer_orig(iface, ip, port,
+                                                 response_handler);
+}
+
+/// Ping response handler for a probe, that records its result in
+///    @ref probed_servers and deletes itself.
+class probe_response final : public steam_api::ISteamMatchmakingPingResponse {
+  /// Key identifying the server in @ref probed_servers.
+  const std::uint64_t key;
+
+  /// Record probe result and delete the handler.
+  ///
+  /// @param [in] details
+  ///    Pointer to details of the server, or `nullptr` if it didn't respond.
+  void finish(const steam_api::gameserveritem_t *_Nullable details) {
+    --probes_in_flight;
+    // The server may have been removed from favorites in the meantime
+    if (const auto it{probed_servers.find(key)}; it != probed_servers.end()) {
+      auto &server{it->second};
+      server.probe_time = std::chrono::steady_clock::now();
+      server.pending = false;
+      server.available = details;
+      if (details) {
+        server.details = *details;
+      }
+    }
+    delete this;
+  }
+
+public:
+  constexpr probe_response(std::uint64_t key) noexcept : key{key} {}
+
+  void ServerResponded(steam_api::gameserveritem_t &server) override {
+    finish(&server);
+  }
+  void ServerFailedToRespond() override {
+    probes_failed.add();
+    finish(nullptr);
+  }
+};
+
+/// Synchronize @ref probed_servers with Steam's list of favorite and history
+///    servers for the game.
+static void load_favorites() {
+  const auto iface{steam_api::ISteamMatchmaking_desc.iface};
+  for (auto &server : probed_servers | std::views::values) {
+    server.flags = 0;
+  }
+  const auto count{SteamMatchmaking_GetFavoriteGameCount_orig(iface)};
+  for (int i{}; i < count; ++i) {
+    std::uint32_t app_id;
+    std::uint32_t ip;
+    std::uint16_t conn_port;
+    std::uint16_t query_port;
+    std::uint32_t flags;
+    std::uint32_t time_last_played;
+    if (!SteamMatchmaking_GetFavoriteGame_orig(iface, i, &app_id, &ip,
+                                               &conn_port, &query_port,
+                                               &flags, &time_last_played) ||
+        (app_id != 346110 && app_id != g_settings.steam->spoof_app_id)) {
+      continue;
+    }
+    auto &server{probed_servers[server_snapshot::server_key(ip, query_port)]};
+    if (!server.flags) {
+      server.details.net_adr = {
+          .connection_port = conn_port, .query_port = query_port, .ip = ip};
+    }
+    server.flags |= flags;
+  }
+  std::erase_if(probed_servers,
+                [](const auto &entry) { return !entry.second.flags; });
+}
+
+/// Start a probe of the server that has gone without one for the longest
+///    time, if it's due and the rate limits allow it.
+static void probe_next_server() {
+  const auto now{std::chrono::steady_clock::now()};
+  if (now - favorites_time >= favorites_refresh_interval) {
+    favorites_time = now;
+    load_favorites();
+  }
+  if (probes_in_flight >= max_probes_in_flight ||
+      now - last_probe_time < probe_spacing) {
+    return;
+  }
+  probed_server *next{};
+  for (auto &server : probed_servers | std::views::values) {
+    if (!server.pending &&
+        (!next || server.probe_time < next->probe_time)) {
+      next = &server;
+    }
+  }
+  if (!next || (next->probe_time.time_since_epoch().count() &&
+                now - next->probe_time < probe_interval)) {
+    return;
+  }
+  const auto &adr{next->details.net_adr};
+  next->pending = true;
+  last_probe_time = now;
+  ++probes_in_flight;
+  probes_started.add();
+  SteamMatchmakingServers_PingServer(
+      steam_api::ISteamMatchmakingServers_desc.iface, adr.ip, adr.query_port,
+      new probe_response{server_snapshot::server_key(adr.ip, adr.query_port)});
+}
+
+/// Update the entry in @ref probed_servers with details received by a live
+///    server list query, if the server is tracked.
+///
+/// @param [in] details
+///    Details of the server.
+static void record_live_details(const steam_api::gameserveritem_t &details) {
+  const auto it{probed_servers.find(server_snapshot::server_key(
+      details.net_adr.ip, details.net_adr.query_port))};
+  if (it == probed_servers.end()) {
+    return;
+  }
+  auto &server{it->second};
+  server.details = details;
+  server.available = true;
+  server.probe_time = std::chrono::steady_clock::now();
+}
+
+/// Compare two strings for equality, ignoring case of ASCII letters.
+///
+/// @param a
+///    The first string.
+/// @param b
+///    The second string.
+/// @return Value indicating whether the strings are equal.
+static bool equal_icase(std::string_view a, std::string_view b) {
+  return std::ranges::equal(a, b, [](char l, char r) {
+    return std::tolower(static_cast<unsigned char>(l)) ==
+           std::tolower(static_cast<unsigned char>(r));
+  });
+}
+
+/// Match a string against a pattern in which `*` matches any sequence of
+///    characters, ignoring case of ASCII letters, like master servers match
+///    `name_match` and `version_match` filters.
+///
+/// @param str
+///    The string to match.
+/// @param pattern
+///    The pattern.
+/// @return Value indicating whether @p str matches @p pattern.
+static bool match_wildcard(std::string_view str, std::string_view pattern) {
+  const auto star{pattern.find('*')};
+  if (star == std::string_view::npos) {
+    return equal_icase(str, pattern);
+  }
+  if (str.size() < star ||
+      !equal_icase(str.substr(0, star), pattern.substr(0, star))) {
+    return false;
+  }
+  str.remove_prefix(star);
+  pattern.remove_prefix(star + 1);
+  for (std::size_t i{}; i <= str.size(); ++i) {
+    if (match_wildcard(str.substr(i), pattern)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Count how many of comma-separated tags are present in server's tags.
+///
+/// @param server_tags
+///    Comma-separated tags of the server.
+/// @param tags
+///    Comma-separated tags to look for.
+/// @return A pair of the number of found tags and the total number of tags
+///    in @p tags.
+static std::pair<int, int> count_tags(std::string_view server_tags,
+                                      std::string_view tags) {
+  int found{};
+  int total{};
+  for (const auto tag : std::views::split(tags, ',')) {
+    const std::string_view tag_view{tag};
+    if (tag_view.empty()) {
+      continue;
+    }
+    ++total;
+    if (std::ranges::any_of(std::views::split(server_tags, ','),
+                            [tag_view](const auto &server_tag) {
+                              return std::string_view{server_tag} == tag_view;
+                            })) {
+      ++found;
+    }
+  }
+  return {found, total};
+}
+
+/// Evaluate the first server list request filter, along with its operands if
+///    it's a logical operator, against details of a server, like master
+///    servers do. Filters on data that the details don't include, like
+///    `gamedataand` or `dedicated`, are treated as matching; servers that
+///    don't match those are retracted when the live query completes.
+///
+/// @param details
+///    Details of the server.
+/// @param [in, out] filters
+///    Filters to evaluate. The evaluated ones are removed from the front.
+/// @return Value indicating whether the server matches the filter.
+static bool
+match_filter(const steam_api::gameserveritem_t &details,
+             std::span<const steam_api::matchmaking_kv_pair> &filters) {
+  const auto &filter{filters.front()};
+  filters = filters.subspan(1);
+  const std::string_view key{filter.key.data()};
+  const std::string_view value{filter.value.data()};
+  if (key == "and" || key == "or" || key == "nor" || key == "nand") {
+    int count{};
+    std::from_chars(value.data(), value.data() + value.size(), count);
+    int operands{};
+    int matched{};
+    for (; operands < count && !filters.empty(); ++operands) {
+      matched += match_filter(details, filters);
+    }
+    if (key == "and") {
+      return matched == operands;
+    }
+    if (key == "or") {
+      return matched;
+    }
+    if (key == "nor") {
+      return !matched;
+    }
+    return matched < operands;
+  }
+  if (key == "map") {
+    return equal_icase(details.map.data(), value);
+  }
+  if (key == "gamedir") {
+    return equal_icase(details.game_dir.data(), value);
+  }
+  if (key == "name_match") {
+    return match_wildcard(details.server_name.data(), value);
+  }
+  if (key == "version_match") {
+    return match_wildcard(std::to_string(details.server_version), value);
+  }
+  if (key == "secure") {
+    return details.secure == (value != "0");
+  }
+  if (key == "password") {
+    return details.password == (value != "0");
+  }
+  if (key == "notfull" || key == "full") {
+    return details.players < details.max_players;
+  }
+  if (key == "hasplayers" || key == "empty") {
+    return details.players > 0;
+  }
+  if (key == "noplayers") {
+    return !details.players;
+  }
+  if (key == "appid" || key == "napp") {
+    std::uint32_t app_id{};
+    std::from_chars(value.data(), value.data() + value.size(), app_id);
+    return (details.app_id == app_id) == (key == "appid");
+  }
+  if (key == "gametagsand" || key == "gametype") {
+    const auto [found, total]{count_tags(details.game_tags.data(), value)};
+    return found == total;
+  }
+  if (key == "gametagsnor") {
+    return !count_tags(details.game_tags.data(), value).first;
+  }
+  return true;
+}
+
+/// Check whether a server matches all server list request filters.
+///
+/// @param details
+///    Details of the server.
+/// @param filters
+///    The filters.
+/// @return Value indicating whether the server matches @p filters.
+static bool
+match_filters(const steam_api::gameserveritem_t &details,
+              std::span<const steam_api::matchmaking_kv_pair> filters) {
+  while (!filters.empty()) {
+    if (!match_filter(details, filters)) {
+      return false;
+    }
+  }
+  return true;
+}
 
 //===-- ISteamMatchmakingServers method wrappers --------------------------===//
 
+/// Check whether a server should be hidden from search results based on
+///    specified rule.
+///
+/// @param key
+///    Rule name.
+/// @param value
+///    Rule value.
+/// @return Value indicating whether the server must be rejected.
+static bool rule_rejected(std::string_view key, std::string_view value) {
+  return (!show_be_servers && key == "SERVERUSESBATTLEYE_b" &&
+          value != "false") ||
+         (!show_unavailable_servers &&
+          g_settings.steam->spoof_app_id != 346110 &&
+          key == "SEARCHKEYWORDS_s" && !value.starts_with("TEKWrapper"));
+}
+
+/// Get the key of a server's rules verdict in the cross-process cache.
+///    Verdicts depend on filtering settings, so they're only shared between
+///    instances that use the same ones.
+///
+/// @param server_key
+///    Key identifying the server, as returned by `server_snapshot::server_key`.
+/// @return FNV-1a hash of @p server_key and filtering settings.
+static std::uint64_t verdict_key(std::uint64_t server_key) {
+  const std::uint64_t settings{
+      static_cast<std::uint64_t>(g_settings.steam->spoof_app_id) << 2 |
+      static_cast<std::uint64_t>(show_unavailable_servers) << 1 |
+      static_cast<std::uint64_t>(show_be_servers)};
+  const std::array values{server_key, settings};
+  return shared_cache::hash_key(std::string_view{
+      reinterpret_cast<const char *>(values.data()), sizeof values});
+}
+
+/// Record server rules verdict into the snapshot, if it's enabled, and into
+///    the cross-process cache.
+///
+/// @param key
+///    Key identifying the server, as returned by `server_snapshot::server_key`.
+/// @param rejected
+///    Value indicating whether the server has been rejected based on its
+///    rules.
+static void record_verdict(std::uint64_t key, bool rejected) {
+  if (!server_snapshot_wpath.empty()) {
+    server_snapshot::verdicts.insert_or_assign(key, rejected);
+  }
+  const std::byte value{rejected};
+  shared_cache::put(shared_cache::record_type::rules_verdict,
+                    verdict_key(key), std::span{&value, 1});
+}
+
 /// Pointer to the original ISteamMatchmakingServers::CancelServerQuery method.
 static steam_api::ISteamMatchmakingServers_CancelServerQuery_t
     *_Nullable SteamMatchmakingServers_CancelServerQuery_orig;
 /// Wrapper for game's ISteamMatchmakingRulesResponse handler.
 class rules_response_wrapper final
-    : public steam_api::ISteamMatchmakingRulesResponse {
+    : public steam_api::ISteamMatchmakingRulesResponse,
+      public memory::pooled<memory::subsystem::server_browser> {
   /// Pointer to the underlying handler instance.
   steam_api::ISteamMatchmakingRulesResponse *const _Nonnull base;
+  /// Key identifying the server in the snapshot.
+  const std::uint64_t server_key;
 
 public:
   /// Server query handle.
   int query;
 
   constexpr rules_response_wrapper(
-      steam_api::ISteamMatchmakingRulesResponse *_Nonnull base) noexcept
-      : base{base} {}
+      steam_api::ISteamMatchmakingRulesResponse *_Nonnull base,
+      std::uint64_t server_key) noexcept
+      : base{base}, server_key{server_key} {}
 
   void RulesResponded(const char *_Nonnull key,
                       const char *_Nonnull value) override {
-    if (const std::string_view key_view{key};
-        (!show_be_servers && key_view == "SERVERUSESBATTLEYE_b" &&
-         std::string_view{value} != "false") ||
-        (!show_unavailable_servers &&
-         g_settings.steam->spoof_app_id != 346110 &&
-         key_view == "SEARCHKEYWORDS_s" &&
-         !std::string_view{value}.starts_with("TEKWrapper"))) {
+    if (rule_rejected(key, value)) {
+      record_verdict(server_key, true);
       SteamMatchmakingServers_CancelServerQuery_orig(
           steam_api::ISteamMatchmakingServers_desc.iface, query);
       base->RulesFailedToRespond();
@@ -116,11 +721,395 @@ public:
     delete this;
   }
   void RulesRefreshComplete() override {
+    record_verdict(server_key, false);
     base->RulesRefreshComplete();
     delete this;
   }
 };
 
+/// Adapter that delivers results of built-in A2S client's rules queries to
+///    game's ISteamMatchmakingRulesResponse handler.
+class a2s_rules_wrapper final
+    : public a2s::rules_handler,
+      public memory::pooled<memory::subsystem::server_browser> {
+  /// Pointer to the underlying handler instance.
+  steam_api::ISteamMatchmakingRulesResponse *const _Nonnull base;
+  /// Key identifying the server in the snapshot.
+  const std::uint64_t server_key;
+
+public:
+  constexpr a2s_rules_wrapper(
+      steam_api::ISteamMatchmakingRulesResponse *_Nonnull base,
+      std::uint64_t server_key) noexcept
+      : base{base}, server_key{server_key} {}
+
+  void rules_received(std::span<const a2s::rule> rules) override {
+    if (std::ranges::any_of(rules, [](const auto &rule) {
+          return rule_rejected(rule.key, rule.value);
+        })) {
+      record_verdict(server_key, true);
+      base->RulesFailedToRespond();
+    } else {
+      record_verdict(server_key, false);
+      for (const auto &rule : rules) {
+        base->RulesResponded(rule.key.data(), rule.value.data());
+      }
+      base->RulesRefreshComplete();
+    }
+    delete this;
+  }
+  void rules_failed() override {
+    base->RulesFailedToRespond();
+    delete this;
+  }
+};
+
+/// Handler for prefetch rules queries, that stores received rules into
+///    @ref prefetched_rules. It's used both with Steam and with the built-in
+///    A2S client.
+class rules_collector final
+    : public steam_api::ISteamMatchmakingRulesResponse,
+      public a2s::rules_handler,
+      public memory::pooled<memory::subsystem::server_browser> {
+  /// Key identifying the server in @ref prefetched_rules.
+  const std::uint64_t server_key;
+  /// Rules received so far from Steam.
+  std::vector<a2s::rule> rules;
+
+public:
+  constexpr rules_collector(std::uint64_t server_key) noexcept
+      : server_key{server_key} {}
+
+  void RulesResponded(const char *_Nonnull key,
+                      const char *_Nonnull value) override {
+    rules.push_back({.key = key, .value = value});
+  }
+  void RulesFailedToRespond() override { delete this; }
+  void RulesRefreshComplete() override {
+    prefetched_rules.insert_or_assign(server_key, std::move(rules));
+    delete this;
+  }
+
+  void rules_received(std::span<const a2s::rule> rules) override {
+    prefetched_rules.insert_or_assign(
+        server_key, std::vector<a2s::rule>{rules.begin(), rules.end()});
+    delete this;
+  }
+  void rules_failed() override { delete this; }
+};
+
+/// Pointer to the original ISteamMatchmakingServers::GetServerDetails method.
+static steam_api::ISteamMatchmakingServers_GetServerDetails_t
+    *_Nullable SteamMatchmakingServers_GetServerDetails_orig;
+/// Wrapper for game's ISteamMatchmakingServerListResponse handler, that
+///    replays servers from the snapshot or from @ref probed_servers and
+///    reconciles them with live results.
+class list_response_wrapper final
+    : public steam_api::ISteamMatchmakingServerListResponse,
+      public memory::pooled<memory::subsystem::server_browser> {
+  /// Pointer to the underlying handler instance.
+  steam_api::ISteamMatchmakingServerListResponse *const _Nonnull base;
+  /// Application ID of the request.
+  const std::uint32_t app_id;
+  /// Filters of the request.
+  std::vector<steam_api::matchmaking_kv_pair> filters;
+  /// Indices of servers in @ref replayed, keyed by
+  ///    `server_snapshot::server_key` values.
+  std::unordered_map<std::uint64_t, int> replayed_idxs;
+  /// Details of servers that responded to the live query.
+  std::vector<steam_api::gameserveritem_t> live;
+  /// Flags indicating which servers in @ref replayed have responded to the
+  ///    live query.
+  std::vector<bool> answered;
+  /// Value indicating whether the live query has completed.
+  bool refreshed;
+  /// Value indicating whether live results should be saved to the snapshot.
+  const bool snapshot;
+
+public:
+  /// Hash of the request parameters.
+  const std::uint64_t filter_hash;
+  /// Server list request handle, or `nullptr` if the game has released the
+  ///    request.
+  void *_Nullable request;
+  /// Details of servers replayed from the snapshot.
+  std::vector<steam_api::gameserveritem_t> replayed;
+  /// Value indicating whether @ref replayed haven't been delivered to the
+  ///    game's handler yet.
+  bool replay_pending;
+
+  list_response_wrapper(
+      steam_api::ISteamMatchmakingServerListResponse *_Nonnull base,
+      std::uint32_t app_id,
+      std::span<const steam_api::matchmaking_kv_pair> filters)
+      : base{base}, app_id{app_id}, filters{filters.begin(), filters.end()},
+        refreshed{}, snapshot{true},
+        filter_hash{server_snapshot::hash_filters(app_id, filters)},
+        request{} {
+    if (server_snapshot::filter_hash == filter_hash) {
+      replayed.reserve(server_snapshot::servers.size());
+      for (const auto &server : server_snapshot::servers) {
+        const auto key{server_snapshot::server_key(server.net_adr.ip,
+                                                   server.net_adr.query_port)};
+        if (const auto it{server_snapshot::verdicts.find(key)};
+            it != server_snapshot::verdicts.end() && it->second) {
+          continue;
+        }
+        if (replayed_idxs.try_emplace(key, replayed.size()).second) {
+          replayed.emplace_back(server);
+        }
+      }
+    }
+    answered.resize(replayed.size());
+    replay_pending = !replayed.empty();
+  }
+  /// Create a wrapper that replays probed favorite or history servers.
+  ///
+  /// @param [in, out] base
+  ///    The game's handler.
+  /// @param app_id
+  ///    Application ID of the request.
+  /// @param flag
+  ///    Favorite flag of servers to replay.
+  /// @param filters
+  ///    Filters of the request, which replayed servers must match.
+  list_response_wrapper(
+      steam_api::ISteamMatchmakingServerListResponse *_Nonnull base,
+      std::uint32_t app_id, std::uint32_t flag,
+      std::span<const steam_api::matchmaking_kv_pair> filters)
+      : base{base}, app_id{app_id}, filters{filters.begin(), filters.end()},
+        refreshed{}, snapshot{false}, filter_hash{}, request{} {
+    for (const auto &[key, server] : probed_servers) {
+      if (server.available && server.flags & flag &&
+          match_filters(server.details, filters)) {
+        replayed_idxs.emplace(key, replayed.size());
+        replayed.emplace_back(server.details);
+      }
+    }
+    answered.resize(replayed.size());
+    replay_pending = !replayed.empty();
+  }
+
+  /// Deliver @ref replayed to the game's handler. Once the live query has
+  ///    completed, only servers that have responded to it are delivered.
+  ///    Stops if the handler releases the request.
+  void replay() {
+    replay_pending = false;
+    for (int i{}; request && i < static_cast<int>(replayed.size()); ++i) {
+      if (!refreshed || answered[i]) {
+        base->ServerResponded(request, snapshot_idx_base + i);
+      }
+    }
+  }
+
+  void ServerResponded(void *_Nonnull request, int server) override {
+    const auto details{SteamMatchmakingServers_GetServerDetails_orig(
+        steam_api::ISteamMatchmakingServers_desc.iface, request, server)};
+    if (!details) {
+      base->ServerResponded(request, server);
+      return;
+    }
+    record_live_details(*details);
+    if (snapshot) {
+      live.emplace_back(*details);
+    }
+    const auto it{replayed_idxs.find(server_snapshot::server_key(
+        details->net_adr.ip, details->net_adr.query_port))};
+    if (it == replayed_idxs.end()) {
+      base->ServerResponded(request, server);
+    } else {
+      // The game already has this server from the snapshot, so refresh its
+      //    details in place and make the game re-read them instead of
+      //    reporting a duplicate
+      const auto idx{it->second};
+      replayed[idx] = *details;
+      answered[idx] = true;
+      if (!replay_pending) {
+        base->ServerResponded(request, snapshot_idx_base + idx);
+      }
+    }
+  }
+  void ServerFailedToRespond(void *_Nonnull request, int server) override {
+    base->ServerFailedToRespond(request, server);
+  }
+  void RefreshComplete(void *_Nonnull request, int response) override {
+    refreshed = true;
+    if (replay_pending) {
+      replay();
+    } else {
+      // Replayed servers that haven't responded to the live query are offline
+      //    or unreachable now, so retract them from the game's list
+      for (int i{}; this->request && i < static_cast<int>(replayed.size());
+           ++i) {
+        if (!answered[i]) {
+          replayed[i].had_successful_response = false;
+          base->ServerFailedToRespond(request, snapshot_idx_base + i);
+        }
+      }
+    }
+    if (snapshot && !live.empty()) {
+      server_snapshot::filter_hash = filter_hash;
+      server_snapshot::app_id = app_id;
+      server_snapshot::filters = filters;
+      server_snapshot::servers = std::move(live);
+      live.clear();
+      server_snapshot::save(server_snapshot_wpath.data());
+    }
+    // The handler may have released the request while receiving servers
+    if (this->request) {
+      base->RefreshComplete(request, response);
+    }
+  }
+};
+/// Wrappers for server list requests that are currently alive. Wrappers of
+///    released requests are kept until the end of the next
+///    SteamAPI_RunCallbacks call, since the game may release a request from
+///    within the wrapper's own callback.
+static std::vector<std::unique_ptr<list_response_wrapper>> list_wrappers;
+
+/// Pointer to the original ISteamMatchmakingServers::SevrerRules method.
+static steam_api::ISteamMatchmakingServers_ServerRules_t
+    *_Nullable SteamMatchmakingServers_ServerRules_orig;
+/// Handler for the internet server list request issued at startup, that
+///    buffers results until the game's first matching request attaches to it.
+class prefetch_response final
+    : public steam_api::ISteamMatchmakingServerListResponse {
+  /// Buffered per-server event.
+  struct event {
+    /// Server index.
+    int server;
+    /// `true` for ServerResponded, `false` for ServerFailedToRespond.
+    bool responded;
+  };
+  /// Events received before the results have been delivered to @ref target.
+  std::vector<event> events;
+  /// Value indicating whether RefreshComplete has been received.
+  bool completed;
+  /// Response code passed to RefreshComplete.
+  int complete_response;
+  /// Number of rules queries started, at most @ref max_prefetched_rules.
+  int num_rules_queries;
+
+  /// Begin prefetching rules of specified server, unless
+  ///    @ref max_prefetched_rules queries have already been started.
+  ///
+  /// @param [in] request
+  ///    Server list request handle.
+  /// @param server
+  ///    Index of the server in the list.
+  void prefetch_rules(void *_Nonnull request, int server) {
+    if (num_rules_queries >= max_prefetched_rules) {
+      return;
+    }
+    const auto details{SteamMatchmakingServers_GetServerDetails_orig(
+        steam_api::ISteamMatchmakingServers_desc.iface, request, server)};
+    if (!details) {
+      return;
+    }
+    const auto &adr{details->net_adr};
+    const auto key{server_snapshot::server_key(adr.ip, adr.query_port)};
+    if (prefetched_rules.contains(key)) {
+      return;
+    }
+    ++num_rules_queries;
+    const auto collector{new rules_collector{key}};
+    if (a2s_running) {
+      a2s::query_rules(adr.ip, adr.query_port, *collector);
+    } else {
+      SteamMatchmakingServers_ServerRules_orig(
+          steam_api::ISteamMatchmakingServers_desc.iface, adr.ip,
+          adr.query_port, collector);
+    }
+  }
+
+public:
+  /// Hash of the request parameters.
+  const std::uint64_t filter_hash;
+  /// Server list request handle, or `nullptr` if the game has released the
+  ///    request.
+  void *_Nullable request;
+  /// Pointer to the handler that results are delivered to, or `nullptr` if
+  ///    no request has attached yet.
+  steam_api::ISteamMatchmakingServerListResponse *_Nullable target;
+  /// Value indicating whether buffered results haven't been delivered to
+  ///    @ref target yet.
+  bool flush_pending;
+
+  constexpr prefetch_response(std::uint64_t filter_hash) noexcept
+      : completed{}, complete_response{}, num_rules_queries{},
+        filter_hash{filter_hash}, request{}, target{}, flush_pending{} {}
+
+  /// Attach specified handler to the request. Buffered results are delivered
+  ///    to it on next SteamAPI_RunCallbacks call.
+  ///
+  /// @param [in, out] handler
+  ///    The handler to deliver results to.
+  void attach(steam_api::ISteamMatchmakingServerListResponse &handler) {
+    target = &handler;
+    flush_pending = true;
+  }
+
+  /// Deliver buffered results to @ref target. Stops if the game releases the
+  ///    request.
+  void flush() {
+    flush_pending = false;
+    for (const auto &event : events) {
+      if (!request) {
+        return;
+      }
+      if (event.responded) {
+        target->ServerResponded(request, event.server);
+      } else {
+        target->ServerFailedToRespond(request, event.server);
+      }
+    }
+    events.clear();
+    events.shrink_to_fit();
+    if (completed && request) {
+      target->RefreshComplete(request, complete_response);
+    }
+  }
+
+  void ServerResponded(void *_Nonnull request, int server) override {
+    prefetch_rules(request, server);
+    if (target && !flush_pending) {
+      target->ServerResponded(request, server);
+    } else {
+      events.emplace_back(server, true);
+    }
+  }
+  void ServerFailedToRespond(void *_Nonnull request, int server) override {
+    if (target && !flush_pending) {
+      target->ServerFailedToRespond(request, server);
+    } else {
+      events.emplace_back(server, false);
+    }
+  }
+  void RefreshComplete(void *_Nonnull request, int response) override {
+    if (target && !flush_pending) {
+      target->RefreshComplete(request, response);
+    } else {
+      completed = true;
+      complete_response = response;
+    }
+  }
+};
+/// Handler for the startup server list request, if it's been issued.
+static std::unique_ptr<prefetch_response> prefetch;
+
+/// Pointer to the original ISteamMatchmakingServers::ReleaseRequest method.
+static steam_api::ISteamMatchmakingServers_ReleaseRequest_t
+    *_Nullable SteamMatchmakingServers_ReleaseRequest_orig;
+
+/// Release the startup server list request that no game request has attached
+///    to, and destroy its handler. Rules that have already been prefetched
+///    remain available.
+static void release_prefetch() {
+  SteamMatchmakingServers_ReleaseRequest_orig(
+      steam_api::ISteamMatchmakingServers_desc.iface, prefetch->request);
+  prefetch.reset();
+}
+
 /// Pointer to the original ISteamMatchmakingServers::RequestInternetServerList
 ///    method.
 static steam_api::ISteamMatchmakingServers_RequestInternetServerList_t
@@ -130,27 +1119,29 @@ static steam_api::ISteamMatchmakingServers_RequestInternetServerList_t
 static void *_Nonnull SteamMatchmakingServers_RequestInternetServerList(
     void *_Nonnull iface, std::uint32_t app_id,
     const steam_api::matchmaking_kv_pair *const _Nonnull *_Nullable filters,
-    std::uint32_t num_filters, void *_Nonnull response_handler) {
+    std::uint32_t num_filters,
+    steam_api::ISteamMatchmakingServerListResponse *_Nonnull response_handler) {
+  // Settings may be changed by hot-reload at any moment, so use consistent
+  //    values for computing filter count and writing the filters
+  const bool show_be{show_be_servers};
+  const bool show_unavailable{show_unavailable_servers};
   auto num_new_filters{num_filters};
-  if (!show_be_servers) {
+  if (!show_be) {
     ++num_new_filters;
   }
-  if (!show_unavailable_servers) {
+  if (!show_unavailable) {
     num_new_filters +=
         unavailable_dlc.empty()
-            ? ((show_be_servers && g_settings.steam->spoof_app_id != 346110)
-                   ? 1
-                   : 0)
+            ? ((show_be && g_settings.steam->spoof_app_id != 346110) ? 1 : 0)
             : (3 + unavailable_dlc.size());
   }
-  const auto new_filters{
-      std::make_unique_for_overwrite<steam_api::matchmaking_kv_pair[]>(
-          num_new_filters)};
-  std::ranges::copy_n(*filters, num_filters, new_filters.get());
+  std::pmr::vector<steam_api::matchmaking_kv_pair> new_filters(
+      num_new_filters, &memory::resource(memory::subsystem::server_browser));
+  std::ranges::copy_n(*filters, num_filters, new_filters.begin());
   auto cur_filter{&new_filters[num_filters]};
-  if (!show_be_servers) {
+  if (!show_be) {
     std::ranges::copy("gamedataand", cur_filter->key.data());
-    if (!show_unavailable_servers && g_settings.steam->spoof_app_id != 346110) {
+    if (!show_unavailable && g_settings.steam->spoof_app_id != 346110) {
       std::ranges::copy("SERVERUSESBATTLEYE_b:false,TEKWrapper:1",
                         cur_filter->value.data());
     } else {
@@ -158,9 +1149,9 @@ static void *_Nonnull SteamMatchmakingServers_RequestInternetServerList(
     }
     ++cur_filter;
   }
-  if (!show_unavailable_servers) {
+  if (!show_unavailable) {
     if (unavailable_dlc.empty()) {
-      if (show_be_servers && g_settings.steam->spoof_app_id != 346110) {
+      if (show_be && g_settings.steam->spoof_app_id != 346110) {
         std::ranges::copy("gamedataand", cur_filter->key.data());
         std::ranges::copy("TEKWrapper:1", cur_filter->value.data());
       }
@@ -185,82 +1176,323 @@ static void *_Nonnull SteamMatchmakingServers_RequestInternetServerList(
       }
     }
   }
-  const auto ptr = new_filters.get();
-  return SteamMatchmakingServers_RequestInternetServerList_orig(
-      iface, app_id, &ptr, num_new_filters, response_handler);
+  const auto ptr = new_filters.data();
+  if (server_snapshot_wpath.empty()) {
+    return SteamMatchmakingServers_RequestInternetServerList_orig(
+        iface, app_id, &ptr, num_new_filters, response_handler);
+  }
+  auto wrapper{std::make_unique<list_response_wrapper>(
+      response_handler, app_id, std::span{ptr, num_new_filters})};
+  if (prefetch && !prefetch->target &&
+      prefetch->filter_hash == wrapper->filter_hash) {
+    // Attach to results of the startup request instead of starting over
+    wrapper->request = prefetch->request;
+    prefetch->attach(*wrapper);
+  } else {
+    if (prefetch && !prefetch->target) {
+      // The game uses different filters, so the prefetched list would never
+      //    be used
+      release_prefetch();
+    }
+    wrapper->request = SteamMatchmakingServers_RequestInternetServerList_orig(
+        iface, app_id, &ptr, num_new_filters, wrapper.get());
+  }
+  return list_wrappers.emplace_back(std::move(wrapper))->request;
+}
+
+/// Wrapper for ISteamMatchmakingServers::ReleaseRequest, making it detach the
+///    response handler wrapper and the startup request handler from the
+///    request, so they're destroyed by next SteamAPI_RunCallbacks call.
+static void SteamMatchmakingServers_ReleaseRequest(void *_Nonnull iface,
+                                                   void *_Nonnull request) {
+  SteamMatchmakingServers_ReleaseRequest_orig(iface, request);
+  if (prefetch && prefetch->request == request) {
+    prefetch->request = nullptr;
+  }
+  for (const auto &wrapper : list_wrappers) {
+    if (wrapper->request == request) {
+      wrapper->request = nullptr;
+    }
+  }
+}
+
+/// Start a favorites or history server list request with a wrapper for the
+///    game's handler, that replays probed servers.
+///
+/// @param [in] orig
+///    Pointer to the original request method.
+/// @param flag
+///    Favorite flag of servers that the request lists.
+/// @param [in, out] iface
+///    Pointer to the ISteamMatchmakingServers instance.
+/// @param app_id
+///    Application ID of the request.
+/// @param [in] filters
+///    Pointer to the array of pointers to filters.
+/// @param num_filters
+///    Number of filters.
+/// @param [in, out] response_handler
+///    The game's handler.
+/// @return Server list request handle.
+static void *_Nonnull request_probed_list(
+    steam_api::ISteamMatchmakingServers_RequestInternetServerList_t
+        *_Nonnull orig,
+    std::uint32_t flag, void *_Nonnull iface, std::uint32_t app_id,
+    const steam_api::matchmaking_kv_pair *const _Nonnull *_Nullable filters,
+    std::uint32_t num_filters,
+    steam_api::ISteamMatchmakingServerListResponse *_Nonnull response_handler) {
+  auto wrapper{std::make_unique<list_response_wrapper>(
+      response_handler, app_id, flag,
+      filters ? std::span{*filters, num_filters}
+              : std::span<const steam_api::matchmaking_kv_pair>{})};
+  wrapper->request = orig(iface, app_id, filters, num_filters, wrapper.get());
+  return list_wrappers.emplace_back(std::move(wrapper))->request;
+}
+
+/// Pointer to the original
+///    ISteamMatchmakingServers::RequestFavoritesServerList method.
+static steam_api::ISteamMatchmakingServers_RequestFavoritesServerList_t
+    *_Nullable SteamMatchmakingServers_RequestFavoritesServerList_orig;
+/// Wrapper for ISteamMatchmakingServers::RequestFavoritesServerList, making it
+///    answer with probed favorite servers at once.
+static void *_Nonnull SteamMatchmakingServers_RequestFavoritesServerList(
+    void *_Nonnull iface, std::uint32_t app_id,
+    const steam_api::matchmaking_kv_pair *const _Nonnull *_Nullable filters,
+    std::uint32_t num_filters,
+    steam_api::ISteamMatchmakingServerListResponse *_Nonnull response_handler) {
+  return request_probed_list(
+      SteamMatchmakingServers_RequestFavoritesServerList_orig,
+      favorite_flag_favorite, iface, app_id, filters, num_filters,
+      response_handler);
+}
+
+/// Pointer to the original ISteamMatchmakingServers::RequestHistoryServerList
+///    method.
+static steam_api::ISteamMatchmakingServers_RequestHistoryServerList_t
+    *_Nullable SteamMatchmakingServers_RequestHistoryServerList_orig;
+/// Wrapper for ISteamMatchmakingServers::RequestHistoryServerList, making it
+///    answer with probed history servers at once.
+static void *_Nonnull SteamMatchmakingServers_RequestHistoryServerList(
+    void *_Nonnull iface, std::uint32_t app_id,
+    const steam_api::matchmaking_kv_pair *const _Nonnull *_Nullable filters,
+    std::uint32_t num_filters,
+    steam_api::ISteamMatchmakingServerListResponse *_Nonnull response_handler) {
+  return request_probed_list(
+      SteamMatchmakingServers_RequestHistoryServerList_orig,
+      favorite_flag_history, iface, app_id, filters, num_filters,
+      response_handler);
+}
+
+/// Wrapper for ISteamMatchmakingServers::GetServerDetails, making it return
+///    details of servers replayed from the snapshot or probed servers.
+static steam_api::gameserveritem_t *_Nullable
+SteamMatchmakingServers_GetServerDetails(void *_Nonnull iface,
+                                         void *_Nonnull request, int server) {
+  if (server < snapshot_idx_base) {
+    return SteamMatchmakingServers_GetServerDetails_orig(iface, request,
+                                                         server);
+  }
+  const auto it{std::ranges::find(list_wrappers, request,
+                                  [](const auto &wrapper) {
+                                    return wrapper->request;
+                                  })};
+  if (it == list_wrappers.end()) {
+    return nullptr;
+  }
+  auto &replayed{(*it)->replayed};
+  const auto idx{static_cast<std::size_t>(server - snapshot_idx_base)};
+  return idx < replayed.size() ? &replayed[idx] : nullptr;
 }
 
-/// Pointer to the original ISteamMatchmakingServers::SevrerRules method.
-static steam_api::ISteamMatchmakingServers_ServerRules_t
-    *_Nullable SteamMatchmakingServers_ServerRules_orig;
 /// Wrapper for ISteamMatchmakingServers::ServerRules, making it create a
-///     wrapper for response handler.
+///     wrapper for response handler, answer the query from prefetched rules if
+///     they're available, fail it if another game instance has recently
+///     rejected the server, and perform the query via built-in A2S client if
+///     it's enabled.
 static int SteamMatchmakingServers_ServerRules(
     void *_Nonnull iface, std::uint32_t ip, std::uint16_t port,
     steam_api::ISteamMatchmakingRulesResponse *_Nonnull response_handler) {
-  const auto wrapper{new rules_response_wrapper{response_handler}};
+  const auto key{server_snapshot::server_key(ip, port)};
+  if (prefetched_rules.contains(key) &&
+      std::chrono::steady_clock::now() - prefetch_time <
+          prefetched_rules_ttl) {
+    const auto query{next_cached_query++};
+    cached_rules_queries.emplace_back(query, key, response_handler, false);
+    return query;
+  }
+  std::byte verdict;
+  if (std::size_t size;
+      shared_cache::get(shared_cache::record_type::rules_verdict,
+                        verdict_key(key), shared_verdict_ttl,
+                        std::span{&verdict, 1}, size) &&
+      verdict != std::byte{}) {
+    const auto query{next_cached_query++};
+    cached_rules_queries.emplace_back(query, key, response_handler, true);
+    return query;
+  }
+  if (a2s_running) {
+    return a2s::query_rules(ip, port,
+                            *new a2s_rules_wrapper{response_handler, key});
+  }
+  const auto wrapper{new rules_response_wrapper{response_handler, key}};
   wrapper->query =
       SteamMatchmakingServers_ServerRules_orig(iface, ip, port, wrapper);
   return wrapper->query;
 }
 
+/// Wrapper for ISteamMatchmakingServers::CancelServerQuery, making it cancel
+///    queries started by built-in A2S client and queries answered from
+///    prefetched rules or shared verdicts.
+static void SteamMatchmakingServers_CancelServerQuery(void *_Nonnull iface,
+                                                      int query) {
+  if (query >= a2s::query_base) {
+    delete a2s::cancel(query);
+    return;
+  }
+  if (query >= cached_query_base) {
+    std::erase_if(cached_rules_queries, [query](const auto &cached_query) {
+      return cached_query.query == query;
+    });
+    return;
+  }
+  SteamMatchmakingServers_CancelServerQuery_orig(iface, query);
+}
+
+//===-- Mod profiles ------------------------------------------------------===//
+
+/// Number of items added to the active mod profile automatically.
+static metrics::counter profile_mods_added{"346110.mod_profile.added"};
+
+/// Get IDs of installed mods that are exposed to the game as subscribed. Must
+///    be called with @ref mods_mtx locked.
+///
+/// @return All of @ref mods if there is no active profile, otherwise the
+///    installed items of the active profile, in profile order.
+static std::vector<std::uint64_t> exposed_mods() {
+  if (!active_profile) {
+    return mods;
+  }
+  std::vector<std::uint64_t> ids;
+  ids.reserve(active_profile->size());
+  std::ranges::copy_if(*active_profile, std::back_inserter(ids),
+                       [](auto id) { return std::ranges::contains(mods, id); });
+  return ids;
+}
+
+/// Add an item requested by the game to the active mod profile if
+///    @ref auto_mod_profile is enabled. Must be called with @ref mods_mtx
+///    locked.
+///
+/// @param id
+///    ID of the item.
+/// @return Value indicating whether the item has been added, in which case
+///    the caller should call @ref save_profiles after unlocking
+///    @ref mods_mtx.
+static bool add_profile_mod(std::uint64_t id) {
+  if (!auto_mod_profile || !active_profile ||
+      std::ranges::contains(*active_profile, id)) {
+    return false;
+  }
+  active_profile->emplace_back(id);
+  profile_mods_added.add();
+  return true;
+}
+
+/// Schedule saving settings with updated mod profiles. Saving is done in
+///    background so wrappers called on game thread don't wait for file I/O.
+static void save_profiles() {
+  jobs::runtime_pool().submit([] { g_settings.save(); }, jobs::priority::low);
+}
+
 //===-- ISteamUGC method wrappers -----------------------------------------===//
 
-static void job_upd_handler(tek_sc_am_item_desc *_Nonnull desc,
-                            tek_sc_am_upd_type upd_mask) {
-  if (upd_mask & TEK_SC_AM_UPD_TYPE_state &&
-      desc->job.state.load(std::memory_order::relaxed) ==
-          TEK_SC_AM_JOB_STATE_stopped) {
-    if (desc->current_manifest_id) {
-      const std::scoped_lock lock{mods_mtx};
-      mods.emplace_back(desc->id.ws_item_id);
+/// Finish handler for Steam Workshop item jobs, that moves successfully
+///    installed items to @ref mods and notifies the game via Steam callbacks.
+///
+/// @param [in] desc
+///    Descriptor of the item.
+/// @param [in] result
+///    Result of the item's job.
+static void job_finish_handler(tek_sc_am_item_desc *_Nonnull desc,
+                               const tek_sc_err &result) {
+  const auto id{desc->id.ws_item_id};
+  // A failed update of an installed item leaves its old manifest ID in place,
+  //    so the ID alone doesn't tell whether the job has succeeded
+  const auto manifest_id{tek_sc_err_success(&result) ||
+                                 result.primary == TEK_SC_ERRC_up_to_date
+                             ? desc->current_manifest_id
+                             : 0};
+  if (manifest_id) {
+    // Updated items are already listed
+    const std::scoped_lock lock{mods_mtx};
+    if (!std::ranges::contains(mods, id)) {
+      mods.emplace_back(id);
     }
+  }
+  {
     const std::scoped_lock lock{ws_descs_mtx};
-    ws_descs.erase(desc->id.ws_item_id);
-    return;
+    ws_descs.erase(id);
+    ws_updates.erase(id);
+  }
+  const auto app_id{g_settings.steam->app_id};
+  if (manifest_id) {
+    steam_api::post_callback(
+        steam_api::item_installed{.app_id = app_id,
+                                  .id = id,
+                                  .legacy_content = 0,
+                                  .manifest_id = manifest_id});
   }
+  steam_api::post_callback(steam_api::download_item_result{
+      .app_id = app_id,
+      .id = id,
+      .result = manifest_id ? TEK_SC_CM_ERESULT_ok : TEK_SC_CM_ERESULT_fail});
 }
 
 /// Wrapper for ISteamUGC::SubscribeItem, making it start a tek-steamclient
 ///    application manager job.
 static std::uint64_t SteamUGC_SubscribeItem(void *, std::uint64_t id) {
-  std::wstring am_path(MultiByteToWideChar(CP_UTF8, 0, ws_am_path.data(),
-                                           ws_am_path.size(), nullptr, 0),
-                       L'\0');
-  MultiByteToWideChar(CP_UTF8, 0, ws_am_path.data(), ws_am_path.size(),
-                      am_path.data(), am_path.length());
-  std::wstring dir_path(MultiByteToWideChar(CP_UTF8, 0, ws_dir_path.data(),
-                                            ws_dir_path.size(), nullptr, 0),
-                        L'\0');
-  MultiByteToWideChar(CP_UTF8, 0, ws_dir_path.data(), ws_dir_path.size(),
-                      dir_path.data(), dir_path.length());
+  // Mods are downloaded when joining a server that requires them
+  if (const std::scoped_lock lock{mods_mtx}; add_profile_mod(id)) {
+    save_profiles();
+  }
   ws_descs_mtx.lock();
-  const auto [it, emplaced]{ws_descs.try_emplace(id)};
+  auto [it, emplaced]{ws_descs.try_emplace(id)};
+  if (emplaced) {
+    if (const auto upd{ws_updates.find(id)};
+        upd != ws_updates.end() && upd->second) {
+      // The item is already being updated in background, let the game track
+      //    that job instead of starting a new one. Reserved updates without a
+      //    job yet give way to the installation
+      it->second = upd->second;
+      emplaced = false;
+    }
+  }
   ws_descs_mtx.unlock();
   if (emplaced) {
-    steamclient::install_workshop_item(am_path.data(), dir_path.data(), id,
-                                       job_upd_handler, &it->second);
+    ws_jobs::install(ws_am_wpath.data(), ws_dir_wpath.data(), id,
+                     job_finish_handler, &it->second);
   }
   return id;
 }
 
 /// Wrapper for ISteamUGC::GetNumSubscribedItems, making it return the number of
-///    elements in @ref mods and @ref ws_descs.
+///    mods exposed by @ref exposed_mods and elements in @ref ws_descs.
 static std::uint32_t SteamUGC_GetNumSubscribedItems(void *) {
   const std::scoped_lock lock{mods_mtx, ws_descs_mtx};
-  return mods.size() + ws_descs.size();
+  return exposed_mods().size() + ws_descs.size();
 }
 
-/// Wrapper for ISteamUGC::GetSubscribedItems, making it return the elements
-///    from @ref mods and IDs from @ref ws_descs.
+/// Wrapper for ISteamUGC::GetSubscribedItems, making it return the mods
+///    exposed by @ref exposed_mods and IDs from @ref ws_descs.
 static std::uint32_t SteamUGC_GetSubscribedItems(void *,
                                                  std::uint64_t *_Nonnull ids,
                                                  std::uint32_t max_entries) {
   std::uint32_t total_copied{};
   {
     const std::scoped_lock lock{mods_mtx};
-    const auto n{std::min<std::size_t>(mods.size(), max_entries)};
-    ids = std::ranges::copy_n(mods.cbegin(), n, ids).out;
+    const auto exposed{exposed_mods()};
+    const auto n{std::min<std::size_t>(exposed.size(), max_entries)};
+    ids = std::ranges::copy_n(exposed.cbegin(), n, ids).out;
     max_entries -= n;
     total_copied += n;
   }
@@ -275,19 +1507,42 @@ static std::uint32_t SteamUGC_GetSubscribedItems(void *,
 }
 
 /// Wrapper for ISteamUGC::GetItemInstallInfo, making it return information
-///    based on @ref mods, @ref ws_descs, and @ref ws_dir_path.
+///    based on @ref mods, @ref ws_descs, and @ref ws_dir_path. All installed
+///    mods are reported regardless of the active mod profile, so the game can
+///    load ones required by the server it joins.
 static bool SteamUGC_GetItemInstallInfo(void *, std::uint64_t id,
                                         std::uint64_t *_Nonnull size_on_disk,
                                         char *_Nullable folder,
                                         std::uint32_t folder_size,
                                         bool *_Nonnull legacy_item) {
   *size_on_disk = 0;
-  if (const std::scoped_lock lock{mods_mtx}; std::ranges::contains(mods, id)) {
+  bool installed;
+  bool added;
+  {
+    const std::scoped_lock lock{mods_mtx};
+    installed = std::ranges::contains(mods, id);
+    added = installed && add_profile_mod(id);
+  }
+  if (added) {
+    save_profiles();
+  }
+  if (installed) {
     *legacy_item = false;
-    *std::format_to_n(folder, folder_size - 1, std::locale::classic(), "{}\\{}",
-                      ws_dir_path, id)
-         .out = '\0';
-
+    if (folder_size) {
+      std::array<char, 20> id_buf;
+      const std::string_view id_str{
+          id_buf.data(),
+          std::to_chars(id_buf.data(), id_buf.data() + id_buf.size(), id).ptr};
+      auto remaining{static_cast<std::size_t>(folder_size - 1)};
+      const auto prefix_len{std::min(ws_item_path_prefix.size(), remaining)};
+      folder = std::ranges::copy_n(ws_item_path_prefix.cbegin(), prefix_len,
+                                   folder)
+                   .out;
+      remaining -= prefix_len;
+      *std::ranges::copy_n(id_str.cbegin(),
+                           std::min(id_str.size(), remaining), folder)
+           .out = '\0';
+    }
     return true;
   } else {
     if (folder_size) {
@@ -311,7 +1566,7 @@ static bool SteamUGC_GetItemUpdateInfo(void *, std::uint64_t id,
   }
   *need_update = true;
   *is_downloading = true;
-  const auto desc{it->second};
+  const auto desc{std::atomic_ref{it->second}.load(std::memory_order::acquire)};
   if (desc && desc->job.stage == TEK_SC_AM_JOB_STAGE_downloading) {
     *bytes_downloaded = desc->job.progress_current;
     *bytes_total = desc->job.progress_total;
@@ -322,9 +1577,188 @@ static bool SteamUGC_GetItemUpdateInfo(void *, std::uint64_t id,
   return true;
 }
 
+/// Wrapper for ISteamUGC::BInitWorkshopForGameServer, that ignores the
+///    directory specified by the server. Items are installed to the shared
+///    store at @ref ws_dir_path instead, which other server instances on the
+///    host may use as well, and the server finds them there via
+///    @ref SteamUGC_GetItemInstallInfo. The override is logged, so server
+///    operators can tell why the directory they've passed stays empty.
+static bool SteamUGC_BInitWorkshopForGameServer(void *, std::uint32_t,
+                                                const char *_Nullable folder) {
+  if (folder && *folder) {
+    log::info("Steam Workshop folder \"{}\" requested by the server is "
+              "overridden by workshop_dir_path",
+              std::string_view{folder});
+  }
+  return true;
+}
+
+/// Wrapper for ISteamUGC::DownloadItem, making it start a tek-steamclient
+///    application manager job the same way as @ref SteamUGC_SubscribeItem.
+static bool SteamUGC_DownloadItem(void *, std::uint64_t id, bool) {
+  SteamUGC_SubscribeItem(nullptr, id);
+  return true;
+}
+
+/// Wrapper for ISteamUGC::GetItemState, making it return `EItemState` flags
+///    based on @ref mods and @ref ws_descs.
+static std::uint32_t SteamUGC_GetItemState(void *, std::uint64_t id) {
+  {
+    const std::scoped_lock lock{ws_descs_mtx};
+    if (const auto it{ws_descs.find(id)}; it != ws_descs.end()) {
+      const auto desc{
+          std::atomic_ref{it->second}.load(std::memory_order::acquire)};
+      return item_state_subscribed | item_state_needs_update |
+             (desc && desc->job.stage == TEK_SC_AM_JOB_STAGE_downloading
+                  ? item_state_downloading
+                  : item_state_download_pending);
+    }
+  }
+  const std::scoped_lock lock{mods_mtx};
+  return std::ranges::contains(mods, id)
+             ? item_state_subscribed | item_state_installed
+             : 0;
+}
+
+/// Number of background update jobs started for installed mods.
+static metrics::counter mod_updates_started{"346110.mod_updates.started"};
+
+/// Reserve a background update of an installed mod before its job is
+///    created, unless the game has already requested installation of the item.
+///
+/// @param id
+///    ID of the item.
+/// @return Value indicating whether the job should be created.
+static bool reserve_mod_update(std::uint64_t id) {
+  const std::scoped_lock lock{ws_descs_mtx};
+  if (ws_descs.contains(id)) {
+    return false;
+  }
+  ws_updates.emplace(id, nullptr);
+  return true;
+}
+
+/// Register a background update job for an installed mod, unless the game
+///    has requested installation of the item since it's been reserved by
+///    @ref reserve_mod_update. The job is run by that installation then.
+///
+/// @param id
+///    ID of the item.
+/// @param [in] desc
+///    Pointer to the descriptor of the item, or `nullptr` if the job hasn't
+///    been created.
+/// @return Value indicating whether the job should be started.
+static bool register_mod_update(std::uint64_t id,
+                                tek_sc_am_item_desc *_Nullable desc) {
+  const std::scoped_lock lock{ws_descs_mtx};
+  const auto it{ws_updates.find(id)};
+  if (!desc || ws_descs.contains(id)) {
+    if (it != ws_updates.end()) {
+      ws_updates.erase(it);
+    }
+    return false;
+  }
+  ws_updates.insert_or_assign(id, desc);
+  mod_updates_started.add();
+  return true;
+}
+
+//===-- Steam Workshop index ---------------------------------------------===//
+
+/// Replace the contents of @ref mods with IDs of Steam Workshop items
+///    installed in specified directory. The index from the cross-process
+///    cache is used if it's up to date, otherwise the directory is scanned and
+///    the index is updated.
+///
+/// @param path
+///    Path to the base directory for Steam Workshop items.
+static void load_mods(const std::filesystem::path &path) {
+  std::error_code ec;
+  const auto mtime{static_cast<std::uint64_t>(
+      std::filesystem::last_write_time(path, ec).time_since_epoch().count())};
+  const auto key{shared_cache::hash_key(ws_dir_path)};
+  std::array<std::uint64_t,
+             shared_cache::max_record_size / sizeof(std::uint64_t)>
+      index;
+  // The list is built aside and swapped in, so repeated loads replace it
+  //    instead of appending to it
+  std::vector<std::uint64_t> ids;
+  if (std::size_t size;
+      ec == std::error_code{} &&
+      shared_cache::get(shared_cache::record_type::ws_index, key,
+                        ws_index_ttl, std::as_writable_bytes(std::span{index}),
+                        size) &&
+      size >= sizeof index[0] && index[0] == mtime) {
+    ids.assign(index.cbegin() + 1,
+               index.cbegin() + size / sizeof(std::uint64_t));
+  } else {
+    std::error_code scan_ec;
+    for (std::filesystem::directory_iterator it{path, scan_ec};
+         !scan_ec && it != std::filesystem::directory_iterator{};
+         it.increment(scan_ec)) {
+      if (std::error_code dir_ec; !it->is_directory(dir_ec)) {
+        continue;
+      }
+      const auto &name{it->path().filename().native()};
+      wchar_t *endptr;
+      const auto id{std::wcstoull(name.data(), &endptr, 10)};
+      if (id && endptr == std::to_address(name.end()) &&
+          !std::ranges::contains(ids, id)) {
+        ids.emplace_back(id);
+      }
+    }
+    if (ec == std::error_code{} && scan_ec == std::error_code{} &&
+        ids.size() < index.size()) {
+      index[0] = mtime;
+      std::ranges::copy(ids, index.begin() + 1);
+      shared_cache::put(shared_cache::record_type::ws_index, key,
+                        std::as_bytes(std::span{index.data(), ids.size() + 1}));
+    }
+  }
+  const std::scoped_lock lock{mods_mtx};
+  mods = std::move(ids);
+}
+
+//===-- Mod file prefetching ----------------------------------------------===//
+
+/// Number of mod files read by @ref prefetch_mods.
+static metrics::counter prefetched_files{"346110.mod_prefetch.files"};
+/// Number of bytes read by @ref prefetch_mods.
+static metrics::counter prefetched_bytes{"346110.mod_prefetch.bytes"};
+/// Time that @ref prefetch_mods has taken to complete, in milliseconds.
+static metrics::counter prefetch_time_ms{"346110.mod_prefetch.time_ms"};
+
+/// Get the pool for prefetching mod files. It has a single worker so reads
+///    stay sequential. It's leaked, as the game may exit while reads are
+///    still in progress.
+///
+/// @return Reference to the prefetch pool.
+static jobs::pool &prefetch_pool() {
+  static auto &instance{*new jobs::pool{"mod_prefetch", 1}};
+  return instance;
+}
+
+/// Read files of installed mods, so they're in the OS page cache by the time
+///    the game loads them.
+///
+/// @param ids
+///    IDs of the mods to prefetch, as returned by @ref exposed_mods. That is
+///    the active profile's order, which is the game's load order, or
+///    directory listing order if there is no active profile.
+static void prefetch_mods(const std::vector<std::uint64_t> &ids) {
+  const auto start{std::chrono::steady_clock::now()};
+  const auto res{mod_prefetch::run(ws_dir_wpath, ids,
+                                   mod_prefetch::default_budget())};
+  prefetched_files.add(res.files);
+  prefetched_bytes.add(res.bytes);
+  prefetch_time_ms.add(std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count());
+}
+
 //===-- ISteamUtils method wrappers ---------------------------------------===//
 
-/// Pointer to the original ISteamUtils::IsAPICallCompleted method.
+/// Pointer to the previous ISteamUtils::IsAPICallCompleted method.
 static steam_api::ISteamUtils_IsAPICallCompleted_t
     *_Nullable SteamUtils_IsAPICallCompleted_orig;
 /// Wrapper for ISteamUtils::IsAPICallCompleted, making it return status for
@@ -334,14 +1768,17 @@ bool SteamUtils_IsAPICallCompleted(void *_Nonnull iface, std::uint64_t call,
   {
     const std::scoped_lock lock{ws_descs_mtx};
     if (const auto it{ws_descs.find(call)}; it != ws_descs.end()) {
-      *failed = !it->second;
+      if (ws_jobs::install_pending(call)) {
+        return false;
+      }
+      *failed = !std::atomic_ref{it->second}.load(std::memory_order::acquire);
       return true;
     }
   }
   return SteamUtils_IsAPICallCompleted_orig(iface, call, failed);
 }
 
-/// Pointer to the original ISteamUtils::GetAPICallResult method.
+/// Pointer to the previous ISteamUtils::GetAPICallResult method.
 static steam_api::ISteamUtils_GetAPICallResult_t
     *_Nullable SteamUtils_GetAPICallResult_orig;
 /// Wrapper for ISteamUtils::GetAPICallResult, making it return results for
@@ -352,12 +1789,15 @@ bool SteamUtils_GetAPICallResult(void *_Nonnull iface, std::uint64_t call,
   if (callback_idx == 1313) {
     const std::scoped_lock lock{ws_descs_mtx};
     if (const auto it{ws_descs.find(call)}; it != ws_descs.end()) {
+      if (ws_jobs::install_pending(call)) {
+        return false;
+      }
       if (callback_size >=
           static_cast<int>(sizeof(steam_api::remote_storage_sub_result))) {
         *reinterpret_cast<steam_api::remote_storage_sub_result *>(callback) = {
             .result = TEK_SC_CM_ERESULT_ok, .id = it->first};
       }
-      *failed = !it->second;
+      *failed = !std::atomic_ref{it->second}.load(std::memory_order::acquire);
       return true;
     }
   }
@@ -397,6 +1837,81 @@ void settings_load_346110(const rapidjson::Document &doc) {
   } else {
     ws_am_path = ws_dir_path;
   }
+  ws_dir_wpath = utf::to_wide(ws_dir_path);
+  ws_am_wpath = utf::to_wide(ws_am_path);
+  ws_item_path_prefix = ws_dir_path;
+  ws_item_path_prefix.push_back('\\');
+  const auto a2s_server_rules_m{doc.FindMember("a2s_server_rules")};
+  if (a2s_server_rules_m != doc.MemberEnd() &&
+      a2s_server_rules_m->value.IsBool()) {
+    a2s_server_rules = a2s_server_rules_m->value.GetBool();
+  }
+  const auto server_snapshot_path_m{doc.FindMember("server_snapshot_path")};
+  if (server_snapshot_path_m != doc.MemberEnd() &&
+      server_snapshot_path_m->value.IsString()) {
+    server_snapshot_path = {server_snapshot_path_m->value.GetString(),
+                            server_snapshot_path_m->value.GetStringLength()};
+  }
+  const auto prefetch_server_list_m{doc.FindMember("prefetch_server_list")};
+  if (prefetch_server_list_m != doc.MemberEnd() &&
+      prefetch_server_list_m->value.IsBool()) {
+    prefetch_server_list = prefetch_server_list_m->value.GetBool();
+  }
+  const auto prefetch_mods_m{doc.FindMember("prefetch_mods")};
+  if (prefetch_mods_m != doc.MemberEnd() && prefetch_mods_m->value.IsBool()) {
+    prefetch_mod_files = prefetch_mods_m->value.GetBool();
+  }
+  const auto update_mods_m{doc.FindMember("update_mods")};
+  if (update_mods_m != doc.MemberEnd() && update_mods_m->value.IsBool()) {
+    update_mod_files = update_mods_m->value.GetBool();
+  }
+  const auto probe_favorite_servers_m{
+      doc.FindMember("probe_favorite_servers")};
+  if (probe_favorite_servers_m != doc.MemberEnd() &&
+      probe_favorite_servers_m->value.IsBool()) {
+    probe_favorite_servers = probe_favorite_servers_m->value.GetBool();
+  }
+  const auto mod_profiles_m{doc.FindMember("mod_profiles")};
+  if (mod_profiles_m != doc.MemberEnd() && mod_profiles_m->value.IsObject()) {
+    for (const auto &profile : mod_profiles_m->value.GetObject()) {
+      if (!profile.value.IsArray()) {
+        continue;
+      }
+      auto &ids{mod_profiles[{profile.name.GetString(),
+                              profile.name.GetStringLength()}]};
+      for (const auto &id : profile.value.GetArray()) {
+        if (id.IsUint64() && !std::ranges::contains(ids, id.GetUint64())) {
+          ids.emplace_back(id.GetUint64());
+        }
+      }
+    }
+  }
+  const auto mod_profile_m{doc.FindMember("mod_profile")};
+  if (mod_profile_m != doc.MemberEnd() && mod_profile_m->value.IsString()) {
+    mod_profile = {mod_profile_m->value.GetString(),
+                   mod_profile_m->value.GetStringLength()};
+  }
+  const auto auto_mod_profile_m{doc.FindMember("auto_mod_profile")};
+  if (auto_mod_profile_m != doc.MemberEnd() &&
+      auto_mod_profile_m->value.IsBool()) {
+    auto_mod_profile = auto_mod_profile_m->value.GetBool();
+  }
+}
+
+void settings_reload_346110(const rapidjson::Document &doc) {
+  // Only server filtering options are applied live, others are used during
+  //    initialization
+  const auto show_be_servers_m{doc.FindMember("show_be_servers")};
+  if (show_be_servers_m != doc.MemberEnd() &&
+      show_be_servers_m->value.IsBool()) {
+    show_be_servers = show_be_servers_m->value.GetBool();
+  }
+  const auto show_unavailable_servers_m{
+      doc.FindMember("show_unavailable_servers")};
+  if (show_unavailable_servers_m != doc.MemberEnd() &&
+      show_unavailable_servers_m->value.IsBool()) {
+    show_unavailable_servers = show_unavailable_servers_m->value.GetBool();
+  }
 }
 
 void settings_save_346110(
@@ -417,11 +1932,79 @@ void settings_save_346110(
     writer.Key(str.data(), str.length());
     writer.String(ws_am_path.data(), ws_am_path.length());
   }
+  str = "a2s_server_rules";
+  writer.Key(str.data(), str.length());
+  writer.Bool(a2s_server_rules);
+  if (!server_snapshot_path.empty()) {
+    str = "server_snapshot_path";
+    writer.Key(str.data(), str.length());
+    writer.String(server_snapshot_path.data(), server_snapshot_path.length());
+  }
+  str = "prefetch_server_list";
+  writer.Key(str.data(), str.length());
+  writer.Bool(prefetch_server_list);
+  str = "prefetch_mods";
+  writer.Key(str.data(), str.length());
+  writer.Bool(prefetch_mod_files);
+  str = "update_mods";
+  writer.Key(str.data(), str.length());
+  writer.Bool(update_mod_files);
+  str = "probe_favorite_servers";
+  writer.Key(str.data(), str.length());
+  writer.Bool(probe_favorite_servers);
+  {
+    const std::scoped_lock lock{mods_mtx};
+    if (!mod_profiles.empty()) {
+      str = "mod_profiles";
+      writer.Key(str.data(), str.length());
+      writer.StartObject();
+      for (const auto &[name, ids] : mod_profiles) {
+        writer.Key(name.data(), name.length());
+        writer.StartArray();
+        for (const auto id : ids) {
+          writer.Uint64(id);
+        }
+        writer.EndArray();
+      }
+      writer.EndObject();
+    }
+  }
+  if (!mod_profile.empty()) {
+    str = "mod_profile";
+    writer.Key(str.data(), str.length());
+    writer.String(mod_profile.data(), mod_profile.length());
+  }
+  str = "auto_mod_profile";
+  writer.Key(str.data(), str.length());
+  writer.Bool(auto_mod_profile);
+}
+
+void steam_api_pre_init_346110() {
+  if (!server_snapshot_path.empty()) {
+    server_snapshot_wpath = utf::to_wide(server_snapshot_path);
+    server_snapshot::load(server_snapshot_wpath.data());
+  }
+  // Whether Steam Workshop emulation is needed depends on the app ID that
+  //    SteamAPI_Init ends up using, which isn't known yet unless it's set
+  //    explicitly, so the index is loaded speculatively. Results are simply
+  //    left unused if the game turns out to be owned.
+  if (g_settings.steam->spoof_app_id != 346110 && !ws_dir_path.empty()) {
+    const std::filesystem::path path{ws_dir_wpath};
+    if (std::error_code ec; std::filesystem::exists(path, ec)) {
+      load_mods(path);
+      steamclient::load();
+    }
+  }
 }
 
 void steam_api_init_346110() {
-  if (!show_be_servers || !show_unavailable_servers) {
-    if (!show_unavailable_servers && g_settings.steam->spoof_app_id == 346110) {
+  // With hot-reload, server filtering settings may be changed later, so their
+  //    wrappers must be set up regardless of initial values
+  const bool filtering{!show_be_servers || !show_unavailable_servers ||
+                       g_settings.hot_reload};
+  if (filtering || !server_snapshot_path.empty()) {
+    if ((!show_unavailable_servers || g_settings.hot_reload) &&
+        g_settings.steam->spoof_app_id == 346110) {
       // Get the list of unowned DLC maps
       const auto ISteamApps_BIsSubscribedApp{
           reinterpret_cast<steam_api::ISteamApps_BIsSubscribedApp_t *>(
@@ -463,8 +2046,9 @@ void steam_api_init_346110() {
       if (!ISteamApps_BIsSubscribedApp(ISteamApps_ptr, 3537070)) {
         unavailable_dlc.emplace_back("Aquatica");
       }
-    } // if (!show_unavailable_servers && spoof_app_id == 346110)
-    // Setup wrappers for ISteamMatchmakingServers
+    } // if ((!show_unavailable_servers || hot_reload) &&
+      //     spoof_app_id == 346110)
+    // Setup search filter wrapper for ISteamMatchmakingServers
     auto &desc{steam_api::ISteamMatchmakingServers_desc};
     SteamMatchmakingServers_RequestInternetServerList_orig = reinterpret_cast<
         steam_api::ISteamMatchmakingServers_RequestInternetServerList_t *>(
@@ -478,6 +2062,30 @@ void steam_api_init_346110() {
                   ISteamMatchmakingServers_m_RequestInternetServerList]] =
         reinterpret_cast<void *>(
             SteamMatchmakingServers_RequestInternetServerList);
+    if (!server_snapshot_path.empty()) {
+      // Setup snapshot replay wrappers
+      SteamMatchmakingServers_GetServerDetails_orig = reinterpret_cast<
+          steam_api::ISteamMatchmakingServers_GetServerDetails_t *>(
+          desc.orig_vtable
+              [desc.vm_idxs
+                   [steam_api::ISteamMatchmakingServers_m_GetServerDetails]]);
+      desc.vtable
+          [desc.vm_idxs
+               [steam_api::ISteamMatchmakingServers_m_GetServerDetails]] =
+          reinterpret_cast<void *>(SteamMatchmakingServers_GetServerDetails);
+      SteamMatchmakingServers_ReleaseRequest_orig = reinterpret_cast<
+          steam_api::ISteamMatchmakingServers_ReleaseRequest_t *>(
+          desc.orig_vtable
+              [desc.vm_idxs
+                   [steam_api::ISteamMatchmakingServers_m_ReleaseRequest]]);
+      desc.vtable
+          [desc.vm_idxs[steam_api::ISteamMatchmakingServers_m_ReleaseRequest]] =
+          reinterpret_cast<void *>(SteamMatchmakingServers_ReleaseRequest);
+    }
+  } // if (filtering || snapshot)
+  if (filtering || a2s_server_rules || !server_snapshot_path.empty()) {
+    // Setup server rules wrappers for ISteamMatchmakingServers
+    auto &desc{steam_api::ISteamMatchmakingServers_desc};
     SteamMatchmakingServers_ServerRules_orig = reinterpret_cast<
         steam_api::ISteamMatchmakingServers_ServerRules_t *>(
         desc.orig_vtable
@@ -490,26 +2098,125 @@ void steam_api_init_346110() {
         desc.orig_vtable
             [desc.vm_idxs
                  [steam_api::ISteamMatchmakingServers_m_CancelServerQuery]]);
-  } // if (!show_be_servers || !show_unavailable_servers)
+    if (a2s_server_rules) {
+      a2s_running = a2s::start();
+    }
+    if (a2s_running) {
+      SteamMatchmakingServers_PingServer_orig = reinterpret_cast<
+          steam_api::ISteamMatchmakingServers_PingServer_t *>(
+          desc.orig_vtable
+              [desc.vm_idxs[steam_api::ISteamMatchmakingServers_m_PingServer]]);
+      desc.vtable
+          [desc.vm_idxs[steam_api::ISteamMatchmakingServers_m_PingServer]] =
+          reinterpret_cast<void *>(SteamMatchmakingServers_PingServer);
+    }
+    const bool prefetch_enabled{prefetch_server_list &&
+                                !server_snapshot_path.empty() &&
+                                server_snapshot::filter_hash};
+    // ServerRules may answer from prefetched rules or from shared verdicts
+    //    with synthetic handles regardless of other settings, so those have
+    //    to be cancellable as well
+    desc.vtable
+        [desc.vm_idxs
+             [steam_api::ISteamMatchmakingServers_m_CancelServerQuery]] =
+        reinterpret_cast<void *>(SteamMatchmakingServers_CancelServerQuery);
+    if (prefetch_enabled) {
+      // Start the request in background so its results are ready by the time
+      //    the game opens server browser
+      prefetch =
+          std::make_unique<prefetch_response>(server_snapshot::filter_hash);
+      const auto filters{server_snapshot::filters.data()};
+      prefetch->request =
+          SteamMatchmakingServers_RequestInternetServerList_orig(
+              desc.iface, server_snapshot::app_id, &filters,
+              server_snapshot::filters.size(), prefetch.get());
+      prefetch_time = std::chrono::steady_clock::now();
+    }
+  } // if (filtering || a2s_server_rules || snapshot)
+  if (probe_favorite_servers) {
+    // Setup favorite and history server list wrappers
+    auto &desc{steam_api::ISteamMatchmakingServers_desc};
+    if (!SteamMatchmakingServers_GetServerDetails_orig) {
+      SteamMatchmakingServers_GetServerDetails_orig = reinterpret_cast<
+          steam_api::ISteamMatchmakingServers_GetServerDetails_t *>(
+          desc.orig_vtable
+              [desc.vm_idxs
+                   [steam_api::ISteamMatchmakingServers_m_GetServerDetails]]);
+      desc.vtable
+          [desc.vm_idxs
+               [steam_api::ISteamMatchmakingServers_m_GetServerDetails]] =
+          reinterpret_cast<void *>(SteamMatchmakingServers_GetServerDetails);
+      SteamMatchmakingServers_ReleaseRequest_orig = reinterpret_cast<
+          steam_api::ISteamMatchmakingServers_ReleaseRequest_t *>(
+          desc.orig_vtable
+              [desc.vm_idxs
+                   [steam_api::ISteamMatchmakingServers_m_ReleaseRequest]]);
+      desc.vtable
+          [desc.vm_idxs[steam_api::ISteamMatchmakingServers_m_ReleaseRequest]] =
+          reinterpret_cast<void *>(SteamMatchmakingServers_ReleaseRequest);
+    }
+    SteamMatchmakingServers_RequestFavoritesServerList_orig = reinterpret_cast<
+        steam_api::ISteamMatchmakingServers_RequestFavoritesServerList_t *>(
+        desc.orig_vtable
+            [desc.vm_idxs
+                 [steam_api::
+                      ISteamMatchmakingServers_m_RequestFavoritesServerList]]);
+    desc.vtable
+        [desc.vm_idxs
+             [steam_api::
+                  ISteamMatchmakingServers_m_RequestFavoritesServerList]] =
+        reinterpret_cast<void *>(
+            SteamMatchmakingServers_RequestFavoritesServerList);
+    SteamMatchmakingServers_RequestHistoryServerList_orig = reinterpret_cast<
+        steam_api::ISteamMatchmakingServers_RequestHistoryServerList_t *>(
+        desc.orig_vtable
+            [desc.vm_idxs
+                 [steam_api::
+                      ISteamMatchmakingServers_m_RequestHistoryServerList]]);
+    desc.vtable
+        [desc.vm_idxs
+             [steam_api::ISteamMatchmakingServers_m_RequestHistoryServerList]] =
+        reinterpret_cast<void *>(
+            SteamMatchmakingServers_RequestHistoryServerList);
+    SteamMatchmakingServers_PingServer_orig = reinterpret_cast<
+        steam_api::ISteamMatchmakingServers_PingServer_t *>(
+        desc.orig_vtable
+            [desc.vm_idxs[steam_api::ISteamMatchmakingServers_m_PingServer]]);
+    const auto &mm_desc{steam_api::ISteamMatchmaking_desc};
+    SteamMatchmaking_GetFavoriteGameCount_orig = reinterpret_cast<
+        steam_api::ISteamMatchmaking_GetFavoriteGameCount_t *>(
+        mm_desc.orig_vtable
+            [mm_desc.vm_idxs
+                 [steam_api::ISteamMatchmaking_m_GetFavoriteGameCount]]);
+    SteamMatchmaking_GetFavoriteGame_orig =
+        reinterpret_cast<steam_api::ISteamMatchmaking_GetFavoriteGame_t *>(
+            mm_desc.orig_vtable
+                [mm_desc.vm_idxs
+                     [steam_api::ISteamMatchmaking_m_GetFavoriteGame]]);
+  } // if (probe_favorite_servers)
   if (g_settings.steam->spoof_app_id != 346110) {
-    if (!ws_dir_path.empty()) {
-      const std::filesystem::path path{
-          std::u8string{ws_dir_path.cbegin(), ws_dir_path.cend()}};
-      if (std::filesystem::exists(path)) {
-        // Get initial mod list
-        for (const auto &child : std::filesystem::directory_iterator{path}) {
-          if (!child.is_directory()) {
-            continue;
-          }
-          const auto &name{child.path().filename().native()};
-          wchar_t *endptr;
-          const auto id{std::wcstoull(name.data(), &endptr, 10)};
-          if (id && endptr == std::to_address(name.end())) {
-            mods.emplace_back(id);
-          }
+    std::vector<std::uint64_t> ids;
+    {
+      const std::scoped_lock lock{mods_mtx};
+      if (!mod_profile.empty()) {
+        if (const auto it{mod_profiles.find(mod_profile)};
+            it != mod_profiles.end()) {
+          active_profile = &it->second;
+        } else if (auto_mod_profile) {
+          // The profile is filled with mods that the game requests
+          active_profile = &mod_profiles[mod_profile];
+          log::info("Created mod profile \"{}\"", mod_profile);
+        } else {
+          log::warning("Mod profile \"{}\" doesn't exist, exposing all "
+                       "installed mods",
+                       mod_profile);
         }
-        steamclient::load();
       }
+      ids = exposed_mods();
+    }
+    if (prefetch_mod_files && !ids.empty()) {
+      prefetch_pool().submit([ids] { prefetch_mods(ids); },
+                             jobs::priority::low);
     }
     // Setup wrappers for ISteamUGC
     auto &desc{steam_api::ISteamUGC_desc};
@@ -525,20 +2232,111 @@ void steam_api_init_346110() {
           reinterpret_cast<void *>(SteamUGC_SubscribeItem);
       desc.vtable[desc.vm_idxs[steam_api::ISteamUGC_m_GetItemUpdateInfo]] =
           reinterpret_cast<void *>(SteamUGC_GetItemUpdateInfo);
+      // Current vtable entries may be runtime wrappers already, which answer
+      //    for synthetic calls
       auto &desc{steam_api::ISteamUtils_desc};
       SteamUtils_IsAPICallCompleted_orig =
           reinterpret_cast<steam_api::ISteamUtils_IsAPICallCompleted_t *>(
-              desc.orig_vtable
+              desc.vtable
                   [desc.vm_idxs[steam_api::ISteamUtils_m_IsAPICallCompleted]]);
       desc.vtable[desc.vm_idxs[steam_api::ISteamUtils_m_IsAPICallCompleted]] =
           reinterpret_cast<void *>(SteamUtils_IsAPICallCompleted);
       SteamUtils_GetAPICallResult_orig =
           reinterpret_cast<steam_api::ISteamUtils_GetAPICallResult_t *>(
-              desc.orig_vtable
+              desc.vtable
                   [desc.vm_idxs[steam_api::ISteamUtils_m_GetAPICallResult]]);
       desc.vtable[desc.vm_idxs[steam_api::ISteamUtils_m_GetAPICallResult]] =
           reinterpret_cast<void *>(SteamUtils_GetAPICallResult);
+      if (update_mod_files) {
+        // Download updates of installed mods before the game joins a server
+        //    that needs them
+        ws_jobs::update(ws_am_wpath.data(), ws_dir_wpath.data(), ids,
+                        job_finish_handler, reserve_mod_update,
+                        register_mod_update);
+      }
+    }
+  }
+}
+
+void steam_game_server_init_346110() {
+  if (ws_dir_path.empty()) {
+    return;
+  }
+  const std::filesystem::path path{ws_dir_wpath};
+  if (std::error_code ec; std::filesystem::exists(path, ec)) {
+    load_mods(path);
+  }
+  steamclient::load();
+  if (!steamclient::loaded) {
+    return;
+  }
+  // Several server instances on the host may use the same store, so items
+  //    are installed under a cross-process lock
+  ws_jobs::shared_dir = true;
+  // Setup wrappers for ISteamUGC
+  auto &desc{steam_api::ISteamUGC_desc};
+  if (desc.vm_idxs[steam_api::ISteamUGC_m_BInitWorkshopForGameServer] >= 0) {
+    desc.vtable
+        [desc.vm_idxs[steam_api::ISteamUGC_m_BInitWorkshopForGameServer]] =
+        reinterpret_cast<void *>(SteamUGC_BInitWorkshopForGameServer);
+  }
+  if (desc.vm_idxs[steam_api::ISteamUGC_m_DownloadItem] >= 0) {
+    desc.vtable[desc.vm_idxs[steam_api::ISteamUGC_m_DownloadItem]] =
+        reinterpret_cast<void *>(SteamUGC_DownloadItem);
+  }
+  if (desc.vm_idxs[steam_api::ISteamUGC_m_GetItemState] >= 0) {
+    desc.vtable[desc.vm_idxs[steam_api::ISteamUGC_m_GetItemState]] =
+        reinterpret_cast<void *>(SteamUGC_GetItemState);
+  }
+  desc.vtable[desc.vm_idxs[steam_api::ISteamUGC_m_GetItemInstallInfo]] =
+      reinterpret_cast<void *>(SteamUGC_GetItemInstallInfo);
+  desc.vtable[desc.vm_idxs[steam_api::ISteamUGC_m_GetItemUpdateInfo]] =
+      reinterpret_cast<void *>(SteamUGC_GetItemUpdateInfo);
+}
+
+void steam_api_run_callbacks_346110() {
+  if (a2s_running) {
+    a2s::dispatch();
+  }
+  if (probe_favorite_servers) {
+    probe_next_server();
+  }
+  // Handlers may start and release requests, so wrappers are accessed by
+  //    index, and wrappers added by handlers wait until the next call
+  for (std::size_t i{}, num{list_wrappers.size()}; i < num; ++i) {
+    if (const auto wrapper{list_wrappers[i].get()};
+        wrapper->request && wrapper->replay_pending) {
+      wrapper->replay();
+    }
+  }
+  std::erase_if(list_wrappers,
+                [](const auto &wrapper) { return !wrapper->request; });
+  if (prefetch) {
+    if (prefetch->request && prefetch->flush_pending) {
+      prefetch->flush();
+    }
+    if (!prefetch->request) {
+      prefetch.reset();
+    } else if (!prefetch->target &&
+               std::chrono::steady_clock::now() - prefetch_time >=
+                   prefetch_attach_timeout) {
+      // The game hasn't opened the server browser in time
+      release_prefetch();
+    }
+  }
+  // Queries are taken one at a time so that handlers may cancel the remaining
+  //    ones, and queries issued by handlers wait until the next call
+  for (const auto end{next_cached_query};
+       !cached_rules_queries.empty() &&
+       cached_rules_queries.front().query < end;) {
+    const auto query{cached_rules_queries.front()};
+    cached_rules_queries.pop_front();
+    if (query.rejected) {
+      query.handler->RulesFailedToRespond();
+      continue;
     }
+    (new a2s_rules_wrapper{query.handler, query.server_key})
+        ->rules_received(prefetched_rules[query.server_key]);
   }
 }
 
@@ -14,13 +14,26 @@
 //===----------------------------------------------------------------------===//
 #include "steam_api.hpp"
 
+#include "call_results.hpp"
 #include "common.hpp"
 #include "game_cbs.hpp"
+#include "http_cache.hpp"
+#include "id_set.hpp"
+#include "jobs.hpp"
+#include "log.hpp"
+#include "memory.hpp"
+#include "metrics.hpp"
+#include "remote_storage_cache.hpp"
 #include "settings.hpp"
+#include "shared_cache.hpp"
+#include "steam_http.hpp"
 #include "tek-steamclient.hpp"
+#include "utf.hpp"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -28,28 +41,67 @@
 #include <format>
 #include <iterator>
 #include <locale>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <ranges>
+#include <shared_mutex>
 #include <span>
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace tek::game_runtime::steam_api {
 
 namespace {
 
-//===-- Common Steam API method wrappers ----------------------------------===//
+//===-- DLC index ---------------------------------------------------------===//
 
-/// Wrapper for ISteamApps::BIsSubscribed, making it always return `true`.
-static bool SteamApps_BIsSubscribed(void *) noexcept { return true; }
+/// Snapshot of DLC lists from settings, that DLC lookup wrappers read without
+///    locking.
+struct dlc_index {
+  /// IDs of "owned" DLC.
+  id_set owned;
+  /// IDs of "installed" DLC.
+  id_set installed;
+};
+
+/// Pointer to the current DLC index. Replaced indexes are never freed, since
+///    wrappers may still be reading them, and DLC lists change only a few
+///    times per process lifetime.
+static std::atomic<const dlc_index *> current_dlc_index;
+/// Mutex serializing DLC index rebuilds.
+static std::mutex dlc_index_mtx;
+/// Value indicating whether DLC lookup wrappers have been installed into
+///    ISteamApps vtable, so they should be re-selected with each rebuild.
+static bool dlc_wrappers_installed;
+
+//===-- DLC lookup method wrappers ----------------------------------------===//
 
 /// Pointer to the original ISteamApps::BIsSubscribedApp method.
 static ISteamApps_BIsSubscribedApp_t *_Nonnull SteamApps_BIsSubscribedApp_orig;
 /// Wrapper for ISteamApps::BIsSubscribedApp, making it always return `true` for
 ///    current application ID and DLC listed in settings.
+///
+/// @tparam layout
+///    Layout of the owned DLC set that the variant is specialized for. If the
+///    index has been replaced with one of different layout before the variant
+///    is, generic lookup is used.
+template <id_set_kind layout>
 static bool SteamApps_BIsSubscribedApp(void *_Nonnull iface,
                                        std::uint32_t app_id) {
-  if (app_id == g_settings.steam->app_id ||
-      std::ranges::contains(g_settings.steam->dlc | std::views::elements<0>,
-                            app_id)) {
+  if (app_id == g_settings.steam->app_id) {
+    return true;
+  }
+  const auto &set{current_dlc_index.load(std::memory_order::acquire)->owned};
+  if (set.kind == layout ? set.contains<layout>(app_id)
+                         : set.contains(app_id)) {
     return true;
   }
   return SteamApps_BIsSubscribedApp_orig(iface, app_id);
@@ -57,10 +109,105 @@ static bool SteamApps_BIsSubscribedApp(void *_Nonnull iface,
 
 /// Wrapper for ISteamApps::BIsDlcInstalled, making it always return `true` for
 ///    IDs listed in the settings.
+///
+/// @tparam layout
+///    Layout of the installed DLC set that the variant is specialized for.
+template <id_set_kind layout>
 static bool SteamApps_BIsDlcInstalled(void *, std::uint32_t app_id) {
-  return g_settings.steam->installed_dlc.contains(app_id);
+  const auto &set{
+      current_dlc_index.load(std::memory_order::acquire)->installed};
+  return set.kind == layout ? set.contains<layout>(app_id)
+                            : set.contains(app_id);
+}
+
+/// Pointer to the original ISteamApps::BIsAppInstalled method.
+static ISteamApps_BIsAppInstalled_t *_Nonnull SteamApps_BIsAppInstalled_orig;
+/// Wrapper for ISteamApps::BIsAppInstalled, making it always return `true` for
+///    current application ID and installed DLC listed in the settings.
+///
+/// @tparam layout
+///    Layout of the installed DLC set that the variant is specialized for.
+template <id_set_kind layout>
+static bool SteamApps_BIsAppInstalled(void *_Nonnull iface,
+                                      std::uint32_t app_id) {
+  if (app_id == g_settings.steam->app_id) {
+    return true;
+  }
+  const auto &set{
+      current_dlc_index.load(std::memory_order::acquire)->installed};
+  if (set.kind == layout ? set.contains<layout>(app_id)
+                         : set.contains(app_id)) {
+    return true;
+  }
+  return SteamApps_BIsAppInstalled_orig(iface, app_id);
 }
 
+/// Tag type carrying a set layout as a template argument.
+template <id_set_kind layout>
+using layout_tag = std::integral_constant<id_set_kind, layout>;
+
+/// Get the variant of a DLC lookup wrapper specialized for specified layout.
+///
+/// @param layout
+///    Layout of the set that the wrapper looks up IDs in.
+/// @param get
+///    Function object that receives a @ref layout_tag and returns pointer to
+///    the wrapper variant for it.
+/// @return Pointer to the wrapper variant, as a vtable entry.
+static void *_Nonnull select_variant(id_set_kind layout, auto get) noexcept {
+  switch (layout) {
+  case id_set_kind::empty:
+    return get(layout_tag<id_set_kind::empty>{});
+  case id_set_kind::linear:
+    return get(layout_tag<id_set_kind::linear>{});
+  case id_set_kind::bitmap:
+    return get(layout_tag<id_set_kind::bitmap>{});
+  case id_set_kind::hashed:
+    break;
+  }
+  return get(layout_tag<id_set_kind::hashed>{});
+}
+
+/// Set ISteamApps vtable entries for DLC lookup methods to wrapper variants
+///    matching specified index. The game may be calling the methods
+///    concurrently, so entries are replaced atomically. Must be called with
+///    @ref dlc_index_mtx locked.
+///
+/// @param [in] index
+///    The index that wrappers will read.
+static void select_dlc_wrappers(const dlc_index &index) {
+  const auto set_entry{[](ISteamApps_m method, void *_Nonnull fn) {
+    const auto idx{ISteamApps_desc.vm_idxs[method]};
+    if (idx >= 0) {
+      std::atomic_ref{ISteamApps_desc.vtable[idx]}.store(
+          fn, std::memory_order::release);
+    }
+  }};
+  set_entry(ISteamApps_m_BIsSubscribedApp,
+            select_variant(index.owned.kind,
+                           []<id_set_kind layout>(layout_tag<layout>) {
+                             return reinterpret_cast<void *>(
+                                 SteamApps_BIsSubscribedApp<layout>);
+                           }));
+  set_entry(ISteamApps_m_BIsDlcInstalled,
+            select_variant(index.installed.kind,
+                           []<id_set_kind layout>(layout_tag<layout>) {
+                             return reinterpret_cast<void *>(
+                                 SteamApps_BIsDlcInstalled<layout>);
+                           }));
+  set_entry(ISteamApps_m_BIsAppInstalled,
+            select_variant(index.installed.kind,
+                           []<id_set_kind layout>(layout_tag<layout>) {
+                             return reinterpret_cast<void *>(
+                                 SteamApps_BIsAppInstalled<layout>);
+                           }));
+}
+
+//===-- Common Steam API method wrappers ----------------------------------===//
+
+/// Wrapper for ISteamApps::BIsSubscribed, making it always return `true`.
+static bool SteamApps_BIsSubscribed(void *) noexcept { return true; }
+
 /// Wrapper for ISteamApps::BIsSubscribedFromFreeWeekend, making it always
 ///    return `false`.
 static bool SteamApps_BIsSubscribedFromFreeWeekend(void *) noexcept {
@@ -69,7 +216,8 @@ static bool SteamApps_BIsSubscribedFromFreeWeekend(void *) noexcept {
 
 /// Wrapper for ISteamApps::GetDLCCount, making it return the number of DLC
 ///    entries in settings.
-static int SteamApps_GetDLCCount(void *) noexcept {
+static int SteamApps_GetDLCCount(void *) {
+  const std::shared_lock lock{g_settings.steam->dlc_mtx};
   return g_settings.steam->dlc.size();
 }
 
@@ -80,6 +228,7 @@ static bool SteamApps_BGetDLCDataByIndex(void *, int idx,
                                          bool *_Nonnull available,
                                          char *_Nullable name_buf,
                                          int name_buf_size) {
+  const std::shared_lock lock{g_settings.steam->dlc_mtx};
   if (idx < static_cast<int>(g_settings.steam->dlc.size())) {
     return false;
   }
@@ -92,19 +241,6 @@ static bool SteamApps_BGetDLCDataByIndex(void *, int idx,
   return true;
 }
 
-/// Pointer to the original ISteamApps::BIsAppInstalled method.
-static ISteamApps_BIsAppInstalled_t *_Nonnull SteamApps_BIsAppInstalled_orig;
-/// Wrapper for ISteamApps::BIsAppInstalled, making it always return `true` for
-///    current application ID and installed DLC listed in the settings.
-static bool SteamApps_BIsAppInstalled(void *_Nonnull iface,
-                                      std::uint32_t app_id) {
-  if (app_id == g_settings.steam->app_id ||
-      g_settings.steam->installed_dlc.contains(app_id)) {
-    return true;
-  }
-  return SteamApps_BIsAppInstalled_orig(iface, app_id);
-}
-
 /// Wrapper for ISteamApps::GetAppOwner, making it return current user's Steam
 ///    ID.
 static std::uint64_t *_Nonnull SteamApps_GetAppOwner(
@@ -137,6 +273,1387 @@ static std::uint32_t SteamUtils_GetAppID(void *) noexcept {
   return g_settings.steam->app_id;
 }
 
+//===-- Lobby data caching ------------------------------------------------===//
+
+/// Cached results of ISteamMatchmaking getters for a lobby.
+struct lobby_data {
+  /// Values returned by GetLobbyData, keyed by metadata key.
+  std::pmr::map<std::pmr::string, std::pmr::string, std::less<>> values{
+      &memory::resource(memory::subsystem::lobby_cache)};
+  /// Key/value pairs returned by GetLobbyDataByIndex, keyed by index.
+  std::pmr::unordered_map<int, std::pair<std::pmr::string, std::pmr::string>>
+      indexed{&memory::resource(memory::subsystem::lobby_cache)};
+  /// Value returned by GetLobbyDataCount, or `-1` if it's not cached yet.
+  int count{-1};
+  /// Value returned by GetNumLobbyMembers, or `-1` if it's not cached yet.
+  int num_members{-1};
+};
+
+/// Number of lobbies in @ref lobby_cache above which data of lobbies that the
+///    user isn't in is dropped.
+constexpr std::size_t max_cached_lobbies{512};
+
+/// Cached lobby data, keyed by lobby Steam ID.
+static std::pmr::unordered_map<std::uint64_t, lobby_data> lobby_cache{
+    &memory::resource(memory::subsystem::lobby_cache)};
+/// Steam IDs of lobbies that the user is currently in. Their data is kept
+///    when lobby lists are refreshed.
+static std::pmr::unordered_set<std::uint64_t> joined_lobbies{
+    &memory::resource(memory::subsystem::lobby_cache)};
+/// Mutex for locking concurrent access to @ref lobby_cache and
+///    @ref joined_lobbies.
+static std::mutex lobby_cache_mtx;
+/// Number of lobby getter calls answered from @ref lobby_cache.
+static metrics::counter lobby_cache_hits{"steam_api.lobby_cache.hits"};
+/// Number of lobby getter calls forwarded to Steam.
+static metrics::counter lobby_cache_misses{"steam_api.lobby_cache.misses"};
+
+/// Drop cached data of all lobbies that the user isn't in. @ref lobby_cache_mtx
+///    must be locked by the caller.
+static void drop_browsed_lobbies() {
+  std::erase_if(lobby_cache, [](const auto &entry) {
+    return !joined_lobbies.contains(entry.first);
+  });
+}
+
+/// Get cached data of a lobby, creating an empty entry if there is none yet.
+///    If @ref lobby_cache is full, data of lobbies that the user isn't in is
+///    dropped first. @ref lobby_cache_mtx must be locked by the caller.
+///
+/// @param lobby
+///    Steam ID of the lobby.
+/// @return Reference to the lobby's cached data.
+static lobby_data &get_lobby_data(std::uint64_t lobby) {
+  if (lobby_cache.size() >= max_cached_lobbies &&
+      !lobby_cache.contains(lobby)) {
+    drop_browsed_lobbies();
+  }
+  return lobby_cache[lobby];
+}
+
+/// Receiver for ISteamMatchmaking callbacks that invalidate cached lobby
+///    data.
+class lobby_cache_invalidator final : public CCallbackBase {
+  /// Size of the callback structure.
+  const int size;
+  /// Function that updates @ref lobby_cache from the callback structure,
+  ///    called with @ref lobby_cache_mtx locked.
+  void (*const _Nonnull invalidate)(const void *_Nonnull param);
+
+public:
+  constexpr lobby_cache_invalidator(
+      int size, void (*_Nonnull invalidate)(const void *_Nonnull)) noexcept
+      : size{size}, invalidate{invalidate} {}
+
+  void Run(void *_Nonnull param, bool, std::uint64_t) override { Run(param); }
+  void Run(void *_Nonnull param) override {
+    const std::scoped_lock lock{lobby_cache_mtx};
+    invalidate(param);
+  }
+  int GetCallbackSizeBytes() override { return size; }
+};
+
+/// Drop cached data of the lobby that a callback structure begins with.
+///
+/// @param [in] param
+///    Pointer to the callback structure.
+static void drop_lobby(const void *_Nonnull param) {
+  lobby_cache.erase(*reinterpret_cast<const std::uint64_t *>(param));
+}
+
+/// Invalidator for LobbyEnter_t callback, which also tracks lobbies that the
+///    user has entered.
+static lobby_cache_invalidator lobby_enter_invalidator{
+    24, [](const void *_Nonnull param) {
+      drop_lobby(param);
+      // m_EChatRoomEnterResponse, k_EChatRoomEnterResponseSuccess
+      if (*reinterpret_cast<const std::uint32_t *>(
+              reinterpret_cast<const std::byte *>(param) + 16) == 1) {
+        joined_lobbies.emplace(*reinterpret_cast<const std::uint64_t *>(param));
+      }
+    }};
+/// Invalidator for LobbyDataUpdate_t callback.
+static lobby_cache_invalidator lobby_data_update_invalidator{24, drop_lobby};
+/// Invalidator for LobbyChatUpdate_t callback.
+static lobby_cache_invalidator lobby_chat_update_invalidator{32, drop_lobby};
+/// Invalidator for LobbyMatchList_t callback, delivered when a new lobby list
+///    arrives. Steam refreshes data of listed lobbies with it.
+static lobby_cache_invalidator lobby_match_list_invalidator{
+    4, [](const void *_Nonnull) { drop_browsed_lobbies(); }};
+
+/// Pointer to the original ISteamMatchmaking::RequestLobbyList method.
+static ISteamMatchmaking_RequestLobbyList_t
+    *_Nonnull SteamMatchmaking_RequestLobbyList_orig;
+/// Wrapper for ISteamMatchmaking::RequestLobbyList, making it drop cached data
+///    of lobbies that the user isn't in, since the new list refreshes it.
+static std::uint64_t SteamMatchmaking_RequestLobbyList(void *_Nonnull iface) {
+  {
+    const std::scoped_lock lock{lobby_cache_mtx};
+    drop_browsed_lobbies();
+  }
+  return SteamMatchmaking_RequestLobbyList_orig(iface);
+}
+
+/// Pointer to the original ISteamMatchmaking::LeaveLobby method.
+static ISteamMatchmaking_LeaveLobby_t
+    *_Nonnull SteamMatchmaking_LeaveLobby_orig;
+/// Wrapper for ISteamMatchmaking::LeaveLobby, making it drop cached data of the
+///    lobby.
+static void SteamMatchmaking_LeaveLobby(void *_Nonnull iface,
+                                        std::uint64_t lobby) {
+  SteamMatchmaking_LeaveLobby_orig(iface, lobby);
+  const std::scoped_lock lock{lobby_cache_mtx};
+  lobby_cache.erase(lobby);
+  joined_lobbies.erase(lobby);
+}
+
+/// Pointer to the original ISteamMatchmaking::GetNumLobbyMembers method.
+static ISteamMatchmaking_GetNumLobbyMembers_t
+    *_Nonnull SteamMatchmaking_GetNumLobbyMembers_orig;
+/// Wrapper for ISteamMatchmaking::GetNumLobbyMembers, making it use
+///    @ref lobby_cache.
+static int SteamMatchmaking_GetNumLobbyMembers(void *_Nonnull iface,
+                                               std::uint64_t lobby) {
+  const std::scoped_lock lock{lobby_cache_mtx};
+  auto &num_members{get_lobby_data(lobby).num_members};
+  if (num_members >= 0) {
+    lobby_cache_hits.add();
+  } else {
+    lobby_cache_misses.add();
+    num_members = SteamMatchmaking_GetNumLobbyMembers_orig(iface, lobby);
+  }
+  return num_members;
+}
+
+/// Pointer to the original ISteamMatchmaking::GetLobbyData method.
+static ISteamMatchmaking_GetLobbyData_t
+    *_Nonnull SteamMatchmaking_GetLobbyData_orig;
+/// Wrapper for ISteamMatchmaking::GetLobbyData, making it use
+///    @ref lobby_cache.
+static const char *_Nonnull SteamMatchmaking_GetLobbyData(
+    void *_Nonnull iface, std::uint64_t lobby, const char *_Nonnull key) {
+  const std::scoped_lock lock{lobby_cache_mtx};
+  auto &values{get_lobby_data(lobby).values};
+  if (const auto it{values.find(std::string_view{key})};
+      it != values.end()) {
+    lobby_cache_hits.add();
+    return it->second.data();
+  }
+  lobby_cache_misses.add();
+  return values.emplace(key, SteamMatchmaking_GetLobbyData_orig(iface, lobby,
+                                                                key))
+      .first->second.data();
+}
+
+/// Pointer to the original ISteamMatchmaking::SetLobbyData method.
+static ISteamMatchmaking_SetLobbyData_t
+    *_Nonnull SteamMatchmaking_SetLobbyData_orig;
+/// Wrapper for ISteamMatchmaking::SetLobbyData, making it drop cached data of
+///    the lobby.
+static bool SteamMatchmaking_SetLobbyData(void *_Nonnull iface,
+                                          std::uint64_t lobby,
+                                          const char *_Nonnull key,
+                                          const char *_Nonnull value) {
+  const auto res{SteamMatchmaking_SetLobbyData_orig(iface, lobby, key, value)};
+  const std::scoped_lock lock{lobby_cache_mtx};
+  lobby_cache.erase(lobby);
+  return res;
+}
+
+/// Pointer to the original ISteamMatchmaking::GetLobbyDataCount method.
+static ISteamMatchmaking_GetLobbyDataCount_t
+    *_Nonnull SteamMatchmaking_GetLobbyDataCount_orig;
+/// Wrapper for ISteamMatchmaking::GetLobbyDataCount, making it use
+///    @ref lobby_cache.
+static int SteamMatchmaking_GetLobbyDataCount(void *_Nonnull iface,
+                                              std::uint64_t lobby) {
+  const std::scoped_lock lock{lobby_cache_mtx};
+  auto &count{get_lobby_data(lobby).count};
+  if (count >= 0) {
+    lobby_cache_hits.add();
+  } else {
+    lobby_cache_misses.add();
+    count = SteamMatchmaking_GetLobbyDataCount_orig(iface, lobby);
+  }
+  return count;
+}
+
+/// Pointer to the original ISteamMatchmaking::GetLobbyDataByIndex method.
+static ISteamMatchmaking_GetLobbyDataByIndex_t
+    *_Nonnull SteamMatchmaking_GetLobbyDataByIndex_orig;
+/// Wrapper for ISteamMatchmaking::GetLobbyDataByIndex, making it use
+///    @ref lobby_cache.
+static bool SteamMatchmaking_GetLobbyDataByIndex(
+    void *_Nonnull iface, std::uint64_t lobby, int idx, char *_Nonnull key,
+    int key_size, char *_Nonnull value, int value_size) {
+  const std::scoped_lock lock{lobby_cache_mtx};
+  auto &indexed{get_lobby_data(lobby).indexed};
+  auto it{indexed.find(idx)};
+  if (it != indexed.end()) {
+    lobby_cache_hits.add();
+  } else {
+    lobby_cache_misses.add();
+    // Use buffers of maximum sizes so that cached values are never truncated
+    //    (k_nMaxLobbyKeyLength and k_cubChatMetadataMax)
+    std::array<char, 256> key_buf;
+    std::array<char, 8192> value_buf;
+    if (!SteamMatchmaking_GetLobbyDataByIndex_orig(
+            iface, lobby, idx, key_buf.data(), key_buf.size(),
+            value_buf.data(), value_buf.size())) {
+      return false;
+    }
+    it = indexed.try_emplace(idx, key_buf.data(), value_buf.data()).first;
+  }
+  const auto &[cached_key, cached_value]{it->second};
+  if (key_size > 0) {
+    key[cached_key.copy(key, key_size - 1)] = '\0';
+  }
+  if (value_size > 0) {
+    value[cached_value.copy(value, value_size - 1)] = '\0';
+  }
+  return true;
+}
+
+/// Pointer to the original ISteamMatchmaking::DeleteLobbyData method.
+static ISteamMatchmaking_DeleteLobbyData_t
+    *_Nonnull SteamMatchmaking_DeleteLobbyData_orig;
+/// Wrapper for ISteamMatchmaking::DeleteLobbyData, making it drop cached data
+///    of the lobby.
+static bool SteamMatchmaking_DeleteLobbyData(void *_Nonnull iface,
+                                             std::uint64_t lobby,
+                                             const char *_Nonnull key) {
+  const auto res{SteamMatchmaking_DeleteLobbyData_orig(iface, lobby, key)};
+  const std::scoped_lock lock{lobby_cache_mtx};
+  lobby_cache.erase(lobby);
+  return res;
+}
+
+//===-- Remote storage write-back caching ---------------------------------===//
+
+/// Pointer to the original ISteamRemoteStorage::FileWrite method.
+static ISteamRemoteStorage_FileWrite_t
+    *_Nonnull SteamRemoteStorage_FileWrite_orig;
+/// Pointer to the original ISteamRemoteStorage::FileDelete method.
+static ISteamRemoteStorage_FileDelete_t
+    *_Nonnull SteamRemoteStorage_FileDelete_orig;
+
+/// Backing storage of the remote storage cache, which is Steam itself.
+static constexpr remote_storage_cache::backend cloud_backend{
+    .write =
+        [](const char *_Nonnull name, std::span<const std::byte> data) {
+          return SteamRemoteStorage_FileWrite_orig(
+              ISteamRemoteStorage_desc.iface, name, data.data(), data.size());
+        },
+    // Deletion fails if the file has never reached Steam, which leaves it in
+    //    the desired state anyway
+    .remove =
+        [](const char *_Nonnull name) {
+          SteamRemoteStorage_FileDelete_orig(ISteamRemoteStorage_desc.iface,
+                                             name);
+        },
+    // Let Steam upload the whole batch at once where supported
+    .begin_batch =
+        [] {
+          const auto &desc{ISteamRemoteStorage_desc};
+          if (const auto idx{
+                  desc.vm_idxs[ISteamRemoteStorage_m_BeginFileWriteBatch]};
+              idx >= 0) {
+            reinterpret_cast<ISteamRemoteStorage_BeginFileWriteBatch_t *>(
+                desc.orig_vtable[idx])(desc.iface);
+          }
+        },
+    .end_batch =
+        [] {
+          const auto &desc{ISteamRemoteStorage_desc};
+          if (const auto idx{
+                  desc.vm_idxs[ISteamRemoteStorage_m_EndFileWriteBatch]};
+              idx >= 0) {
+            reinterpret_cast<ISteamRemoteStorage_EndFileWriteBatch_t *>(
+                desc.orig_vtable[idx])(desc.iface);
+          }
+        }};
+
+/// Wrapper for ISteamRemoteStorage::FileWrite, making it store file contents
+///    in the remote storage cache and write them to Steam in background.
+static bool SteamRemoteStorage_FileWrite(void *_Nonnull iface,
+                                         const char *_Nonnull file,
+                                         const void *_Nonnull data,
+                                         std::int32_t size) {
+  if (size < 0 || size > remote_storage_cache::max_file_size) {
+    remote_storage_cache::drop(file);
+    return SteamRemoteStorage_FileWrite_orig(iface, file, data, size);
+  }
+  remote_storage_cache::write(
+      file, {reinterpret_cast<const std::byte *>(data),
+             static_cast<std::size_t>(size)});
+  return true;
+}
+
+/// Pointer to the original ISteamRemoteStorage::FileRead method.
+static ISteamRemoteStorage_FileRead_t
+    *_Nonnull SteamRemoteStorage_FileRead_orig;
+/// Pointer to the original ISteamRemoteStorage::GetFileSize method.
+static ISteamRemoteStorage_GetFileSize_t
+    *_Nonnull SteamRemoteStorage_GetFileSize_orig;
+/// Wrapper for ISteamRemoteStorage::FileRead, making it use the remote
+///    storage cache.
+static std::int32_t SteamRemoteStorage_FileRead(void *_Nonnull iface,
+                                                const char *_Nonnull file,
+                                                void *_Nonnull data,
+                                                std::int32_t size) {
+  const auto bytes{reinterpret_cast<std::byte *>(data)};
+  if (const auto res{remote_storage_cache::read(
+          file, {bytes, static_cast<std::size_t>(std::max(size, 0))})};
+      res) {
+    return *res;
+  }
+  const auto res{SteamRemoteStorage_FileRead_orig(iface, file, data, size)};
+  // Cache file contents only if they have been read completely
+  if (res > 0 && res <= remote_storage_cache::max_file_size &&
+      (res < size || SteamRemoteStorage_GetFileSize_orig(iface, file) == res)) {
+    remote_storage_cache::fill(file, {bytes, static_cast<std::size_t>(res)});
+  }
+  return res;
+}
+
+/// Wrapper for ISteamRemoteStorage::FileDelete, making it mark the file as
+///    deleted in the remote storage cache and delete it from Steam in
+///    background.
+static bool SteamRemoteStorage_FileDelete(void *_Nonnull iface,
+                                          const char *_Nonnull file) {
+  if (const auto existed{remote_storage_cache::remove(file)}; existed) {
+    return *existed;
+  }
+  return SteamRemoteStorage_FileDelete_orig(iface, file);
+}
+
+/// Pointer to the original ISteamRemoteStorage::FileExists method.
+static ISteamRemoteStorage_FileExists_t
+    *_Nonnull SteamRemoteStorage_FileExists_orig;
+/// Wrapper for ISteamRemoteStorage::FileExists, making it use the remote
+///    storage cache.
+static bool SteamRemoteStorage_FileExists(void *_Nonnull iface,
+                                          const char *_Nonnull file) {
+  if (const auto exists{remote_storage_cache::exists(file)}; exists) {
+    return *exists;
+  }
+  return SteamRemoteStorage_FileExists_orig(iface, file);
+}
+
+/// Wrapper for ISteamRemoteStorage::GetFileSize, making it use the remote
+///    storage cache.
+static std::int32_t SteamRemoteStorage_GetFileSize(void *_Nonnull iface,
+                                                   const char *_Nonnull file) {
+  if (const auto size{remote_storage_cache::size(file)}; size) {
+    return *size;
+  }
+  return SteamRemoteStorage_GetFileSize_orig(iface, file);
+}
+
+/// Pointer to the original ISteamRemoteStorage::FileWriteAsync method.
+static ISteamRemoteStorage_FileWriteAsync_t
+    *_Nonnull SteamRemoteStorage_FileWriteAsync_orig;
+/// Wrapper for ISteamRemoteStorage::FileWriteAsync, making it write pending
+///    changes first and drop cached state of the file.
+static std::uint64_t SteamRemoteStorage_FileWriteAsync(
+    void *_Nonnull iface, const char *_Nonnull file, const void *_Nonnull data,
+    std::uint32_t size) {
+  remote_storage_cache::drop(file);
+  return SteamRemoteStorage_FileWriteAsync_orig(iface, file, data, size);
+}
+
+/// Pointer to the original ISteamRemoteStorage::FileReadAsync method.
+static ISteamRemoteStorage_FileReadAsync_t
+    *_Nonnull SteamRemoteStorage_FileReadAsync_orig;
+/// Wrapper for ISteamRemoteStorage::FileReadAsync, making it write pending
+///    changes first.
+static std::uint64_t SteamRemoteStorage_FileReadAsync(void *_Nonnull iface,
+                                                      const char *_Nonnull file,
+                                                      std::uint32_t offset,
+                                                      std::uint32_t size) {
+  remote_storage_cache::flush();
+  return SteamRemoteStorage_FileReadAsync_orig(iface, file, offset, size);
+}
+
+/// Pointer to the original ISteamRemoteStorage::FileForget method.
+static ISteamRemoteStorage_FileForget_t
+    *_Nonnull SteamRemoteStorage_FileForget_orig;
+/// Wrapper for ISteamRemoteStorage::FileForget, making it write pending
+///    changes first.
+static bool SteamRemoteStorage_FileForget(void *_Nonnull iface,
+                                          const char *_Nonnull file) {
+  remote_storage_cache::flush();
+  return SteamRemoteStorage_FileForget_orig(iface, file);
+}
+
+/// Pointer to the original ISteamRemoteStorage::FileWriteStreamOpen method.
+static ISteamRemoteStorage_FileWriteStreamOpen_t
+    *_Nonnull SteamRemoteStorage_FileWriteStreamOpen_orig;
+/// Wrapper for ISteamRemoteStorage::FileWriteStreamOpen, making it write
+///    pending changes first and drop cached state of the file.
+static std::uint64_t
+SteamRemoteStorage_FileWriteStreamOpen(void *_Nonnull iface,
+                                       const char *_Nonnull file) {
+  remote_storage_cache::drop(file);
+  return SteamRemoteStorage_FileWriteStreamOpen_orig(iface, file);
+}
+
+/// Pointer to the original ISteamRemoteStorage::GetFileTimestamp method.
+static ISteamRemoteStorage_GetFileTimestamp_t
+    *_Nonnull SteamRemoteStorage_GetFileTimestamp_orig;
+/// Wrapper for ISteamRemoteStorage::GetFileTimestamp, making it write pending
+///    changes first.
+static std::int64_t SteamRemoteStorage_GetFileTimestamp(
+    void *_Nonnull iface, const char *_Nonnull file) {
+  remote_storage_cache::flush();
+  return SteamRemoteStorage_GetFileTimestamp_orig(iface, file);
+}
+
+/// Pointer to the original ISteamRemoteStorage::GetFileCount method.
+static ISteamRemoteStorage_GetFileCount_t
+    *_Nonnull SteamRemoteStorage_GetFileCount_orig;
+/// Wrapper for ISteamRemoteStorage::GetFileCount, making it write pending
+///    changes first so that file enumeration reflects them.
+static std::int32_t SteamRemoteStorage_GetFileCount(void *_Nonnull iface) {
+  remote_storage_cache::flush();
+  return SteamRemoteStorage_GetFileCount_orig(iface);
+}
+
+//===-- User stats caching ------------------------------------------------===//
+
+/// Minimum interval between `StoreStats` calls forwarded to Steam.
+constexpr std::chrono::seconds store_stats_interval{10};
+
+/// Cached value of a user stat.
+struct cached_stat {
+  /// Value of the stat.
+  std::variant<std::int32_t, float> value;
+  /// Value indicating whether @ref value has been set by the game but not yet
+  ///    passed to Steam.
+  bool dirty;
+};
+
+/// Cached state of an achievement.
+struct cached_achievement {
+  /// Value indicating whether the achievement is achieved.
+  bool achieved;
+  /// Value indicating whether @ref achieved has been set by the game but not
+  ///    yet passed to Steam.
+  bool dirty;
+};
+
+/// Cached user stats, keyed by API names.
+static std::pmr::map<std::pmr::string, cached_stat, std::less<>> cached_stats{
+    &memory::resource(memory::subsystem::user_stats)};
+/// Cached achievements, keyed by API names.
+static std::pmr::map<std::pmr::string, cached_achievement, std::less<>>
+    cached_achievements{&memory::resource(memory::subsystem::user_stats)};
+/// Mutex for locking concurrent access to user stats cache state.
+static std::mutex user_stats_mtx;
+/// Value indicating whether the game has called `StoreStats` since the last
+///    call forwarded to Steam.
+static bool store_stats_pending;
+/// Time of the last `StoreStats` call forwarded to Steam.
+static std::chrono::steady_clock::time_point last_store_stats;
+/// Number of stat and achievement getter calls answered from the cache.
+static metrics::counter user_stats_get_hits{"steam_api.user_stats.get_hits"};
+/// Number of stat and achievement getter calls forwarded to Steam.
+static metrics::counter user_stats_get_misses{
+    "steam_api.user_stats.get_misses"};
+/// Number of stat and achievement setter calls absorbed by the cache.
+static metrics::counter user_stats_set_calls{"steam_api.user_stats.set_calls"};
+/// Number of stat and achievement changes passed to Steam.
+static metrics::counter user_stats_forwarded_sets{
+    "steam_api.user_stats.forwarded_sets"};
+/// Number of `StoreStats` calls made by the game.
+static metrics::counter user_stats_store_calls{
+    "steam_api.user_stats.store_calls"};
+/// Number of `StoreStats` calls forwarded to Steam.
+static metrics::counter user_stats_forwarded_stores{
+    "steam_api.user_stats.forwarded_stores"};
+/// Number of stat and achievement changes rejected by Steam when passed to it.
+static metrics::counter user_stats_rejected_sets{
+    "steam_api.user_stats.rejected_sets"};
+
+/// Pointer to the original ISteamUserStats::GetStat(float) method.
+static ISteamUserStats_GetStatFloat_t
+    *_Nonnull SteamUserStats_GetStatFloat_orig;
+/// Pointer to the original ISteamUserStats::GetStat(int32) method.
+static ISteamUserStats_GetStatInt32_t
+    *_Nonnull SteamUserStats_GetStatInt32_orig;
+/// Pointer to the original ISteamUserStats::SetStat(float) method.
+static ISteamUserStats_SetStatFloat_t
+    *_Nonnull SteamUserStats_SetStatFloat_orig;
+/// Pointer to the original ISteamUserStats::SetStat(int32) method.
+static ISteamUserStats_SetStatInt32_t
+    *_Nonnull SteamUserStats_SetStatInt32_orig;
+/// Pointer to the original ISteamUserStats::SetAchievement method.
+static ISteamUserStats_SetAchievement_t
+    *_Nonnull SteamUserStats_SetAchievement_orig;
+/// Pointer to the original ISteamUserStats::ClearAchievement method.
+static ISteamUserStats_ClearAchievement_t
+    *_Nonnull SteamUserStats_ClearAchievement_orig;
+/// Pointer to the original ISteamUserStats::StoreStats method.
+static ISteamUserStats_StoreStats_t *_Nonnull SteamUserStats_StoreStats_orig;
+
+/// Pass stat and achievement changes made by the game to Steam. Entries that
+///    Steam rejects are dropped from the cache, so that following getter
+///    calls return the values that Steam actually has.
+static void flush_user_stats() {
+  std::vector<std::pair<std::string, std::variant<std::int32_t, float>>> stats;
+  std::vector<std::pair<std::string, bool>> achievements;
+  {
+    const std::scoped_lock lock{user_stats_mtx};
+    for (auto &[name, stat] : cached_stats) {
+      if (stat.dirty) {
+        stat.dirty = false;
+        stats.emplace_back(std::string{name}, stat.value);
+      }
+    }
+    for (auto &[name, achievement] : cached_achievements) {
+      if (achievement.dirty) {
+        achievement.dirty = false;
+        achievements.emplace_back(std::string{name}, achievement.achieved);
+      }
+    }
+  }
+  const auto iface{ISteamUserStats_desc.iface};
+  std::vector<std::string_view> rejected_stats;
+  for (const auto &[name, value] : stats) {
+    const auto int_value{std::get_if<std::int32_t>(&value)};
+    if (!(int_value ? SteamUserStats_SetStatInt32_orig(iface, name.data(),
+                                                       *int_value)
+                    : SteamUserStats_SetStatFloat_orig(
+                          iface, name.data(), std::get<float>(value)))) {
+      rejected_stats.emplace_back(name);
+    }
+  }
+  std::vector<std::string_view> rejected_achievements;
+  for (const auto &[name, achieved] : achievements) {
+    if (!(achieved ? SteamUserStats_SetAchievement_orig
+                   : SteamUserStats_ClearAchievement_orig)(iface,
+                                                           name.data())) {
+      rejected_achievements.emplace_back(name);
+    }
+  }
+  user_stats_forwarded_sets.add(stats.size() + achievements.size());
+  if (rejected_stats.empty() && rejected_achievements.empty()) {
+    return;
+  }
+  user_stats_rejected_sets.add(rejected_stats.size() +
+                               rejected_achievements.size());
+  const std::scoped_lock lock{user_stats_mtx};
+  // Entries that the game has changed again in the meantime are kept, their
+  //    new values are passed to Steam on the next flush
+  for (const auto name : rejected_stats) {
+    log::warning("Steam has rejected a change of stat \"{}\"", name);
+    if (const auto it{cached_stats.find(name)};
+        it != cached_stats.end() && !it->second.dirty) {
+      cached_stats.erase(it);
+    }
+  }
+  for (const auto name : rejected_achievements) {
+    log::warning("Steam has rejected a change of achievement \"{}\"", name);
+    if (const auto it{cached_achievements.find(name)};
+        it != cached_achievements.end() && !it->second.dirty) {
+      cached_achievements.erase(it);
+    }
+  }
+}
+
+/// Drop cached stats and achievements that have no pending changes, so that
+///    they are queried from Steam again. Must be called with
+///    @ref user_stats_mtx locked.
+static void drop_clean_user_stats() {
+  std::erase_if(cached_stats,
+                [](const auto &entry) { return !entry.second.dirty; });
+  std::erase_if(cached_achievements,
+                [](const auto &entry) { return !entry.second.dirty; });
+}
+
+/// Receiver for ISteamUserStats callbacks that invalidate cached stats and
+///    achievements.
+class user_stats_invalidator final : public CCallbackBase {
+  /// Size of the callback structure.
+  const int size;
+  /// Function returning a value indicating whether the cache must be dropped
+  ///    for specified callback structure.
+  bool (*const _Nonnull applies)(const void *_Nonnull param);
+
+public:
+  constexpr user_stats_invalidator(
+      int size, bool (*_Nonnull applies)(const void *_Nonnull)) noexcept
+      : size{size}, applies{applies} {}
+
+  void Run(void *_Nonnull param, bool, std::uint64_t) override { Run(param); }
+  void Run(void *_Nonnull param) override {
+    if (applies(param)) {
+      const std::scoped_lock lock{user_stats_mtx};
+      drop_clean_user_stats();
+    }
+  }
+  int GetCallbackSizeBytes() override { return size; }
+};
+
+/// Invalidator for UserStatsReceived_t callback, delivered when Steam has
+///    fetched current stats from the server.
+static user_stats_invalidator user_stats_received_invalidator{
+    24, [](const void *_Nonnull) { return true; }};
+/// Invalidator for UserStatsStored_t callback. When storing fails, Steam may
+///    revert stats to server values.
+static user_stats_invalidator user_stats_stored_invalidator{
+    16, [](const void *_Nonnull param) {
+      // m_eResult, k_EResultOK
+      return *reinterpret_cast<const std::uint32_t *>(
+                 reinterpret_cast<const std::byte *>(param) + 8) != 1;
+    }};
+
+/// Forward a pending `StoreStats` call to Steam if @ref store_stats_interval
+///    has passed since the previous one. Called from the game thread.
+static void maybe_store_stats() {
+  {
+    const std::scoped_lock lock{user_stats_mtx};
+    if (!store_stats_pending) {
+      return;
+    }
+    const auto now{std::chrono::steady_clock::now()};
+    if (now - last_store_stats < store_stats_interval) {
+      return;
+    }
+    store_stats_pending = false;
+    last_store_stats = now;
+  }
+  flush_user_stats();
+  SteamUserStats_StoreStats_orig(ISteamUserStats_desc.iface);
+  user_stats_forwarded_stores.add();
+}
+
+/// Look up a stat in @ref cached_stats.
+///
+/// @tparam T
+///    Type of the stat value.
+/// @param [in] name
+///    API name of the stat.
+/// @param [out] value
+///    On success, receives the value of the stat.
+/// @return Value indicating whether the stat has been found.
+template <typename T>
+static bool get_cached_stat(const char *_Nonnull name, T &value) {
+  const std::scoped_lock lock{user_stats_mtx};
+  const auto it{cached_stats.find(std::string_view{name})};
+  if (it == cached_stats.end()) {
+    return false;
+  }
+  const auto cached{std::get_if<T>(&it->second.value)};
+  if (!cached) {
+    return false;
+  }
+  value = *cached;
+  return true;
+}
+
+/// Put a stat value that is known to Steam into @ref cached_stats.
+///
+/// @tparam T
+///    Type of the stat value.
+/// @param [in] name
+///    API name of the stat.
+/// @param value
+///    Value of the stat.
+template <typename T>
+static void cache_stat(const char *_Nonnull name, T value) {
+  const std::scoped_lock lock{user_stats_mtx};
+  if (const auto it{cached_stats.find(std::string_view{name})};
+      it != cached_stats.end()) {
+    if (!it->second.dirty) {
+      it->second.value = value;
+    }
+  } else {
+    cached_stats.try_emplace(name, cached_stat{.value = value, .dirty = false});
+  }
+}
+
+/// Set the value of a stat in @ref cached_stats, if the stat is known. Steam
+///    validates the value when it's passed to it by @ref flush_user_stats.
+///
+/// @tparam T
+///    Type of the stat value.
+/// @param [in] name
+///    API name of the stat.
+/// @param value
+///    New value of the stat.
+/// @return Value indicating whether the stat has been found.
+template <typename T>
+static bool set_cached_stat(const char *_Nonnull name, T value) {
+  const std::scoped_lock lock{user_stats_mtx};
+  const auto it{cached_stats.find(std::string_view{name})};
+  if (it == cached_stats.end() ||
+      !std::holds_alternative<T>(it->second.value)) {
+    return false;
+  }
+  it->second.value = value;
+  it->second.dirty = true;
+  return true;
+}
+
+/// Wrapper for ISteamUserStats::GetStat(float), making it use
+///    @ref cached_stats.
+static bool SteamUserStats_GetStatFloat(void *_Nonnull iface,
+                                        const char *_Nonnull name,
+                                        float *_Nonnull data) {
+  if (get_cached_stat(name, *data)) {
+    user_stats_get_hits.add();
+    return true;
+  }
+  user_stats_get_misses.add();
+  if (!SteamUserStats_GetStatFloat_orig(iface, name, data)) {
+    return false;
+  }
+  cache_stat(name, *data);
+  return true;
+}
+
+/// Wrapper for ISteamUserStats::GetStat(int32), making it use
+///    @ref cached_stats.
+static bool SteamUserStats_GetStatInt32(void *_Nonnull iface,
+                                        const char *_Nonnull name,
+                                        std::int32_t *_Nonnull data) {
+  if (get_cached_stat(name, *data)) {
+    user_stats_get_hits.add();
+    return true;
+  }
+  user_stats_get_misses.add();
+  if (!SteamUserStats_GetStatInt32_orig(iface, name, data)) {
+    return false;
+  }
+  cache_stat(name, *data);
+  return true;
+}
+
+/// Wrapper for ISteamUserStats::SetStat(float), making it update
+///    @ref cached_stats and defer passing the value to Steam.
+static bool SteamUserStats_SetStatFloat(void *_Nonnull iface,
+                                        const char *_Nonnull name,
+                                        float data) {
+  if (set_cached_stat(name, data)) {
+    user_stats_set_calls.add();
+    return true;
+  }
+  // Let Steam validate stats that haven't been seen yet
+  if (!SteamUserStats_SetStatFloat_orig(iface, name, data)) {
+    return false;
+  }
+  cache_stat(name, data);
+  return true;
+}
+
+/// Wrapper for ISteamUserStats::SetStat(int32), making it update
+///    @ref cached_stats and defer passing the value to Steam.
+static bool SteamUserStats_SetStatInt32(void *_Nonnull iface,
+                                        const char *_Nonnull name,
+                                        std::int32_t data) {
+  if (set_cached_stat(name, data)) {
+    user_stats_set_calls.add();
+    return true;
+  }
+  // Let Steam validate stats that haven't been seen yet
+  if (!SteamUserStats_SetStatInt32_orig(iface, name, data)) {
+    return false;
+  }
+  cache_stat(name, data);
+  return true;
+}
+
+/// Pointer to the original ISteamUserStats::UpdateAvgRateStat method.
+static ISteamUserStats_UpdateAvgRateStat_t
+    *_Nonnull SteamUserStats_UpdateAvgRateStat_orig;
+/// Wrapper for ISteamUserStats::UpdateAvgRateStat, making it pass pending
+///    changes to Steam first and drop the cached value of the stat, since
+///    Steam computes the new value itself.
+static bool SteamUserStats_UpdateAvgRateStat(void *_Nonnull iface,
+                                             const char *_Nonnull name,
+                                             float count_this_session,
+                                             double session_length) {
+  flush_user_stats();
+  {
+    const std::scoped_lock lock{user_stats_mtx};
+    if (const auto it{cached_stats.find(std::string_view{name})};
+        it != cached_stats.end()) {
+      cached_stats.erase(it);
+    }
+  }
+  return SteamUserStats_UpdateAvgRateStat_orig(iface, name, count_this_session,
+                                               session_length);
+}
+
+/// Pointer to the original ISteamUserStats::GetAchievement method.
+static ISteamUserStats_GetAchievement_t
+    *_Nonnull SteamUserStats_GetAchievement_orig;
+/// Wrapper for ISteamUserStats::GetAchievement, making it use
+///    @ref cached_achievements.
+static bool SteamUserStats_GetAchievement(void *_Nonnull iface,
+                                          const char *_Nonnull name,
+                                          bool *_Nonnull achieved) {
+  {
+    const std::scoped_lock lock{user_stats_mtx};
+    if (const auto it{cached_achievements.find(std::string_view{name})};
+        it != cached_achievements.end()) {
+      user_stats_get_hits.add();
+      *achieved = it->second.achieved;
+      return true;
+    }
+  }
+  user_stats_get_misses.add();
+  if (!SteamUserStats_GetAchievement_orig(iface, name, achieved)) {
+    return false;
+  }
+  const std::scoped_lock lock{user_stats_mtx};
+  cached_achievements.try_emplace(
+      name, cached_achievement{.achieved = *achieved, .dirty = false});
+  return true;
+}
+
+/// Set the state of an achievement in @ref cached_achievements, or forward
+///    the change to Steam if the achievement hasn't been seen yet.
+///
+/// @param [in, out] iface
+///    Pointer to the ISteamUserStats instance.
+/// @param [in] name
+///    API name of the achievement.
+/// @param achieved
+///    New state of the achievement.
+/// @return Value indicating whether the achievement exists.
+static bool set_cached_achievement(void *_Nonnull iface,
+                                   const char *_Nonnull name, bool achieved) {
+  {
+    const std::scoped_lock lock{user_stats_mtx};
+    if (const auto it{cached_achievements.find(std::string_view{name})};
+        it != cached_achievements.end()) {
+      user_stats_set_calls.add();
+      if (it->second.achieved != achieved) {
+        it->second.achieved = achieved;
+        it->second.dirty = true;
+      }
+      return true;
+    }
+  }
+  if (!(achieved ? SteamUserStats_SetAchievement_orig
+                 : SteamUserStats_ClearAchievement_orig)(iface, name)) {
+    return false;
+  }
+  const std::scoped_lock lock{user_stats_mtx};
+  cached_achievements.try_emplace(
+      name, cached_achievement{.achieved = achieved, .dirty = false});
+  return true;
+}
+
+/// Wrapper for ISteamUserStats::SetAchievement, making it update
+///    @ref cached_achievements and defer passing the change to Steam.
+static bool SteamUserStats_SetAchievement(void *_Nonnull iface,
+                                          const char *_Nonnull name) {
+  return set_cached_achievement(iface, name, true);
+}
+
+/// Wrapper for ISteamUserStats::ClearAchievement, making it update
+///    @ref cached_achievements and defer passing the change to Steam.
+static bool SteamUserStats_ClearAchievement(void *_Nonnull iface,
+                                            const char *_Nonnull name) {
+  return set_cached_achievement(iface, name, false);
+}
+
+/// Pointer to the original ISteamUserStats::GetAchievementAndUnlockTime
+///    method.
+static ISteamUserStats_GetAchievementAndUnlockTime_t
+    *_Nonnull SteamUserStats_GetAchievementAndUnlockTime_orig;
+/// Wrapper for ISteamUserStats::GetAchievementAndUnlockTime, making it pass
+///    pending changes to Steam first, so that it assigns unlock times.
+static bool SteamUserStats_GetAchievementAndUnlockTime(
+    void *_Nonnull iface, const char *_Nonnull name, bool *_Nonnull achieved,
+    std::uint32_t *_Nonnull unlock_time) {
+  flush_user_stats();
+  return SteamUserStats_GetAchievementAndUnlockTime_orig(iface, name, achieved,
+                                                         unlock_time);
+}
+
+/// Wrapper for ISteamUserStats::StoreStats, making it coalesce calls made
+///    within @ref store_stats_interval.
+static bool SteamUserStats_StoreStats(void *_Nonnull) {
+  user_stats_store_calls.add();
+  {
+    const std::scoped_lock lock{user_stats_mtx};
+    store_stats_pending = true;
+  }
+  // Forward the call right away if the interval has passed already, otherwise
+  //    it's forwarded by SteamAPI_RunCallbacks or SteamAPI_Shutdown
+  maybe_store_stats();
+  return true;
+}
+
+/// Pointer to the original ISteamUserStats::ResetAllStats method.
+static ISteamUserStats_ResetAllStats_t
+    *_Nonnull SteamUserStats_ResetAllStats_orig;
+/// Wrapper for ISteamUserStats::ResetAllStats, making it drop cached values,
+///    which are reset along with pending changes.
+static bool SteamUserStats_ResetAllStats(void *_Nonnull iface,
+                                         bool achievements_too) {
+  {
+    const std::scoped_lock lock{user_stats_mtx};
+    cached_stats.clear();
+    if (achievements_too) {
+      cached_achievements.clear();
+    }
+  }
+  return SteamUserStats_ResetAllStats_orig(iface, achievements_too);
+}
+
+//===-- Import hooking ----------------------------------------------------===//
+
+/// Locate the import address table entry for specified steam_api64.dll
+///    function in the game executable, checking regular imports first and
+///    delay-load imports second.
+///
+/// @param [in] name
+///    Name of the function to locate.
+/// @return Pointer to the IAT entry for the function, or `nullptr` if it's not
+///    imported by the executable.
+static void *_Nullable *_Nullable find_import_thunk(std::string_view name) {
+  const auto module{reinterpret_cast<char *>(GetModuleHandleW(nullptr))};
+  // First, try to locate regular import descriptor for steam_api64.dll
+  ULONG dir_size;
+  const auto import_desc_base{reinterpret_cast<const IMAGE_IMPORT_DESCRIPTOR *>(
+      ImageDirectoryEntryToDataEx(module, TRUE, IMAGE_DIRECTORY_ENTRY_IMPORT,
+                                  &dir_size, nullptr))};
+  if (import_desc_base) {
+    const std::span import_descs{import_desc_base,
+                                 (dir_size / sizeof *import_desc_base) - 1};
+    const auto import_desc{std::ranges::find(
+        import_descs, "steam_api64.dll", [module](const auto &desc) {
+          return std::string_view{&module[desc.Name]};
+        })};
+    if (import_desc != import_descs.end()) {
+      for (auto ilt_desc_base{reinterpret_cast<const IMAGE_THUNK_DATA *>(
+               &module[import_desc->OriginalFirstThunk])},
+           ilt_desc{ilt_desc_base};
+           ilt_desc->u1.AddressOfData; ++ilt_desc) {
+        if (!(ilt_desc->u1.AddressOfData & IMAGE_ORDINAL_FLAG) &&
+            std::string_view{reinterpret_cast<const IMAGE_IMPORT_BY_NAME *>(
+                                 &module[ilt_desc->u1.AddressOfData])
+                                 ->Name} == name) {
+          return reinterpret_cast<void **>(&(
+              reinterpret_cast<IMAGE_THUNK_DATA *>(
+                  &module[import_desc->FirstThunk])[std::distance(ilt_desc_base,
+                                                                  ilt_desc)]
+                  .u1.Function));
+        }
+      }
+    } // if (import_desc != import_descs.end())
+  } // if (import_desc_base)
+  // Try to locate delay load descriptor for steam_api64.dll
+  const auto delay_load_desc_base{
+      reinterpret_cast<const IMAGE_DELAYLOAD_DESCRIPTOR *>(
+          ImageDirectoryEntryToDataEx(const_cast<char *>(module), TRUE,
+                                      IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT,
+                                      &dir_size, nullptr))};
+  if (delay_load_desc_base) {
+    const std::span delay_load_descs{
+        delay_load_desc_base, (dir_size / sizeof *delay_load_desc_base) - 1};
+    const auto delay_desc{std::ranges::find(
+        delay_load_descs, "steam_api64.dll", [module](const auto &desc) {
+          return std::string_view{&module[desc.DllNameRVA]};
+        })};
+    if (delay_desc != delay_load_descs.end()) {
+      for (auto int_desc_base{reinterpret_cast<const IMAGE_THUNK_DATA *>(
+               &module[delay_desc->ImportNameTableRVA])},
+           int_desc{int_desc_base};
+           int_desc->u1.AddressOfData; ++int_desc) {
+        if (std::string_view{reinterpret_cast<const IMAGE_IMPORT_BY_NAME *>(
+                                 &module[int_desc->u1.AddressOfData])
+                                 ->Name} == name) {
+          return reinterpret_cast<void **>(
+              &(reinterpret_cast<IMAGE_THUNK_DATA *>(
+                    &module[delay_desc->ImportAddressTableRVA])
+                    [std::distance(int_desc_base, int_desc)]
+                        .u1.Function));
+        }
+      }
+    } // if (delay_desc != delay_load_descs.end())
+  } // if (delay_load_desc_base)
+  return nullptr;
+}
+
+//===-- Callback injection ------------------------------------------------===//
+
+/// Synthetic callback queued for delivery.
+struct queued_callback {
+  /// Pointer to the next element in the queue.
+  queued_callback *_Nullable next;
+  /// ID of the callback.
+  int callback;
+  /// Callback data.
+  std::vector<std::byte> data;
+};
+
+/// `CallbackMsg_t` structure used by manual dispatch functions.
+struct callback_msg {
+  std::int32_t user;
+  int callback;
+  std::uint8_t *_Nullable param;
+  int param_size;
+};
+
+/// Lock-free stack of callbacks posted by @ref post_callback, newest first.
+static std::atomic<queued_callback *> posted_callbacks;
+/// First callback in the delivery queue, which is only accessed on the game's
+///    callback thread.
+static queued_callback *_Nullable pending_head;
+/// Last callback in the delivery queue.
+static queued_callback *_Nullable pending_tail;
+/// Value indicating whether any callback dispatch function has been hooked,
+///    so posted callbacks can be delivered.
+static bool dispatch_hooked;
+/// Callback receivers registered by the game, keyed by callback ID.
+static std::unordered_map<int, std::vector<CCallbackBase *>> game_receivers;
+/// Mutex for locking concurrent access to @ref game_receivers.
+static std::mutex game_receivers_mtx;
+/// Steam user handle reported in synthetic manual dispatch messages.
+static std::int32_t steam_user;
+/// Number of synthetic callbacks posted.
+static metrics::counter callbacks_posted{"steam_api.callbacks.posted"};
+/// Number of synthetic callbacks delivered to the game.
+static metrics::counter callbacks_delivered{"steam_api.callbacks.delivered"};
+
+/// Move callbacks from @ref posted_callbacks to the delivery queue, in the
+///    order they've been posted.
+static void collect_callbacks() {
+  auto node{posted_callbacks.exchange(nullptr, std::memory_order::acquire)};
+  if (!node) {
+    return;
+  }
+  const auto tail{node};
+  queued_callback *head{};
+  while (node) {
+    const auto next{node->next};
+    node->next = head;
+    head = node;
+    node = next;
+  }
+  if (pending_tail) {
+    pending_tail->next = head;
+  } else {
+    pending_head = head;
+  }
+  pending_tail = tail;
+}
+
+/// Remove the first callback from the delivery queue.
+///
+/// @return Pointer to the removed callback, or `nullptr` if the queue is
+///    empty. The caller takes ownership over it.
+static queued_callback *_Nullable pop_callback() {
+  const auto node{pending_head};
+  if (node) {
+    pending_head = node->next;
+    if (!pending_head) {
+      pending_tail = nullptr;
+    }
+  }
+  return node;
+}
+
+/// Push a callback onto @ref posted_callbacks.
+///
+/// @param [in] node
+///    The callback to push. The stack takes ownership over it.
+static void push_callback(queued_callback *_Nonnull node) {
+  node->next = posted_callbacks.load(std::memory_order::relaxed);
+  while (!posted_callbacks.compare_exchange_weak(node->next, node,
+                                                 std::memory_order::release,
+                                                 std::memory_order::relaxed)) {
+  }
+  callbacks_posted.add();
+}
+
+/// Deliver all queued callbacks and synthetic call results to receivers
+///    registered by the game.
+static void dispatch_callbacks() {
+  collect_callbacks();
+  while (const auto node{pop_callback()}) {
+    std::vector<CCallbackBase *> receivers;
+    {
+      const std::scoped_lock lock{game_receivers_mtx};
+      if (const auto it{game_receivers.find(node->callback)};
+          it != game_receivers.end()) {
+        receivers = it->second;
+      }
+    }
+    for (const auto receiver : receivers) {
+      // A previous receiver might have unregistered this one
+      {
+        const std::scoped_lock lock{game_receivers_mtx};
+        const auto it{game_receivers.find(node->callback)};
+        if (it == game_receivers.end() ||
+            !std::ranges::contains(it->second, receiver)) {
+          continue;
+        }
+      }
+      receiver->Run(node->data.data());
+    }
+    callbacks_delivered.add();
+    delete node;
+  }
+  call_results::dispatch();
+}
+
+/// `SteamAPI_RegisterCallback` function type.
+using SteamAPI_RegisterCallback_t = void(CCallbackBase *_Nonnull, int);
+/// Pointer to the original `SteamAPI_RegisterCallback` function.
+static SteamAPI_RegisterCallback_t *_Nullable SteamAPI_RegisterCallback_orig;
+/// Wrapper for `SteamAPI_RegisterCallback`, that remembers receivers
+///    registered by the game.
+static void SteamAPI_RegisterCallback(CCallbackBase *_Nonnull receiver,
+                                      int callback) {
+  if (!SteamAPI_RegisterCallback_orig) {
+    SteamAPI_RegisterCallback_orig =
+        reinterpret_cast<SteamAPI_RegisterCallback_t *>(
+            GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                           "SteamAPI_RegisterCallback"));
+  }
+  SteamAPI_RegisterCallback_orig(receiver, callback);
+  const std::scoped_lock lock{game_receivers_mtx};
+  game_receivers[callback].emplace_back(receiver);
+}
+
+/// `SteamAPI_UnregisterCallback` function type.
+using SteamAPI_UnregisterCallback_t = void(CCallbackBase *_Nonnull);
+/// Pointer to the original `SteamAPI_UnregisterCallback` function.
+static SteamAPI_UnregisterCallback_t
+    *_Nullable SteamAPI_UnregisterCallback_orig;
+/// Wrapper for `SteamAPI_UnregisterCallback`, that forgets the receiver.
+static void SteamAPI_UnregisterCallback(CCallbackBase *_Nonnull receiver) {
+  if (!SteamAPI_UnregisterCallback_orig) {
+    SteamAPI_UnregisterCallback_orig =
+        reinterpret_cast<SteamAPI_UnregisterCallback_t *>(
+            GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                           "SteamAPI_UnregisterCallback"));
+  }
+  {
+    const std::scoped_lock lock{game_receivers_mtx};
+    if (const auto it{game_receivers.find(receiver->callback)};
+        it != game_receivers.end()) {
+      std::erase(it->second, receiver);
+    }
+  }
+  SteamAPI_UnregisterCallback_orig(receiver);
+}
+
+/// Synthetic callback that has been returned by
+///    @ref SteamAPI_ManualDispatch_GetNextCallback and not freed yet.
+static queued_callback *_Nullable manual_current;
+
+/// `SteamAPI_ManualDispatch_GetNextCallback` function type.
+using SteamAPI_ManualDispatch_GetNextCallback_t =
+    bool(std::int32_t pipe, callback_msg *_Nonnull msg);
+/// Pointer to the original `SteamAPI_ManualDispatch_GetNextCallback`
+///    function.
+static SteamAPI_ManualDispatch_GetNextCallback_t
+    *_Nullable SteamAPI_ManualDispatch_GetNextCallback_orig;
+/// Wrapper for `SteamAPI_ManualDispatch_GetNextCallback`, that returns queued
+///    synthetic callbacks after the ones from Steam.
+static bool
+SteamAPI_ManualDispatch_GetNextCallback(std::int32_t pipe,
+                                        callback_msg *_Nonnull msg) {
+  if (!SteamAPI_ManualDispatch_GetNextCallback_orig) {
+    SteamAPI_ManualDispatch_GetNextCallback_orig =
+        reinterpret_cast<SteamAPI_ManualDispatch_GetNextCallback_t *>(
+            GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                           "SteamAPI_ManualDispatch_GetNextCallback"));
+  }
+  if (SteamAPI_ManualDispatch_GetNextCallback_orig(pipe, msg)) {
+    return true;
+  }
+  collect_callbacks();
+  manual_current = pop_callback();
+  if (!manual_current) {
+    return false;
+  }
+  auto &data{manual_current->data};
+  *msg = {.user = steam_user,
+          .callback = manual_current->callback,
+          .param = reinterpret_cast<std::uint8_t *>(data.data()),
+          .param_size = static_cast<int>(data.size())};
+  callbacks_delivered.add();
+  return true;
+}
+
+/// `SteamAPI_ManualDispatch_FreeLastCallback` function type.
+using SteamAPI_ManualDispatch_FreeLastCallback_t = void(std::int32_t pipe);
+/// Pointer to the original `SteamAPI_ManualDispatch_FreeLastCallback`
+///    function.
+static SteamAPI_ManualDispatch_FreeLastCallback_t
+    *_Nullable SteamAPI_ManualDispatch_FreeLastCallback_orig;
+/// Wrapper for `SteamAPI_ManualDispatch_FreeLastCallback`, that frees
+///    synthetic callbacks.
+static void SteamAPI_ManualDispatch_FreeLastCallback(std::int32_t pipe) {
+  if (manual_current) {
+    delete manual_current;
+    manual_current = nullptr;
+    return;
+  }
+  if (!SteamAPI_ManualDispatch_FreeLastCallback_orig) {
+    SteamAPI_ManualDispatch_FreeLastCallback_orig =
+        reinterpret_cast<SteamAPI_ManualDispatch_FreeLastCallback_t *>(
+            GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                           "SteamAPI_ManualDispatch_FreeLastCallback"));
+  }
+  SteamAPI_ManualDispatch_FreeLastCallback_orig(pipe);
+}
+
+//===-- Synthetic call results --------------------------------------------===//
+
+/// Value indicating whether call result registration functions have been
+///    hooked, which is required for serving synthetic call results.
+static bool call_results_hooked;
+
+/// Pointer to the original ISteamUtils::IsAPICallCompleted method.
+static ISteamUtils_IsAPICallCompleted_t
+    *_Nonnull SteamUtils_IsAPICallCompleted_orig;
+/// Wrapper for ISteamUtils::IsAPICallCompleted, that answers for synthetic
+///    API calls, for games that poll results instead of registering call
+///    result receivers.
+static bool SteamUtils_IsAPICallCompleted(void *_Nonnull iface,
+                                          std::uint64_t call,
+                                          bool *_Nonnull failed) {
+  return call_results::is_synthetic(call)
+             ? call_results::is_completed(call, failed)
+             : SteamUtils_IsAPICallCompleted_orig(iface, call, failed);
+}
+
+/// Pointer to the original ISteamUtils::GetAPICallResult method.
+static ISteamUtils_GetAPICallResult_t
+    *_Nonnull SteamUtils_GetAPICallResult_orig;
+/// Wrapper for ISteamUtils::GetAPICallResult, that returns results of
+///    synthetic API calls.
+static bool SteamUtils_GetAPICallResult(void *_Nonnull iface,
+                                        std::uint64_t call,
+                                        void *_Nonnull callback,
+                                        int callback_size, int callback_idx,
+                                        bool *_Nonnull failed) {
+  return call_results::is_synthetic(call)
+             ? call_results::get_result(call, callback, callback_size,
+                                        callback_idx, failed)
+             : SteamUtils_GetAPICallResult_orig(iface, call, callback,
+                                                callback_size, callback_idx,
+                                                failed);
+}
+
+/// `SteamAPI_RegisterCallResult` and `SteamAPI_UnregisterCallResult` function
+///    type.
+using SteamAPI_CallResult_t = void(CCallbackBase *_Nonnull, std::uint64_t);
+/// Pointer to the original `SteamAPI_RegisterCallResult` function.
+static SteamAPI_CallResult_t *_Nullable SteamAPI_RegisterCallResult_orig;
+/// Wrapper for `SteamAPI_RegisterCallResult`, that remembers receivers for
+///    synthetic API calls and puts proxies in front of receivers for
+///    cacheable HTTP requests.
+static void SteamAPI_RegisterCallResult(CCallbackBase *_Nonnull receiver,
+                                        std::uint64_t call) {
+  if (call_results::is_synthetic(call)) {
+    call_results::set_receiver(call, receiver);
+    return;
+  }
+  if (!SteamAPI_RegisterCallResult_orig) {
+    SteamAPI_RegisterCallResult_orig =
+        reinterpret_cast<SteamAPI_CallResult_t *>(
+            GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                           "SteamAPI_RegisterCallResult"));
+  }
+  SteamAPI_RegisterCallResult_orig(steam_http::attach_receiver(call, receiver),
+                                   call);
+}
+
+/// Pointer to the original `SteamAPI_UnregisterCallResult` function.
+static SteamAPI_CallResult_t *_Nullable SteamAPI_UnregisterCallResult_orig;
+/// Wrapper for `SteamAPI_UnregisterCallResult`, that forgets receivers for
+///    synthetic API calls and detaches them from proxies.
+static void SteamAPI_UnregisterCallResult(CCallbackBase *_Nonnull receiver,
+                                          std::uint64_t call) {
+  if (call_results::is_synthetic(call)) {
+    call_results::set_receiver(call, nullptr);
+    return;
+  }
+  if (!SteamAPI_UnregisterCallResult_orig) {
+    SteamAPI_UnregisterCallResult_orig =
+        reinterpret_cast<SteamAPI_CallResult_t *>(
+            GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                           "SteamAPI_UnregisterCallResult"));
+  }
+  if (!steam_http::detach_receiver(call)) {
+    SteamAPI_UnregisterCallResult_orig(receiver, call);
+  }
+}
+
+//===-- SteamAPI_RunCallbacks wrapping ------------------------------------===//
+
+/// `SteamAPI_RunCallbacks` function type.
+using SteamAPI_RunCallbacks_t = void();
+
+/// Pointer to the original `SteamAPI_RunCallbacks` function.
+static SteamAPI_RunCallbacks_t *_Nullable SteamAPI_RunCallbacks_orig;
+/// Pointer to the `SteamAPI_RunCallbacks` callback for current game.
+static steam_api_run_callbacks_cb_t *_Nullable run_callbacks_cb;
+
+/// Wrapper for `SteamAPI_RunCallbacks`.
+static void SteamAPI_RunCallbacks() {
+  if (!SteamAPI_RunCallbacks_orig) {
+    SteamAPI_RunCallbacks_orig = reinterpret_cast<SteamAPI_RunCallbacks_t *>(
+        GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                       "SteamAPI_RunCallbacks"));
+  }
+  SteamAPI_RunCallbacks_orig();
+  dispatch_callbacks();
+  if (ISteamUserStats_desc.iface) {
+    maybe_store_stats();
+  }
+  if (run_callbacks_cb) {
+    run_callbacks_cb();
+  }
+}
+
+//===-- SteamAPI_Shutdown wrapping ----------------------------------------===//
+
+/// `SteamAPI_Shutdown` function type.
+using SteamAPI_Shutdown_t = void();
+
+/// Pointer to the original `SteamAPI_Shutdown` function.
+static SteamAPI_Shutdown_t *_Nullable SteamAPI_Shutdown_orig;
+
+/// Wrapper for `SteamAPI_Shutdown`, that writes pending remote storage
+///    changes and stores pending user stats while Steam API is still
+///    available.
+static void SteamAPI_Shutdown() {
+  if (!SteamAPI_Shutdown_orig) {
+    SteamAPI_Shutdown_orig = reinterpret_cast<SteamAPI_Shutdown_t *>(
+        GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                       "SteamAPI_Shutdown"));
+  }
+  if (ISteamRemoteStorage_desc.iface) {
+    remote_storage_cache::shut_down();
+  }
+  if (ISteamUserStats_desc.iface) {
+    bool store;
+    {
+      const std::scoped_lock lock{user_stats_mtx};
+      store = store_stats_pending;
+      store_stats_pending = false;
+    }
+    flush_user_stats();
+    if (store) {
+      SteamUserStats_StoreStats_orig(ISteamUserStats_desc.iface);
+      user_stats_forwarded_stores.add();
+    }
+  }
+  SteamAPI_Shutdown_orig();
+}
+
 //===-- SteamAPI_Init wrapping --------------------------------------------===//
 
 /// Primitive C++ interface representation.
@@ -145,40 +1662,12 @@ struct cpp_interface {
   void *const _Nonnull *_Nonnull vtable;
 };
 
-/// `SteamAPI_Init` function type.
-using SteamAPI_Init_t = bool();
-
-/// Wrapper for `SteamAPI_Init`.
-static bool SteamAPI_Init() {
-  const auto app_id{g_settings.steam->app_id};
-  const auto spoof_app_id{g_settings.steam->spoof_app_id};
-  std::array<WCHAR, 11> buf;
-  *std::format_to_n(buf.data(), buf.size(), std::locale::classic(), L"{}",
-                    spoof_app_id ? spoof_app_id : app_id)
-       .out = L'\0';
-  SetEnvironmentVariableW(L"SteamAppId", buf.data());
-  const auto SteamAPI_Init_orig{reinterpret_cast<SteamAPI_Init_t *>(
-      GetProcAddress(GetModuleHandleW(L"steam_api64.dll"), "SteamAPI_Init"))};
-  bool res{SteamAPI_Init_orig()};
-  if (!spoof_app_id) {
-    if (res) {
-      g_settings.steam->spoof_app_id = app_id;
-    } else {
-      // User probably doesn't have license for app_id, try again with 480
-      SetEnvironmentVariableW(L"SteamAppId", L"480");
-      res = SteamAPI_Init_orig();
-      if (res) {
-        g_settings.steam->spoof_app_id = 480;
-      }
-    }
-  }
-  if (!res) {
-    display_error(
-        L"SteamAPI_Init() returned false. Make sure that Steam is running; if "
-        L"it is, try signing out of your account then signing back in.");
-    return false;
-  }
-  // Get Steam API file version
+/// Get Steam API file version into @ref ver and check whether it's supported.
+///    Displays an error message on failure.
+///
+/// @return Value indicating whether the version has been obtained and is
+///    supported.
+static bool load_version() {
   const auto module{GetModuleHandleW(L"steam_api64.dll")};
   {
     const auto rsrc{
@@ -213,10 +1702,1208 @@ static bool SteamAPI_Init() {
             .data());
     return false;
   }
+  return true;
+version_fail:
+  display_error(L"Couldn't load steam_api64.dll file version, no changes will "
+                L"be applied");
+  return false;
+}
+
+/// Get the version of ISteamClient interface for current Steam API version,
+///    for Steamworks SDK v1.37+.
+///
+/// @return ISteamClient interface version string.
+static const char *_Nonnull client_interface_ver() {
+  if (ver >= 0x0008003F000B0054) { // 08.63.11.84
+    // Steamworks SDK v1.59+
+    return "SteamClient021";
+  } else if (ver >= 0x000500350021004E) { // 05.53.33.78
+    // Steamworks SDK v1.47+
+    return "SteamClient020";
+  } else if (ver >= 0x0005001900410015) { // 05.25.65.21
+    // Steamworks SDK v1.46
+    return "SteamClient019";
+  } else if (ver >= 0x0004005F0014001E) { // 04.95.20.30
+    // Steamworks SDK v1.43+
+    return "SteamClient018";
+  } else {
+    // All previous Steamworks SDK versions since v1.37
+    return "SteamClient017";
+  }
+}
+
+/// Get the version of ISteamUGC interface for current Steam API version, for
+///    Steamworks SDK v1.37+.
+///
+/// @return ISteamUGC interface version string.
+static const char *_Nonnull ugc_interface_ver() {
+  if (ver >= 0x0009003C002C000A) { // 09.60.44.10
+    // Steamworks SDK v1.62
+    return "STEAMUGC_INTERFACE_VERSION021";
+  } else if (ver >= 0x0008006100630046) { // 08.97.99.70
+    // Steamworks SDK v1.60+
+    return "STEAMUGC_INTERFACE_VERSION020";
+  } else if (ver >= 0x0008002100090017) { // 08.33.09.23
+    // Steamworks SDK v1.58+
+    return "STEAMUGC_INTERFACE_VERSION018";
+  } else if (ver >= 0x000700600000002C) { // 07.96.00.44
+    // Steamworks SDK v1.56+
+    return "STEAMUGC_INTERFACE_VERSION017";
+  } else if (ver >= 0x0006005B00150039) { // 06.91.21.57
+    // Steamworks SDK v1.53+
+    return "STEAMUGC_INTERFACE_VERSION016";
+  } else if (ver >= 0x0006001C00120056) { // 06.28.18.86
+    // Steamworks SDK v1.51+
+    return "STEAMUGC_INTERFACE_VERSION015";
+  } else if (ver >= 0x000500350021004E) { // 05.53.33.78
+    // Steamworks SDK v1.47+
+    return "STEAMUGC_INTERFACE_VERSION014";
+  } else if (ver >= 0x000500130026003E) { // 05.19.38.62
+    // Steamworks SDK v1.45+
+    return "STEAMUGC_INTERFACE_VERSION013";
+  } else if (ver >= 0x0004005F0014001E) { // 04.95.20.30
+    // Steamworks SDK v1.43+
+    return "STEAMUGC_INTERFACE_VERSION012";
+  } else if (ver >= 0x0003005C0048003A) { // 03.92.72.58
+    // Steamworks SDK v1.40+
+    return "STEAMUGC_INTERFACE_VERSION010";
+  } else if (ver >= 0x0003003E00520052) { // 03.62.82.82
+    // Steamworks SDK v1.38+
+    return "STEAMUGC_INTERFACE_VERSION009";
+  } else {
+    // Steamworks SDK v1.37
+    return "STEAMUGC_INTERFACE_VERSION008";
+  }
+}
+
+/// Setup ISteamUGC interface wrapper based on current Steam API version.
+///
+/// @param [in, out] ISteamUGC_ptr
+///    Pointer to the interface instance to wrap.
+static void wrap_ugc(cpp_interface *_Nonnull ISteamUGC_ptr) {
+  if (ver >= 0x0009003C002C000A) { // 09.60.44.10
+    // "STEAMUGC_INTERFACE_VERSION021", used in Steamworks SDK v1.62
+    ISteamUGC_desc.num_methods = 96;
+    for (std::size_t i = 0; i < ISteamUGC_desc.num_methods; ++i) {
+      ISteamUGC_desc.vm_idxs[i] = i;
+    }
+  } else if (ver >= 0x0008006100630046) { // 08.97.99.70
+    // "STEAMUGC_INTERFACE_VERSION020", used since Steamworks SDK v1.60
+    ISteamUGC_desc.num_methods = 94;
+    for (std::size_t i = 0; i < ISteamUGC_desc.num_methods; ++i) {
+      ISteamUGC_desc.vm_idxs[i] = i;
+    }
+  } else if (ver >= 0x0008002100090017) { // 08.33.09.23
+    // "STEAMUGC_INTERFACE_VERSION018", used since Steamworks SDK v1.58
+    ISteamUGC_desc.num_methods = 90;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCContentDescriptors] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeCreatedDateRange] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeUpdatedDateRange] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddContentDescriptor] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveContentDescriptor] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 73;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 75;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 76;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 77;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 78;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 79;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 80;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 81;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 82;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 83;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 84;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 85;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 86;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 87;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 88;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserContentDescriptorPreferences] =
+        89;
+  } else if (ver >= 0x000700600000002C) { // 07.96.00.44
+    // "STEAMUGC_INTERFACE_VERSION017", used since Steamworks SDK v1.56
+    ISteamUGC_desc.num_methods = 89;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCContentDescriptors] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeCreatedDateRange] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeUpdatedDateRange] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddContentDescriptor] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveContentDescriptor] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 73;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 75;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 76;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 77;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 78;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 79;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 80;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 81;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 82;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 83;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 84;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 85;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 86;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 87;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 88;
+  } else if (ver >= 0x0006005B00150039) { // 06.91.21.57
+    // "STEAMUGC_INTERFACE_VERSION016", used since Steamworks SDK v1.53
+    ISteamUGC_desc.num_methods = 86;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeCreatedDateRange] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeUpdatedDateRange] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 73;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 75;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 76;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 77;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 78;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 79;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 80;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 81;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 82;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 83;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 84;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 85;
+  } else if (ver >= 0x0006001C00120056) { // 06.28.18.86
+    // "STEAMUGC_INTERFACE_VERSION015", used since Steamworks SDK v1.51
+    ISteamUGC_desc.num_methods = 84;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 73;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 75;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 76;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 77;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 78;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 79;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 80;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 81;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 82;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 83;
+  } else if (ver >= 0x000500350021004E) { // 05.53.33.78
+    // "STEAMUGC_INTERFACE_VERSION014", used since Steamworks SDK v1.47
+    ISteamUGC_desc.num_methods = 79;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 73;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 75;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 76;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 77;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 78;
+  } else if (ver >= 0x000500130026003E) { // 05.19.38.62
+    // "STEAMUGC_INTERFACE_VERSION013", used since Steamworks SDK v1.45
+    ISteamUGC_desc.num_methods = 78;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 73;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 75;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 76;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 77;
+  } else if (ver >= 0x0004005F0014001E) { // 04.95.20.30
+    // "STEAMUGC_INTERFACE_VERSION012", used since Steamworks SDK v1.43
+    ISteamUGC_desc.num_methods = 76;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 73;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 75;
+  } else if (ver >= 0x0003005C0048003A) { // 03.92.72.58
+    // "STEAMUGC_INTERFACE_VERSION010", used since Steamworks SDK v1.40
+    ISteamUGC_desc.num_methods = 74;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 66;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 68;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 69;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 70;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 71;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 72;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 73;
+  } else if (ver >= 0x0003003E00520052) { // 03.62.82.82
+    // "STEAMUGC_INTERFACE_VERSION009", used since Steamworks SDK v1.38
+    ISteamUGC_desc.num_methods = 67;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 62;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 64;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 65;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 66;
+  } else if (ver >= 0x0003002A003D0042) { // 03.42.61.66
+    // "STEAMUGC_INTERFACE_VERSION008", used in Steamworks SDK v1.37
+    ISteamUGC_desc.num_methods = 63;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 57;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 59;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 60;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 61;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 62;
+  } else if (ver >= 0x00020059002D0004) { // 02.89.45.04
+    // "STEAMUGC_INTERFACE_VERSION007", used since Steamworks SDK v1.34
+    ISteamUGC_desc.num_methods = 58;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 45;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 47;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 48;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 49;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 50;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 51;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 52;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 53;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 54;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 55;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 56;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 57;
+  } else if (ver >= 0x0002004D00250052) { // 02.77.37.82
+    // "STEAMUGC_INTERFACE_VERSION005", used in Steamworks SDK v1.33
+    ISteamUGC_desc.num_methods = 46;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 30;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 32;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 33;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 34;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 35;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 36;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 37;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 38;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 39;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 40;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 41;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 42;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 43;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 44;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 45;
+  } else if (ver >= 0x000200130022005D) { // 02.19.34.93
+    // "STEAMUGC_INTERFACE_VERSION002" and "STEAMUGC_INTERFACE_VERSION003",
+    //    used since Steamworks SDK v1.29
+    ISteamUGC_desc.num_methods = 31;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 13;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 15;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 16;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 17;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 18;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 19;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 20;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 21;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 22;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 23;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 24;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 25;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 26;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 27;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 28;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 29;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateInfo] = 30;
+  } else {
+    // "STEAMUGC_INTERFACE_VERSION001"
+    ISteamUGC_desc.num_methods = 14;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 2;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 3;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 4;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 5;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 6;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 7;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 8;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 9;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 10;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 11;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 12;
+    ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 13;
+  }
+  ISteamUGC_desc.orig_vtable = ISteamUGC_ptr->vtable;
+  ISteamUGC_desc.iface = ISteamUGC_ptr;
+  std::ranges::copy_n(ISteamUGC_ptr->vtable, ISteamUGC_desc.num_methods,
+                      ISteamUGC_desc.vtable.begin());
+  ISteamUGC_ptr->vtable = ISteamUGC_desc.vtable.data();
+}
+
+/// `SteamAPI_Init` function type.
+using SteamAPI_Init_t = bool();
+
+/// Time spent in the original `SteamAPI_Init`, in milliseconds.
+static metrics::counter startup_steam_init_ms{"startup.steam_init_ms"};
+/// Total time of jobs run concurrently with the original `SteamAPI_Init`, in
+///    milliseconds.
+static metrics::counter startup_pre_init_jobs_ms{"startup.pre_init_jobs_ms"};
+/// Time spent waiting for pre-init jobs after the original `SteamAPI_Init` has
+///    returned, in milliseconds. Non-zero values mean that the jobs are on
+///    the critical path.
+static metrics::counter startup_pre_init_wait_ms{"startup.pre_init_wait_ms"};
+/// Total time spent in successful `SteamAPI_Init` wrapper calls, in
+///    milliseconds.
+static metrics::counter startup_total_ms{"startup.total_ms"};
+
+/// Get the number of milliseconds elapsed since specified time point.
+///
+/// @param start
+///    The time point to measure from.
+/// @return Number of elapsed milliseconds.
+static std::uint64_t ms_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+/// Wrap a pre-init job function so its duration is accounted in
+///    @ref startup_pre_init_jobs_ms.
+///
+/// @param fn
+///    The function to wrap.
+/// @return Callable that can be submitted to a job pool.
+static auto timed_job(void (*_Nonnull fn)()) {
+  return [fn] {
+    const auto start{std::chrono::steady_clock::now()};
+    fn();
+    startup_pre_init_jobs_ms.add(ms_since(start));
+  };
+}
+
+/// Start setup jobs that only depend on settings, so they run concurrently
+///    with the original `SteamAPI_Init`, which blocks on IPC with Steam
+///    client. The cross-process cache is opened first, since both DLC list
+///    update and game-specific setup read from it; loading tek-steamclient
+///    and the game's pre-init callback run in parallel after that.
+///
+/// @return Futures for the jobs of the graph. Jobs that aren't needed with
+///    current settings have invalid futures.
+static std::array<jobs::future<void>, 3> start_pre_init_jobs() {
+  std::array<jobs::future<void>, 3> futures;
+  // The main thread blocks on these jobs, so they're run with high priority
+  futures[0] = jobs::runtime_pool().submit(
+      timed_job([] {
+        if (g_settings.steam->shared_cache) {
+          shared_cache::open(g_settings.steam->app_id);
+        }
+      }),
+      jobs::priority::high);
+  if (g_settings.steam->auto_update_dlc) {
+    futures[1] =
+        futures[0].then(timed_job(steamclient::load), jobs::priority::high);
+  }
+  const auto cb{get_steam_api_pre_init_cb()};
+  if (cb) {
+    futures[2] = futures[0].then(timed_job(cb), jobs::priority::high);
+  }
+  return futures;
+}
+
+/// Wrapper for `SteamAPI_Init`.
+static bool SteamAPI_Init() {
+  const auto start{std::chrono::steady_clock::now()};
+  const auto pre_init_jobs{start_pre_init_jobs()};
+  const auto app_id{g_settings.steam->app_id};
+  const auto spoof_app_id{g_settings.steam->spoof_app_id};
+  std::array<WCHAR, 11> buf;
+  *std::format_to_n(buf.data(), buf.size(), std::locale::classic(), L"{}",
+                    spoof_app_id ? spoof_app_id : app_id)
+       .out = L'\0';
+  SetEnvironmentVariableW(L"SteamAppId", buf.data());
+  const auto SteamAPI_Init_orig{reinterpret_cast<SteamAPI_Init_t *>(
+      GetProcAddress(GetModuleHandleW(L"steam_api64.dll"), "SteamAPI_Init"))};
+  const auto steam_init_start{std::chrono::steady_clock::now()};
+  bool res{SteamAPI_Init_orig()};
+  bool fallback{};
+  if (!res && !spoof_app_id) {
+    // User probably doesn't have license for app_id, try again with 480
+    SetEnvironmentVariableW(L"SteamAppId", L"480");
+    res = SteamAPI_Init_orig();
+    fallback = true;
+  }
+  startup_steam_init_ms.add(ms_since(steam_init_start));
+  {
+    // Pre-init jobs read settings, so they must be done before settings are
+    //    modified, and before returning on failure as well
+    const auto wait_start{std::chrono::steady_clock::now()};
+    for (const auto &job : pre_init_jobs) {
+      if (job.valid()) {
+        job.wait();
+      }
+    }
+    startup_pre_init_wait_ms.add(ms_since(wait_start));
+  }
+  if (res && !spoof_app_id) {
+    g_settings.steam->spoof_app_id = fallback ? 480 : app_id;
+  }
+  if (!res) {
+    display_error(
+        L"SteamAPI_Init() returned false. Make sure that Steam is running; if "
+        L"it is, try signing out of your account then signing back in.");
+    return false;
+  }
+  if (!load_version()) {
+    return false;
+  }
+  const auto module{GetModuleHandleW(L"steam_api64.dll")};
   // Obtain interface pointers
   cpp_interface *ISteamApps_ptr;
+  cpp_interface *ISteamHTTP_ptr;
   cpp_interface *ISteamMatchmaking_ptr;
   cpp_interface *ISteamMatchmakingServers_ptr;
+  cpp_interface *ISteamRemoteStorage_ptr;
+  cpp_interface *ISteamUserStats_ptr;
   cpp_interface *ISteamUGC_ptr;
   cpp_interface *ISteamUser_ptr;
   cpp_interface *ISteamUtils_ptr;
@@ -229,26 +2916,9 @@ static bool SteamAPI_Init() {
     using ISteamClient_GetISteamGenericInterface_t = cpp_interface *(
         cpp_interface *, std::int32_t, std::int32_t, const char *);
     const char *interface_ver;
-    // Get ISteamClient
-    if (ver >= 0x0008003F000B0054) { // 08.63.11.84
-      // Steamworks SDK v1.59+
-      interface_ver = "SteamClient021";
-    } else if (ver >= 0x000500350021004E) { // 05.53.33.78
-      // Steamworks SDK v1.47+
-      interface_ver = "SteamClient020";
-    } else if (ver >= 0x0005001900410015) { // 05.25.65.21
-      // Steamworks SDK v1.46
-      interface_ver = "SteamClient019";
-    } else if (ver >= 0x0004005F0014001E) { // 04.95.20.30
-      // Steamworks SDK v1.43+
-      interface_ver = "SteamClient018";
-    } else {
-      // All previous Steamworks SDK versions since v1.37
-      interface_ver = "SteamClient017";
-    }
     const auto ISteamClient_ptr{
         reinterpret_cast<SteamInternal_CreateInterface_t *>(GetProcAddress(
-            module, "SteamInternal_CreateInterface"))(interface_ver)};
+            module, "SteamInternal_CreateInterface"))(client_interface_ver())};
     const auto ISteamClient_GetISteamGenericInterface{
         reinterpret_cast<ISteamClient_GetISteamGenericInterface_t *>(
             ISteamClient_ptr->vtable[12])};
@@ -256,55 +2926,65 @@ static bool SteamAPI_Init() {
         GetProcAddress(module, "SteamAPI_GetHSteamPipe"))()};
     const auto user{reinterpret_cast<SteamAPI_GetHSteam_t *>(
         GetProcAddress(module, "SteamAPI_GetHSteamUser"))()};
+    steam_user = user;
     // Get ISteamApps
     ISteamApps_ptr = ISteamClient_GetISteamGenericInterface(
         ISteamClient_ptr, user, pipe, "STEAMAPPS_INTERFACE_VERSION008");
+    // Get ISteamHTTP
+    if (call_results_hooked && !g_settings.steam->http_cache_path.empty()) {
+      ISteamHTTP_ptr = ISteamClient_GetISteamGenericInterface(
+          ISteamClient_ptr, user, pipe,
+          ver >= 0x0004005F0014001E // 04.95.20.30
+              // Steamworks SDK v1.43+
+              ? "STEAMHTTP_INTERFACE_VERSION003"
+              // All previous Steamworks SDK versions since v1.37
+              : "STEAMHTTP_INTERFACE_VERSION002");
+    } else {
+      ISteamHTTP_ptr = nullptr;
+    }
     // Get ISteamMatchmaking
     ISteamMatchmaking_ptr = ISteamClient_GetISteamGenericInterface(
         ISteamClient_ptr, user, pipe, "SteamMatchMaking009");
     // Get ISteamMatchmakingServers
     ISteamMatchmakingServers_ptr = ISteamClient_GetISteamGenericInterface(
         ISteamClient_ptr, user, pipe, "SteamMatchMakingServers002");
-    // Get ISteamUGC
-    ISteamUGC_ptr = ISteamClient_GetISteamGenericInterface(
-        ISteamClient_ptr, user, pipe, interface_ver);
-    if (ver >= 0x0009003C002C000A) { // 09.60.44.10
-      // Steamworks SDK v1.62
-      interface_ver = "STEAMUGC_INTERFACE_VERSION021";
-    } else if (ver >= 0x0008006100630046) { // 08.97.99.70
-      // Steamworks SDK v1.60+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION020";
-    } else if (ver >= 0x0008002100090017) { // 08.33.09.23
-      // Steamworks SDK v1.58+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION018";
-    } else if (ver >= 0x000700600000002C) { // 07.96.00.44
-      // Steamworks SDK v1.56+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION017";
-    } else if (ver >= 0x0006005B00150039) { // 06.91.21.57
-      // Steamworks SDK v1.53+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION016";
-    } else if (ver >= 0x0006001C00120056) { // 06.28.18.86
-      // Steamworks SDK v1.51+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION015";
-    } else if (ver >= 0x000500350021004E) { // 05.53.33.78
-      // Steamworks SDK v1.47+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION014";
-    } else if (ver >= 0x000500130026003E) { // 05.19.38.62
-      // Steamworks SDK v1.45+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION013";
-    } else if (ver >= 0x0004005F0014001E) { // 04.95.20.30
-      // Steamworks SDK v1.43+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION012";
-    } else if (ver >= 0x0003005C0048003A) { // 03.92.72.58
-      // Steamworks SDK v1.40+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION010";
-    } else if (ver >= 0x0003003E00520052) { // 03.62.82.82
-      // Steamworks SDK v1.38+
-      interface_ver = "STEAMUGC_INTERFACE_VERSION009";
+    // Get ISteamRemoteStorage
+    if (g_settings.steam->cache_remote_storage) {
+      if (ver >= 0x0006001C00120056) { // 06.28.18.86
+        // Steamworks SDK v1.51+
+        interface_ver = "STEAMREMOTESTORAGE_INTERFACE_VERSION016";
+      } else if (ver >= 0x0003005C0048003A) { // 03.92.72.58
+        // Steamworks SDK v1.40+
+        interface_ver = "STEAMREMOTESTORAGE_INTERFACE_VERSION014";
+      } else {
+        // All previous Steamworks SDK versions since v1.37
+        interface_ver = "STEAMREMOTESTORAGE_INTERFACE_VERSION013";
+      }
+      ISteamRemoteStorage_ptr = ISteamClient_GetISteamGenericInterface(
+          ISteamClient_ptr, user, pipe, interface_ver);
+    } else {
+      ISteamRemoteStorage_ptr = nullptr;
+    }
+    // Get ISteamUserStats
+    if (g_settings.steam->cache_user_stats) {
+      if (ver >= 0x0009003C002C000A) { // 09.60.44.10
+        // Steamworks SDK v1.62
+        interface_ver = "STEAMUSERSTATS_INTERFACE_VERSION013";
+      } else if (ver >= 0x0006005B00150039) { // 06.91.21.57
+        // Steamworks SDK v1.53+
+        interface_ver = "STEAMUSERSTATS_INTERFACE_VERSION012";
+      } else {
+        // All previous Steamworks SDK versions since v1.37
+        interface_ver = "STEAMUSERSTATS_INTERFACE_VERSION011";
+      }
+      ISteamUserStats_ptr = ISteamClient_GetISteamGenericInterface(
+          ISteamClient_ptr, user, pipe, interface_ver);
     } else {
-      // Steamworks SDK v1.37
-      interface_ver = "STEAMUGC_INTERFACE_VERSION008";
+      ISteamUserStats_ptr = nullptr;
     }
+    // Get ISteamUGC
+    ISteamUGC_ptr = ISteamClient_GetISteamGenericInterface(
+        ISteamClient_ptr, user, pipe, ugc_interface_ver());
     // Get ISteamUser
     if (ver >= 0x000800020015005F) { // 08.02.21.95
       // Steamworks SDK v1.57+
@@ -347,6 +3027,11 @@ static bool SteamAPI_Init() {
         GetProcAddress(module, "SteamMatchmaking"))();
     ISteamMatchmakingServers_ptr = reinterpret_cast<getter_t *>(
         GetProcAddress(module, "SteamMatchmakingServers"))();
+    // HTTP response, remote storage and user stats caching rely on the layout
+    //    of interface versions used since Steamworks SDK v1.37
+    ISteamHTTP_ptr = nullptr;
+    ISteamRemoteStorage_ptr = nullptr;
+    ISteamUserStats_ptr = nullptr;
     if (ver >= 0x00010062001F0049) { // 01.98.31.73
       /// ISteamUGC appeared only in Steamworks SDK v1.26
       ISteamUGC_ptr =
@@ -468,1004 +3153,8 @@ static bool SteamAPI_Init() {
   }
   // ISteamUGC
   if (ISteamUGC_ptr) {
-    if (ver >= 0x0009003C002C000A) { // 09.60.44.10
-      // "STEAMUGC_INTERFACE_VERSION021", used in Steamworks SDK v1.62
-      ISteamUGC_desc.num_methods = 96;
-      for (std::size_t i = 0; i < ISteamUGC_desc.num_methods; ++i) {
-        ISteamUGC_desc.vm_idxs[i] = i;
-      }
-    } else if (ver >= 0x0008006100630046) { // 08.97.99.70
-      // "STEAMUGC_INTERFACE_VERSION020", used since Steamworks SDK v1.60
-      ISteamUGC_desc.num_methods = 94;
-      for (std::size_t i = 0; i < ISteamUGC_desc.num_methods; ++i) {
-        ISteamUGC_desc.vm_idxs[i] = i;
-      }
-    } else if (ver >= 0x0008002100090017) { // 08.33.09.23
-      // "STEAMUGC_INTERFACE_VERSION018", used since Steamworks SDK v1.58
-      ISteamUGC_desc.num_methods = 90;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCContentDescriptors] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeCreatedDateRange] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeUpdatedDateRange] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddContentDescriptor] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveContentDescriptor] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 73;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 75;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 76;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 77;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 78;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 79;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 80;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 81;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 82;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 83;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 84;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 85;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 86;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 87;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 88;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserContentDescriptorPreferences] =
-          89;
-    } else if (ver >= 0x000700600000002C) { // 07.96.00.44
-      // "STEAMUGC_INTERFACE_VERSION017", used since Steamworks SDK v1.56
-      ISteamUGC_desc.num_methods = 89;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCContentDescriptors] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeCreatedDateRange] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeUpdatedDateRange] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddContentDescriptor] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveContentDescriptor] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 73;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 75;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 76;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 77;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 78;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 79;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 80;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 81;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 82;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 83;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 84;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 85;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 86;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 87;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 88;
-    } else if (ver >= 0x0006005B00150039) { // 06.91.21.57
-      // "STEAMUGC_INTERFACE_VERSION016", used since Steamworks SDK v1.53
-      ISteamUGC_desc.num_methods = 86;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeCreatedDateRange] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetTimeUpdatedDateRange] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 73;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 75;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 76;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 77;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 78;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 79;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 80;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 81;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 82;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 83;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 84;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 85;
-    } else if (ver >= 0x0006001C00120056) { // 06.28.18.86
-      // "STEAMUGC_INTERFACE_VERSION015", used since Steamworks SDK v1.51
-      ISteamUGC_desc.num_methods = 84;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumTags] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTag] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCTagDisplayName] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 73;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 75;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 76;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 77;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 78;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 79;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 80;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 81;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ShowWorkshopEULA] = 82;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetWorkshopEULAStatus] = 83;
-    } else if (ver >= 0x000500350021004E) { // 05.53.33.78
-      // "STEAMUGC_INTERFACE_VERSION014", used since Steamworks SDK v1.47
-      ISteamUGC_desc.num_methods = 79;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTagGroup] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 73;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 75;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 76;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 77;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 78;
-    } else if (ver >= 0x000500130026003E) { // 05.19.38.62
-      // "STEAMUGC_INTERFACE_VERSION013", used since Steamworks SDK v1.45
-      ISteamUGC_desc.num_methods = 78;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryFirstUGCKeyValueTag] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAllItemKeyValueTags] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 73;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 75;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 76;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 77;
-    } else if (ver >= 0x0004005F0014001E) { // 04.95.20.30
-      // "STEAMUGC_INTERFACE_VERSION012", used since Steamworks SDK v1.43
-      ISteamUGC_desc.num_methods = 76;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestCursor] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowLegacyUpload] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 73;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 75;
-    } else if (ver >= 0x0003005C0048003A) { // 03.92.72.58
-      // "STEAMUGC_INTERFACE_VERSION010", used since Steamworks SDK v1.40
-      ISteamUGC_desc.num_methods = 74;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnPlaytimeStats] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 66;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddDependency] = 68;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveDependency] = 69;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddAppDependency] = 70;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveAppDependency] = 71;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetAppDependencies] = 72;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DeleteItem] = 73;
-    } else if (ver >= 0x0003003E00520052) { // 03.62.82.82
-      // "STEAMUGC_INTERFACE_VERSION009", used since Steamworks SDK v1.38
-      ISteamUGC_desc.num_methods = 67;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnOnlyIDs] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 62;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartPlaytimeTracking] = 64;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTracking] = 65;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StopPlaytimeTrackingForAllItems] = 66;
-    } else if (ver >= 0x0003002A003D0042) { // 03.42.61.66
-      // "STEAMUGC_INTERFACE_VERSION008", used in Steamworks SDK v1.37
-      ISteamUGC_desc.num_methods = 63;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewFile] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemPreviewVideo] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewFile] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UpdateItemPreviewVideo] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemPreview] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 57;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 59;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 60;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 61;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 62;
-    } else if (ver >= 0x00020059002D0004) { // 02.89.45.04
-      // "STEAMUGC_INTERFACE_VERSION007", used since Steamworks SDK v1.34
-      ISteamUGC_desc.num_methods = 58;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumKeyValueTags] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCKeyValueTag] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnKeyValueTags] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetLanguage] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredKeyValueTag] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemUpdateLanguage] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemKeyValueTags] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemKeyValueTag] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetUserItemVote] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetUserItemVote] = 45;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 47;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 48;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 49;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 50;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 51;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 52;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 53;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 54;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 55;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_BInitWorkshopForGameServer] = 56;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SuspendDownloads] = 57;
-    } else if (ver >= 0x0002004D00250052) { // 02.77.37.82
-      // "STEAMUGC_INTERFACE_VERSION005", used in Steamworks SDK v1.33
-      ISteamUGC_desc.num_methods = 46;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUGCDetailsRequest] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCPreviewURL] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCMetadata] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCChildren] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCStatistic] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCNumAdditionalPreviews] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCAdditionalPreview] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnMetadata] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnChildren] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnAdditionalPreviews] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemMetadata] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 30;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 32;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 33;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 34;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 35;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddItemToFavorites] = 36;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RemoveItemFromFavorites] = 37;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 38;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 39;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 40;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 41;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemState] = 42;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 43;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemDownloadInfo] = 44;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_DownloadItem] = 45;
-    } else if (ver >= 0x000200130022005D) { // 02.19.34.93
-      // "STEAMUGC_INTERFACE_VERSION002" and "STEAMUGC_INTERFACE_VERSION003",
-      //    used since Steamworks SDK v1.29
-      ISteamUGC_desc.num_methods = 31;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetAllowCachedResponse] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 13;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateItem] = 15;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_StartItemUpdate] = 16;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTitle] = 17;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemDescription] = 18;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemVisibility] = 19;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemTags] = 20;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemContent] = 21;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetItemPreview] = 22;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubmitItemUpdate] = 23;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateProgress] = 24;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SubscribeItem] = 25;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_UnsubscribeItem] = 26;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetNumSubscribedItems] = 27;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetSubscribedItems] = 28;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemInstallInfo] = 29;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetItemUpdateInfo] = 30;
-    } else {
-      // "STEAMUGC_INTERFACE_VERSION001"
-      ISteamUGC_desc.num_methods = 14;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryUserUGCRequest] = 0;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_CreateQueryAllUGCRequestPage] = 1;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SendQueryUGCRequest] = 2;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_GetQueryUGCResult] = 3;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_ReleaseQueryUGCRequest] = 4;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddRequiredTag] = 5;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_AddExcludedTag] = 6;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnLongDescription] = 7;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetReturnTotalOnly] = 8;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetCloudFileNameFilter] = 9;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetMatchAnyTag] = 10;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetSearchText] = 11;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_SetRankedByTrendDays] = 12;
-      ISteamUGC_desc.vm_idxs[ISteamUGC_m_RequestUGCDetails] = 13;
-    }
-    ISteamUGC_desc.orig_vtable = ISteamUGC_ptr->vtable;
-    ISteamUGC_desc.iface = ISteamUGC_ptr;
-    std::ranges::copy_n(ISteamUGC_ptr->vtable, ISteamUGC_desc.num_methods,
-                        ISteamUGC_desc.vtable.begin());
-    ISteamUGC_ptr->vtable = ISteamUGC_desc.vtable.data();
-  } // if (ISteamUGC_ptr)
+    wrap_ugc(ISteamUGC_ptr);
+  }
   // ISteamUser
   if (ver >= 0x000800020015005F) { // 08.02.21.95
     // "SteamUser023", used since Steamworks SDK v1.57
@@ -1712,6 +3401,71 @@ static bool SteamAPI_Init() {
   for (std::size_t i{}; i < ISteamUtils_desc.num_methods; ++i) {
     ISteamUtils_desc.vm_idxs[i] = i;
   }
+  // ISteamHTTP
+  if (ISteamHTTP_ptr) {
+    auto &desc{ISteamHTTP_desc};
+    // "STEAMHTTP_INTERFACE_VERSION003" and "...002" have the same methods
+    desc.num_methods = 25;
+    desc.orig_vtable = ISteamHTTP_ptr->vtable;
+    desc.iface = ISteamHTTP_ptr;
+    std::ranges::copy_n(ISteamHTTP_ptr->vtable, desc.num_methods,
+                        desc.vtable.begin());
+    ISteamHTTP_ptr->vtable = desc.vtable.data();
+    for (std::size_t i{}; i < desc.num_methods; ++i) {
+      desc.vm_idxs[i] = i;
+    }
+  }
+  // ISteamRemoteStorage
+  if (ISteamRemoteStorage_ptr) {
+    auto &desc{ISteamRemoteStorage_desc};
+    if (ver >= 0x0006001C00120056) { // 06.28.18.86
+      // "STEAMREMOTESTORAGE_INTERFACE_VERSION016", used since Steamworks SDK
+      //    v1.51
+      desc.num_methods = 59;
+    } else {
+      // "STEAMREMOTESTORAGE_INTERFACE_VERSION014" and "...013", used since
+      //    Steamworks SDK v1.37; they differ only in GetQuota parameter types
+      desc.num_methods = 55;
+    }
+    desc.orig_vtable = ISteamRemoteStorage_ptr->vtable;
+    desc.iface = ISteamRemoteStorage_ptr;
+    std::ranges::copy_n(ISteamRemoteStorage_ptr->vtable, desc.num_methods,
+                        desc.vtable.begin());
+    ISteamRemoteStorage_ptr->vtable = desc.vtable.data();
+    for (std::size_t i{}; i < desc.num_methods; ++i) {
+      desc.vm_idxs[i] = i;
+    }
+  }
+  // ISteamUserStats
+  if (ISteamUserStats_ptr) {
+    auto &desc{ISteamUserStats_desc};
+    if (ver >= 0x0009003C002C000A) { // 09.60.44.10
+      // "STEAMUSERSTATS_INTERFACE_VERSION013", without RequestCurrentStats
+      desc.num_methods = 44;
+    } else if (ver >= 0x0006005B00150039) { // 06.91.21.57
+      // "STEAMUSERSTATS_INTERFACE_VERSION012", used since Steamworks SDK v1.53
+      desc.num_methods = 45;
+    } else {
+      // "STEAMUSERSTATS_INTERFACE_VERSION011", used by earlier Steamworks SDK
+      //    versions
+      desc.num_methods = 43;
+    }
+    desc.orig_vtable = ISteamUserStats_ptr->vtable;
+    desc.iface = ISteamUserStats_ptr;
+    std::ranges::copy_n(ISteamUserStats_ptr->vtable, desc.num_methods,
+                        desc.vtable.begin());
+    ISteamUserStats_ptr->vtable = desc.vtable.data();
+    if (desc.num_methods == 44) {
+      // RequestCurrentStats has been removed from the start of the vtable
+      for (std::size_t i{1}; i < ISteamUserStats_num_methods; ++i) {
+        desc.vm_idxs[i] = i - 1;
+      }
+    } else {
+      for (std::size_t i{}; i < desc.num_methods; ++i) {
+        desc.vm_idxs[i] = i;
+      }
+    }
+  }
   // Get current user Steam ID
   reinterpret_cast<ISteamUser_GetSteamID_t *>(
       ISteamUser_desc
@@ -1724,12 +3478,6 @@ static bool SteamAPI_Init() {
       ISteamApps_BIsSubscribedApp_t *>(
       ISteamApps_desc
           .orig_vtable[ISteamApps_desc.vm_idxs[ISteamApps_m_BIsSubscribedApp]]);
-  ISteamApps_desc
-      .vtable[ISteamApps_desc.vm_idxs[ISteamApps_m_BIsSubscribedApp]] =
-      reinterpret_cast<void *>(SteamApps_BIsSubscribedApp);
-  ISteamApps_desc
-      .vtable[ISteamApps_desc.vm_idxs[ISteamApps_m_BIsDlcInstalled]] =
-      reinterpret_cast<void *>(SteamApps_BIsDlcInstalled);
   int idx;
   idx = ISteamApps_desc.vm_idxs[ISteamApps_m_BIsSubscribedFromFreeWeekend];
   if (idx >= 0) {
@@ -1751,9 +3499,14 @@ static bool SteamAPI_Init() {
     SteamApps_BIsAppInstalled_orig =
         reinterpret_cast<ISteamApps_BIsAppInstalled_t *>(
             ISteamApps_desc.orig_vtable[idx]);
-    ISteamApps_desc.vtable[idx] =
-        reinterpret_cast<void *>(SteamApps_BIsAppInstalled);
   }
+  // DLC lookup wrappers are specialized for the shape of DLC lists, and are
+  //    re-selected whenever the lists change
+  {
+    const std::scoped_lock lock{dlc_index_mtx};
+    dlc_wrappers_installed = true;
+  }
+  update_dlc_index();
   idx = ISteamApps_desc.vm_idxs[ISteamApps_m_GetAppOwner];
   if (idx >= 0) {
     ISteamApps_desc.vtable[idx] =
@@ -1774,98 +3527,517 @@ static bool SteamAPI_Init() {
       reinterpret_cast<void *>(SteamUser_UserHasLicenseForApp);
   ISteamUtils_desc.vtable[ISteamUtils_desc.vm_idxs[ISteamUtils_m_GetAppID]] =
       reinterpret_cast<void *>(SteamUtils_GetAppID);
-  if (g_settings.steam->auto_update_dlc) {
-    // Attempt to load tek-steamclient and update the DLC list.
-    steamclient::load();
-    if (steamclient::loaded) {
-      steamclient::update_dlc();
-    }
+  if (g_settings.steam->cache_lobby_data) {
+    // Setup lobby data cache wrappers
+    auto &desc{ISteamMatchmaking_desc};
+    SteamMatchmaking_RequestLobbyList_orig =
+        reinterpret_cast<ISteamMatchmaking_RequestLobbyList_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamMatchmaking_m_RequestLobbyList]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_RequestLobbyList]] =
+        reinterpret_cast<void *>(SteamMatchmaking_RequestLobbyList);
+    SteamMatchmaking_LeaveLobby_orig =
+        reinterpret_cast<ISteamMatchmaking_LeaveLobby_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamMatchmaking_m_LeaveLobby]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_LeaveLobby]] =
+        reinterpret_cast<void *>(SteamMatchmaking_LeaveLobby);
+    SteamMatchmaking_GetNumLobbyMembers_orig =
+        reinterpret_cast<ISteamMatchmaking_GetNumLobbyMembers_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamMatchmaking_m_GetNumLobbyMembers]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_GetNumLobbyMembers]] =
+        reinterpret_cast<void *>(SteamMatchmaking_GetNumLobbyMembers);
+    SteamMatchmaking_GetLobbyData_orig =
+        reinterpret_cast<ISteamMatchmaking_GetLobbyData_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamMatchmaking_m_GetLobbyData]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_GetLobbyData]] =
+        reinterpret_cast<void *>(SteamMatchmaking_GetLobbyData);
+    SteamMatchmaking_SetLobbyData_orig =
+        reinterpret_cast<ISteamMatchmaking_SetLobbyData_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamMatchmaking_m_SetLobbyData]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_SetLobbyData]] =
+        reinterpret_cast<void *>(SteamMatchmaking_SetLobbyData);
+    SteamMatchmaking_GetLobbyDataCount_orig =
+        reinterpret_cast<ISteamMatchmaking_GetLobbyDataCount_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamMatchmaking_m_GetLobbyDataCount]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_GetLobbyDataCount]] =
+        reinterpret_cast<void *>(SteamMatchmaking_GetLobbyDataCount);
+    SteamMatchmaking_GetLobbyDataByIndex_orig =
+        reinterpret_cast<ISteamMatchmaking_GetLobbyDataByIndex_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamMatchmaking_m_GetLobbyDataByIndex]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_GetLobbyDataByIndex]] =
+        reinterpret_cast<void *>(SteamMatchmaking_GetLobbyDataByIndex);
+    SteamMatchmaking_DeleteLobbyData_orig =
+        reinterpret_cast<ISteamMatchmaking_DeleteLobbyData_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamMatchmaking_m_DeleteLobbyData]]);
+    desc.vtable[desc.vm_idxs[ISteamMatchmaking_m_DeleteLobbyData]] =
+        reinterpret_cast<void *>(SteamMatchmaking_DeleteLobbyData);
+    register_callback(lobby_enter_invalidator, 504);
+    register_callback(lobby_data_update_invalidator, 505);
+    register_callback(lobby_chat_update_invalidator, 506);
+    register_callback(lobby_match_list_invalidator, 510);
+  }
+  if (ISteamHTTP_desc.iface) {
+    // Setup HTTP response cache wrappers
+    auto &desc{ISteamHTTP_desc};
+    const auto get_orig{[&desc]<typename T>(T *&fn, ISteamHTTP_m method) {
+      fn = reinterpret_cast<T *>(desc.orig_vtable[desc.vm_idxs[method]]);
+    }};
+    steam_http::backend methods;
+    get_orig(methods.CreateHTTPRequest, ISteamHTTP_m_CreateHTTPRequest);
+    get_orig(methods.SetHTTPRequestContextValue,
+             ISteamHTTP_m_SetHTTPRequestContextValue);
+    get_orig(methods.SetHTTPRequestHeaderValue,
+             ISteamHTTP_m_SetHTTPRequestHeaderValue);
+    get_orig(methods.SetHTTPRequestGetOrPostParameter,
+             ISteamHTTP_m_SetHTTPRequestGetOrPostParameter);
+    get_orig(methods.SendHTTPRequest, ISteamHTTP_m_SendHTTPRequest);
+    get_orig(methods.GetHTTPResponseHeaderSize,
+             ISteamHTTP_m_GetHTTPResponseHeaderSize);
+    get_orig(methods.GetHTTPResponseHeaderValue,
+             ISteamHTTP_m_GetHTTPResponseHeaderValue);
+    get_orig(methods.GetHTTPResponseBodySize,
+             ISteamHTTP_m_GetHTTPResponseBodySize);
+    get_orig(methods.GetHTTPResponseBodyData,
+             ISteamHTTP_m_GetHTTPResponseBodyData);
+    get_orig(methods.ReleaseHTTPRequest, ISteamHTTP_m_ReleaseHTTPRequest);
+    get_orig(methods.GetHTTPDownloadProgressPct,
+             ISteamHTTP_m_GetHTTPDownloadProgressPct);
+    get_orig(methods.SetHTTPRequestRawPostBody,
+             ISteamHTTP_m_SetHTTPRequestRawPostBody);
+    get_orig(methods.SetHTTPRequestCookieContainer,
+             ISteamHTTP_m_SetHTTPRequestCookieContainer);
+    steam_http::init(methods);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_CreateHTTPRequest]] =
+        reinterpret_cast<void *>(steam_http::CreateHTTPRequest);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_SetHTTPRequestContextValue]] =
+        reinterpret_cast<void *>(steam_http::SetHTTPRequestContextValue);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_SetHTTPRequestHeaderValue]] =
+        reinterpret_cast<void *>(steam_http::SetHTTPRequestHeaderValue);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_SetHTTPRequestGetOrPostParameter]] =
+        reinterpret_cast<void *>(steam_http::SetHTTPRequestGetOrPostParameter);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_SendHTTPRequest]] =
+        reinterpret_cast<void *>(steam_http::SendHTTPRequest);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_GetHTTPResponseHeaderSize]] =
+        reinterpret_cast<void *>(steam_http::GetHTTPResponseHeaderSize);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_GetHTTPResponseHeaderValue]] =
+        reinterpret_cast<void *>(steam_http::GetHTTPResponseHeaderValue);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_GetHTTPResponseBodySize]] =
+        reinterpret_cast<void *>(steam_http::GetHTTPResponseBodySize);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_GetHTTPResponseBodyData]] =
+        reinterpret_cast<void *>(steam_http::GetHTTPResponseBodyData);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_ReleaseHTTPRequest]] =
+        reinterpret_cast<void *>(steam_http::ReleaseHTTPRequest);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_GetHTTPDownloadProgressPct]] =
+        reinterpret_cast<void *>(steam_http::GetHTTPDownloadProgressPct);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_SetHTTPRequestRawPostBody]] =
+        reinterpret_cast<void *>(steam_http::SetHTTPRequestRawPostBody);
+    desc.vtable[desc.vm_idxs[ISteamHTTP_m_SetHTTPRequestCookieContainer]] =
+        reinterpret_cast<void *>(steam_http::SetHTTPRequestCookieContainer);
+    http_cache::open(utf::to_wide(g_settings.steam->http_cache_path));
+    // Served requests complete via synthetic calls, which games polling
+    //    ISteamUtils instead of registering call results need answers for
+    auto &utils_desc{ISteamUtils_desc};
+    SteamUtils_IsAPICallCompleted_orig =
+        reinterpret_cast<ISteamUtils_IsAPICallCompleted_t *>(
+            utils_desc.orig_vtable
+                [utils_desc.vm_idxs[ISteamUtils_m_IsAPICallCompleted]]);
+    utils_desc.vtable[utils_desc.vm_idxs[ISteamUtils_m_IsAPICallCompleted]] =
+        reinterpret_cast<void *>(SteamUtils_IsAPICallCompleted);
+    SteamUtils_GetAPICallResult_orig =
+        reinterpret_cast<ISteamUtils_GetAPICallResult_t *>(
+            utils_desc.orig_vtable
+                [utils_desc.vm_idxs[ISteamUtils_m_GetAPICallResult]]);
+    utils_desc.vtable[utils_desc.vm_idxs[ISteamUtils_m_GetAPICallResult]] =
+        reinterpret_cast<void *>(SteamUtils_GetAPICallResult);
+  }
+  if (ISteamRemoteStorage_desc.iface) {
+    // Setup remote storage cache wrappers
+    remote_storage_cache::init(cloud_backend);
+    auto &desc{ISteamRemoteStorage_desc};
+    SteamRemoteStorage_FileWrite_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileWrite_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileWrite]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileWrite]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileWrite);
+    SteamRemoteStorage_FileRead_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileRead_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileRead]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileRead]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileRead);
+    SteamRemoteStorage_FileWriteAsync_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileWriteAsync_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamRemoteStorage_m_FileWriteAsync]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileWriteAsync]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileWriteAsync);
+    SteamRemoteStorage_FileReadAsync_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileReadAsync_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamRemoteStorage_m_FileReadAsync]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileReadAsync]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileReadAsync);
+    SteamRemoteStorage_FileForget_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileForget_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileForget]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileForget]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileForget);
+    SteamRemoteStorage_FileDelete_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileDelete_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileDelete]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileDelete]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileDelete);
+    SteamRemoteStorage_FileWriteStreamOpen_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileWriteStreamOpen_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamRemoteStorage_m_FileWriteStreamOpen]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileWriteStreamOpen]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileWriteStreamOpen);
+    SteamRemoteStorage_FileExists_orig =
+        reinterpret_cast<ISteamRemoteStorage_FileExists_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileExists]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_FileExists]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_FileExists);
+    SteamRemoteStorage_GetFileSize_orig =
+        reinterpret_cast<ISteamRemoteStorage_GetFileSize_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamRemoteStorage_m_GetFileSize]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_GetFileSize]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_GetFileSize);
+    SteamRemoteStorage_GetFileTimestamp_orig =
+        reinterpret_cast<ISteamRemoteStorage_GetFileTimestamp_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamRemoteStorage_m_GetFileTimestamp]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_GetFileTimestamp]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_GetFileTimestamp);
+    SteamRemoteStorage_GetFileCount_orig =
+        reinterpret_cast<ISteamRemoteStorage_GetFileCount_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamRemoteStorage_m_GetFileCount]]);
+    desc.vtable[desc.vm_idxs[ISteamRemoteStorage_m_GetFileCount]] =
+        reinterpret_cast<void *>(SteamRemoteStorage_GetFileCount);
+  }
+  if (ISteamUserStats_desc.iface) {
+    // Setup user stats cache wrappers
+    auto &desc{ISteamUserStats_desc};
+    SteamUserStats_GetStatFloat_orig =
+        reinterpret_cast<ISteamUserStats_GetStatFloat_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_GetStatFloat]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_GetStatFloat]] =
+        reinterpret_cast<void *>(SteamUserStats_GetStatFloat);
+    SteamUserStats_GetStatInt32_orig =
+        reinterpret_cast<ISteamUserStats_GetStatInt32_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_GetStatInt32]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_GetStatInt32]] =
+        reinterpret_cast<void *>(SteamUserStats_GetStatInt32);
+    SteamUserStats_SetStatFloat_orig =
+        reinterpret_cast<ISteamUserStats_SetStatFloat_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_SetStatFloat]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_SetStatFloat]] =
+        reinterpret_cast<void *>(SteamUserStats_SetStatFloat);
+    SteamUserStats_SetStatInt32_orig =
+        reinterpret_cast<ISteamUserStats_SetStatInt32_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_SetStatInt32]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_SetStatInt32]] =
+        reinterpret_cast<void *>(SteamUserStats_SetStatInt32);
+    SteamUserStats_UpdateAvgRateStat_orig =
+        reinterpret_cast<ISteamUserStats_UpdateAvgRateStat_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamUserStats_m_UpdateAvgRateStat]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_UpdateAvgRateStat]] =
+        reinterpret_cast<void *>(SteamUserStats_UpdateAvgRateStat);
+    SteamUserStats_GetAchievement_orig =
+        reinterpret_cast<ISteamUserStats_GetAchievement_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_GetAchievement]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_GetAchievement]] =
+        reinterpret_cast<void *>(SteamUserStats_GetAchievement);
+    SteamUserStats_SetAchievement_orig =
+        reinterpret_cast<ISteamUserStats_SetAchievement_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_SetAchievement]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_SetAchievement]] =
+        reinterpret_cast<void *>(SteamUserStats_SetAchievement);
+    SteamUserStats_ClearAchievement_orig =
+        reinterpret_cast<ISteamUserStats_ClearAchievement_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_ClearAchievement]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_ClearAchievement]] =
+        reinterpret_cast<void *>(SteamUserStats_ClearAchievement);
+    SteamUserStats_GetAchievementAndUnlockTime_orig =
+        reinterpret_cast<ISteamUserStats_GetAchievementAndUnlockTime_t *>(
+            desc.orig_vtable
+                [desc.vm_idxs[ISteamUserStats_m_GetAchievementAndUnlockTime]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_GetAchievementAndUnlockTime]] =
+        reinterpret_cast<void *>(SteamUserStats_GetAchievementAndUnlockTime);
+    SteamUserStats_StoreStats_orig =
+        reinterpret_cast<ISteamUserStats_StoreStats_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_StoreStats]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_StoreStats]] =
+        reinterpret_cast<void *>(SteamUserStats_StoreStats);
+    SteamUserStats_ResetAllStats_orig =
+        reinterpret_cast<ISteamUserStats_ResetAllStats_t *>(
+            desc.orig_vtable[desc.vm_idxs[ISteamUserStats_m_ResetAllStats]]);
+    desc.vtable[desc.vm_idxs[ISteamUserStats_m_ResetAllStats]] =
+        reinterpret_cast<void *>(SteamUserStats_ResetAllStats);
+    register_callback(user_stats_received_invalidator, 1101);
+    register_callback(user_stats_stored_invalidator, 1102);
   }
-  // Perform game-specific setup
   {
+    jobs::future<void> dlc_update;
+    if (g_settings.steam->auto_update_dlc && steamclient::loaded) {
+      // Update the DLC list in background while game-specific setup is
+      //    running
+      dlc_update = jobs::runtime_pool().submit(steamclient::update_dlc,
+                                               jobs::priority::high);
+    }
+    // Perform game-specific setup
     const auto cb{get_steam_api_init_cb()};
     if (cb) {
       cb();
     }
+    // The game may query DLC right after SteamAPI_Init returns, so the list
+    //    must be complete by then
+    if (dlc_update.valid()) {
+      dlc_update.wait();
+    }
   }
+  run_callbacks_cb = get_steam_api_run_callbacks_cb();
+  // Initialization is complete, nothing allocated from the startup arena is
+  //    used past this point
+  memory::release_startup_arena();
+  g_settings.watch();
+  startup_total_ms.add(ms_since(start));
   return true;
-version_fail:
-  display_error(L"Couldn't load steam_api64.dll file version, no changes will "
-                L"be applied");
-  return false;
+}
+
+//===-- SteamGameServer_Init wrapping -------------------------------------===//
+
+/// `SteamGameServer_Init` and `SteamInternal_GameServer_Init` function type.
+using SteamGameServer_Init_t = bool(std::uint32_t ip, std::uint16_t steam_port,
+                                    std::uint16_t game_port,
+                                    std::uint16_t query_port, int server_mode,
+                                    const char *_Nonnull version);
+/// `SteamGameServer_RunCallbacks` function type.
+using SteamGameServer_RunCallbacks_t = void();
+
+/// Pointer to the original `SteamGameServer_RunCallbacks` function.
+static SteamGameServer_RunCallbacks_t
+    *_Nullable SteamGameServer_RunCallbacks_orig;
+
+/// Setup game server interface wrappers after successful game server
+///    initialization. Game servers use their own ISteamUGC instance, which
+///    is described by @ref ISteamUGC_desc in that case.
+static void game_server_init() {
+  if (!load_version()) {
+    return;
+  }
+  const auto module{GetModuleHandleW(L"steam_api64.dll")};
+  cpp_interface *ISteamUGC_ptr;
+  if (ver >= 0x0003002A003D0042) { // 03.42.61.66
+    // Steamworks SDK v1.37+ obtain game server interfaces from ISteamClient
+    //    using game server's pipe and user handles
+    using SteamInternal_CreateInterface_t = cpp_interface *(const char *);
+    using SteamGameServer_GetHSteam_t = std::int32_t();
+    using ISteamClient_GetISteamGenericInterface_t = cpp_interface *(
+        cpp_interface *, std::int32_t, std::int32_t, const char *);
+    const auto ISteamClient_ptr{
+        reinterpret_cast<SteamInternal_CreateInterface_t *>(GetProcAddress(
+            module, "SteamInternal_CreateInterface"))(client_interface_ver())};
+    const auto pipe{reinterpret_cast<SteamGameServer_GetHSteam_t *>(
+        GetProcAddress(module, "SteamGameServer_GetHSteamPipe"))()};
+    const auto user{reinterpret_cast<SteamGameServer_GetHSteam_t *>(
+        GetProcAddress(module, "SteamGameServer_GetHSteamUser"))()};
+    ISteamUGC_ptr =
+        reinterpret_cast<ISteamClient_GetISteamGenericInterface_t *>(
+            ISteamClient_ptr->vtable[12])(ISteamClient_ptr, user, pipe,
+                                          ugc_interface_ver());
+  } else if (ver >= 0x00010062001F0049) { // 01.98.31.73
+    // ISteamUGC appeared only in Steamworks SDK v1.26
+    using getter_t = cpp_interface *();
+    ISteamUGC_ptr = reinterpret_cast<getter_t *>(
+        GetProcAddress(module, "SteamGameServerUGC"))();
+  } else {
+    ISteamUGC_ptr = nullptr;
+  }
+  if (!ISteamUGC_ptr || ISteamUGC_desc.iface) {
+    // Either there is nothing to wrap, or the process has already wrapped
+    //    the client instance via SteamAPI_Init
+    return;
+  }
+  wrap_ugc(ISteamUGC_ptr);
+  if (g_settings.steam->shared_cache) {
+    shared_cache::open(g_settings.steam->app_id);
+  }
+  // Perform game-specific setup
+  const auto cb{get_steam_game_server_init_cb()};
+  if (cb) {
+    cb();
+  }
+  memory::release_startup_arena();
+  g_settings.watch();
+}
+
+/// Wrapper for `SteamGameServer_Init`, exported by Steamworks SDK versions
+///    before v1.37.
+static bool SteamGameServer_Init(std::uint32_t ip, std::uint16_t steam_port,
+                                 std::uint16_t game_port,
+                                 std::uint16_t query_port, int server_mode,
+                                 const char *_Nonnull version) {
+  if (!reinterpret_cast<SteamGameServer_Init_t *>(
+          GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                         "SteamGameServer_Init"))(
+          ip, steam_port, game_port, query_port, server_mode, version)) {
+    return false;
+  }
+  game_server_init();
+  return true;
+}
+
+/// Wrapper for `SteamInternal_GameServer_Init`, which inline
+///    `SteamGameServer_Init` of Steamworks SDK v1.37+ calls.
+static bool SteamInternal_GameServer_Init(std::uint32_t ip,
+                                          std::uint16_t steam_port,
+                                          std::uint16_t game_port,
+                                          std::uint16_t query_port,
+                                          int server_mode,
+                                          const char *_Nonnull version) {
+  if (!reinterpret_cast<SteamGameServer_Init_t *>(
+          GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                         "SteamInternal_GameServer_Init"))(
+          ip, steam_port, game_port, query_port, server_mode, version)) {
+    return false;
+  }
+  game_server_init();
+  return true;
+}
+
+/// Wrapper for `SteamGameServer_RunCallbacks`, that delivers synthetic
+///    callbacks to game server's receivers.
+static void SteamGameServer_RunCallbacks() {
+  if (!SteamGameServer_RunCallbacks_orig) {
+    SteamGameServer_RunCallbacks_orig =
+        reinterpret_cast<SteamGameServer_RunCallbacks_t *>(
+            GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                           "SteamGameServer_RunCallbacks"));
+  }
+  SteamGameServer_RunCallbacks_orig();
+  dispatch_callbacks();
 }
 
 } // namespace
 
+void update_dlc_index() {
+  const std::scoped_lock lock{dlc_index_mtx};
+  const dlc_index *index;
+  {
+    const std::shared_lock dlc_lock{g_settings.steam->dlc_mtx};
+    index = new dlc_index{
+        .owned = id_set{g_settings.steam->dlc | std::views::keys},
+        .installed = id_set{g_settings.steam->installed_dlc}};
+  }
+  current_dlc_index.store(index, std::memory_order::release);
+  if (dlc_wrappers_installed) {
+    select_dlc_wrappers(*index);
+  }
+}
+
+void register_callback(CCallbackBase &receiver, int callback) {
+  using SteamAPI_RegisterCallback_t = void(CCallbackBase *, int);
+  reinterpret_cast<SteamAPI_RegisterCallback_t *>(
+      GetProcAddress(GetModuleHandleW(L"steam_api64.dll"),
+                     "SteamAPI_RegisterCallback"))(&receiver, callback);
+}
+
+void post_callback(int callback, std::span<const std::byte> data) {
+  if (!dispatch_hooked) {
+    // Nothing would ever deliver it
+    return;
+  }
+  push_callback(new queued_callback{.next = nullptr,
+                                    .callback = callback,
+                                    .data = {data.begin(), data.end()}});
+}
+
 void wrap_init() {
-  const auto module{reinterpret_cast<char *>(GetModuleHandleW(nullptr))};
-  SteamAPI_Init_t **thunk_ptr{};
-  // First, try to locate regular import descriptor for steam_api64.dll
-  ULONG dir_size;
-  const auto import_desc_base{reinterpret_cast<const IMAGE_IMPORT_DESCRIPTOR *>(
-      ImageDirectoryEntryToDataEx(module, TRUE, IMAGE_DIRECTORY_ENTRY_IMPORT,
-                                  &dir_size, nullptr))};
-  if (import_desc_base) {
-    const std::span import_descs{import_desc_base,
-                                 (dir_size / sizeof *import_desc_base) - 1};
-    const auto import_desc{std::ranges::find(
-        import_descs, "steam_api64.dll", [module](const auto &desc) {
-          return std::string_view{&module[desc.Name]};
-        })};
-    if (import_desc != import_descs.end()) {
-      for (auto ilt_desc_base{reinterpret_cast<const IMAGE_THUNK_DATA *>(
-               &module[import_desc->OriginalFirstThunk])},
-           ilt_desc{ilt_desc_base};
-           ilt_desc->u1.AddressOfData; ++ilt_desc) {
-        if (!(ilt_desc->u1.AddressOfData & IMAGE_ORDINAL_FLAG) &&
-            std::string_view{reinterpret_cast<const IMAGE_IMPORT_BY_NAME *>(
-                                 &module[ilt_desc->u1.AddressOfData])
-                                 ->Name} == "SteamAPI_Init") {
-          thunk_ptr = reinterpret_cast<SteamAPI_Init_t **>(&(
-              reinterpret_cast<IMAGE_THUNK_DATA *>(
-                  &module[import_desc->FirstThunk])[std::distance(ilt_desc_base,
-                                                                  ilt_desc)]
-                  .u1.Function));
-          break;
-        }
-      }
-    } // if (import_desc != import_descs.end())
-  } // if (import_desc_base)
-  if (!thunk_ptr) {
-    // Try to locate delay load descriptor for steam_api64.dll
-    const auto delay_load_desc_base{
-        reinterpret_cast<const IMAGE_DELAYLOAD_DESCRIPTOR *>(
-            ImageDirectoryEntryToDataEx(const_cast<char *>(module), TRUE,
-                                        IMAGE_DIRECTORY_ENTRY_DELAY_IMPORT,
-                                        &dir_size, nullptr))};
-    if (delay_load_desc_base) {
-      const std::span delay_load_descs{
-          delay_load_desc_base, (dir_size / sizeof *delay_load_desc_base) - 1};
-      const auto delay_desc{std::ranges::find(
-          delay_load_descs, "steam_api64.dll", [module](const auto &desc) {
-            return std::string_view{&module[desc.DllNameRVA]};
-          })};
-      if (delay_desc != delay_load_descs.end()) {
-        for (auto int_desc_base{reinterpret_cast<const IMAGE_THUNK_DATA *>(
-                 &module[delay_desc->ImportNameTableRVA])},
-             int_desc{int_desc_base};
-             int_desc->u1.AddressOfData; ++int_desc) {
-          if (std::string_view{reinterpret_cast<const IMAGE_IMPORT_BY_NAME *>(
-                                   &module[int_desc->u1.AddressOfData])
-                                   ->Name} == "SteamAPI_Init") {
-            thunk_ptr = reinterpret_cast<SteamAPI_Init_t **>(
-                &(reinterpret_cast<IMAGE_THUNK_DATA *>(
-                      &module[delay_desc->ImportAddressTableRVA])
-                      [std::distance(int_desc_base, int_desc)]
-                          .u1.Function));
-            break;
-          }
-        }
-      } // if (delay_desc != delay_load_descs.end())
-    } // if (delay_load_desc_base)
-  } // if (!thunk_ptr)
-  if (thunk_ptr) {
-    *thunk_ptr = SteamAPI_Init;
+  const auto init_thunk{find_import_thunk("SteamAPI_Init")};
+  if (init_thunk) {
+    *init_thunk = reinterpret_cast<void *>(SteamAPI_Init);
+  }
+  const auto run_callbacks_thunk{find_import_thunk("SteamAPI_RunCallbacks")};
+  if (run_callbacks_thunk) {
+    *run_callbacks_thunk = reinterpret_cast<void *>(SteamAPI_RunCallbacks);
+  }
+  // Synthetic callbacks need receivers registered by the game, and either
+  //    regular or manual dispatch to deliver them
+  const auto register_thunk{find_import_thunk("SteamAPI_RegisterCallback")};
+  const auto unregister_thunk{
+      find_import_thunk("SteamAPI_UnregisterCallback")};
+  const auto gs_run_callbacks_thunk{
+      find_import_thunk("SteamGameServer_RunCallbacks")};
+  if (register_thunk && unregister_thunk) {
+    *register_thunk = reinterpret_cast<void *>(SteamAPI_RegisterCallback);
+    *unregister_thunk = reinterpret_cast<void *>(SteamAPI_UnregisterCallback);
+    if (gs_run_callbacks_thunk) {
+      *gs_run_callbacks_thunk =
+          reinterpret_cast<void *>(SteamGameServer_RunCallbacks);
+    }
+    dispatch_hooked = run_callbacks_thunk || gs_run_callbacks_thunk;
+  }
+  // Synthetic call results for cached HTTP responses are delivered by
+  //    SteamAPI_RunCallbacks to receivers registered via call result
+  //    registration functions
+  if (!g_settings.steam->http_cache_path.empty() && run_callbacks_thunk) {
+    const auto register_call_result_thunk{
+        find_import_thunk("SteamAPI_RegisterCallResult")};
+    const auto unregister_call_result_thunk{
+        find_import_thunk("SteamAPI_UnregisterCallResult")};
+    if (register_call_result_thunk && unregister_call_result_thunk) {
+      *register_call_result_thunk =
+          reinterpret_cast<void *>(SteamAPI_RegisterCallResult);
+      *unregister_call_result_thunk =
+          reinterpret_cast<void *>(SteamAPI_UnregisterCallResult);
+      call_results_hooked = true;
+    } else {
+      log::warning("Call result registration functions are not imported by "
+                   "the game, HTTP responses won't be cached");
+    }
+  }
+  if (!dispatch_hooked) {
+    log::info("Callback dispatch functions are not imported by the game, "
+              "runtime callbacks won't be delivered");
+  }
+  const auto get_next_thunk{
+      find_import_thunk("SteamAPI_ManualDispatch_GetNextCallback")};
+  const auto free_last_thunk{
+      find_import_thunk("SteamAPI_ManualDispatch_FreeLastCallback")};
+  if (get_next_thunk && free_last_thunk) {
+    *get_next_thunk =
+        reinterpret_cast<void *>(SteamAPI_ManualDispatch_GetNextCallback);
+    *free_last_thunk =
+        reinterpret_cast<void *>(SteamAPI_ManualDispatch_FreeLastCallback);
+    dispatch_hooked = true;
+  }
+  // Dedicated servers initialize game server API instead of the client one
+  const auto gs_init_thunk{find_import_thunk("SteamGameServer_Init")};
+  if (gs_init_thunk) {
+    *gs_init_thunk = reinterpret_cast<void *>(SteamGameServer_Init);
+  }
+  const auto gs_internal_init_thunk{
+      find_import_thunk("SteamInternal_GameServer_Init")};
+  if (gs_internal_init_thunk) {
+    *gs_internal_init_thunk =
+        reinterpret_cast<void *>(SteamInternal_GameServer_Init);
+  }
+  if (!init_thunk && !gs_init_thunk && !gs_internal_init_thunk) {
+    log::warning("Steam API initialization functions are not imported by the "
+                 "game, interface wrappers won't be set up");
+  }
+  if (g_settings.steam->cache_remote_storage ||
+      g_settings.steam->cache_user_stats) {
+    const auto shutdown_thunk{find_import_thunk("SteamAPI_Shutdown")};
+    if (shutdown_thunk) {
+      *shutdown_thunk = reinterpret_cast<void *>(SteamAPI_Shutdown);
+    }
   }
 }
 
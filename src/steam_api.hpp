@@ -19,6 +19,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <tek-steamclient/cm.h>
 
 namespace tek::game_runtime::steam_api {
@@ -88,6 +89,36 @@ enum ISteamApps_m {
   ISteamApps_num_methods
 };
 
+/// Virtual method enumeration for ISteamHTTP interface.
+enum ISteamHTTP_m {
+  ISteamHTTP_m_CreateHTTPRequest,
+  ISteamHTTP_m_SetHTTPRequestContextValue,
+  ISteamHTTP_m_SetHTTPRequestNetworkActivityTimeout,
+  ISteamHTTP_m_SetHTTPRequestHeaderValue,
+  ISteamHTTP_m_SetHTTPRequestGetOrPostParameter,
+  ISteamHTTP_m_SendHTTPRequest,
+  ISteamHTTP_m_SendHTTPRequestAndStreamResponse,
+  ISteamHTTP_m_DeferHTTPRequest,
+  ISteamHTTP_m_PrioritizeHTTPRequest,
+  ISteamHTTP_m_GetHTTPResponseHeaderSize,
+  ISteamHTTP_m_GetHTTPResponseHeaderValue,
+  ISteamHTTP_m_GetHTTPResponseBodySize,
+  ISteamHTTP_m_GetHTTPResponseBodyData,
+  ISteamHTTP_m_GetHTTPStreamingResponseBodyData,
+  ISteamHTTP_m_ReleaseHTTPRequest,
+  ISteamHTTP_m_GetHTTPDownloadProgressPct,
+  ISteamHTTP_m_SetHTTPRequestRawPostBody,
+  ISteamHTTP_m_CreateCookieContainer,
+  ISteamHTTP_m_ReleaseCookieContainer,
+  ISteamHTTP_m_SetCookie,
+  ISteamHTTP_m_SetHTTPRequestCookieContainer,
+  ISteamHTTP_m_SetHTTPRequestUserAgentInfo,
+  ISteamHTTP_m_SetHTTPRequestRequiresVerifiedCertificate,
+  ISteamHTTP_m_SetHTTPRequestAbsoluteTimeoutMS,
+  ISteamHTTP_m_GetHTTPRequestWasTimedOut,
+  ISteamHTTP_num_methods
+};
+
 /// Virtual method enumeration for ISteamMatchmaking interface.
 enum ISteamMatchmaking_m {
   ISteamMatchmaking_m_GetFavoriteGameCount,
@@ -153,6 +184,70 @@ enum ISteamMatchmakingServers_m {
   ISteamMatchmakingServers_num_methods
 };
 
+/// Virtual method enumeration for ISteamRemoteStorage interface.
+enum ISteamRemoteStorage_m {
+  ISteamRemoteStorage_m_FileWrite,
+  ISteamRemoteStorage_m_FileRead,
+  ISteamRemoteStorage_m_FileWriteAsync,
+  ISteamRemoteStorage_m_FileReadAsync,
+  ISteamRemoteStorage_m_FileReadAsyncComplete,
+  ISteamRemoteStorage_m_FileForget,
+  ISteamRemoteStorage_m_FileDelete,
+  ISteamRemoteStorage_m_FileShare,
+  ISteamRemoteStorage_m_SetSyncPlatforms,
+  ISteamRemoteStorage_m_FileWriteStreamOpen,
+  ISteamRemoteStorage_m_FileWriteStreamWriteChunk,
+  ISteamRemoteStorage_m_FileWriteStreamClose,
+  ISteamRemoteStorage_m_FileWriteStreamCancel,
+  ISteamRemoteStorage_m_FileExists,
+  ISteamRemoteStorage_m_FilePersisted,
+  ISteamRemoteStorage_m_GetFileSize,
+  ISteamRemoteStorage_m_GetFileTimestamp,
+  ISteamRemoteStorage_m_GetSyncPlatforms,
+  ISteamRemoteStorage_m_GetFileCount,
+  ISteamRemoteStorage_m_GetFileNameAndSize,
+  ISteamRemoteStorage_m_GetQuota,
+  ISteamRemoteStorage_m_IsCloudEnabledForAccount,
+  ISteamRemoteStorage_m_IsCloudEnabledForApp,
+  ISteamRemoteStorage_m_SetCloudEnabledForApp,
+  ISteamRemoteStorage_m_UGCDownload,
+  ISteamRemoteStorage_m_GetUGCDownloadProgress,
+  ISteamRemoteStorage_m_GetUGCDetails,
+  ISteamRemoteStorage_m_UGCRead,
+  ISteamRemoteStorage_m_GetCachedUGCCount,
+  ISteamRemoteStorage_m_GetCachedUGCHandle,
+  ISteamRemoteStorage_m_PublishWorkshopFile,
+  ISteamRemoteStorage_m_CreatePublishedFileUpdateRequest,
+  ISteamRemoteStorage_m_UpdatePublishedFileFile,
+  ISteamRemoteStorage_m_UpdatePublishedFilePreviewFile,
+  ISteamRemoteStorage_m_UpdatePublishedFileTitle,
+  ISteamRemoteStorage_m_UpdatePublishedFileDescription,
+  ISteamRemoteStorage_m_UpdatePublishedFileVisibility,
+  ISteamRemoteStorage_m_UpdatePublishedFileTags,
+  ISteamRemoteStorage_m_CommitPublishedFileUpdate,
+  ISteamRemoteStorage_m_GetPublishedFileDetails,
+  ISteamRemoteStorage_m_DeletePublishedFile,
+  ISteamRemoteStorage_m_EnumerateUserPublishedFiles,
+  ISteamRemoteStorage_m_SubscribePublishedFile,
+  ISteamRemoteStorage_m_EnumerateUserSubscribedFiles,
+  ISteamRemoteStorage_m_UnsubscribePublishedFile,
+  ISteamRemoteStorage_m_UpdatePublishedFileSetChangeDescription,
+  ISteamRemoteStorage_m_GetPublishedItemVoteDetails,
+  ISteamRemoteStorage_m_UpdateUserPublishedItemVote,
+  ISteamRemoteStorage_m_GetUserPublishedItemVoteDetails,
+  ISteamRemoteStorage_m_EnumerateUserSharedWorkshopFiles,
+  ISteamRemoteStorage_m_PublishVideo,
+  ISteamRemoteStorage_m_SetUserPublishedFileAction,
+  ISteamRemoteStorage_m_EnumeratePublishedFilesByUserAction,
+  ISteamRemoteStorage_m_EnumeratePublishedWorkshopFiles,
+  ISteamRemoteStorage_m_UGCDownloadToLocation,
+  ISteamRemoteStorage_m_GetLocalFileChangeCount,
+  ISteamRemoteStorage_m_GetLocalFileChange,
+  ISteamRemoteStorage_m_BeginFileWriteBatch,
+  ISteamRemoteStorage_m_EndFileWriteBatch,
+  ISteamRemoteStorage_num_methods
+};
+
 /// Virtual method enumeration for ISteamUGC interface.
 enum ISteamUGC_m {
   ISteamUGC_m_CreateQueryUserUGCRequest,
@@ -293,6 +388,57 @@ enum ISteamUser_m {
   ISteamUser_num_methods
 };
 
+/// Virtual method enumeration for ISteamUserStats interface. Overloaded
+///    methods are listed in MSVC vtable order, with parameter type suffixes.
+enum ISteamUserStats_m {
+  ISteamUserStats_m_RequestCurrentStats,
+  ISteamUserStats_m_GetStatFloat,
+  ISteamUserStats_m_GetStatInt32,
+  ISteamUserStats_m_SetStatFloat,
+  ISteamUserStats_m_SetStatInt32,
+  ISteamUserStats_m_UpdateAvgRateStat,
+  ISteamUserStats_m_GetAchievement,
+  ISteamUserStats_m_SetAchievement,
+  ISteamUserStats_m_ClearAchievement,
+  ISteamUserStats_m_GetAchievementAndUnlockTime,
+  ISteamUserStats_m_StoreStats,
+  ISteamUserStats_m_GetAchievementIcon,
+  ISteamUserStats_m_GetAchievementDisplayAttribute,
+  ISteamUserStats_m_IndicateAchievementProgress,
+  ISteamUserStats_m_GetNumAchievements,
+  ISteamUserStats_m_GetAchievementName,
+  ISteamUserStats_m_RequestUserStats,
+  ISteamUserStats_m_GetUserStatFloat,
+  ISteamUserStats_m_GetUserStatInt32,
+  ISteamUserStats_m_GetUserAchievement,
+  ISteamUserStats_m_GetUserAchievementAndUnlockTime,
+  ISteamUserStats_m_ResetAllStats,
+  ISteamUserStats_m_FindOrCreateLeaderboard,
+  ISteamUserStats_m_FindLeaderboard,
+  ISteamUserStats_m_GetLeaderboardName,
+  ISteamUserStats_m_GetLeaderboardEntryCount,
+  ISteamUserStats_m_GetLeaderboardSortMethod,
+  ISteamUserStats_m_GetLeaderboardDisplayType,
+  ISteamUserStats_m_DownloadLeaderboardEntries,
+  ISteamUserStats_m_DownloadLeaderboardEntriesForUsers,
+  ISteamUserStats_m_GetDownloadedLeaderboardEntry,
+  ISteamUserStats_m_UploadLeaderboardScore,
+  ISteamUserStats_m_AttachLeaderboardUGC,
+  ISteamUserStats_m_GetNumberOfCurrentPlayers,
+  ISteamUserStats_m_RequestGlobalAchievementPercentages,
+  ISteamUserStats_m_GetMostAchievedAchievementInfo,
+  ISteamUserStats_m_GetNextMostAchievedAchievementInfo,
+  ISteamUserStats_m_GetAchievementAchievedPercent,
+  ISteamUserStats_m_RequestGlobalStats,
+  ISteamUserStats_m_GetGlobalStatDouble,
+  ISteamUserStats_m_GetGlobalStatInt64,
+  ISteamUserStats_m_GetGlobalStatHistoryDouble,
+  ISteamUserStats_m_GetGlobalStatHistoryInt64,
+  ISteamUserStats_m_GetAchievementProgressLimitsFloat,
+  ISteamUserStats_m_GetAchievementProgressLimitsInt32,
+  ISteamUserStats_num_methods
+};
+
 /// Virtual method enumeration for ISteamUtils interface.
 enum ISteamUtils_m {
   ISteamUtils_m_GetSecondsSinceAppActive,
@@ -348,11 +494,96 @@ struct matchmaking_kv_pair {
   std::array<char, 256> value;
 };
 
+/// Steam game server network address.
+struct servernetadr_t {
+  /// Game connection port, in host byte order.
+  std::uint16_t connection_port;
+  /// Query port, in host byte order.
+  std::uint16_t query_port;
+  /// IPv4 address, in host byte order.
+  std::uint32_t ip;
+};
+
+/// Steam game server details as returned by ISteamMatchmakingServers.
+struct gameserveritem_t {
+  servernetadr_t net_adr;
+  int ping;
+  bool had_successful_response;
+  bool do_not_refresh;
+  std::array<char, 32> game_dir;
+  std::array<char, 32> map;
+  std::array<char, 64> game_description;
+  std::uint32_t app_id;
+  int players;
+  int max_players;
+  int bot_players;
+  bool password;
+  bool secure;
+  std::uint32_t time_last_played;
+  int server_version;
+  std::array<char, 64> server_name;
+  std::array<char, 128> game_tags;
+  std::uint64_t steam_id;
+};
+
 struct remote_storage_sub_result {
   tek_sc_cm_eresult result;
   std::uint64_t id;
 };
 
+/// ItemInstalled_t callback data, layout of Steamworks SDK v1.59+ which is
+///    compatible with earlier versions.
+struct item_installed {
+  /// Steam callback ID.
+  static constexpr int callback{3405};
+  std::uint32_t app_id;
+  std::uint64_t id;
+  std::uint64_t legacy_content;
+  std::uint64_t manifest_id;
+};
+
+/// DownloadItemResult_t callback data.
+struct download_item_result {
+  /// Steam callback ID.
+  static constexpr int callback{3406};
+  std::uint32_t app_id;
+  std::uint64_t id;
+  tek_sc_cm_eresult result;
+};
+
+/// DlcInstalled_t callback data.
+struct dlc_installed {
+  /// Steam callback ID.
+  static constexpr int callback{1005};
+  std::uint32_t app_id;
+};
+
+/// HTTPRequestCompleted_t callback data, layout of Steamworks SDK v1.37+.
+struct http_request_completed {
+  /// Steam callback ID.
+  static constexpr int callback{2101};
+  std::uint32_t request;
+  std::uint64_t context_value;
+  bool successful;
+  int status_code;
+  std::uint32_t body_size;
+};
+
+/// Steam API callback receiver, compatible with CCallbackBase.
+struct CCallbackBase {
+  // MSVC places overloaded virtual methods into vtable in reverse order of
+  //    declaration, so they're declared here in vtable order
+  virtual void Run(void *_Nonnull param, bool io_failure,
+                   std::uint64_t call) = 0;
+  virtual void Run(void *_Nonnull param) = 0;
+  virtual int GetCallbackSizeBytes() = 0;
+
+  /// Flags set by SteamAPI_RegisterCallback.
+  std::uint8_t callback_flags{};
+  /// ID of the callback that the receiver is registered for.
+  int callback{};
+};
+
 struct ISteamMatchmakingRulesResponse {
   virtual void RulesResponded(const char *_Nonnull key,
                               const char *_Nonnull value) = 0;
@@ -360,24 +591,177 @@ struct ISteamMatchmakingRulesResponse {
   virtual void RulesRefreshComplete() = 0;
 };
 
+struct ISteamMatchmakingServerListResponse {
+  virtual void ServerResponded(void *_Nonnull request, int server) = 0;
+  virtual void ServerFailedToRespond(void *_Nonnull request, int server) = 0;
+  virtual void RefreshComplete(void *_Nonnull request, int response) = 0;
+};
+
+struct ISteamMatchmakingPingResponse {
+  virtual void ServerResponded(gameserveritem_t &server) = 0;
+  virtual void ServerFailedToRespond() = 0;
+};
+
 using ISteamApps_BIsSubscribedApp_t = bool(void *_Nonnull iface,
                                            std::uint32_t app_id);
 using ISteamApps_BIsAppInstalled_t = bool(void *_Nonnull iface,
                                           std::uint32_t app_id);
 
+using ISteamHTTP_CreateHTTPRequest_t = std::uint32_t(void *_Nonnull iface,
+                                                     int method,
+                                                     const char *_Nonnull url);
+using ISteamHTTP_SetHTTPRequestContextValue_t = bool(void *_Nonnull iface,
+                                                     std::uint32_t request,
+                                                     std::uint64_t value);
+using ISteamHTTP_SetHTTPRequestParam_t = bool(void *_Nonnull iface,
+                                              std::uint32_t request,
+                                              const char *_Nonnull name,
+                                              const char *_Nonnull value);
+using ISteamHTTP_SendHTTPRequest_t = bool(void *_Nonnull iface,
+                                          std::uint32_t request,
+                                          std::uint64_t *_Nullable call);
+using ISteamHTTP_GetHTTPResponseHeaderSize_t =
+    bool(void *_Nonnull iface, std::uint32_t request,
+         const char *_Nonnull name, std::uint32_t *_Nonnull size);
+using ISteamHTTP_GetHTTPResponseHeaderValue_t =
+    bool(void *_Nonnull iface, std::uint32_t request,
+         const char *_Nonnull name, std::uint8_t *_Nonnull buf,
+         std::uint32_t size);
+using ISteamHTTP_GetHTTPResponseBodySize_t = bool(void *_Nonnull iface,
+                                                  std::uint32_t request,
+                                                  std::uint32_t *_Nonnull size);
+using ISteamHTTP_GetHTTPResponseBodyData_t = bool(void *_Nonnull iface,
+                                                  std::uint32_t request,
+                                                  std::uint8_t *_Nonnull buf,
+                                                  std::uint32_t size);
+using ISteamHTTP_GetHTTPDownloadProgressPct_t = bool(void *_Nonnull iface,
+                                                     std::uint32_t request,
+                                                     float *_Nonnull pct);
+using ISteamHTTP_ReleaseHTTPRequest_t = bool(void *_Nonnull iface,
+                                             std::uint32_t request);
+using ISteamHTTP_SetHTTPRequestRawPostBody_t =
+    bool(void *_Nonnull iface, std::uint32_t request,
+         const char *_Nonnull content_type, std::uint8_t *_Nonnull body,
+         std::uint32_t body_size);
+using ISteamHTTP_SetHTTPRequestCookieContainer_t =
+    bool(void *_Nonnull iface, std::uint32_t request, std::uint32_t container);
+
+using ISteamMatchmaking_GetFavoriteGameCount_t = int(void *_Nonnull iface);
+using ISteamMatchmaking_GetFavoriteGame_t =
+    bool(void *_Nonnull iface, int game, std::uint32_t *_Nonnull app_id,
+         std::uint32_t *_Nonnull ip, std::uint16_t *_Nonnull conn_port,
+         std::uint16_t *_Nonnull query_port, std::uint32_t *_Nonnull flags,
+         std::uint32_t *_Nonnull time_last_played);
+using ISteamMatchmaking_RequestLobbyList_t =
+    std::uint64_t(void *_Nonnull iface);
+using ISteamMatchmaking_LeaveLobby_t = void(void *_Nonnull iface,
+                                             std::uint64_t lobby);
+using ISteamMatchmaking_GetNumLobbyMembers_t = int(void *_Nonnull iface,
+                                                   std::uint64_t lobby);
+using ISteamMatchmaking_GetLobbyData_t =
+    const char *_Nonnull(void *_Nonnull iface, std::uint64_t lobby,
+                         const char *_Nonnull key);
+using ISteamMatchmaking_SetLobbyData_t = bool(void *_Nonnull iface,
+                                              std::uint64_t lobby,
+                                              const char *_Nonnull key,
+                                              const char *_Nonnull value);
+using ISteamMatchmaking_GetLobbyDataCount_t = int(void *_Nonnull iface,
+                                                  std::uint64_t lobby);
+using ISteamMatchmaking_GetLobbyDataByIndex_t =
+    bool(void *_Nonnull iface, std::uint64_t lobby, int idx,
+         char *_Nonnull key, int key_size, char *_Nonnull value,
+         int value_size);
+using ISteamMatchmaking_DeleteLobbyData_t = bool(void *_Nonnull iface,
+                                                 std::uint64_t lobby,
+                                                 const char *_Nonnull key);
+
 using ISteamMatchmakingServers_RequestInternetServerList_t =
     void *_Nonnull(void *_Nonnull iface, std::uint32_t app_id,
                    const matchmaking_kv_pair *const _Nonnull *_Nullable filters,
-                   std::uint32_t num_filters, void *_Nonnull response_handler);
+                   std::uint32_t num_filters,
+                   ISteamMatchmakingServerListResponse
+                       *_Nonnull response_handler);
+using ISteamMatchmakingServers_RequestFavoritesServerList_t =
+    ISteamMatchmakingServers_RequestInternetServerList_t;
+using ISteamMatchmakingServers_RequestHistoryServerList_t =
+    ISteamMatchmakingServers_RequestInternetServerList_t;
+using ISteamMatchmakingServers_ReleaseRequest_t = void(void *_Nonnull iface,
+                                                       void *_Nonnull request);
+using ISteamMatchmakingServers_GetServerDetails_t =
+    gameserveritem_t *_Nullable(void *_Nonnull iface, void *_Nonnull request,
+                                int server);
+using ISteamMatchmakingServers_PingServer_t =
+    int(void *_Nonnull iface, std::uint32_t ip, std::uint16_t port,
+        ISteamMatchmakingPingResponse *_Nonnull response_handler);
 using ISteamMatchmakingServers_ServerRules_t =
     int(void *_Nonnull iface, std::uint32_t ip, std::uint16_t port,
         ISteamMatchmakingRulesResponse *_Nonnull response_handler);
 using ISteamMatchmakingServers_CancelServerQuery_t = void(void *_Nonnull iface,
                                                           int query);
 
+using ISteamRemoteStorage_FileWrite_t = bool(void *_Nonnull iface,
+                                              const char *_Nonnull file,
+                                              const void *_Nonnull data,
+                                              std::int32_t size);
+using ISteamRemoteStorage_FileRead_t = std::int32_t(void *_Nonnull iface,
+                                                    const char *_Nonnull file,
+                                                    void *_Nonnull data,
+                                                    std::int32_t size);
+using ISteamRemoteStorage_FileWriteAsync_t =
+    std::uint64_t(void *_Nonnull iface, const char *_Nonnull file,
+                  const void *_Nonnull data, std::uint32_t size);
+using ISteamRemoteStorage_FileReadAsync_t =
+    std::uint64_t(void *_Nonnull iface, const char *_Nonnull file,
+                  std::uint32_t offset, std::uint32_t size);
+using ISteamRemoteStorage_FileForget_t = bool(void *_Nonnull iface,
+                                              const char *_Nonnull file);
+using ISteamRemoteStorage_FileDelete_t = bool(void *_Nonnull iface,
+                                              const char *_Nonnull file);
+using ISteamRemoteStorage_FileWriteStreamOpen_t =
+    std::uint64_t(void *_Nonnull iface, const char *_Nonnull file);
+using ISteamRemoteStorage_FileExists_t = bool(void *_Nonnull iface,
+                                              const char *_Nonnull file);
+using ISteamRemoteStorage_GetFileSize_t =
+    std::int32_t(void *_Nonnull iface, const char *_Nonnull file);
+using ISteamRemoteStorage_GetFileTimestamp_t =
+    std::int64_t(void *_Nonnull iface, const char *_Nonnull file);
+using ISteamRemoteStorage_GetFileCount_t = std::int32_t(void *_Nonnull iface);
+using ISteamRemoteStorage_BeginFileWriteBatch_t = bool(void *_Nonnull iface);
+using ISteamRemoteStorage_EndFileWriteBatch_t = bool(void *_Nonnull iface);
+
 using ISteamUser_GetSteamID_t =
     std::uint64_t *_Nonnull(void *_Nonnull iface, std::uint64_t *_Nonnull id);
 
+using ISteamUserStats_RequestCurrentStats_t = bool(void *_Nonnull iface);
+using ISteamUserStats_GetStatFloat_t = bool(void *_Nonnull iface,
+                                            const char *_Nonnull name,
+                                            float *_Nonnull data);
+using ISteamUserStats_GetStatInt32_t = bool(void *_Nonnull iface,
+                                            const char *_Nonnull name,
+                                            std::int32_t *_Nonnull data);
+using ISteamUserStats_SetStatFloat_t = bool(void *_Nonnull iface,
+                                            const char *_Nonnull name,
+                                            float data);
+using ISteamUserStats_SetStatInt32_t = bool(void *_Nonnull iface,
+                                            const char *_Nonnull name,
+                                            std::int32_t data);
+using ISteamUserStats_UpdateAvgRateStat_t =
+    bool(void *_Nonnull iface, const char *_Nonnull name,
+         float count_this_session, double session_length);
+using ISteamUserStats_GetAchievement_t = bool(void *_Nonnull iface,
+                                              const char *_Nonnull name,
+                                              bool *_Nonnull achieved);
+using ISteamUserStats_SetAchievement_t = bool(void *_Nonnull iface,
+                                              const char *_Nonnull name);
+using ISteamUserStats_ClearAchievement_t = bool(void *_Nonnull iface,
+                                                const char *_Nonnull name);
+using ISteamUserStats_GetAchievementAndUnlockTime_t =
+    bool(void *_Nonnull iface, const char *_Nonnull name,
+         bool *_Nonnull achieved, std::uint32_t *_Nonnull unlock_time);
+using ISteamUserStats_StoreStats_t = bool(void *_Nonnull iface);
+using ISteamUserStats_ResetAllStats_t = bool(void *_Nonnull iface,
+                                             bool achievements_too);
+
 using ISteamUtils_IsAPICallCompleted_t = bool(void *_Nonnull iface,
                                               std::uint64_t call,
                                               bool *_Nonnull failed);
@@ -400,22 +784,75 @@ inline std::uint64_t steam_id;
 
 /// Wrapper descriptor for ISteamApps interface.
 inline wrapper_desc<ISteamApps_num_methods> ISteamApps_desc;
+/// Wrapper descriptor for ISteamHTTP interface. It's only set up when HTTP
+///    response caching is enabled.
+inline wrapper_desc<ISteamHTTP_num_methods> ISteamHTTP_desc;
 /// Wrapper descriptor for ISteamMatchmaking interface.
 inline wrapper_desc<ISteamMatchmaking_num_methods> ISteamMatchmaking_desc;
 /// Wrapper descriptor for ISteamMatchmakingServers interface.
 inline wrapper_desc<ISteamMatchmakingServers_num_methods>
     ISteamMatchmakingServers_desc;
+/// Wrapper descriptor for ISteamRemoteStorage interface. It's only set up when
+///    remote storage caching is enabled.
+inline wrapper_desc<ISteamRemoteStorage_num_methods> ISteamRemoteStorage_desc;
 /// Wrapper descriptor for ISteamUGC interface.
 inline wrapper_desc<ISteamUGC_num_methods> ISteamUGC_desc;
 /// Wrapper descriptor for ISteamUser interface.
 inline wrapper_desc<ISteamUser_num_methods> ISteamUser_desc;
+/// Wrapper descriptor for ISteamUserStats interface. It's only set up when
+///    stats caching is enabled.
+inline wrapper_desc<ISteamUserStats_num_methods> ISteamUserStats_desc;
 /// Wrapper descriptor for ISteamUtils interface.
 inline wrapper_desc<ISteamUtils_num_methods> ISteamUtils_desc;
 
 //===-- Function ----------------------------------------------------------===//
 
-/// Install IAT hook for SteamAPI_Init to setup vtable wrappers.
+/// Install IAT hooks for SteamAPI_Init to setup vtable wrappers, for
+///    SteamAPI_RunCallbacks to run game-specific per-frame processing, and for
+///    callback registration and manual dispatch functions to deliver
+///    callbacks posted via @ref post_callback.
 [[gnu::visibility("internal")]]
 void wrap_init();
 
+/// Rebuild the index that ISteamApps DLC lookup wrappers read from DLC lists
+///    in settings, and switch the wrappers to variants specialized for its
+///    layout. Must be called after DLC lists are modified. May be called from
+///    any thread.
+[[gnu::visibility("internal")]]
+void update_dlc_index();
+
+/// Register a callback receiver via `SteamAPI_RegisterCallback`.
+///
+/// @param [in, out] receiver
+///    The callback receiver to register. It must stay alive until the process
+///    exits.
+/// @param callback
+///    ID of the callback to receive.
+[[gnu::visibility("internal")]]
+void register_callback(CCallbackBase &receiver, int callback);
+
+/// Queue a synthetic callback for delivery to the receivers that the game has
+///    registered for it. Delivery happens on the game's callback thread, in
+///    `SteamAPI_RunCallbacks` or via manual dispatch. May be called from any
+///    thread, doesn't block.
+///
+/// @param callback
+///    ID of the callback to deliver.
+/// @param data
+///    Callback data, copied into the queue.
+[[gnu::visibility("internal")]]
+void post_callback(int callback, std::span<const std::byte> data);
+
+/// Queue a synthetic callback for delivery to the receivers that the game has
+///    registered for it.
+///
+/// @tparam T
+///    Callback data type, which must have a `callback` static member holding
+///    the callback ID.
+/// @param [in] data
+///    Callback data, copied into the queue.
+template <typename T> void post_callback(const T &data) {
+  post_callback(T::callback, std::as_bytes(std::span{&data, 1}));
+}
+
 } // namespace tek::game_runtime::steam_api
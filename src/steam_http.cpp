@@ -0,0 +1,528 @@
+//===-- steam_http.cpp - ISteamHTTP response caching ----------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of ISteamHTTP method wrappers serving responses from the
+///    HTTP response cache.
+///
+//===----------------------------------------------------------------------===//
+#include "steam_http.hpp"
+
+#include "call_results.hpp"
+#include "common.hpp" // IWYU pragma: keep
+#include "http_cache.hpp"
+#include "memory.hpp"
+#include "metrics.hpp"
+#include "steam_api.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::steam_http {
+
+namespace {
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// `EHTTPMethod` value for GET requests.
+constexpr int http_method_get{1};
+
+//===-- Types -------------------------------------------------------------===//
+
+using steam_api::CCallbackBase;
+using steam_api::http_request_completed;
+
+/// State of an ISteamHTTP request created by the game.
+struct http_request {
+  /// Key identifying the request in the cache, built from its method, URL,
+  ///    headers and parameters. Empty if the request may not be cached.
+  std::string key;
+  /// Context value set by the game.
+  std::uint64_t context_value;
+  /// Response served to the game instead of sending the request, or `nullptr`
+  ///    if the request is handled by Steam.
+  std::shared_ptr<const http_cache::response> response;
+};
+
+/// Request waiting for the response to an identical request that is in
+///    flight.
+struct http_follower {
+  /// Handle of the request.
+  std::uint32_t request;
+  /// Handle of the synthetic API call returned to the game for the request.
+  std::uint64_t call;
+};
+
+class http_call_proxy;
+
+/// Request sent to Steam, that identical requests may wait for.
+struct http_leader {
+  /// Pointer to the interface instance that the request has been sent via.
+  void *_Nonnull iface;
+  /// Handle of the request.
+  std::uint32_t request;
+  /// Key of the request. Empty if the game has released the request before
+  ///    it completed.
+  std::string key;
+  /// Proxy standing in for the call result receiver that the game has
+  ///    registered for the request, or `nullptr` if it hasn't registered one
+  ///    yet, in which case the response can't be observed.
+  http_call_proxy *_Nullable proxy;
+  /// Requests waiting for the response.
+  std::vector<http_follower> followers;
+};
+
+} // namespace
+
+//===-- Private variables -------------------------------------------------===//
+
+/// The original ISteamHTTP methods.
+static backend orig;
+/// States of requests created by the game, keyed by request handle.
+static std::unordered_map<std::uint32_t, http_request> http_requests;
+/// Requests sent to Steam that may be cached, keyed by API call handle.
+static std::unordered_map<std::uint64_t, http_leader> http_leaders;
+/// Mutex for locking concurrent access to @ref http_requests and
+///    @ref http_leaders.
+static std::mutex http_mtx;
+/// Number of requests answered from the cache.
+static metrics::counter http_cache_hits{"steam_api.http_cache.hits"};
+/// Number of cacheable requests sent to Steam.
+static metrics::counter http_cache_misses{"steam_api.http_cache.misses"};
+/// Number of requests answered with the response to an identical request that
+///    was in flight.
+static metrics::counter http_cache_dedups{"steam_api.http_cache.dedups"};
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Complete the synthetic API call of a request with a HTTPRequestCompleted_t
+///    call result.
+///
+/// @param request
+///    Handle of the request.
+/// @param call
+///    Handle of the synthetic API call returned to the game for the request.
+/// @param context_value
+///    Context value of the request.
+/// @param resp
+///    Response to report, or `nullptr` to report a failure.
+static void
+complete_request(std::uint32_t request, std::uint64_t call,
+                 std::uint64_t context_value,
+                 const http_cache::response *_Nullable resp) {
+  const http_request_completed data{
+      .request = request,
+      .context_value = context_value,
+      .successful = resp != nullptr,
+      .status_code = resp ? resp->status_code : 0,
+      .body_size = resp ? static_cast<std::uint32_t>(resp->body.size()) : 0};
+  call_results::complete(call, http_request_completed::callback,
+                         std::as_bytes(std::span{&data, 1}));
+}
+
+/// Serve a response to requests waiting for it.
+///
+/// @param followers
+///    The requests to serve.
+/// @param resp
+///    The response, or `nullptr` if the request they waited for has failed.
+static void serve_followers(std::span<const http_follower> followers,
+                            std::shared_ptr<const http_cache::response> resp) {
+  for (const auto &follower : followers) {
+    std::uint64_t context_value{};
+    {
+      const std::scoped_lock lock{http_mtx};
+      const auto it{http_requests.find(follower.request)};
+      if (it == http_requests.end()) {
+        // The game has released the request already
+        continue;
+      }
+      it->second.response = resp;
+      context_value = it->second.context_value;
+    }
+    complete_request(follower.request, follower.call, context_value,
+                     resp.get());
+    http_cache_dedups.add();
+  }
+}
+
+namespace {
+
+/// Call result receiver that stands in for the game's one for requests in
+///    @ref http_leaders, capturing the response before forwarding the result.
+class http_call_proxy final : public CCallbackBase {
+public:
+  /// The game's receiver, or `nullptr` if the game has cancelled the call.
+  CCallbackBase *_Nullable receiver;
+
+  constexpr http_call_proxy(void *_Nonnull iface,
+                            CCallbackBase *_Nonnull receiver) noexcept
+      : receiver{receiver}, iface{iface} {
+    callback = http_request_completed::callback;
+  }
+
+  void Run(void *_Nonnull param) override { Run(param, false, 0); }
+  void Run(void *_Nonnull param, bool io_failure,
+           std::uint64_t call) override {
+    const auto &data{*static_cast<const http_request_completed *>(param)};
+    std::vector<http_follower> followers;
+    std::string key;
+    {
+      const std::scoped_lock lock{http_mtx};
+      if (const auto it{http_leaders.find(call)}; it != http_leaders.end()) {
+        followers = std::move(it->second.followers);
+        key = std::move(it->second.key);
+        http_leaders.erase(it);
+      }
+    }
+    if (!key.empty()) {
+      std::shared_ptr<http_cache::response> resp;
+      if (!io_failure && data.successful) {
+        resp = capture(data);
+      }
+      if (resp && resp->status_code == 200 &&
+          resp->body.size() <= http_cache::max_body_size) {
+        const auto cache_control{
+            http_cache::find_header(*resp, "Cache-Control")};
+        const auto lifetime{cache_control
+                                ? http_cache::freshness_lifetime(*cache_control)
+                                : std::chrono::seconds{}};
+        if (lifetime.count() > 0) {
+          resp->expires = std::chrono::system_clock::now() + lifetime;
+          http_cache::put(std::move(key), resp);
+        }
+      }
+      serve_followers(followers, std::move(resp));
+    }
+    if (receiver) {
+      receiver->Run(param, io_failure, call);
+    }
+    delete this;
+  }
+  int GetCallbackSizeBytes() override {
+    return sizeof(http_request_completed);
+  }
+
+private:
+  /// Pointer to the interface instance that the request has been sent via.
+  void *_Nonnull iface;
+
+  /// Read the response to a completed request.
+  ///
+  /// @param data
+  ///    Completion data of the request.
+  /// @return Pointer to the response, or `nullptr` if it couldn't be read.
+  std::shared_ptr<http_cache::response>
+  capture(const http_request_completed &data) const {
+    auto resp{std::allocate_shared<http_cache::response>(
+        std::pmr::polymorphic_allocator<>{
+            &memory::resource(memory::subsystem::http_cache)})};
+    resp->status_code = data.status_code;
+    std::uint32_t size;
+    if (!orig.GetHTTPResponseBodySize(iface, data.request, &size)) {
+      return nullptr;
+    }
+    resp->body.resize(size);
+    if (size && !orig.GetHTTPResponseBodyData(iface, data.request,
+                                              resp->body.data(), size)) {
+      return nullptr;
+    }
+    for (const auto name : http_cache::stored_headers) {
+      if (!orig.GetHTTPResponseHeaderSize(iface, data.request, name, &size)) {
+        continue;
+      }
+      auto &[header_name, value]{resp->headers.emplace_back()};
+      header_name = name;
+      value.resize(size);
+      if (size && !orig.GetHTTPResponseHeaderValue(
+                      iface, data.request, name,
+                      reinterpret_cast<std::uint8_t *>(value.data()), size)) {
+        resp->headers.pop_back();
+        continue;
+      }
+      // Values may be reported with the null terminator
+      if (!value.empty() && value.back() == '\0') {
+        value.pop_back();
+      }
+    }
+    return resp;
+  }
+};
+
+} // namespace
+
+/// Get the response served to the game for a request.
+///
+/// @param request
+///    Handle of the request.
+/// @return Pointer to the response, or `nullptr` if the request is handled by
+///    Steam.
+static std::shared_ptr<const http_cache::response>
+served_response(std::uint32_t request) {
+  const std::scoped_lock lock{http_mtx};
+  const auto it{http_requests.find(request)};
+  return it == http_requests.end() ? nullptr : it->second.response;
+}
+
+/// Append a request property to its cache key.
+///
+/// @param request
+///    Handle of the request.
+/// @param prop
+///    The property, as it should be appended to the key.
+static void append_to_key(std::uint32_t request, std::string_view prop) {
+  const std::scoped_lock lock{http_mtx};
+  if (const auto it{http_requests.find(request)};
+      it != http_requests.end() && !it->second.key.empty()) {
+    it->second.key.append(prop);
+  }
+}
+
+/// Mark a request as not cacheable.
+///
+/// @param request
+///    Handle of the request.
+static void clear_key(std::uint32_t request) {
+  const std::scoped_lock lock{http_mtx};
+  if (const auto it{http_requests.find(request)}; it != http_requests.end()) {
+    it->second.key.clear();
+  }
+}
+
+//===-- Internal functions ------------------------------------------------===//
+
+void init(const backend &methods) { orig = methods; }
+
+CCallbackBase *attach_receiver(std::uint64_t call, CCallbackBase *receiver) {
+  const std::scoped_lock lock{http_mtx};
+  const auto it{http_leaders.find(call)};
+  if (it == http_leaders.end() || it->second.proxy) {
+    return receiver;
+  }
+  it->second.proxy = new http_call_proxy{it->second.iface, receiver};
+  return it->second.proxy;
+}
+
+bool detach_receiver(std::uint64_t call) {
+  const std::scoped_lock lock{http_mtx};
+  const auto it{http_leaders.find(call)};
+  if (it == http_leaders.end() || !it->second.proxy) {
+    return false;
+  }
+  it->second.proxy->receiver = nullptr;
+  return true;
+}
+
+//===-- ISteamHTTP method wrappers ----------------------------------------===//
+
+std::uint32_t CreateHTTPRequest(void *iface, int method, const char *url) {
+  const auto request{orig.CreateHTTPRequest(iface, method, url)};
+  if (request) {
+    const std::scoped_lock lock{http_mtx};
+    http_requests.insert_or_assign(
+        request, http_request{.key = method == http_method_get
+                                         ? std::format("GET {}", url)
+                                         : std::string{},
+                              .context_value = 0,
+                              .response = nullptr});
+  }
+  return request;
+}
+
+bool SetHTTPRequestContextValue(void *iface, std::uint32_t request,
+                                std::uint64_t value) {
+  if (!orig.SetHTTPRequestContextValue(iface, request, value)) {
+    return false;
+  }
+  const std::scoped_lock lock{http_mtx};
+  if (const auto it{http_requests.find(request)}; it != http_requests.end()) {
+    it->second.context_value = value;
+  }
+  return true;
+}
+
+bool SetHTTPRequestHeaderValue(void *iface, std::uint32_t request,
+                               const char *name, const char *value) {
+  if (!orig.SetHTTPRequestHeaderValue(iface, request, name, value)) {
+    return false;
+  }
+  append_to_key(request, std::format("\nH:{}:{}", name, value));
+  return true;
+}
+
+bool SetHTTPRequestGetOrPostParameter(void *iface, std::uint32_t request,
+                                      const char *name, const char *value) {
+  if (!orig.SetHTTPRequestGetOrPostParameter(iface, request, name, value)) {
+    return false;
+  }
+  append_to_key(request, std::format("\nP:{}={}", name, value));
+  return true;
+}
+
+bool SetHTTPRequestRawPostBody(void *iface, std::uint32_t request,
+                               const char *type, std::uint8_t *body,
+                               std::uint32_t body_size) {
+  clear_key(request);
+  return orig.SetHTTPRequestRawPostBody(iface, request, type, body, body_size);
+}
+
+bool SetHTTPRequestCookieContainer(void *iface, std::uint32_t request,
+                                   std::uint32_t container) {
+  clear_key(request);
+  return orig.SetHTTPRequestCookieContainer(iface, request, container);
+}
+
+bool SendHTTPRequest(void *iface, std::uint32_t request, std::uint64_t *call) {
+  std::string key;
+  std::uint64_t context_value{};
+  {
+    const std::scoped_lock lock{http_mtx};
+    if (const auto it{http_requests.find(request)};
+        it != http_requests.end()) {
+      key = it->second.key;
+      context_value = it->second.context_value;
+    }
+  }
+  // Without a call handle the game can't receive a synthetic call result
+  if (key.empty() || !call) {
+    return orig.SendHTTPRequest(iface, request, call);
+  }
+  if (auto resp{http_cache::get(key)}) {
+    *call = call_results::create();
+    {
+      const std::scoped_lock lock{http_mtx};
+      if (const auto it{http_requests.find(request)};
+          it != http_requests.end()) {
+        it->second.response = resp;
+      }
+    }
+    complete_request(request, *call, context_value, resp.get());
+    http_cache_hits.add();
+    return true;
+  }
+  {
+    const std::scoped_lock lock{http_mtx};
+    const auto it{std::ranges::find_if(http_leaders, [&key](const auto &e) {
+      return e.second.proxy && e.second.key == key;
+    })};
+    if (it != http_leaders.end()) {
+      *call = call_results::create();
+      it->second.followers.emplace_back(request, *call);
+      return true;
+    }
+  }
+  if (!orig.SendHTTPRequest(iface, request, call)) {
+    return false;
+  }
+  http_cache_misses.add();
+  const std::scoped_lock lock{http_mtx};
+  http_leaders.insert_or_assign(*call, http_leader{.iface = iface,
+                                                   .request = request,
+                                                   .key = std::move(key),
+                                                   .proxy = nullptr,
+                                                   .followers = {}});
+  return true;
+}
+
+bool GetHTTPResponseHeaderSize(void *iface, std::uint32_t request,
+                               const char *name, std::uint32_t *size) {
+  const auto resp{served_response(request)};
+  if (!resp) {
+    return orig.GetHTTPResponseHeaderSize(iface, request, name, size);
+  }
+  const auto value{http_cache::find_header(*resp, name)};
+  if (!value) {
+    return false;
+  }
+  *size = value->size();
+  return true;
+}
+
+bool GetHTTPResponseHeaderValue(void *iface, std::uint32_t request,
+                                const char *name, std::uint8_t *buf,
+                                std::uint32_t size) {
+  const auto resp{served_response(request)};
+  if (!resp) {
+    return orig.GetHTTPResponseHeaderValue(iface, request, name, buf, size);
+  }
+  const auto value{http_cache::find_header(*resp, name)};
+  if (!value || size < value->size()) {
+    return false;
+  }
+  std::ranges::copy(*value, reinterpret_cast<char *>(buf));
+  return true;
+}
+
+bool GetHTTPResponseBodySize(void *iface, std::uint32_t request,
+                             std::uint32_t *size) {
+  const auto resp{served_response(request)};
+  if (!resp) {
+    return orig.GetHTTPResponseBodySize(iface, request, size);
+  }
+  *size = resp->body.size();
+  return true;
+}
+
+bool GetHTTPResponseBodyData(void *iface, std::uint32_t request,
+                             std::uint8_t *buf, std::uint32_t size) {
+  const auto resp{served_response(request)};
+  if (!resp) {
+    return orig.GetHTTPResponseBodyData(iface, request, buf, size);
+  }
+  if (size < resp->body.size()) {
+    return false;
+  }
+  std::ranges::copy(resp->body, buf);
+  return true;
+}
+
+bool GetHTTPDownloadProgressPct(void *iface, std::uint32_t request,
+                                float *pct) {
+  if (!served_response(request)) {
+    return orig.GetHTTPDownloadProgressPct(iface, request, pct);
+  }
+  *pct = 100.0f;
+  return true;
+}
+
+bool ReleaseHTTPRequest(void *iface, std::uint32_t request) {
+  std::vector<http_follower> followers;
+  {
+    const std::scoped_lock lock{http_mtx};
+    http_requests.erase(request);
+    if (const auto it{std::ranges::find(
+            http_leaders, request,
+            [](const auto &e) { return e.second.request; })};
+        it != http_leaders.end()) {
+      followers = std::move(it->second.followers);
+      if (it->second.proxy) {
+        // Keep the entry for the proxy to find, but stop using the response
+        it->second.key.clear();
+      } else {
+        http_leaders.erase(it);
+      }
+    }
+  }
+  serve_followers(followers, nullptr);
+  return orig.ReleaseHTTPRequest(iface, request);
+}
+
+} // namespace tek::game_runtime::steam_http
@@ -0,0 +1,182 @@
+//===-- steam_http.hpp - ISteamHTTP response caching ----------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations of ISteamHTTP method wrappers that serve cacheable GET
+///    requests from @ref http_cache, or with the response to an identical
+///    request in flight. Such requests complete via synthetic API calls, see
+///    @ref call_results. Steam is accessed only via @ref backend functions,
+///    so the wrappers don't depend on how the interface is obtained.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+#include "steam_api.hpp"
+
+#include <cstdint>
+
+namespace tek::game_runtime::steam_http {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Original ISteamHTTP methods that the wrappers forward to.
+struct backend {
+  steam_api::ISteamHTTP_CreateHTTPRequest_t *_Nonnull CreateHTTPRequest;
+  steam_api::ISteamHTTP_SetHTTPRequestContextValue_t
+      *_Nonnull SetHTTPRequestContextValue;
+  steam_api::ISteamHTTP_SetHTTPRequestParam_t
+      *_Nonnull SetHTTPRequestHeaderValue;
+  steam_api::ISteamHTTP_SetHTTPRequestParam_t
+      *_Nonnull SetHTTPRequestGetOrPostParameter;
+  steam_api::ISteamHTTP_SendHTTPRequest_t *_Nonnull SendHTTPRequest;
+  steam_api::ISteamHTTP_GetHTTPResponseHeaderSize_t
+      *_Nonnull GetHTTPResponseHeaderSize;
+  steam_api::ISteamHTTP_GetHTTPResponseHeaderValue_t
+      *_Nonnull GetHTTPResponseHeaderValue;
+  steam_api::ISteamHTTP_GetHTTPResponseBodySize_t
+      *_Nonnull GetHTTPResponseBodySize;
+  steam_api::ISteamHTTP_GetHTTPResponseBodyData_t
+      *_Nonnull GetHTTPResponseBodyData;
+  steam_api::ISteamHTTP_ReleaseHTTPRequest_t *_Nonnull ReleaseHTTPRequest;
+  steam_api::ISteamHTTP_GetHTTPDownloadProgressPct_t
+      *_Nonnull GetHTTPDownloadProgressPct;
+  steam_api::ISteamHTTP_SetHTTPRequestRawPostBody_t
+      *_Nonnull SetHTTPRequestRawPostBody;
+  steam_api::ISteamHTTP_SetHTTPRequestCookieContainer_t
+      *_Nonnull SetHTTPRequestCookieContainer;
+};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Set the original ISteamHTTP methods. Must be called before any other
+///    function.
+///
+/// @param [in] methods
+///    The original methods.
+[[gnu::visibility("internal")]]
+void init(const backend &methods);
+
+/// Get the receiver to register via `SteamAPI_RegisterCallResult` in place of
+///    the game's one. Requests sent to Steam that identical requests wait for
+///    need a proxy receiver, which captures the response before forwarding
+///    the result to the game's receiver.
+///
+/// @param call
+///    Handle of the API call that the game registers the receiver for.
+/// @param [in] receiver
+///    The game's receiver.
+/// @return Pointer to the receiver to register, which is @p receiver itself
+///    if it doesn't need a proxy.
+[[gnu::visibility("internal")]]
+steam_api::CCallbackBase *_Nonnull attach_receiver(
+    std::uint64_t call, steam_api::CCallbackBase *_Nonnull receiver);
+
+/// Detach the game's receiver from its proxy when the game unregisters it.
+///    The proxy stays registered to serve requests waiting for the response,
+///    and deletes itself when the call completes.
+///
+/// @param call
+///    Handle of the API call that the game unregisters the receiver for.
+/// @return Value indicating whether the receiver has been detached from a
+///    proxy, in which case it must not be unregistered via
+///    `SteamAPI_UnregisterCallResult`.
+[[gnu::visibility("internal")]]
+bool detach_receiver(std::uint64_t call);
+
+//===-- ISteamHTTP method wrappers ----------------------------------------===//
+
+/// Wrapper for ISteamHTTP::CreateHTTPRequest, that starts tracking the
+///    request.
+[[gnu::visibility("internal")]]
+std::uint32_t CreateHTTPRequest(void *_Nonnull iface, int method,
+                                const char *_Nonnull url);
+
+/// Wrapper for ISteamHTTP::SetHTTPRequestContextValue, that remembers the
+///    value for synthetic call results.
+[[gnu::visibility("internal")]]
+bool SetHTTPRequestContextValue(void *_Nonnull iface, std::uint32_t request,
+                                std::uint64_t value);
+
+/// Wrapper for ISteamHTTP::SetHTTPRequestHeaderValue, that adds the header to
+///    the request's cache key.
+[[gnu::visibility("internal")]]
+bool SetHTTPRequestHeaderValue(void *_Nonnull iface, std::uint32_t request,
+                               const char *_Nonnull name,
+                               const char *_Nonnull value);
+
+/// Wrapper for ISteamHTTP::SetHTTPRequestGetOrPostParameter, that adds the
+///    parameter to the request's cache key.
+[[gnu::visibility("internal")]]
+bool SetHTTPRequestGetOrPostParameter(void *_Nonnull iface,
+                                      std::uint32_t request,
+                                      const char *_Nonnull name,
+                                      const char *_Nonnull value);
+
+/// Wrapper for ISteamHTTP::SetHTTPRequestRawPostBody, that marks the request
+///    as not cacheable.
+[[gnu::visibility("internal")]]
+bool SetHTTPRequestRawPostBody(void *_Nonnull iface, std::uint32_t request,
+                               const char *_Nonnull type,
+                               std::uint8_t *_Nonnull body,
+                               std::uint32_t body_size);
+
+/// Wrapper for ISteamHTTP::SetHTTPRequestCookieContainer, that marks the
+///    request as not cacheable since its response may depend on cookies.
+[[gnu::visibility("internal")]]
+bool SetHTTPRequestCookieContainer(void *_Nonnull iface, std::uint32_t request,
+                                   std::uint32_t container);
+
+/// Wrapper for ISteamHTTP::SendHTTPRequest, that serves cacheable requests
+///    from the cache or from the response to an identical request in flight
+///    when possible. Such requests get synthetic API call handles.
+[[gnu::visibility("internal")]]
+bool SendHTTPRequest(void *_Nonnull iface, std::uint32_t request,
+                     std::uint64_t *_Nullable call);
+
+/// Wrapper for ISteamHTTP::GetHTTPResponseHeaderSize, that answers for
+///    served responses.
+[[gnu::visibility("internal")]]
+bool GetHTTPResponseHeaderSize(void *_Nonnull iface, std::uint32_t request,
+                               const char *_Nonnull name,
+                               std::uint32_t *_Nonnull size);
+
+/// Wrapper for ISteamHTTP::GetHTTPResponseHeaderValue, that answers for
+///    served responses.
+[[gnu::visibility("internal")]]
+bool GetHTTPResponseHeaderValue(void *_Nonnull iface, std::uint32_t request,
+                                const char *_Nonnull name,
+                                std::uint8_t *_Nonnull buf,
+                                std::uint32_t size);
+
+/// Wrapper for ISteamHTTP::GetHTTPResponseBodySize, that answers for served
+///    responses.
+[[gnu::visibility("internal")]]
+bool GetHTTPResponseBodySize(void *_Nonnull iface, std::uint32_t request,
+                             std::uint32_t *_Nonnull size);
+
+/// Wrapper for ISteamHTTP::GetHTTPResponseBodyData, that answers for served
+///    responses.
+[[gnu::visibility("internal")]]
+bool GetHTTPResponseBodyData(void *_Nonnull iface, std::uint32_t request,
+                             std::uint8_t *_Nonnull buf, std::uint32_t size);
+
+/// Wrapper for ISteamHTTP::GetHTTPDownloadProgressPct, that reports served
+///    responses as fully downloaded.
+[[gnu::visibility("internal")]]
+bool GetHTTPDownloadProgressPct(void *_Nonnull iface, std::uint32_t request,
+                                float *_Nonnull pct);
+
+/// Wrapper for ISteamHTTP::ReleaseHTTPRequest, that stops tracking the
+///    request and fails requests waiting for its response.
+[[gnu::visibility("internal")]]
+bool ReleaseHTTPRequest(void *_Nonnull iface, std::uint32_t request);
+
+} // namespace tek::game_runtime::steam_http
@@ -15,15 +15,24 @@
 #include "tek-steamclient.hpp"
 
 #include "common.hpp" // IWYU pragma: keep
+#include "log.hpp"
+#include "metrics.hpp"
 #include "settings.hpp"
+#include "shared_cache.hpp"
+#include "steam_api.hpp"
+#include "utf.hpp"
+#include "ws_jobs.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <charconv>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <process.h>
+#include <mutex>
 #include <ranges>
+#include <shared_mutex>
 #include <span>
 #include <string>
 #include <string_view>
@@ -41,6 +50,29 @@ namespace tek::game_runtime::steamclient {
 
 namespace {
 
+//===-- Constants ---------------------------------------------------------===//
+
+/// Maximum age of DLC records in the cross-process cache that may be used
+///    instead of requesting PICS.
+constexpr std::chrono::hours dlc_cache_ttl{1};
+/// Period of time after a failed connection to a Steam CM server during which
+///    other connection attempts for DLC list updates are skipped. Each attempt
+///    holds `SteamAPI_Init` for up to the connect timeout, and a failure is
+///    usually caused by lack of connectivity that affects every instance.
+constexpr std::chrono::minutes cm_failure_backoff{2};
+
+//===-- Types -------------------------------------------------------------===//
+
+/// DLC list update context, used as CM client's user data.
+struct dlc_update_ctx {
+  /// Futex indicating whether the client has finished its work.
+  std::atomic_bool done;
+  /// Value indicating whether new DLC entries have been added to settings.
+  bool save_settings;
+  /// Time when connection to a CM server has been initiated.
+  std::chrono::steady_clock::time_point connect_start;
+};
+
 //===-- Private variables -------------------------------------------------===//
 
 /// libtek-steamclient-1.dll module handle.
@@ -49,6 +81,21 @@ static HMODULE module;
 static tek_sc_lib_ctx *_Nullable lib_ctx;
 /// Pointer to the application manager instance.
 static tek_sc_am *_Nullable am;
+/// Mutex serializing @ref load calls, which may come from concurrently running
+///    startup jobs.
+static std::mutex load_mtx;
+/// Mutex for locking concurrent creation of @ref am.
+static std::mutex am_mtx;
+/// Number of connections to CM servers initiated by the runtime.
+static metrics::counter cm_connects{"steamclient.cm.connects"};
+/// Number of connections to CM servers that have failed.
+static metrics::counter cm_connect_failures{"steamclient.cm.connect_failures"};
+/// Total time spent establishing successful connections to CM servers, in
+///    milliseconds.
+static metrics::counter cm_connect_ms{"steamclient.cm.connect_ms"};
+/// Number of connections to CM servers skipped because of a recent failure
+///    recorded in the cross-process cache.
+static metrics::counter cm_connects_skipped{"steamclient.cm.connects_skipped"};
 
 //===-- tek-steamclient function pointers ---------------------------------===//
 
@@ -70,6 +117,31 @@ static decltype(&tek_sc_am_get_item_desc) am_get_item_desc;
 static decltype(&tek_sc_am_create_job) am_create_job;
 static decltype(&tek_sc_am_run_job) am_run_job;
 
+//===-- CM connection history ---------------------------------------------===//
+
+/// Record the outcome of a connection to a Steam CM server in the
+///    cross-process cache.
+///
+/// @param connected
+///    Value indicating whether the connection has succeeded.
+static void record_cm_connect(bool connected) {
+  const std::byte failed{!connected};
+  shared_cache::put(shared_cache::record_type::cm_connect, 0,
+                    std::span{&failed, 1});
+}
+
+/// Check whether a connection to a Steam CM server has failed within
+///    @ref cm_failure_backoff, in this or another instance.
+///
+/// @return Value indicating whether the last recent connection has failed.
+static bool cm_recently_failed() {
+  std::byte failed;
+  std::size_t size;
+  return shared_cache::get(shared_cache::record_type::cm_connect, 0,
+                           cm_failure_backoff, std::span{&failed, 1}, size) &&
+         size == 1 && failed != std::byte{};
+}
+
 //===-- CM client callbacks -----------------------------------------------===//
 
 /// The callback for CM client PICS DLC info received event.
@@ -78,16 +150,21 @@ static decltype(&tek_sc_am_run_job) am_run_job;
 ///    Pointer to the CM client instance that emitted the callback.
 /// @param [in, out] data
 ///    Pointer to `tek_sc_cm_data_pics` associated with the request.
+/// @param [out] user_data
+///    Pointer to the @ref dlc_update_ctx associated with @p client.
 static void cb_dlc_info(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
-                        void *) {
+                        void *_Nonnull user_data) {
   auto &data_pics{*reinterpret_cast<tek_sc_cm_data_pics *>(data)};
   if (!tek_sc_err_success(&data_pics.result)) {
+    log::warning("DLC update: failed to get DLC info, error code {}",
+                 static_cast<int>(data_pics.result.primary));
     delete[] data_pics.app_entries;
     delete &data_pics;
     cm_disconnect(client);
     return;
   }
-  bool save_settings{};
+  auto &save_settings{
+      reinterpret_cast<dlc_update_ctx *>(user_data)->save_settings};
   for (const auto &entry :
        std::span{data_pics.app_entries,
                  static_cast<std::size_t>(data_pics.num_app_entries)}) {
@@ -106,14 +183,21 @@ static void cb_dlc_info(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
       const auto &common_m{common->second};
       const auto name{common_m->attribs.find("name")};
       if (name != common_m->attribs.end()) {
+        shared_cache::put(shared_cache::record_type::dlc_name, entry.id,
+                          std::as_bytes(std::span{name->second}));
+        const std::scoped_lock lock{g_settings.steam->dlc_mtx};
         g_settings.steam->dlc.emplace_back(entry.id, std::move(name->second));
         g_settings.steam->installed_dlc.emplace(entry.id);
         save_settings = true;
+        steam_api::post_callback(steam_api::dlc_installed{.app_id = entry.id});
+        continue;
       }
     }
+    // Remember that the DLC has no name so other instances don't request it
+    shared_cache::put(shared_cache::record_type::dlc_name, entry.id, {});
   }
   if (save_settings) {
-    g_settings.save();
+    steam_api::update_dlc_index();
   }
   delete[] data_pics.app_entries;
   delete &data_pics;
@@ -130,6 +214,8 @@ static void cb_dlc_access_token(tek_sc_cm_client *_Nonnull client,
                                 void *_Nonnull data, void *) {
   auto &data_pics{*reinterpret_cast<tek_sc_cm_data_pics *>(data)};
   if (!tek_sc_err_success(&data_pics.result)) {
+    log::warning("DLC update: failed to get DLC access tokens, error code {}",
+                 static_cast<int>(data_pics.result.primary));
     delete[] data_pics.app_entries;
     delete &data_pics;
     cm_disconnect(client);
@@ -149,6 +235,10 @@ static void cb_app_info(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
   auto &data_pics{*reinterpret_cast<tek_sc_cm_data_pics *>(data)};
   if (!tek_sc_err_success(&data_pics.result) ||
       !tek_sc_err_success(&data_pics.app_entries->result)) {
+    log::warning("DLC update: failed to get app info, error code {}",
+                 static_cast<int>(tek_sc_err_success(&data_pics.result)
+                                      ? data_pics.app_entries->result.primary
+                                      : data_pics.result.primary));
     delete data_pics.app_entries;
     delete &data_pics;
     cm_disconnect(client);
@@ -165,12 +255,14 @@ static void cb_app_info(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
     cm_disconnect(client);
     return;
   }
+  std::vector<std::uint32_t> all_dlc;
   std::vector<std::uint32_t> new_dlc;
   const auto extended{vdf.childs.find("extended")};
   if (extended != vdf.childs.end()) {
     const auto &extended_m{extended->second};
     const auto listofdlc{extended_m->attribs.find("listofdlc")};
     if (listofdlc != extended_m->attribs.end()) {
+      const std::shared_lock lock{g_settings.steam->dlc_mtx};
       const auto &dlc{g_settings.steam->dlc};
       for (const auto &&id_view : listofdlc->second | std::views::split(',') |
                                       std::views::transform([](auto &&segment) {
@@ -178,13 +270,18 @@ static void cb_app_info(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
                                       })) {
         if (std::uint32_t id;
             std::from_chars(id_view.cbegin(), id_view.cend(), id).ec ==
-                std::errc{} &&
-            !std::ranges::contains(dlc | std::views::keys, id)) {
-          new_dlc.emplace_back(id);
+                std::errc{}) {
+          all_dlc.emplace_back(id);
+          if (!std::ranges::contains(dlc | std::views::keys, id)) {
+            new_dlc.emplace_back(id);
+          }
         }
       }
     }
   }
+  shared_cache::put(shared_cache::record_type::dlc_ids,
+                    g_settings.steam->app_id,
+                    std::as_bytes(std::span{all_dlc}));
   if (new_dlc.empty()) {
     delete data_pics.app_entries;
     delete &data_pics;
@@ -228,7 +325,11 @@ static void cb_access_token(tek_sc_cm_client *_Nonnull client,
 ///    Pointer to `tek_sc_err` indicating the result of the sign-in attempt.
 static void cb_signed_in(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
                          void *) {
-  if (!tek_sc_err_success(reinterpret_cast<const tek_sc_err *>(data))) {
+  if (const auto &err{*reinterpret_cast<const tek_sc_err *>(data)};
+      !tek_sc_err_success(&err)) {
+    log::warning("DLC update: failed to sign in to Steam CM server, error "
+                 "code {}",
+                 static_cast<int>(err.primary));
     cm_disconnect(client);
     return;
   }
@@ -247,44 +348,156 @@ static void cb_signed_in(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
 /// @param [in] data
 ///    Pointer to `tek_sc_err` indicating the result of connection.
 /// @param [in, out] user_data
-///    Pointer to the futex associated with @p client.
+///    Pointer to the @ref dlc_update_ctx associated with @p client.
 static void cb_connected(tek_sc_cm_client *_Nonnull client, void *_Nonnull data,
                          void *_Nonnull user_data) {
-  if (tek_sc_err_success(reinterpret_cast<const tek_sc_err *>(data))) {
+  auto &ctx{*reinterpret_cast<dlc_update_ctx *>(user_data)};
+  const bool connected{
+      tek_sc_err_success(reinterpret_cast<const tek_sc_err *>(data))};
+  record_cm_connect(connected);
+  if (connected) {
+    cm_connect_ms.add(std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now() - ctx.connect_start)
+                          .count());
     cm_sign_in_anon(client, cb_signed_in, 2500);
   } else {
-    reinterpret_cast<std::atomic_bool *>(user_data)->store(
-        true, std::memory_order::relaxed);
-    WakeByAddressSingle(user_data);
+    cm_connect_failures.add();
+    log::warning(
+        "DLC update: failed to connect to Steam CM server, error code {}",
+        static_cast<int>(reinterpret_cast<const tek_sc_err *>(data)->primary));
+    auto &done{ctx.done};
+    done.store(true, std::memory_order::relaxed);
+    WakeByAddressSingle(&done);
   }
 }
 
 /// The callback for CM client disconnected event.
 ///
 /// @param [in, out] user_data
-///    Pointer to the futex associated with the client.
+///    Pointer to the @ref dlc_update_ctx associated with the client.
 static void cb_disconnected(tek_sc_cm_client *, void *,
                             void *_Nonnull user_data) {
-  reinterpret_cast<std::atomic_bool *>(user_data)->store(
-      true, std::memory_order::relaxed);
-  WakeByAddressSingle(user_data);
+  auto &done{reinterpret_cast<dlc_update_ctx *>(user_data)->done};
+  done.store(true, std::memory_order::relaxed);
+  WakeByAddressSingle(&done);
 }
 
-//===-- Steam Workshop item install processing ----------------------------===//
+//===-- Cross-process cache -----------------------------------------------===//
 
-/// Temporary storage for passing arguments to the job thread.
-struct ws_job_args {
-  tek_sc_am_item_desc *_Nonnull desc;
-  tek_sc_am_job_upd_func *_Nullable upd_handler;
-};
+/// Add DLC entries from the cross-process cache to settings, and save them if
+///    any have been added.
+///
+/// @return Value indicating whether the cache had complete DLC info for the
+///    game.
+static bool update_dlc_from_cache() {
+  std::array<std::uint32_t,
+             shared_cache::max_record_size / sizeof(std::uint32_t)>
+      ids;
+  std::size_t size;
+  if (!shared_cache::get(shared_cache::record_type::dlc_ids,
+                         g_settings.steam->app_id, dlc_cache_ttl,
+                         std::as_writable_bytes(std::span{ids}), size)) {
+    return false;
+  }
+  auto &dlc{g_settings.steam->dlc};
+  std::vector<std::pair<std::uint32_t, std::string>> new_dlc;
+  for (const auto id : std::span{ids.data(), size / sizeof(std::uint32_t)}) {
+    if (const std::shared_lock lock{g_settings.steam->dlc_mtx};
+        std::ranges::contains(dlc | std::views::keys, id)) {
+      continue;
+    }
+    std::array<char, shared_cache::max_record_size> name;
+    std::size_t name_size;
+    if (!shared_cache::get(shared_cache::record_type::dlc_name, id,
+                           dlc_cache_ttl,
+                           std::as_writable_bytes(std::span{name}),
+                           name_size)) {
+      return false;
+    }
+    if (name_size) {
+      new_dlc.emplace_back(id, std::string{name.data(), name_size});
+    }
+  }
+  if (new_dlc.empty()) {
+    return true;
+  }
+  {
+    const std::scoped_lock lock{g_settings.steam->dlc_mtx};
+    for (auto &[id, name] : new_dlc) {
+      dlc.emplace_back(id, std::move(name));
+      g_settings.steam->installed_dlc.emplace(id);
+    }
+  }
+  steam_api::update_dlc_index();
+  g_settings.save();
+  return true;
+}
 
-/// Steam Workshop item download job procedure.
-static unsigned ws_job_proc(void *_Nonnull arg) {
-  const auto args_ptr{reinterpret_cast<ws_job_args *>(arg)};
-  const auto args{*args_ptr};
-  delete args_ptr;
-  return static_cast<unsigned>(
-      am_run_job(am, args.desc, args.upd_handler).primary);
+//===-- Application manager backend ---------------------------------------===//
+
+/// Create application manager instance if it hasn't been created yet.
+///
+/// @param [in] am_dir
+///    Path to the game root directory to initialize application manager
+///    instance with, as a null-terminated string.
+/// @param [in] ws_dir
+///    Path to the base directory for Steam Workshop items, as a null-terminated
+///    string.
+/// @return Value indicating whether application manager instance is
+///    available.
+static bool init_am(const tek_sc_os_char *_Nonnull am_dir,
+                    const tek_sc_os_char *_Nonnull ws_dir) {
+  const std::scoped_lock lock{am_mtx};
+  if (am) {
+    return true;
+  }
+  tek_sc_err err;
+  am = am_create(lib_ctx, am_dir, &err);
+  if (!am) {
+    return false;
+  }
+  if (am_set_ws_dir(am, ws_dir).primary) {
+    am_destroy(am);
+    am = nullptr;
+    return false;
+  }
+  return true;
+}
+
+/// Get descriptor of a Steam Workshop item from @ref am.
+///
+/// @param [in] item_id
+///    Pointer to the ID of the item.
+/// @return Pointer to the descriptor of the item, or `nullptr` if it's not
+///    known to the application manager.
+static tek_sc_am_item_desc *_Nullable
+get_item_desc(const tek_sc_item_id *_Nonnull item_id) {
+  return am_get_item_desc(am, item_id);
+}
+
+/// Create a job for the latest version of a Steam Workshop item in @ref am.
+///
+/// @param [in] item_id
+///    Pointer to the ID of the item.
+/// @param [out] item_desc
+///    Address of variable that receives pointer to the descriptor of the item.
+/// @return A @ref tek_sc_err indicating the result of the operation.
+static tek_sc_err
+create_job(const tek_sc_item_id *_Nonnull item_id,
+           tek_sc_am_item_desc *_Nullable *_Nonnull item_desc) {
+  return am_create_job(am, item_id, 0, false, item_desc);
+}
+
+/// Run a Steam Workshop item job in @ref am.
+///
+/// @param [in, out] desc
+///    Descriptor of the item.
+/// @param [in] upd_handler
+///    Job update handler.
+/// @return A @ref tek_sc_err indicating the result of the operation.
+static tek_sc_err run_job(tek_sc_am_item_desc *_Nonnull desc,
+                          tek_sc_am_job_upd_func *_Nonnull upd_handler) {
+  return am_run_job(am, desc, upd_handler);
 }
 
 } // namespace
@@ -292,17 +505,11 @@ static unsigned ws_job_proc(void *_Nonnull arg) {
 //===-- Internal functions ------------------------------------------------===//
 
 void load() {
+  const std::scoped_lock lock{load_mtx};
   if (loaded) {
     return;
   }
-  std::wstring path;
-  const auto &tek_sc_path{g_settings.steam->tek_sc_path};
-  if (!tek_sc_path.empty()) {
-    path.resize(MultiByteToWideChar(CP_UTF8, 0, tek_sc_path.data(),
-                                    tek_sc_path.size(), nullptr, 0));
-    MultiByteToWideChar(CP_UTF8, 0, tek_sc_path.data(), tek_sc_path.size(),
-                        path.data(), path.length());
-  }
+  const auto path{utf::to_wide(g_settings.steam->tek_sc_path)};
   module =
       LoadLibraryW(path.empty() ? L"libtek-steamclient-2.dll" : path.data());
   if (!module) {
@@ -387,6 +594,11 @@ void load() {
   if (!lib_ctx) {
     goto free_lib;
   }
+  ws_jobs::init({.init = init_am,
+                 .get_item_desc = get_item_desc,
+                 .create_job = create_job,
+                 .run_job = run_job},
+                g_settings.steam->app_id);
   loaded = true;
   return;
 free_lib:
@@ -413,63 +625,34 @@ free_lib:
 }
 
 void update_dlc() {
-  std::atomic_bool done{};
-  const auto client{cm_client_create(lib_ctx, &done)};
+  if (update_dlc_from_cache()) {
+    return;
+  }
+  if (cm_recently_failed()) {
+    cm_connects_skipped.add();
+    log::info("DLC update: skipped, the last connection to Steam CM server "
+              "has failed less than {} minutes ago",
+              cm_failure_backoff.count());
+    return;
+  }
+  dlc_update_ctx ctx{};
+  const auto client{cm_client_create(lib_ctx, &ctx)};
   if (!client) {
     return;
   }
+  cm_connects.add();
+  ctx.connect_start = std::chrono::steady_clock::now();
   cm_connect(client, cb_connected, 2500, cb_disconnected);
   do {
     bool cmp{};
-    if (!WaitOnAddress(&done, &cmp, sizeof cmp, 10000) &&
+    if (!WaitOnAddress(&ctx.done, &cmp, sizeof cmp, 10000) &&
         GetLastError() == ERROR_TIMEOUT) {
       break;
     }
-  } while (!done.load(std::memory_order::relaxed));
+  } while (!ctx.done.load(std::memory_order::relaxed));
   cm_client_destroy(client);
-}
-
-bool install_workshop_item(const tek_sc_os_char *am_dir,
-                           const tek_sc_os_char *ws_dir, std::uint64_t id,
-                           tek_sc_am_job_upd_func *upd_handler,
-                           tek_sc_am_item_desc **item_desc) {
-  if (!am) {
-    tek_sc_err err;
-    am = am_create(lib_ctx, am_dir, &err);
-    if (!am) {
-      return false;
-    }
-    if (am_set_ws_dir(am, ws_dir).primary) {
-      am_destroy(am);
-      am = nullptr;
-      return false;
-    }
-  }
-  const tek_sc_item_id item_id{.app_id = g_settings.steam->app_id,
-                               .depot_id = g_settings.steam->app_id,
-                               .ws_item_id = id};
-  auto &desc{*item_desc};
-  desc = am_get_item_desc(am, &item_id);
-  if (!desc || !(desc->status & TEK_SC_AM_ITEM_STATUS_job)) {
-    auto const res{am_create_job(am, &item_id, 0, false, &desc)};
-    if (!tek_sc_err_success(&res)) {
-      if (res.primary == TEK_SC_ERRC_up_to_date) {
-        upd_handler(desc, TEK_SC_AM_UPD_TYPE_state);
-        return true;
-      }
-      desc = nullptr;
-      return false;
-    }
-  }
-  const auto args{new ws_job_args{.desc = desc, .upd_handler = upd_handler}};
-  const auto thread{_beginthreadex(nullptr, 0, ws_job_proc, args, 0, nullptr)};
-  if (thread) {
-    CloseHandle(reinterpret_cast<HANDLE>(thread));
-    return true;
-  } else {
-    delete args;
-    desc = nullptr;
-    return false;
+  if (ctx.save_settings) {
+    g_settings.save();
   }
 }
 
@@ -0,0 +1,179 @@
+//===-- utf.cpp - UTF-8/UTF-16 transcoding implementation -----------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of UTF-8/UTF-16 transcoding functions.
+///
+//===----------------------------------------------------------------------===//
+#include "utf.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace tek::game_runtime::utf {
+
+namespace {
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Code point that ill-formed sequences are replaced with.
+constexpr char16_t replacement_char{0xFFFD};
+
+} // namespace
+
+//===-- Internal functions ------------------------------------------------===//
+
+result to_utf16(std::string_view src, char16_t *dst) noexcept {
+  const auto data{reinterpret_cast<const unsigned char *>(src.data())};
+  const auto size{src.size()};
+  std::size_t i{};
+  std::size_t len{};
+  bool valid{true};
+  while (i < size) {
+#ifdef __SSE2__
+    // Widen ASCII runs 16 bytes at a time
+    const auto zero{_mm_setzero_si128()};
+    while (size - i >= 16) {
+      const auto chunk{
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(&data[i]))};
+      if (_mm_movemask_epi8(chunk)) {
+        break;
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[len]),
+                       _mm_unpacklo_epi8(chunk, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(&dst[len + 8]),
+                       _mm_unpackhi_epi8(chunk, zero));
+      i += 16;
+      len += 16;
+    }
+    if (i == size) {
+      break;
+    }
+#endif // def __SSE2__
+    const auto lead{data[i]};
+    if (lead < 0x80) {
+      dst[len++] = lead;
+      ++i;
+      continue;
+    }
+    std::uint32_t cp;
+    std::size_t seq_len;
+    std::uint32_t min_cp;
+    if ((lead & 0xE0) == 0xC0) {
+      cp = lead & 0x1F;
+      seq_len = 2;
+      min_cp = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+      cp = lead & 0x0F;
+      seq_len = 3;
+      min_cp = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+      cp = lead & 0x07;
+      seq_len = 4;
+      min_cp = 0x10000;
+    } else {
+      // Stray continuation byte or invalid lead byte
+      dst[len++] = replacement_char;
+      valid = false;
+      ++i;
+      continue;
+    }
+    std::size_t num_read{1};
+    for (; num_read < seq_len && i + num_read < size; ++num_read) {
+      const auto cont{data[i + num_read]};
+      if ((cont & 0xC0) != 0x80) {
+        break;
+      }
+      cp = (cp << 6) | (cont & 0x3F);
+    }
+    i += num_read;
+    // Reject truncated and overlong sequences, surrogates, and code points
+    //    outside of Unicode range
+    if (num_read < seq_len || cp < min_cp || cp > 0x10FFFF ||
+        (cp >= 0xD800 && cp <= 0xDFFF)) {
+      dst[len++] = replacement_char;
+      valid = false;
+      continue;
+    }
+    if (cp >= 0x10000) {
+      cp -= 0x10000;
+      dst[len++] = static_cast<char16_t>(0xD800 | (cp >> 10));
+      dst[len++] = static_cast<char16_t>(0xDC00 | (cp & 0x3FF));
+    } else {
+      dst[len++] = static_cast<char16_t>(cp);
+    }
+  } // while (i < size)
+  return {.length = len, .valid = valid};
+}
+
+result to_utf8(std::u16string_view src, char *dst) noexcept {
+  const auto data{src.data()};
+  const auto size{src.size()};
+  const auto out{reinterpret_cast<unsigned char *>(dst)};
+  std::size_t i{};
+  std::size_t len{};
+  bool valid{true};
+  while (i < size) {
+#ifdef __SSE2__
+    // Narrow ASCII runs 8 code units at a time
+    const auto zero{_mm_setzero_si128()};
+    const auto non_ascii_mask{_mm_set1_epi16(static_cast<short>(0xFF80))};
+    while (size - i >= 8) {
+      const auto chunk{
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(&data[i]))};
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(
+              _mm_and_si128(chunk, non_ascii_mask), zero)) != 0xFFFF) {
+        break;
+      }
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(&out[len]),
+                       _mm_packus_epi16(chunk, chunk));
+      i += 8;
+      len += 8;
+    }
+    if (i == size) {
+      break;
+    }
+#endif // def __SSE2__
+    std::uint32_t cp{data[i++]};
+    if (cp < 0x80) {
+      out[len++] = static_cast<unsigned char>(cp);
+      continue;
+    }
+    if (cp < 0x800) {
+      out[len++] = static_cast<unsigned char>(0xC0 | (cp >> 6));
+      out[len++] = static_cast<unsigned char>(0x80 | (cp & 0x3F));
+      continue;
+    }
+    if (cp >= 0xD800 && cp <= 0xDFFF) {
+      if (cp <= 0xDBFF && i < size && data[i] >= 0xDC00 && data[i] <= 0xDFFF) {
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (data[i++] - 0xDC00);
+        out[len++] = static_cast<unsigned char>(0xF0 | (cp >> 18));
+        out[len++] = static_cast<unsigned char>(0x80 | ((cp >> 12) & 0x3F));
+        out[len++] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3F));
+        out[len++] = static_cast<unsigned char>(0x80 | (cp & 0x3F));
+        continue;
+      }
+      // Unpaired surrogate
+      cp = replacement_char;
+      valid = false;
+    }
+    out[len++] = static_cast<unsigned char>(0xE0 | (cp >> 12));
+    out[len++] = static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3F));
+    out[len++] = static_cast<unsigned char>(0x80 | (cp & 0x3F));
+  } // while (i < size)
+  return {.length = len, .valid = valid};
+}
+
+} // namespace tek::game_runtime::utf
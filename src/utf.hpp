@@ -0,0 +1,91 @@
+//===-- utf.hpp - UTF-8/UTF-16 transcoding interface ----------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for UTF-8/UTF-16 transcoding functions that validate and
+///    convert input in a single pass. ASCII runs are processed 16 bytes at a
+///    time with SSE2 where available, other input takes the scalar path.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace tek::game_runtime::utf {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Result of a transcoding operation.
+struct result {
+  /// Number of code units written to the output buffer.
+  std::size_t length;
+  /// Value indicating whether the input was well-formed. Ill-formed sequences
+  ///    are replaced with U+FFFD in the output.
+  bool valid;
+};
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Convert a UTF-8 string to UTF-16.
+///
+/// @param src
+///    The string to convert.
+/// @param [out] dst
+///    Buffer that receives converted string, without a null terminator. Must
+///    be able to hold at least `src.size()` code units.
+/// @return Transcoding result.
+[[gnu::visibility("internal")]]
+result to_utf16(std::string_view src, char16_t *dst) noexcept;
+
+/// Convert a UTF-16 string to UTF-8.
+///
+/// @param src
+///    The string to convert.
+/// @param [out] dst
+///    Buffer that receives converted string, without a null terminator. Must
+///    be able to hold at least `src.size() * 3` bytes.
+/// @return Transcoding result.
+[[gnu::visibility("internal")]]
+result to_utf8(std::u16string_view src, char *dst) noexcept;
+
+#ifdef _WIN32
+/// Convert a UTF-8 string to a Windows wide string.
+///
+/// @param src
+///    The string to convert.
+/// @return Converted string.
+inline std::wstring to_wide(std::string_view src) {
+  std::wstring result;
+  result.resize_and_overwrite(src.size(), [src](wchar_t *buf, std::size_t) {
+    return to_utf16(src, reinterpret_cast<char16_t *>(buf)).length;
+  });
+  return result;
+}
+
+/// Convert a Windows wide string to UTF-8.
+///
+/// @param src
+///    The string to convert.
+/// @return Converted string.
+inline std::string from_wide(std::wstring_view src) {
+  std::string result;
+  result.resize_and_overwrite(src.size() * 3, [src](char *buf, std::size_t) {
+    return to_utf8({reinterpret_cast<const char16_t *>(src.data()),
+                    src.size()},
+                   buf)
+        .length;
+  });
+  return result;
+}
+#endif // def _WIN32
+
+} // namespace tek::game_runtime::utf
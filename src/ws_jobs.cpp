@@ -0,0 +1,575 @@
+//===-- ws_jobs.cpp - Steam Workshop item job scheduling ------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Implementation of Steam Workshop item job scheduling.
+///
+//===----------------------------------------------------------------------===//
+#include "ws_jobs.hpp"
+
+#include "common.hpp" // IWYU pragma: keep
+#include "jobs.hpp"
+#include "log.hpp"
+#include "metrics.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <tek-steamclient/am.h>
+#include <tek-steamclient/error.h>
+#include <tek-steamclient/os.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tek::game_runtime::ws_jobs {
+
+namespace {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Pending Steam Workshop item install request.
+struct install_req {
+  /// ID of the item to install.
+  std::uint64_t id;
+  /// The callback for when the item is done with.
+  finish_func *_Nullable on_finish;
+  /// Address of variable that receives pointer to the item descriptor.
+  tek_sc_am_item_desc *_Nullable *_Nonnull item_desc;
+};
+
+/// Context for background Steam Workshop item update checks, shared by all
+///    batch jobs.
+struct update_ctx {
+  /// IDs of the items to check.
+  std::vector<std::uint64_t> ids;
+  /// The callback for when started jobs finish.
+  finish_func *_Nullable on_finish;
+  /// The callback that decides whether update jobs are created.
+  update_check_func *_Nonnull on_check;
+  /// The callback that decides whether created update jobs are started.
+  update_func *_Nonnull on_update;
+};
+
+/// Timing state of a running Steam Workshop item job.
+struct job_timing {
+  /// Time when the current stage has begun.
+  std::chrono::steady_clock::time_point stage_start;
+  /// Current stage of the job.
+  tek_sc_am_job_stage stage;
+  /// Total time spent in the downloading stage.
+  std::chrono::steady_clock::duration download_time;
+  /// Number of bytes downloaded, as last reported by a progress update during
+  ///    the downloading stage.
+  std::int64_t download_bytes;
+};
+
+#ifdef _WIN32
+/// Handle for the cross-process lock of a Steam Workshop item, which is a
+///    named mutex. `nullptr` if it couldn't be created.
+using item_lock = HANDLE;
+#else  // def _WIN32
+/// Handle for the cross-process lock of a Steam Workshop item, which is a
+///    file descriptor of a lock file. `-1` if it couldn't be opened.
+using item_lock = int;
+#endif // def _WIN32 else
+
+} // namespace
+
+//===-- Private variables -------------------------------------------------===//
+
+/// Functions accessing the application manager.
+static backend am;
+/// ID of the application that Steam Workshop items belong to.
+static std::uint32_t app_id;
+/// Steam Workshop item install requests gathered during current window.
+static std::vector<install_req> pending_installs;
+/// IDs of Steam Workshop items which install requests have been made for but
+///    jobs haven't been created yet.
+static std::unordered_set<std::uint64_t> unresolved_installs;
+/// Mutex for locking concurrent access to @ref pending_installs and
+///    @ref unresolved_installs.
+static std::mutex pending_installs_mtx;
+/// Number of Steam Workshop item install batches processed.
+static metrics::counter install_batches{"steamclient.ws_install.batches"};
+/// Number of Steam Workshop item install requests processed.
+static metrics::counter install_items{"steamclient.ws_install.items"};
+/// Timing states of running Steam Workshop item jobs, keyed by item
+///    descriptor.
+static std::unordered_map<const tek_sc_am_item_desc *, job_timing>
+    job_timings;
+/// Number of times a job has been run for each Steam Workshop item during the
+///    session.
+static std::unordered_map<std::uint64_t, std::uint32_t> job_runs;
+/// Mutex for locking concurrent access to @ref job_timings and
+///    @ref job_runs.
+static std::mutex job_timings_mtx;
+/// Number of Steam Workshop item jobs run.
+static metrics::counter jobs_run{"steamclient.ws_job.runs"};
+/// Number of Steam Workshop item jobs run for items that already had a job
+///    run during the session.
+static metrics::counter jobs_retried{"steamclient.ws_job.retries"};
+/// Number of Steam Workshop item jobs that have failed.
+static metrics::counter jobs_failed{"steamclient.ws_job.failures"};
+/// Total durations of Steam Workshop item jobs, in milliseconds.
+static metrics::distribution job_ms{"steamclient.ws_job.total_ms"};
+/// Download rates of Steam Workshop item jobs, in bytes per second.
+static metrics::distribution job_download_rate{
+    "steamclient.ws_job.download_bytes_per_sec"};
+/// Durations of Steam Workshop item job stages, in milliseconds, named after
+///    `tek_sc_am_job_stage` values.
+static struct {
+  metrics::distribution fetching_data{
+      "steamclient.ws_job.stage.fetching_data_ms"};
+  metrics::distribution dw_manifest{"steamclient.ws_job.stage.dw_manifest_ms"};
+  metrics::distribution dw_patch{"steamclient.ws_job.stage.dw_patch_ms"};
+  metrics::distribution verifying{"steamclient.ws_job.stage.verifying_ms"};
+  metrics::distribution downloading{"steamclient.ws_job.stage.downloading_ms"};
+  metrics::distribution patching{"steamclient.ws_job.stage.patching_ms"};
+  metrics::distribution installing{"steamclient.ws_job.stage.installing_ms"};
+  metrics::distribution deleting{"steamclient.ws_job.stage.deleting_ms"};
+  metrics::distribution finalizing{"steamclient.ws_job.stage.finalizing_ms"};
+  /// Stages that tek-steamclient may add in the future.
+  metrics::distribution other{"steamclient.ws_job.stage.other_ms"};
+} stage_ms;
+
+//===-- Private functions -------------------------------------------------===//
+
+/// Get the pool for running download jobs of Steam Workshop items requested
+///    by the game. Those may block for minutes, so they are kept off the
+///    runtime pool, and off @ref update_pool so background updates never
+///    take capacity from them. It's leaked, as downloads may be cut off by
+///    process exit.
+///
+/// @return Reference to the Steam Workshop install pool.
+static jobs::pool &install_pool() {
+  static auto &instance{*new jobs::pool{"workshop", 2}};
+  return instance;
+}
+
+/// Get the pool for background update checks and update download jobs of
+///    installed Steam Workshop items. It has a single worker, so updates use
+///    little of the bandwidth that game-requested downloads need. It's
+///    leaked, as update checks may still be waiting on Steam at process exit.
+///
+/// @return Reference to the Steam Workshop update pool.
+static jobs::pool &update_pool() {
+  static auto &instance{*new jobs::pool{"workshop_updates", 1}};
+  return instance;
+}
+
+/// Get the item ID structure of a Steam Workshop item.
+///
+/// @param id
+///    ID of the Steam Workshop item.
+/// @return Item ID structure for the item.
+static tek_sc_item_id item_id(std::uint64_t id) {
+  return {.app_id = app_id, .depot_id = app_id, .ws_item_id = id};
+}
+
+/// Get the distribution of durations of a Steam Workshop item job stage.
+///
+/// @param stage
+///    The job stage.
+/// @return Reference to the distribution of durations of @p stage.
+static metrics::distribution &stage_distribution(tek_sc_am_job_stage stage) {
+  switch (stage) {
+  case TEK_SC_AM_JOB_STAGE_fetching_data:
+    return stage_ms.fetching_data;
+  case TEK_SC_AM_JOB_STAGE_dw_manifest:
+    return stage_ms.dw_manifest;
+  case TEK_SC_AM_JOB_STAGE_dw_patch:
+    return stage_ms.dw_patch;
+  case TEK_SC_AM_JOB_STAGE_verifying:
+    return stage_ms.verifying;
+  case TEK_SC_AM_JOB_STAGE_downloading:
+    return stage_ms.downloading;
+  case TEK_SC_AM_JOB_STAGE_patching:
+    return stage_ms.patching;
+  case TEK_SC_AM_JOB_STAGE_installing:
+    return stage_ms.installing;
+  case TEK_SC_AM_JOB_STAGE_deleting:
+    return stage_ms.deleting;
+  case TEK_SC_AM_JOB_STAGE_finalizing:
+    return stage_ms.finalizing;
+  default:
+    return stage_ms.other;
+  }
+}
+
+/// Record the duration of a job's current stage.
+///
+/// @param [in, out] timing
+///    Timing state of the job.
+/// @param now
+///    Time when the stage has ended.
+static void end_stage(job_timing &timing,
+                      std::chrono::steady_clock::time_point now) {
+  const auto duration{now - timing.stage_start};
+  stage_distribution(timing.stage)
+      .add(std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+               .count());
+  if (timing.stage == TEK_SC_AM_JOB_STAGE_downloading) {
+    timing.download_time += duration;
+  }
+  timing.stage_start = now;
+}
+
+/// Job update handler that records stage transitions and download progress
+///    of the job.
+///
+/// @param [in, out] desc
+///    Descriptor of the item.
+/// @param upd_mask
+///    Bitmask of update types.
+static void timed_upd_handler(tek_sc_am_item_desc *_Nonnull desc,
+                              tek_sc_am_upd_type upd_mask) {
+  const std::scoped_lock lock{job_timings_mtx};
+  if (const auto it{job_timings.find(desc)}; it != job_timings.end()) {
+    auto &timing{it->second};
+    if (upd_mask & TEK_SC_AM_UPD_TYPE_stage) {
+      end_stage(timing, std::chrono::steady_clock::now());
+      timing.stage = desc->job.stage;
+    } else if (upd_mask & TEK_SC_AM_UPD_TYPE_progress &&
+               timing.stage == TEK_SC_AM_JOB_STAGE_downloading) {
+      timing.download_bytes = desc->job.progress_current;
+    }
+  }
+}
+
+/// Run application manager job for a Steam Workshop item, record its timing
+///    metrics, log its failure, and pass its result to the caller.
+///
+/// @param [in, out] desc
+///    Descriptor of the item.
+/// @param [in] on_finish
+///    The callback to pass the result of the job to.
+static void run_item_job(tek_sc_am_item_desc *_Nonnull desc,
+                         finish_func *_Nullable on_finish) {
+  const auto id{desc->id.ws_item_id};
+  const auto start{std::chrono::steady_clock::now()};
+  job_timing timing{.stage_start = start,
+                    .stage = desc->job.stage,
+                    .download_time = {},
+                    .download_bytes = 0};
+  {
+    const std::scoped_lock lock{job_timings_mtx};
+    job_timings.insert_or_assign(desc, timing);
+    if (++job_runs[id] > 1) {
+      jobs_retried.add();
+    }
+  }
+  jobs_run.add();
+  const auto res{am.run_job(desc, timed_upd_handler)};
+  const auto end{std::chrono::steady_clock::now()};
+  {
+    const std::scoped_lock lock{job_timings_mtx};
+    if (const auto node{job_timings.extract(desc)}; node) {
+      timing = node.mapped();
+    }
+  }
+  end_stage(timing, end);
+  const auto total_ms{
+      std::chrono::duration_cast<std::chrono::milliseconds>(end - start)
+          .count()};
+  job_ms.add(total_ms);
+  if (timing.download_bytes > 0 &&
+      timing.download_time > std::chrono::steady_clock::duration::zero()) {
+    job_download_rate.add(static_cast<std::uint64_t>(
+        timing.download_bytes /
+        std::chrono::duration<double>{timing.download_time}.count()));
+  }
+  if (!tek_sc_err_success(&res)) {
+    jobs_failed.add();
+    log::error("Job for Steam Workshop item {} failed after {} ms, error code "
+               "{}",
+               id, total_ms, static_cast<int>(res.primary));
+  } else {
+    log::debug("Job for Steam Workshop item {} finished in {} ms, {} bytes "
+               "downloaded",
+               id, total_ms, timing.download_bytes);
+  }
+  if (on_finish) {
+    on_finish(desc, res);
+  }
+}
+
+/// Store the result of an install request and mark it as resolved.
+///
+/// @param [in] req
+///    The install request.
+/// @param [in] desc
+///    Pointer to the descriptor of the item, or `nullptr` if its job couldn't
+///    be created.
+static void resolve_install(const install_req &req,
+                            tek_sc_am_item_desc *_Nullable desc) {
+  std::atomic_ref{*req.item_desc}.store(desc, std::memory_order::release);
+  const std::scoped_lock lock{pending_installs_mtx};
+  unresolved_installs.erase(req.id);
+}
+
+/// Create application manager job for an install request, unless the item
+///    already has one, and resolve the request.
+///
+/// @param [in] req
+///    The install request.
+/// @return Pointer to the descriptor of the item which job should be run, or
+///    `nullptr` if there is nothing to run.
+static tek_sc_am_item_desc *_Nullable create_item_job(const install_req &req) {
+  const auto id{item_id(req.id)};
+  auto desc{am.get_item_desc(&id)};
+  if (!desc || !(desc->status & TEK_SC_AM_ITEM_STATUS_job)) {
+    auto const res{am.create_job(&id, &desc)};
+    if (!tek_sc_err_success(&res)) {
+      if (res.primary == TEK_SC_ERRC_up_to_date) {
+        resolve_install(req, desc);
+        if (req.on_finish) {
+          req.on_finish(desc, res);
+        }
+      } else {
+        log::error("Failed to create a job for Steam Workshop item {}, error "
+                   "code {}",
+                   req.id, static_cast<int>(res.primary));
+        resolve_install(req, nullptr);
+      }
+      return nullptr;
+    }
+  }
+  resolve_install(req, desc);
+  return desc;
+}
+
+/// Open the cross-process lock of a Steam Workshop item, without acquiring
+///    it.
+///
+/// @param id
+///    ID of the Steam Workshop item.
+/// @return Handle for the lock.
+static item_lock open_item_lock(std::uint64_t id) {
+#ifdef _WIN32
+  return CreateMutexW(
+      nullptr, FALSE,
+      std::format(L"tek-game-runtime-ws-{}-{}", app_id, id).data());
+#else  // def _WIN32
+  return open((std::filesystem::temp_directory_path() /
+               std::format("tek-game-runtime-ws-{}-{}.lock", app_id, id))
+                  .c_str(),
+              O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+#endif // def _WIN32 else
+}
+
+/// Try to acquire the cross-process lock of a Steam Workshop item.
+///
+/// @param lock
+///    Handle for the lock.
+/// @return Value indicating whether the lock has been acquired or doesn't
+///    exist, `false` if it's held by another process.
+static bool try_acquire(item_lock lock) {
+#ifdef _WIN32
+  // WAIT_ABANDONED grants ownership as well, the job will then resume or
+  //    verify whatever the other process has left
+  return !lock || WaitForSingleObject(lock, 0) != WAIT_TIMEOUT;
+#else  // def _WIN32
+  // Locks of terminated processes are released by the kernel, with the same
+  //    outcome as above
+  return lock < 0 || flock(lock, LOCK_EX | LOCK_NB) == 0;
+#endif // def _WIN32 else
+}
+
+/// Release the cross-process lock of a Steam Workshop item and close its
+///    handle.
+///
+/// @param lock
+///    Handle for the lock.
+static void release(item_lock lock) {
+#ifdef _WIN32
+  if (lock) {
+    ReleaseMutex(lock);
+    CloseHandle(lock);
+  }
+#else  // def _WIN32
+  if (lock >= 0) {
+    // Closing the descriptor releases the lock
+    close(lock);
+  }
+#endif // def _WIN32 else
+}
+
+/// Install a Steam Workshop item located in a directory shared with other
+///    processes. A cross-process lock serializes work on the item, so if
+///    another process is installing the same item, this one waits for it to
+///    finish and then finds the item up to date. The lock is polled by delayed
+///    jobs, so waiting doesn't occupy a worker of the pool.
+///
+/// @param [in] req
+///    The install request.
+/// @param lock
+///    Handle for the cross-process lock of the item. It's released once the
+///    item is installed.
+static void install_shared(const install_req &req, item_lock lock) {
+  if (!try_acquire(lock)) {
+    install_pool().submit_after(lock_poll_interval, [req, lock] {
+      install_shared(req, lock);
+    });
+    return;
+  }
+  const auto desc{create_item_job(req)};
+  if (desc) {
+    run_item_job(desc, req.on_finish);
+  }
+  release(lock);
+}
+
+/// Create and start jobs for all install requests gathered during
+///    @ref install_window.
+///
+/// @param [in] am_dir
+///    Path to the game root directory to initialize application manager
+///    instance with, as a null-terminated string.
+/// @param [in] ws_dir
+///    Path to the base directory for Steam Workshop items, as a null-terminated
+///    string.
+static void process_installs(const tek_sc_os_char *_Nonnull am_dir,
+                             const tek_sc_os_char *_Nonnull ws_dir) {
+  std::vector<install_req> reqs;
+  {
+    const std::scoped_lock lock{pending_installs_mtx};
+    reqs.swap(pending_installs);
+  }
+  install_batches.add();
+  install_items.add(reqs.size());
+  if (!am.init(am_dir, ws_dir)) {
+    // Resolve requests anyway, so the caller doesn't wait for them forever
+    for (const auto &req : reqs) {
+      resolve_install(req, nullptr);
+    }
+    return;
+  }
+  for (const auto &req : reqs) {
+    if (shared_dir) {
+      // Shared items are installed by separate jobs, so waiting for another
+      //    process holds back only one item
+      install_pool().submit(
+          [req] { install_shared(req, open_item_lock(req.id)); });
+      continue;
+    }
+    const auto desc{create_item_job(req)};
+    if (desc) {
+      // Downloads are started as soon as their jobs are created, without
+      //    waiting for the rest of the batch
+      install_pool().submit([desc, on_finish = req.on_finish] {
+        run_item_job(desc, on_finish);
+      });
+    }
+  }
+}
+
+/// Check a batch of Steam Workshop items for updates and start jobs for
+///    outdated ones, then schedule the next batch.
+///
+/// @param ctx
+///    Update check context.
+/// @param offset
+///    Index of the first item of the batch in `ctx->ids`.
+static void check_batch(std::shared_ptr<const update_ctx> ctx,
+                        std::size_t offset) {
+  const auto end{std::min(offset + upd_batch_size, ctx->ids.size())};
+  for (const auto id : std::span{ctx->ids}.subspan(offset, end - offset)) {
+    const auto full_id{item_id(id)};
+    auto desc{am.get_item_desc(&full_id)};
+    if (desc && desc->status & TEK_SC_AM_ITEM_STATUS_job) {
+      // The item already has a job, possibly started by the game
+      continue;
+    }
+    // Ask before creating the job, as a created job can't be left unrun
+    if (!ctx->on_check(id)) {
+      continue;
+    }
+    // Job creation fetches latest manifest ID of the item, and fails with
+    //    TEK_SC_ERRC_up_to_date if it matches the installed one
+    const auto res{am.create_job(&full_id, &desc)};
+    const bool created{tek_sc_err_success(&res)};
+    if (!ctx->on_update(id, created ? desc : nullptr) || !created) {
+      continue;
+    }
+    update_pool().submit(
+        [desc, on_finish = ctx->on_finish] { run_item_job(desc, on_finish); },
+        jobs::priority::low);
+  }
+  if (end < ctx->ids.size()) {
+    update_pool().submit(
+        [ctx = std::move(ctx), end] { check_batch(ctx, end); },
+        jobs::priority::low);
+  }
+}
+
+//===-- Internal functions ------------------------------------------------===//
+
+void init(const backend &am, std::uint32_t app_id) {
+  ws_jobs::am = am;
+  ws_jobs::app_id = app_id;
+}
+
+void install(const tek_sc_os_char *am_dir, const tek_sc_os_char *ws_dir,
+             std::uint64_t id, finish_func *on_finish,
+             tek_sc_am_item_desc **item_desc) {
+  bool first;
+  {
+    const std::scoped_lock lock{pending_installs_mtx};
+    first = pending_installs.empty();
+    pending_installs.emplace_back(id, on_finish, item_desc);
+    unresolved_installs.emplace(id);
+  }
+  // The first request of a window schedules processing of the whole batch
+  if (first) {
+    install_pool().submit_after(
+        install_window, [am_dir, ws_dir] { process_installs(am_dir, ws_dir); },
+        jobs::priority::high);
+  }
+}
+
+bool install_pending(std::uint64_t id) {
+  const std::scoped_lock lock{pending_installs_mtx};
+  return unresolved_installs.contains(id);
+}
+
+void update(const tek_sc_os_char *am_dir, const tek_sc_os_char *ws_dir,
+            std::vector<std::uint64_t> ids,
+            finish_func *on_finish, update_check_func *on_check,
+            update_func *on_update) {
+  if (ids.empty()) {
+    return;
+  }
+  auto ctx{std::make_shared<const update_ctx>(std::move(ids), on_finish,
+                                              on_check, on_update)};
+  update_pool().submit(
+      [am_dir, ws_dir, ctx = std::move(ctx)] {
+        if (am.init(am_dir, ws_dir)) {
+          check_batch(ctx, 0);
+        }
+      },
+      jobs::priority::low);
+}
+
+} // namespace tek::game_runtime::ws_jobs
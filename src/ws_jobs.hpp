@@ -0,0 +1,195 @@
+//===-- ws_jobs.hpp - Steam Workshop item job scheduling ------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Declarations for scheduling of tek-steamclient application manager jobs for
+///    Steam Workshop items: installations requested by the game, background
+///    update checks, and installation into directories shared by several
+///    processes. The application manager is accessed only via @ref backend
+///    functions, so scheduling doesn't depend on how the library is loaded.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include "common.hpp" // IWYU pragma: keep
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <tek-steamclient/am.h>
+#include <tek-steamclient/error.h>
+#include <tek-steamclient/os.h>
+#include <vector>
+
+namespace tek::game_runtime::ws_jobs {
+
+//===-- Types -------------------------------------------------------------===//
+
+/// Functions accessing the application manager. They are called from Steam
+///    Workshop pool threads.
+struct backend {
+  /// Create application manager instance if it hasn't been created yet.
+  ///
+  /// @param [in] am_dir
+  ///    Path to the game root directory to initialize application manager
+  ///    instance with, as a null-terminated string.
+  /// @param [in] ws_dir
+  ///    Path to the base directory for Steam Workshop items, as a
+  ///    null-terminated string.
+  /// @return Value indicating whether application manager instance is
+  ///    available.
+  bool (*_Nonnull init)(const tek_sc_os_char *_Nonnull am_dir,
+                        const tek_sc_os_char *_Nonnull ws_dir);
+  /// Get descriptor of an item, see `tek_sc_am_get_item_desc`.
+  tek_sc_am_item_desc *_Nullable (*_Nonnull get_item_desc)(
+      const tek_sc_item_id *_Nonnull item_id);
+  /// Create a job for an item, see `tek_sc_am_create_job`.
+  tek_sc_err (*_Nonnull create_job)(
+      const tek_sc_item_id *_Nonnull item_id,
+      tek_sc_am_item_desc *_Nullable *_Nonnull item_desc);
+  /// Run a job, see `tek_sc_am_run_job`.
+  tek_sc_err (*_Nonnull run_job)(tek_sc_am_item_desc *_Nonnull desc,
+                                 tek_sc_am_job_upd_func *_Nonnull upd_handler);
+};
+
+/// The callback that is called before creating a background update job for a
+///    Steam Workshop item.
+///
+/// @param id
+///    ID of the item.
+/// @return Value indicating whether the job should be created.
+using update_check_func = bool(std::uint64_t id);
+
+/// The callback that is called after an attempt to create a background update
+///    job for a Steam Workshop item that @ref update_check_func has allowed.
+///
+/// @param id
+///    ID of the item.
+/// @param [in] desc
+///    Pointer to the descriptor of the item with the job created, or `nullptr`
+///    if the job hasn't been created, e.g. because the item is up to date.
+/// @return Value indicating whether the job should be started. If it's not,
+///    the caller must ensure that the job is run by other means, e.g. by an
+///    installation that the game has requested in the meantime.
+using update_func = bool(std::uint64_t id,
+                         tek_sc_am_item_desc *_Nullable desc);
+
+/// The callback that is called when a Steam Workshop item is done with, either
+///    because its job has finished or because it's already up to date. It's
+///    called from a Steam Workshop pool thread.
+///
+/// @param [in, out] desc
+///    Descriptor of the item.
+/// @param [in] result
+///    Result of the job, or the `TEK_SC_ERRC_up_to_date` error if no job has
+///    been needed.
+using finish_func = void(tek_sc_am_item_desc *_Nonnull desc,
+                         const tek_sc_err &result);
+
+//===-- Constants ---------------------------------------------------------===//
+
+/// Number of Steam Workshop items checked for updates by a single job.
+constexpr std::size_t upd_batch_size{16};
+/// Period of time during which Steam Workshop item install requests are
+///    gathered before jobs for them are created. The game requests all
+///    missing mods of a server within a few milliseconds.
+constexpr std::chrono::milliseconds install_window{50};
+/// Interval between attempts to acquire the cross-process lock of a Steam
+///    Workshop item that another process is installing into the shared
+///    directory.
+constexpr std::chrono::milliseconds lock_poll_interval{250};
+
+//===-- Variables ---------------------------------------------------------===//
+
+/// Value indicating whether the Steam Workshop directory may be shared with
+///    other processes, in which case items are installed under a
+///    cross-process lock for each item.
+inline bool shared_dir;
+
+//===-- Functions ---------------------------------------------------------===//
+
+/// Set the application manager backend. Must be called before any other
+///    function.
+///
+/// @param [in] am
+///    Functions accessing the application manager.
+/// @param app_id
+///    ID of the application that Steam Workshop items belong to.
+[[gnu::visibility("internal")]]
+void init(const backend &am, std::uint32_t app_id);
+
+/// Begin installation of specified Steam Workshop item via application manager
+///    interface. Requests made within @ref install_window are gathered, and
+///    jobs for them are created in background by a single job, so bursts of
+///    requests don't block the caller on per-item lookups.
+///
+/// @param [in] am_dir
+///    Path to the game root directory to initialize application manager
+///    instance with, as a null-terminated string.
+/// @param [in] ws_dir
+///    Path to the base directory for Steam Workshop items, as a null-terminated
+///    string.
+/// @param id
+///    ID of the Steam Workshop item to install.
+/// @param on_finish
+///    Optional pointer to the function that is called when the item is done
+///    with.
+/// @param [out] item_desc
+///    Address of variable that receives pointer to the @ref tek_sc_am_item_desc
+///    for the item once its job is created. It's written atomically from a
+///    Steam Workshop pool thread, and set to `nullptr` if the job cannot be
+///    created. Must stay valid until then.
+[[gnu::visibility("internal")]]
+void install(const tek_sc_os_char *_Nonnull am_dir,
+             const tek_sc_os_char *_Nonnull ws_dir, std::uint64_t id,
+             finish_func *_Nullable on_finish,
+             tek_sc_am_item_desc *_Nullable *_Nonnull item_desc);
+
+/// Check whether the job for specified Steam Workshop item, requested via
+///    @ref install, is yet to be created. Once this returns `false`, the item
+///    descriptor variable holds its final value.
+///
+/// @param id
+///    ID of the Steam Workshop item.
+/// @return Value indicating whether the request is still pending.
+[[gnu::visibility("internal")]]
+bool install_pending(std::uint64_t id);
+
+/// Check specified installed Steam Workshop items for updates in background,
+///    and start low-priority jobs that install the outdated ones. Items are
+///    checked in batches, each batch being a separate job. Checks and update
+///    jobs run on a pool separate from the one that runs installations
+///    requested by the game, so those are not held back by updates.
+///
+/// @param [in] am_dir
+///    Path to the game root directory to initialize application manager
+///    instance with, as a null-terminated string. Must stay valid until all
+///    checks are done.
+/// @param [in] ws_dir
+///    Path to the base directory for Steam Workshop items, as a null-terminated
+///    string. Must stay valid until all checks are done.
+/// @param ids
+///    IDs of the items to check.
+/// @param on_finish
+///    Optional pointer to the function that is called when each started job
+///    finishes.
+/// @param on_check
+///    Pointer to the function that is called before creating each update job.
+/// @param on_update
+///    Pointer to the function that is called after creating each update job.
+[[gnu::visibility("internal")]]
+void update(const tek_sc_os_char *_Nonnull am_dir,
+            const tek_sc_os_char *_Nonnull ws_dir,
+            std::vector<std::uint64_t> ids,
+            finish_func *_Nullable on_finish,
+            update_check_func *_Nonnull on_check,
+            update_func *_Nonnull on_update);
+
+} // namespace tek::game_runtime::ws_jobs
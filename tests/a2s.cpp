@@ -0,0 +1,416 @@
+//===-- a2s.cpp - tests for the A2S client --------------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests and benchmark of the A2S client against a stand-in server that
+///    simulates thousands of game servers on 127.1.0.0/16 loopback addresses
+///    with a single UDP socket. Simulated servers differ in whether they
+///    require a challenge, split their rules responses, or don't respond at
+///    all.
+///
+//===----------------------------------------------------------------------===//
+#include "a2s.hpp"
+
+#include "test.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tek::game_runtime;
+
+namespace {
+
+/// Challenge number that simulated servers issue.
+constexpr std::int32_t challenge{0x12345678};
+
+/// Get the IPv4 address of a simulated server.
+constexpr std::uint32_t server_ip(int idx) {
+  return 0x7F010000 | static_cast<std::uint32_t>(idx + 1);
+}
+/// Get the index of a simulated server from its IPv4 address.
+constexpr int server_idx(std::uint32_t ip) {
+  return static_cast<int>(ip & 0xFFFF) - 1;
+}
+/// Check whether a simulated server never responds.
+constexpr bool is_silent(int idx, bool bench) {
+  return !bench && idx % 10 == 9;
+}
+/// Check whether a simulated server requires a challenge.
+constexpr bool needs_challenge(int idx) { return idx % 4 == 1; }
+/// Check whether a simulated server splits its rules response.
+constexpr bool splits_rules(int idx) { return idx % 5 == 2; }
+/// Get the number of players reported by a simulated server.
+constexpr int num_players(int idx) { return idx % 70; }
+
+/// Append a little-endian integer to a message.
+template <typename T> void put(std::string &msg, T value) {
+  for (std::size_t i{}; i < sizeof(T); ++i) {
+    msg.push_back(static_cast<char>(static_cast<std::uint64_t>(value) >>
+                                    (i * 8)));
+  }
+}
+/// Append a null-terminated string to a message.
+void put_str(std::string &msg, std::string_view str) {
+  msg.append(str);
+  msg.push_back('\0');
+}
+
+/// Stand-in server simulating many game servers. It receives requests
+///    addressed to any 127.1.x.y address and replies from the same address,
+///    using `IP_PKTINFO`.
+class stand_in_server {
+  /// The socket.
+  int sock;
+  /// Thread serving requests.
+  std::thread thread;
+  /// Value indicating whether the server should stop.
+  std::atomic_bool stopping;
+  /// Value indicating whether the server is run for a benchmark.
+  bool bench;
+
+  /// Send a reply from specified local address.
+  void reply(const sockaddr_in &to, in_addr from, std::string_view msg) {
+    iovec iov{.iov_base = const_cast<char *>(msg.data()),
+              .iov_len = msg.size()};
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(in_pktinfo))> ctl{};
+    msghdr hdr{};
+    hdr.msg_name = const_cast<sockaddr_in *>(&to);
+    hdr.msg_namelen = sizeof to;
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = ctl.data();
+    hdr.msg_controllen = ctl.size();
+    const auto cmsg{CMSG_FIRSTHDR(&hdr)};
+    cmsg->cmsg_level = IPPROTO_IP;
+    cmsg->cmsg_type = IP_PKTINFO;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+    in_pktinfo info{};
+    info.ipi_spec_dst = from;
+    std::memcpy(CMSG_DATA(cmsg), &info, sizeof info);
+    sendmsg(sock, &hdr, 0);
+  }
+
+  /// Build the A2S_INFO response of a simulated server.
+  static std::string info_response(int idx) {
+    std::string msg{"\xFF\xFF\xFF\xFF\x49\x11", 6};
+    put_str(msg, "Server " + std::to_string(idx));
+    put_str(msg, "TheIsland");
+    put_str(msg, "ark_survival_evolved");
+    put_str(msg, "ARK: Survival Evolved");
+    put<std::uint16_t>(msg, 0);
+    put<std::uint8_t>(msg, num_players(idx));
+    put<std::uint8_t>(msg, 70);
+    put<std::uint8_t>(msg, 0);
+    msg.append("dw", 2);
+    put<std::uint8_t>(msg, idx % 2);
+    put<std::uint8_t>(msg, 1);
+    put_str(msg, "1.0.0.0");
+    put<std::uint8_t>(msg, 0x80 | 0x10 | 0x20 | 0x01);
+    put<std::uint16_t>(msg, 7777);
+    put<std::uint64_t>(msg, 90000000000000000u + idx);
+    put_str(msg, "tag," + std::to_string(idx));
+    put<std::uint64_t>(msg, 346110);
+    return msg;
+  }
+
+  /// Build the A2S_RULES response payload of a simulated server, without the
+  ///    header.
+  static std::string rules_payload(int idx) {
+    std::string msg{"\x45", 1};
+    put<std::uint16_t>(msg, 3);
+    put_str(msg, "idx");
+    put_str(msg, std::to_string(idx));
+    put_str(msg, "SERVERUSESBATTLEYE_b");
+    put_str(msg, idx % 3 ? "false" : "true");
+    put_str(msg, "padding");
+    put_str(msg, std::string(splits_rules(idx) ? 1500 : 100, 'x'));
+    return msg;
+  }
+
+  /// Handle a received request.
+  void handle(const sockaddr_in &from, in_addr to,
+              std::span<const std::uint8_t> req) {
+    const auto idx{server_idx(ntohl(to.s_addr))};
+    if (req.size() < 5 || idx < 0 || is_silent(idx, bench)) {
+      return;
+    }
+    std::int32_t req_challenge{-1};
+    bool has_challenge{};
+    if (req[4] == 0x54 && req.size() >= 29) {
+      std::memcpy(&req_challenge, &req[25], 4);
+      has_challenge = true;
+    } else if (req[4] == 0x56 && req.size() >= 9) {
+      std::memcpy(&req_challenge, &req[5], 4);
+      has_challenge = req_challenge != -1;
+    }
+    if (needs_challenge(idx) &&
+        (!has_challenge || req_challenge != challenge)) {
+      std::string msg{"\xFF\xFF\xFF\xFF\x41", 5};
+      put<std::int32_t>(msg, challenge);
+      reply(from, to, msg);
+      return;
+    }
+    if (req[4] == 0x54) {
+      reply(from, to, info_response(idx));
+      return;
+    }
+    if (req[4] != 0x56) {
+      return;
+    }
+    const auto payload{"\xFF\xFF\xFF\xFF" + rules_payload(idx)};
+    if (!splits_rules(idx)) {
+      reply(from, to, payload);
+      return;
+    }
+    // Send fragments in reverse order to check reassembly
+    const auto half{payload.size() / 2};
+    for (int num{1}; num >= 0; --num) {
+      std::string msg{"\xFE\xFF\xFF\xFF", 4};
+      put<std::uint32_t>(msg, 0x100 + idx);
+      put<std::uint8_t>(msg, 2);
+      put<std::uint8_t>(msg, num);
+      put<std::uint16_t>(msg, 1248);
+      msg.append(num ? payload.substr(half) : payload.substr(0, half));
+      reply(from, to, msg);
+    }
+  }
+
+  /// Server thread procedure.
+  void thread_proc() {
+    std::array<std::uint8_t, 2048> buf;
+    while (!stopping.load(std::memory_order::relaxed)) {
+      pollfd fd{.fd = sock, .events = POLLIN, .revents = 0};
+      if (poll(&fd, 1, 50) <= 0) {
+        continue;
+      }
+      for (;;) {
+        sockaddr_in from;
+        iovec iov{.iov_base = buf.data(), .iov_len = buf.size()};
+        alignas(cmsghdr) std::array<char, 256> ctl;
+        msghdr hdr{};
+        hdr.msg_name = &from;
+        hdr.msg_namelen = sizeof from;
+        hdr.msg_iov = &iov;
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = ctl.data();
+        hdr.msg_controllen = ctl.size();
+        const auto res{recvmsg(sock, &hdr, MSG_DONTWAIT)};
+        if (res < 0) {
+          break;
+        }
+        for (auto cmsg{CMSG_FIRSTHDR(&hdr)}; cmsg;
+             cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+          if (cmsg->cmsg_level == IPPROTO_IP &&
+              cmsg->cmsg_type == IP_PKTINFO) {
+            in_pktinfo info;
+            std::memcpy(&info, CMSG_DATA(cmsg), sizeof info);
+            handle(from, info.ipi_addr,
+                   std::span{buf.data(), static_cast<std::size_t>(res)});
+          }
+        }
+      }
+    }
+  }
+
+public:
+  /// Port that the server listens on, in host byte order.
+  std::uint16_t port;
+
+  stand_in_server(bool bench) : stopping{}, bench{bench} {
+    sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    const int on{1};
+    setsockopt(sock, IPPROTO_IP, IP_PKTINFO, &on, sizeof on);
+    const int buf_size{8 * 1024 * 1024};
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof buf_size);
+    setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof buf_size);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    bind(sock, reinterpret_cast<const sockaddr *>(&addr), sizeof addr);
+    socklen_t len{sizeof addr};
+    getsockname(sock, reinterpret_cast<sockaddr *>(&addr), &len);
+    port = ntohs(addr.sin_port);
+    thread = std::thread{&stand_in_server::thread_proc, this};
+  }
+  ~stand_in_server() {
+    stopping = true;
+    thread.join();
+    close(sock);
+  }
+};
+
+/// Results of queries to a single simulated server.
+struct result {
+  /// Number of delivered A2S_INFO results.
+  int info_count;
+  /// Number of delivered A2S_RULES results.
+  int rules_count;
+  /// Value indicating whether the A2S_INFO query succeeded.
+  bool info_ok;
+  /// Value indicating whether the A2S_RULES query succeeded.
+  bool rules_ok;
+  /// Received server information.
+  a2s::server_info info;
+  /// Received rules.
+  std::vector<a2s::rule> rules;
+};
+
+/// Handler recording results into a @ref result.
+class recorder final : public a2s::rules_handler, public a2s::info_handler {
+  /// The result to record into.
+  result &res;
+  /// Counter of completed queries.
+  int &completed;
+
+public:
+  recorder(result &res, int &completed) : res{res}, completed{completed} {}
+
+  void rules_received(std::span<const a2s::rule> rules) override {
+    ++res.rules_count;
+    res.rules_ok = true;
+    res.rules.assign(rules.begin(), rules.end());
+    ++completed;
+  }
+  void rules_failed() override {
+    ++res.rules_count;
+    ++completed;
+  }
+  void info_received(const a2s::server_info &info) override {
+    ++res.info_count;
+    res.info_ok = true;
+    res.info = info;
+    ++completed;
+  }
+  void info_failed() override {
+    ++res.info_count;
+    ++completed;
+  }
+};
+
+/// Query all simulated servers and wait for results.
+///
+/// @param num_servers
+///    Number of simulated servers.
+/// @param port
+///    Port of the stand-in server.
+/// @param [out] results
+///    Results of queries, indexed by server index.
+/// @return Value indicating whether all queries have completed in time.
+bool query_all(int num_servers, std::uint16_t port,
+               std::vector<result> &results) {
+  results.assign(num_servers, {});
+  int completed{};
+  std::vector<std::unique_ptr<recorder>> recorders;
+  recorders.reserve(num_servers);
+  for (int i{}; i < num_servers; ++i) {
+    auto &rec{*recorders.emplace_back(
+        std::make_unique<recorder>(results[i], completed))};
+    a2s::query_info(server_ip(i), port, rec);
+    a2s::query_rules(server_ip(i), port, rec);
+  }
+  const auto deadline{std::chrono::steady_clock::now() +
+                      std::chrono::seconds{60}};
+  while (completed < num_servers * 2 &&
+         std::chrono::steady_clock::now() < deadline) {
+    a2s::dispatch();
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  }
+  return completed == num_servers * 2;
+}
+
+/// Check results of @ref query_all.
+void check_results(const std::vector<result> &results) {
+  for (int i{}; i < static_cast<int>(results.size()); ++i) {
+    const auto &res{results[i]};
+    CHECK(res.info_count == 1);
+    CHECK(res.rules_count == 1);
+    if (is_silent(i, false)) {
+      CHECK(!res.info_ok);
+      CHECK(!res.rules_ok);
+      continue;
+    }
+    CHECK(res.info_ok);
+    CHECK(res.info.name == "Server " + std::to_string(i));
+    CHECK(res.info.map == "TheIsland");
+    CHECK(res.info.players == num_players(i));
+    CHECK(res.info.max_players == 70);
+    CHECK(res.info.password == (i % 2 != 0));
+    CHECK(res.info.vac);
+    CHECK(res.info.game_port == 7777);
+    CHECK(res.info.steam_id == 90000000000000000u + i);
+    CHECK(res.info.keywords == "tag," + std::to_string(i));
+    CHECK(res.info.game_id == 346110);
+    CHECK(res.info.ping >= 0);
+    CHECK(res.rules_ok);
+    CHECK(res.rules.size() == 3);
+    if (res.rules.size() == 3) {
+      CHECK(res.rules[0].key == "idx");
+      CHECK(res.rules[0].value == std::to_string(i));
+      CHECK(res.rules[2].value.size() == (splits_rules(i) ? 1500u : 100u));
+    }
+  }
+}
+
+/// Handler that must never be called.
+class unreachable final : public a2s::rules_handler {
+public:
+  void rules_received(std::span<const a2s::rule>) override {
+    CHECK(!"cancelled query was dispatched");
+  }
+  void rules_failed() override {
+    CHECK(!"cancelled query was dispatched");
+  }
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const bool bench{test::bench_mode(argc, argv)};
+  stand_in_server server{bench};
+  CHECK(a2s::start());
+  if (bench) {
+    for (const int num_servers : {1000, 4000}) {
+      std::vector<result> results;
+      bool done{};
+      const auto time{test::time_s(
+          [&] { done = query_all(num_servers, server.port, results); })};
+      CHECK(done);
+      test::report("a2s " + std::to_string(num_servers) +
+                       " servers, info+rules",
+                   num_servers * 2 / time, "queries/s");
+    }
+  } else {
+    // Cancelled queries must not be delivered
+    unreachable never;
+    const auto cancelled{a2s::query_rules(server_ip(0), server.port, never)};
+    CHECK(cancelled >= a2s::query_base);
+    CHECK(a2s::cancel(cancelled) == &never);
+    CHECK(a2s::cancel(cancelled) == nullptr);
+    std::vector<result> results;
+    CHECK(query_all(2000, server.port, results));
+    check_results(results);
+  }
+  a2s::stop();
+  return test::result();
+}
@@ -0,0 +1,161 @@
+//===-- file_watcher.cpp - tests for the file watcher ---------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of the file watcher's inotify backend: in-place writes, bursts,
+///    editor-style replacement by rename, changes to other files in the same
+///    directory, @ref file_watcher::ignore_current and stopping. The benchmark
+///    measures latency from a write to the callback beyond the debounce delay.
+///
+//===----------------------------------------------------------------------===//
+#include "file_watcher.hpp"
+
+#include "test.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace tek::game_runtime;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Callback invocation counter that can be waited on.
+class counter {
+  std::mutex mtx;
+  std::condition_variable cv;
+  int value{};
+  std::chrono::steady_clock::time_point last_time;
+
+public:
+  /// Record a callback invocation.
+  void increment() {
+    {
+      const std::scoped_lock lock{mtx};
+      ++value;
+      last_time = std::chrono::steady_clock::now();
+    }
+    cv.notify_all();
+  }
+  /// Wait until the value reaches specified one or a timeout expires.
+  ///
+  /// @param expected
+  ///    The value to wait for.
+  /// @param timeout
+  ///    Maximum time to wait.
+  /// @return Current value.
+  int wait_for(int expected, std::chrono::milliseconds timeout) {
+    std::unique_lock lock{mtx};
+    cv.wait_for(lock, timeout, [&] { return value >= expected; });
+    return value;
+  }
+  /// Get the time of the last invocation.
+  std::chrono::steady_clock::time_point time() {
+    const std::scoped_lock lock{mtx};
+    return last_time;
+  }
+};
+
+/// Time to wait for a callback that is expected to happen.
+constexpr auto expect_timeout{file_watcher::debounce_delay * 8};
+/// Time to wait to be sure that a callback doesn't happen.
+constexpr auto quiet_timeout{file_watcher::debounce_delay * 3};
+
+/// Write specified content to a file, truncating it.
+void write_file(const fs::path &path, const std::string &content) {
+  std::ofstream{path, std::ios::binary | std::ios::trunc} << content;
+}
+
+/// Run all checks against a watcher of a file in specified directory.
+void test_watcher(const fs::path &dir) {
+  const auto path{dir / "settings.json"};
+  write_file(path, "{}");
+  counter changes;
+  file_watcher watcher{path, [&changes] { changes.increment(); }};
+  CHECK(watcher.start());
+  CHECK(watcher.start());
+  // Nothing happens until the file changes
+  CHECK(changes.wait_for(1, quiet_timeout) == 0);
+  // An in-place write
+  write_file(path, R"({"a":1})");
+  CHECK(changes.wait_for(1, expect_timeout) == 1);
+  // A burst of writes is coalesced
+  for (int i{}; i < 10; ++i) {
+    write_file(path, std::string(10 + i, 'x'));
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+  CHECK(changes.wait_for(2, expect_timeout) == 2);
+  CHECK(changes.wait_for(3, quiet_timeout) == 2);
+  // Replacement by rename, as editors do it
+  write_file(dir / "settings.json.tmp", R"({"replaced":true})");
+  fs::rename(dir / "settings.json.tmp", path);
+  CHECK(changes.wait_for(3, expect_timeout) == 3);
+  // Other files in the directory are ignored
+  write_file(dir / "other.txt", "other");
+  CHECK(changes.wait_for(4, quiet_timeout) == 3);
+  // Changes made by the caller itself
+  write_file(path, R"({"own":"change"})");
+  watcher.ignore_current();
+  CHECK(changes.wait_for(4, quiet_timeout) == 3);
+  // No callbacks after stop
+  watcher.stop();
+  watcher.stop();
+  write_file(path, R"({"after":"stop"})");
+  CHECK(changes.wait_for(4, quiet_timeout) == 3);
+  // Restarting picks up new changes only
+  CHECK(watcher.start());
+  CHECK(changes.wait_for(4, quiet_timeout) == 3);
+  write_file(path, "{}");
+  CHECK(changes.wait_for(4, expect_timeout) == 4);
+}
+
+/// Measure the time from a write to the callback, excluding the debounce
+///    delay.
+void bench_latency(const fs::path &dir) {
+  const auto path{dir / "settings.json"};
+  write_file(path, "{}");
+  counter changes;
+  file_watcher watcher{path, [&changes] { changes.increment(); }};
+  watcher.start();
+  constexpr int num_iters{10};
+  double total{};
+  for (int i{}; i < num_iters; ++i) {
+    const auto start{std::chrono::steady_clock::now()};
+    write_file(path, std::string(i + 3, 'x'));
+    changes.wait_for(i + 1, expect_timeout);
+    total += std::chrono::duration<double, std::milli>(
+                 changes.time() - start - file_watcher::debounce_delay)
+                 .count();
+  }
+  test::report("file_watcher write to callback beyond debounce",
+               total / num_iters, "ms");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto dir{fs::temp_directory_path() /
+                 ("tek-gr-watcher-test-" + std::to_string(getpid()))};
+  fs::create_directories(dir);
+  if (test::bench_mode(argc, argv)) {
+    bench_latency(dir);
+  } else {
+    test_watcher(dir);
+  }
+  fs::remove_all(dir);
+  return test::result();
+}
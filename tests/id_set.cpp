@@ -0,0 +1,217 @@
+//===-- id_set.cpp - tests for immutable app ID sets ----------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of layout selection and lookups of app ID sets, and a benchmark of
+///    DLC lookup variants: the locked scan of settings that DLC wrappers used
+///    before, generic lookup that dispatches on layout, and lookup
+///    specialized for the layout, on DLC lists of each shape. Lookups are
+///    made via function pointers, like the game calls wrappers via vtables.
+///
+//===----------------------------------------------------------------------===//
+#include "id_set.hpp"
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace tek::game_runtime;
+
+namespace {
+
+/// Generate app IDs.
+///
+/// @param count
+///    Number of IDs to generate.
+/// @param base
+///    The lowest ID.
+/// @param stride
+///    Difference between consecutive IDs.
+/// @return The generated IDs.
+std::vector<std::uint32_t> make_ids(std::size_t count, std::uint32_t base,
+                                    std::uint32_t stride) {
+  std::vector<std::uint32_t> ids;
+  for (std::size_t i{}; i < count; ++i) {
+    ids.push_back(base + static_cast<std::uint32_t>(i) * stride);
+  }
+  return ids;
+}
+
+/// Check that a set has expected layout and answers like a linear search,
+///    for members, neighbours of members and IDs around the range.
+///
+/// @param ids
+///    IDs to build the set from.
+/// @param kind
+///    Expected layout of the set.
+void check_set(const std::vector<std::uint32_t> &ids, id_set_kind kind) {
+  const id_set set{ids};
+  CHECK(set.kind == kind);
+  std::vector<std::uint32_t> probes{0, 1, UINT32_MAX};
+  for (const auto id : ids) {
+    probes.insert(probes.end(), {id - 1, id, id + 1});
+  }
+  for (const auto id : probes) {
+    const bool expected{std::ranges::contains(ids, id)};
+    CHECK(set.contains(id) == expected);
+    switch (kind) {
+    case id_set_kind::empty:
+      CHECK(set.contains<id_set_kind::empty>(id) == expected);
+      break;
+    case id_set_kind::linear:
+      CHECK(set.contains<id_set_kind::linear>(id) == expected);
+      break;
+    case id_set_kind::bitmap:
+      CHECK(set.contains<id_set_kind::bitmap>(id) == expected);
+      break;
+    case id_set_kind::hashed:
+      CHECK(set.contains<id_set_kind::hashed>(id) == expected);
+      break;
+    }
+  }
+}
+
+/// Check layout selection and lookups for sets of each shape.
+void test_layouts() {
+  check_set({}, id_set_kind::empty);
+  check_set({480}, id_set_kind::linear);
+  // Sizes that aren't multiples of 4 are padded with the first ID
+  check_set(make_ids(7, 512000, 10), id_set_kind::linear);
+  check_set(make_ids(max_linear_ids, 512000, 1000), id_set_kind::linear);
+  check_set(make_ids(max_linear_ids + 1, 512000, 3), id_set_kind::bitmap);
+  check_set(make_ids(500, 100, 1), id_set_kind::bitmap);
+  // The widest possible bitmap, and one bit more
+  check_set({10, 10 + max_bitmap_bits / 2, 10 + max_bitmap_bits - 1, 20, 30,
+             40, 50, 60, 70, 80, 90, 100, 110, 120, 130, 140, 150},
+            id_set_kind::bitmap);
+  check_set(make_ids(max_linear_ids + 1, 10, max_bitmap_bits / max_linear_ids),
+            id_set_kind::hashed);
+  check_set(make_ids(500, 1000, 997), id_set_kind::hashed);
+  // Duplicates are removed before the layout is chosen
+  std::vector<std::uint32_t> dups(100, 346110);
+  dups.push_back(346111);
+  check_set(dups, id_set_kind::linear);
+}
+
+//===-- Benchmark ---------------------------------------------------------===//
+
+/// DLC list in the shape of settings, with names.
+std::vector<std::pair<std::uint32_t, std::string>> settings_dlc;
+/// Mutex guarding @ref settings_dlc, like the settings DLC mutex.
+std::shared_mutex settings_dlc_mtx;
+
+/// Lookup function, called via pointer like a vtable entry.
+using lookup_func = bool(const id_set &set, std::uint32_t id);
+
+/// Lookup that DLC wrappers used before the DLC index, scanning the list in
+///    settings under a shared lock.
+[[gnu::noinline]] bool lookup_settings(const id_set &, std::uint32_t id) {
+  const std::shared_lock lock{settings_dlc_mtx};
+  return std::ranges::contains(settings_dlc | std::views::elements<0>, id);
+}
+
+/// Generic lookup, dispatching on layout on each call.
+[[gnu::noinline]] bool lookup_generic(const id_set &set, std::uint32_t id) {
+  return set.contains(id);
+}
+
+/// Lookup specialized for a layout, with the same layout check that
+///    wrappers make against index replacement.
+template <id_set_kind layout>
+[[gnu::noinline]] bool lookup_specialized(const id_set &set,
+                                          std::uint32_t id) {
+  return set.kind == layout ? set.contains<layout>(id) : set.contains(id);
+}
+
+/// Measure average time of a lookup function on a set.
+///
+/// @param name
+///    Name of the measured case.
+/// @param fn
+///    The lookup function.
+/// @param set
+///    The set to look IDs up in.
+/// @param probes
+///    IDs to look up, half of them present in the set.
+void measure(const char *name, lookup_func *fn, const id_set &set,
+             const std::vector<std::uint32_t> &probes) {
+  // Prevent the compiler from resolving the pointer at compile time
+  lookup_func *volatile fn_ptr{fn};
+  constexpr int num_rounds{20};
+  std::size_t found{};
+  const auto time{test::time_s([&] {
+    for (int i{}; i < num_rounds; ++i) {
+      for (const auto id : probes) {
+        found += fn_ptr(set, id);
+      }
+    }
+  })};
+  test::report(name, time / (num_rounds * probes.size()) * 1e9, "ns/lookup");
+  CHECK(found > 0 || set.kind == id_set_kind::empty);
+}
+
+/// Run all lookup variants on a DLC list of one shape.
+///
+/// @param shape
+///    Name of the shape.
+/// @param ids
+///    IDs in the DLC list.
+/// @param specialized
+///    Lookup variant specialized for the layout of the list.
+void bench_shape(const std::string &shape,
+                 const std::vector<std::uint32_t> &ids,
+                 lookup_func *specialized) {
+  settings_dlc.clear();
+  for (const auto id : ids) {
+    settings_dlc.emplace_back(id, "DLC " + std::to_string(id));
+  }
+  const id_set set{ids};
+  // Mix of members and IDs that aren't, in random order
+  std::vector<std::uint32_t> probes;
+  std::mt19937 rng{42};
+  for (int i{}; i < 4096; ++i) {
+    probes.push_back(ids.empty() || i % 2
+                         ? static_cast<std::uint32_t>(rng())
+                         : ids[rng() % ids.size()]);
+  }
+  measure((shape + ", locked scan").data(), lookup_settings, set, probes);
+  measure((shape + ", generic").data(), lookup_generic, set, probes);
+  measure((shape + ", specialized").data(), specialized, set, probes);
+}
+
+/// Compare lookup variants on DLC lists of each shape.
+void bench() {
+  bench_shape("no DLC", {}, lookup_specialized<id_set_kind::empty>);
+  bench_shape("12 DLC, linear", make_ids(12, 512000, 17),
+              lookup_specialized<id_set_kind::linear>);
+  bench_shape("1000 DLC, bitmap", make_ids(1000, 100000, 3),
+              lookup_specialized<id_set_kind::bitmap>);
+  bench_shape("1000 DLC, hashed", make_ids(1000, 100000, 997),
+              lookup_specialized<id_set_kind::hashed>);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (test::bench_mode(argc, argv)) {
+    bench();
+  } else {
+    test_layouts();
+  }
+  return test::result();
+}
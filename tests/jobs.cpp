@@ -0,0 +1,269 @@
+//===-- jobs.cpp - tests for the background job system --------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of job pool results, priorities, continuations, cancellation,
+///    failed jobs and work stealing, and a benchmark of job throughput compared to a thread
+///    per job.
+///
+//===----------------------------------------------------------------------===//
+#include "jobs.hpp"
+
+#include "test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <latch>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tek::game_runtime;
+
+namespace {
+
+/// Check that results and continuations are delivered.
+void test_results() {
+  jobs::pool pool{"test", 2};
+  auto fut{pool.submit([] { return 20; })};
+  auto next{fut.then([](int &value) { return std::to_string(value + 1); })};
+  std::atomic_int side{};
+  auto last{next.then([&side](std::string &str) { side = str.size(); })};
+  CHECK(fut.get() == 20);
+  CHECK(next.get() == "21");
+  last.wait();
+  CHECK(side == 2);
+  CHECK(!last.cancelled());
+  // A continuation of a finished job is scheduled immediately
+  CHECK(fut.then([](int &value) { return value * 2; }).get() == 40);
+}
+
+/// Check that queued jobs are taken in priority order.
+void test_priorities() {
+  jobs::pool pool{"test", 1};
+  std::latch blocked{1};
+  std::latch release{1};
+  pool.submit([&] {
+    blocked.count_down();
+    release.wait();
+  });
+  blocked.wait();
+  std::mutex mtx;
+  std::vector<int> order;
+  const auto record{[&](int value) {
+    return [&, value] {
+      const std::scoped_lock lock{mtx};
+      order.push_back(value);
+    };
+  }};
+  auto last{pool.submit(record(2), jobs::priority::low)};
+  pool.submit(record(1), jobs::priority::normal);
+  pool.submit(record(0), jobs::priority::high);
+  CHECK(pool.stats().queued == 3);
+  release.count_down();
+  CHECK(!last.cancelled());
+  CHECK((order == std::vector{0, 1, 2}));
+}
+
+/// Check cancellation of queued jobs, their continuations and jobs left in
+///    queues when the pool stops.
+void test_cancellation() {
+  jobs::pool pool{"test", 1};
+  std::latch blocked{1};
+  std::latch release{1};
+  std::atomic_bool saw_cancel{};
+  auto running{pool.submit([&] {
+    blocked.count_down();
+    release.wait();
+    saw_cancel = jobs::this_job_cancelled();
+  })};
+  blocked.wait();
+  std::atomic_int executed{};
+  auto queued{pool.submit([&] { ++executed; })};
+  auto cont{queued.then([&] { ++executed; })};
+  queued.cancel();
+  running.cancel();
+  release.count_down();
+  CHECK(queued.cancelled());
+  CHECK(cont.cancelled());
+  CHECK(!running.cancelled());
+  CHECK(saw_cancel);
+  CHECK(executed == 0);
+  // Jobs remaining in queues are cancelled on stop
+  std::latch blocked2{1};
+  std::latch release2{1};
+  pool.submit([&] {
+    blocked2.count_down();
+    release2.wait();
+  });
+  blocked2.wait();
+  auto left{pool.submit([&] { ++executed; })};
+  std::thread stopper{[&] { pool.stop(); }};
+  // Submissions to a stopping pool are cancelled right away, which tells
+  //    when the worker may be released
+  while (!pool.submit([] {}).ready()) {
+    std::this_thread::yield();
+  }
+  release2.count_down();
+  stopper.join();
+  CHECK(left.cancelled());
+  CHECK(executed == 0);
+  const auto stats{pool.stats()};
+  CHECK(stats.cancelled >= 3);
+  CHECK(stats.queued == 0);
+  CHECK(stats.completed == 2);
+}
+
+/// Check that exceptions thrown by jobs are contained: the job is marked as
+///    failed, its continuations are cancelled, and the worker keeps running.
+void test_failure() {
+  jobs::pool pool{"test", 1};
+  std::atomic_int executed{};
+  auto throwing{pool.submit([]() -> int {
+    throw std::runtime_error{"test failure"};
+  })};
+  auto cont{throwing.then([&executed](int &) { ++executed; })};
+  auto unknown{pool.submit([] { throw 1; })};
+  CHECK(throwing.failed());
+  CHECK(!throwing.cancelled());
+  CHECK(cont.cancelled());
+  CHECK(!cont.failed());
+  CHECK(unknown.failed());
+  // Continuations added after the failure are cancelled right away
+  CHECK(unknown.then([&executed] { ++executed; }).cancelled());
+  CHECK(pool.submit([] { return 7; }).get() == 7);
+  CHECK(executed == 0);
+  const auto stats{pool.stats()};
+  CHECK(stats.failed == 2);
+  CHECK(stats.completed == 3);
+}
+
+/// Check that jobs submitted from a worker into its local queue get stolen by
+///    idle workers.
+void test_stealing() {
+  jobs::pool pool{"test", 4};
+  constexpr int num_jobs{256};
+  std::atomic_int done{};
+  pool.submit([&] {
+        for (int i{}; i < num_jobs; ++i) {
+          pool.submit([&done] {
+            std::this_thread::sleep_for(std::chrono::microseconds{200});
+            ++done;
+          });
+        }
+      })
+      .wait();
+  while (done < num_jobs) {
+    std::this_thread::yield();
+  }
+  pool.stop();
+  const auto stats{pool.stats()};
+  CHECK(stats.completed == num_jobs + 1);
+  CHECK(stats.stolen > 0);
+  CHECK(stats.max_queued > 0);
+  CHECK(std::ranges::any_of(jobs::all_stats(), [](const auto &entry) {
+    return entry.first == "test";
+  }));
+}
+
+/// Check that delayed jobs are enqueued in time order after their delay
+///    without occupying workers, and are cancelled when the pool stops.
+void test_delayed() {
+  jobs::pool pool{"test", 1};
+  const auto start{std::chrono::steady_clock::now()};
+  std::mutex mtx;
+  std::vector<int> order;
+  const auto record{[&](int value) {
+    return [&, value] {
+      const std::scoped_lock lock{mtx};
+      order.push_back(value);
+    };
+  }};
+  auto late{pool.submit_after(std::chrono::milliseconds{150}, record(2))};
+  auto early{pool.submit_after(std::chrono::milliseconds{50}, record(1))};
+  // The worker stays free while delays run
+  CHECK(pool.submit([] { return 5; }).get() == 5);
+  CHECK(!late.cancelled());
+  CHECK(std::chrono::steady_clock::now() - start >=
+        std::chrono::milliseconds{150});
+  CHECK(!early.cancelled());
+  CHECK((order == std::vector{1, 2}));
+  auto never{pool.submit_after(std::chrono::hours{1}, record(3))};
+  auto never_cont{never.then(record(4))};
+  pool.stop();
+  CHECK(never.cancelled());
+  CHECK(never_cont.cancelled());
+  CHECK(pool.submit_after(std::chrono::milliseconds{1}, [] {}).cancelled());
+  CHECK(order.size() == 2);
+}
+
+/// Measure throughput of short jobs.
+void bench_throughput() {
+  constexpr int num_jobs{200000};
+  for (const unsigned num_threads : {1u, 2u, 4u}) {
+    jobs::pool pool{"bench", num_threads};
+    std::atomic_int done{};
+    const auto time{test::time_s([&] {
+      std::vector<jobs::future<void>> futures;
+      futures.reserve(num_jobs);
+      for (int i{}; i < num_jobs; ++i) {
+        futures.emplace_back(pool.submit([&done] { ++done; }));
+      }
+      for (const auto &fut : futures) {
+        fut.wait();
+      }
+    })};
+    test::report("jobs external submit, " + std::to_string(num_threads) +
+                     " threads",
+                 num_jobs / time, "jobs/s");
+    const auto nested_time{test::time_s([&] {
+      done = 0;
+      pool.submit([&] {
+            for (int i{}; i < num_jobs; ++i) {
+              pool.submit([&done] { ++done; });
+            }
+          })
+          .wait();
+      while (done < num_jobs) {
+        std::this_thread::yield();
+      }
+    })};
+    test::report("jobs nested submit, " + std::to_string(num_threads) +
+                     " threads",
+                 num_jobs / nested_time, "jobs/s");
+  }
+  constexpr int num_threads{20000};
+  std::atomic_int done{};
+  const auto time{test::time_s([&] {
+    for (int i{}; i < num_threads; ++i) {
+      std::thread{[&done] { ++done; }}.join();
+    }
+  })};
+  test::report("thread per job (reference)", num_threads / time, "jobs/s");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (test::bench_mode(argc, argv)) {
+    bench_throughput();
+  } else {
+    test_results();
+    test_priorities();
+    test_cancellation();
+    test_failure();
+    test_stealing();
+    test_delayed();
+  }
+  return test::result();
+}
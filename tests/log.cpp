@@ -0,0 +1,293 @@
+//===-- log.cpp - tests for the runtime log -------------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of level filtering, deferred formatting of captured arguments, and
+///    ordering of records written by several threads. The benchmark measures
+///    the cost of a log call on the writing thread for a disabled level and
+///    an enabled one, compared to formatting and writing the line in place.
+///
+//===----------------------------------------------------------------------===//
+#include "log.hpp"
+
+#include "settings.hpp"
+#include "test.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <latch>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace tek::game_runtime;
+using namespace std::chrono_literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Reader of lines appended to the log file.
+class log_reader {
+  /// Path to the log file.
+  fs::path path;
+  /// Number of bytes already read.
+  std::streamoff offset{};
+  /// Incomplete last line.
+  std::string partial;
+
+public:
+  explicit log_reader(fs::path path) : path{std::move(path)} {}
+
+  /// Read lines appended since the previous call.
+  ///
+  /// @param [out] lines
+  ///    Vector to append complete lines to.
+  void read(std::vector<std::string> &lines) {
+    std::ifstream file{path, std::ios::binary};
+    file.seekg(offset);
+    const std::string data{std::istreambuf_iterator<char>{file}, {}};
+    offset += data.size();
+    for (const auto ch : data) {
+      if (ch == '\n') {
+        lines.emplace_back(std::move(partial));
+        partial.clear();
+      } else {
+        partial.push_back(ch);
+      }
+    }
+  }
+
+  /// Wait until specified number of lines is appended, writing pending
+  ///    records on calling thread in case the write job is slow to start.
+  ///
+  /// @param count
+  ///    Number of lines to wait for.
+  /// @return Lines that have been appended, which are fewer than @p count if
+  ///    waiting has timed out.
+  std::vector<std::string> wait(std::size_t count) {
+    std::vector<std::string> lines;
+    for (int i{}; i < 1000 && lines.size() < count; ++i) {
+      log::flush();
+      read(lines);
+      if (lines.size() < count) {
+        std::this_thread::sleep_for(5ms);
+      }
+    }
+    return lines;
+  }
+};
+
+/// Get the value of a field in a log line.
+///
+/// @param line
+///    The log line.
+/// @param name
+///    Name of the field.
+/// @return Raw value of the field, including quotes for strings, or an empty
+///    view if the field is missing.
+std::string_view field(std::string_view line, std::string_view name) {
+  const auto key{std::format("\"{}\":", name)};
+  auto pos{line.find(key)};
+  if (pos == std::string_view::npos) {
+    return {};
+  }
+  pos += key.size();
+  auto end{pos};
+  if (line[pos] == '"') {
+    for (++end; end < line.size() && line[end] != '"'; ++end) {
+      if (line[end] == '\\') {
+        ++end;
+      }
+    }
+    ++end;
+  } else {
+    end = line.find_first_of(",}", pos);
+  }
+  return line.substr(pos, end - pos);
+}
+
+/// Check that nothing is enabled before the log is opened.
+void test_closed() {
+  CHECK(!log::enabled(log::level::error));
+  // Must not touch the buffers
+  log::error("not written {}", 1);
+  log::flush();
+}
+
+/// Check that records below the configured level are skipped, and that
+///    arguments are captured by value and formatted later.
+void test_levels(log_reader &reader) {
+  CHECK(!log::enabled(log::level::debug));
+  CHECK(log::enabled(log::level::info));
+  CHECK(log::enabled(log::level::error));
+  std::string temp{"temporary"};
+  log::debug("skipped {}", 1);
+  log::info("value {} {}", 42, temp);
+  // The record must hold a copy of the string, not a reference
+  temp.assign(temp.size(), 'x');
+  log::warning("{}", std::string(60, 'a'));
+  log::error("quote \" in {:>4}", "msg");
+  const auto lines{reader.wait(3)};
+  CHECK(lines.size() == 3);
+  if (lines.size() != 3) {
+    return;
+  }
+  CHECK(field(lines[0], "level") == "\"info\"");
+  CHECK(field(lines[0], "msg") == "\"value 42 temporary\"");
+  CHECK(field(lines[0], "thread") == std::to_string(gettid()));
+  CHECK(field(lines[0], "time").ends_with("Z\""));
+  CHECK(field(lines[1], "level") == "\"warning\"");
+  // Strings are truncated to 47 bytes
+  CHECK(field(lines[1], "msg") == std::format("\"{}\"", std::string(47, 'a')));
+  CHECK(field(lines[2], "level") == "\"error\"");
+  CHECK(field(lines[2], "msg") == "\"quote \\\" in  msg\"");
+}
+
+/// Check that records written by several threads all reach the file, in
+///    order for each thread.
+void test_threads(log_reader &reader) {
+  constexpr int num_threads{4};
+  // Fits into a thread's buffer, so no records are dropped
+  constexpr int num_records{100};
+  // Buffers of exited threads are reused, so threads must not exit until all
+  //    of them have written their records
+  std::latch finished{num_threads};
+  {
+    std::vector<std::jthread> threads;
+    for (int i{}; i < num_threads; ++i) {
+      threads.emplace_back([i, &finished] {
+        for (int j{}; j < num_records; ++j) {
+          log::info("{} {}", i, j);
+        }
+        finished.arrive_and_wait();
+      });
+    }
+  }
+  const auto lines{reader.wait(num_threads * num_records)};
+  CHECK(lines.size() == num_threads * num_records);
+  std::array<int, num_threads> next{};
+  bool ordered{true};
+  for (const auto &line : lines) {
+    int thread;
+    int record;
+    const auto msg{field(line, "msg")};
+    if (std::sscanf(std::string{msg}.data(), "\"%d %d\"", &thread, &record) !=
+            2 ||
+        thread < 0 || thread >= num_threads || record != next[thread]++) {
+      ordered = false;
+    }
+  }
+  CHECK(ordered);
+  CHECK(next == (std::array<int, num_threads>{num_records, num_records,
+                                              num_records, num_records}));
+}
+
+/// Measure the cost of log calls on the writing thread.
+void bench_calls(log_reader &reader) {
+  constexpr int num_disabled{10000000};
+  const auto disabled_time{test::time_s([] {
+    for (int i{}; i < num_disabled; ++i) {
+      log::debug("disabled {} {}", i, "string");
+    }
+  })};
+  test::report("disabled level", disabled_time / num_disabled * 1e9, "ns");
+  // Records are written in batches that fit into the buffer, and only the
+  //    calls are timed, not waiting for the write job
+  constexpr int num_batches{1000};
+  constexpr int batch_size{100};
+  for (const int num_threads : {1, 4}) {
+    std::chrono::steady_clock::duration total{};
+    std::mutex mtx;
+    for (int i{}; i < num_batches; ++i) {
+      {
+        std::latch finished{num_threads};
+        std::vector<std::jthread> threads;
+        for (int j{}; j < num_threads; ++j) {
+          threads.emplace_back([&, i] {
+            const auto start{std::chrono::steady_clock::now()};
+            for (int k{}; k < batch_size; ++k) {
+              log::info("enabled {} {}", i * batch_size + k, "string");
+            }
+            const auto time{std::chrono::steady_clock::now() - start};
+            {
+              const std::scoped_lock lock{mtx};
+              total += time;
+            }
+            // Keep the buffer until all threads are done, see test_threads
+            finished.arrive_and_wait();
+          });
+        }
+      }
+      reader.wait(num_threads * batch_size);
+    }
+    test::report(std::format("enabled level, {} threads", num_threads),
+                 std::chrono::duration<double, std::nano>(total).count() /
+                     (num_batches * num_threads * batch_size),
+                 "ns");
+  }
+  // Reference: what each call would cost if it formatted and wrote its line
+  const auto path{fs::temp_directory_path() /
+                  std::format("tek-gr-log-bench-{}.log", getpid())};
+  const int fd{::open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644)};
+  constexpr int num_sync{100000};
+  std::mutex mtx;
+  const auto sync_time{test::time_s([&] {
+    for (int i{}; i < num_sync; ++i) {
+      const auto line{std::format(
+          "{{\"time\":\"{:%FT%TZ}\",\"level\":\"info\",\"thread\":{},"
+          "\"msg\":\"enabled {} {}\"}}\n",
+          std::chrono::floor<std::chrono::milliseconds>(
+              std::chrono::system_clock::now()),
+          gettid(), i, "string")};
+      const std::scoped_lock lock{mtx};
+      [[maybe_unused]] const auto res{write(fd, line.data(), line.size())};
+    }
+  })};
+  close(fd);
+  fs::remove(path);
+  test::report("synchronous format and write (reference)",
+               sync_time / num_sync * 1e9, "ns");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto path{fs::temp_directory_path() /
+                  std::format("tek-gr-log-test-{}.log", getpid())};
+  fs::remove(path);
+  const bool bench{test::bench_mode(argc, argv)};
+  if (!bench) {
+    test_closed();
+  }
+  g_settings.log_path = path.string();
+  g_settings.log_level = "info";
+  log::open();
+  log_reader reader{path};
+  if (bench) {
+    bench_calls(reader);
+  } else {
+    test_levels(reader);
+    test_threads(reader);
+  }
+  fs::remove(path);
+  return test::result();
+}
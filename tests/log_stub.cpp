@@ -0,0 +1,29 @@
+//===-- log_stub.cpp - log stand-in for tests -----------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Stand-in for log.cpp in tests of modules that write log records, which
+///    doesn't depend on settings. The log is never opened, so records are
+///    never written.
+///
+//===----------------------------------------------------------------------===//
+#include "log.hpp"
+
+namespace tek::game_runtime::log {
+
+detail::record *detail::acquire() noexcept { return nullptr; }
+
+void detail::commit() noexcept {}
+
+void open() {}
+
+void flush() noexcept {}
+
+} // namespace tek::game_runtime::log
@@ -0,0 +1,198 @@
+//===-- memory.cpp - tests for memory resources ---------------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of per-subsystem accounting of pool resources, pooled objects and
+///    the startup arena, and a benchmark of pooled allocations compared to
+///    global operator new.
+///
+//===----------------------------------------------------------------------===//
+#include "memory.hpp"
+
+#include "test.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tek::game_runtime;
+using memory::subsystem;
+
+namespace {
+
+/// Polymorphic base for checking deletion via base pointers.
+class base_obj {
+public:
+  virtual ~base_obj() = default;
+};
+
+/// Pooled object larger than its base.
+class pooled_obj final : public base_obj,
+                         public memory::pooled<subsystem::server_browser> {
+public:
+  std::array<std::byte, 200> payload;
+};
+
+/// Plain heap-allocated object of the same size as @ref pooled_obj.
+class plain_obj final : public base_obj {
+public:
+  std::array<std::byte, 200> payload;
+};
+
+/// Check allocation accounting of a steady-state resource.
+void test_accounting() {
+  auto &res{memory::resource(subsystem::lobby_cache)};
+  const auto before{memory::get_usage(subsystem::lobby_cache)};
+  const auto a{res.allocate(100, alignof(std::max_align_t))};
+  const auto b{res.allocate(300, 64)};
+  CHECK(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+  auto usage{memory::get_usage(subsystem::lobby_cache)};
+  CHECK(usage.bytes == before.bytes + 400);
+  CHECK(usage.peak_bytes >= before.bytes + 400);
+  CHECK(usage.allocations == before.allocations + 2);
+  res.deallocate(a, 100, alignof(std::max_align_t));
+  res.deallocate(b, 300, 64);
+  usage = memory::get_usage(subsystem::lobby_cache);
+  CHECK(usage.bytes == before.bytes);
+  CHECK(usage.peak_bytes >= before.bytes + 400);
+  // Other subsystems are unaffected
+  CHECK(memory::get_usage(subsystem::eos).allocations == 0);
+  // pmr containers work on top of the resource
+  {
+    std::pmr::vector<std::pmr::string> strs{&res};
+    for (int i{}; i < 100; ++i) {
+      strs.emplace_back(std::string(64, 'a' + i % 26));
+    }
+    CHECK(memory::get_usage(subsystem::lobby_cache).bytes > before.bytes);
+  }
+  CHECK(memory::get_usage(subsystem::lobby_cache).bytes == before.bytes);
+}
+
+/// Check that pooled objects are accounted to their subsystem, including
+///    when deleted via a base pointer.
+void test_pooled() {
+  const auto before{memory::get_usage(subsystem::server_browser)};
+  std::unique_ptr<base_obj> obj{new pooled_obj};
+  const auto usage{memory::get_usage(subsystem::server_browser)};
+  CHECK(usage.bytes == before.bytes + sizeof(pooled_obj));
+  CHECK(usage.allocations == before.allocations + 1);
+  obj.reset();
+  CHECK(memory::get_usage(subsystem::server_browser).bytes == before.bytes);
+}
+
+/// Check the startup arena.
+void test_arena() {
+  auto &arena{memory::startup_arena()};
+  CHECK(&memory::resource(subsystem::startup) == &arena);
+  const auto before{memory::get_usage(subsystem::startup)};
+  std::vector<void *> ptrs;
+  for (int i{}; i < 1000; ++i) {
+    ptrs.push_back(arena.allocate(48, 16));
+  }
+  // Deallocation is a no-op, the arena grows in chunks
+  for (const auto ptr : ptrs) {
+    arena.deallocate(ptr, 48, 16);
+  }
+  const auto usage{memory::get_usage(subsystem::startup)};
+  CHECK(usage.bytes >= before.bytes + 48000);
+  CHECK(usage.allocations < before.allocations + 20);
+  memory::release_startup_arena();
+  CHECK(memory::get_usage(subsystem::startup).bytes == 0);
+  // The arena can be used again after release
+  CHECK(arena.allocate(8, 8) != nullptr);
+  memory::release_startup_arena();
+}
+
+/// Check that concurrent allocations from several threads are accounted
+///    exactly.
+void test_concurrency() {
+  const auto before{memory::get_usage(subsystem::http_cache)};
+  constexpr int num_threads{4};
+  constexpr int num_allocs{20000};
+  std::vector<std::thread> threads;
+  for (int t{}; t < num_threads; ++t) {
+    threads.emplace_back([] {
+      auto &res{memory::resource(subsystem::http_cache)};
+      std::vector<void *> ptrs;
+      ptrs.reserve(num_allocs);
+      for (int i{}; i < num_allocs; ++i) {
+        ptrs.push_back(res.allocate(32 + i % 4 * 16, 16));
+      }
+      for (int i{}; i < num_allocs; ++i) {
+        res.deallocate(ptrs[i], 32 + i % 4 * 16, 16);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto usage{memory::get_usage(subsystem::http_cache)};
+  CHECK(usage.bytes == before.bytes);
+  CHECK(usage.allocations == before.allocations + num_threads * num_allocs);
+  CHECK(usage.peak_bytes > before.bytes);
+}
+
+/// Run an allocation churn benchmark on specified number of threads.
+///
+/// @tparam T
+///    Type of allocated objects.
+/// @param name
+///    Name of the measured case.
+/// @param num_threads
+///    Number of threads.
+template <typename T>
+void bench_churn(std::string_view name, int num_threads) {
+  constexpr int num_iters{200};
+  constexpr int batch{1000};
+  const auto time{test::time_s([&] {
+    std::vector<std::thread> threads;
+    for (int t{}; t < num_threads; ++t) {
+      threads.emplace_back([] {
+        std::vector<base_obj *> objs(batch);
+        for (int i{}; i < num_iters; ++i) {
+          for (auto &obj : objs) {
+            obj = new T;
+          }
+          for (const auto obj : objs) {
+            delete obj;
+          }
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  })};
+  test::report(std::string{name} + ", " + std::to_string(num_threads) +
+                   " threads",
+               2.0 * num_iters * batch * num_threads / time, "ops/s");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (test::bench_mode(argc, argv)) {
+    for (const int num_threads : {1, 4}) {
+      bench_churn<pooled_obj>("memory pooled new/delete", num_threads);
+      bench_churn<plain_obj>("global new/delete (reference)", num_threads);
+    }
+  } else {
+    test_accounting();
+    test_pooled();
+    test_arena();
+    test_concurrency();
+  }
+  return test::result();
+}
@@ -0,0 +1,37 @@
+//===-- metrics_stub.cpp - metrics stand-in for tests ---------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Stand-in for metrics.cpp in tests of modules that record metrics, which
+///    doesn't depend on settings and never writes the output file. Counter
+///    values are still maintained, so tests may check them.
+///
+//===----------------------------------------------------------------------===//
+#include "metrics.hpp"
+
+#include <cstdint>
+#include <mutex>
+
+namespace tek::game_runtime::metrics {
+
+counter::counter(const char *name) noexcept
+    : name{name}, value{}, next{} {}
+
+distribution::distribution(const char *name) noexcept
+    : name{name}, count{}, next{} {}
+
+void distribution::add(std::uint64_t) {
+  const std::scoped_lock lock{mtx};
+  ++count;
+}
+
+void dump() {}
+
+} // namespace tek::game_runtime::metrics
@@ -0,0 +1,199 @@
+//===-- mod_prefetch.cpp - tests for the mod file prefetcher --------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of the mod file prefetcher on a generated workshop directory, and a
+///    load-time benchmark. The benchmark evicts mod files from the page cache
+///    and measures how long a simulated game load takes, which reads every
+///    file in mod order and spends CPU time parsing it. It's run without
+///    prefetching, with prefetching started together with the load, and with
+///    prefetching given a head start, like it gets from the game's own
+///    initialization before it loads mods.
+///
+//===----------------------------------------------------------------------===//
+#include "mod_prefetch.hpp"
+
+#include "test.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tek::game_runtime;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// CPU time that the simulated game load spends parsing each 64 KiB chunk.
+constexpr std::chrono::microseconds parse_time{20};
+
+/// Create a mod directory with files of specified size, one of them in a
+///    subdirectory.
+///
+/// @param dir
+///    Path to the mod directory.
+/// @param num_files
+///    Number of files to create.
+/// @param file_size
+///    Size of each file in bytes.
+void create_mod(const fs::path &dir, int num_files, std::size_t file_size) {
+  fs::create_directories(dir / "Content");
+  const std::string data(file_size, 'm');
+  for (int i{}; i < num_files; ++i) {
+    const auto path{i ? dir / ("file" + std::to_string(i) + ".uasset")
+                      : dir / "Content" / "nested.uasset"};
+    std::ofstream{path, std::ios::binary} << data;
+  }
+}
+
+/// Drop all files in a directory from the page cache.
+void evict(const fs::path &dir) {
+  for (const auto &entry : fs::recursive_directory_iterator{dir}) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    const int fd{open(entry.path().c_str(), O_RDONLY)};
+    if (fd >= 0) {
+      fdatasync(fd);
+      posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      close(fd);
+    }
+  }
+}
+
+/// Check which files are read and how the budget limits reading.
+void test_run(const fs::path &dir) {
+  create_mod(dir / "1", 3, 1000);
+  create_mod(dir / "2", 2, 3 * mod_prefetch::chunk_size / 2);
+  create_mod(dir / "3", 4, 10);
+  // Mods that aren't listed are ignored, missing ones are skipped
+  const std::array<std::uint64_t, 3> ids{2, 1, 404};
+  auto res{mod_prefetch::run(dir, ids, UINT64_MAX)};
+  CHECK(res.files == 5);
+  CHECK(res.bytes == 3000 + 3 * mod_prefetch::chunk_size);
+  // Reading stops once the budget is exhausted
+  res = mod_prefetch::run(dir, ids, mod_prefetch::chunk_size);
+  CHECK(res.files == 1);
+  CHECK(res.bytes == mod_prefetch::chunk_size);
+  res = mod_prefetch::run(dir, ids, 0);
+  CHECK(res.files == 0 && res.bytes == 0);
+  // Empty mod list and missing base directory
+  CHECK(mod_prefetch::run(dir, {}, UINT64_MAX).files == 0);
+  CHECK(mod_prefetch::run(dir / "missing", ids, UINT64_MAX).files == 0);
+  CHECK(mod_prefetch::default_budget() > 0);
+}
+
+/// Simulate the game loading mods: read every file in 64 KiB chunks, in mod
+///    order, spending CPU time on each chunk.
+///
+/// @param dir
+///    Path to the workshop directory.
+/// @param ids
+///    IDs of the mods to load.
+/// @param cpu_per_chunk
+///    Busy time to spend per chunk.
+void load_mods(const fs::path &dir, std::span<const std::uint64_t> ids,
+               std::chrono::microseconds cpu_per_chunk) {
+  std::vector<char> buf(64 * 1024);
+  for (const auto id : ids) {
+    for (const auto &entry :
+         fs::recursive_directory_iterator{dir / std::to_string(id)}) {
+      if (!entry.is_regular_file()) {
+        continue;
+      }
+      const int fd{open(entry.path().c_str(), O_RDONLY)};
+      while (read(fd, buf.data(), buf.size()) > 0) {
+        const auto until{std::chrono::steady_clock::now() + cpu_per_chunk};
+        while (std::chrono::steady_clock::now() < until) {
+        }
+      }
+      close(fd);
+    }
+  }
+}
+
+/// Measure load time in one scenario.
+///
+/// @param dir
+///    Path to the workshop directory.
+/// @param ids
+///    IDs of the mods to load.
+/// @param prefetch
+///    Value indicating whether to run the prefetcher.
+/// @param head_start
+///    Time between starting the prefetcher and the load.
+/// @return Load time in milliseconds, excluding @p head_start.
+double measure(const fs::path &dir, std::span<const std::uint64_t> ids,
+               bool prefetch, std::chrono::milliseconds head_start) {
+  evict(dir);
+  std::thread prefetcher;
+  if (prefetch) {
+    prefetcher = std::thread{
+        [&] { mod_prefetch::run(dir, ids, mod_prefetch::default_budget()); }};
+    std::this_thread::sleep_for(head_start);
+  }
+  const auto time{test::time_s(
+      [&] { load_mods(dir, ids, parse_time); })};
+  if (prefetcher.joinable()) {
+    prefetcher.join();
+  }
+  return time * 1000;
+}
+
+/// Run the load-time benchmark on 8 mods of 16 MiB each.
+void bench(const fs::path &dir) {
+  std::vector<std::uint64_t> ids;
+  for (std::uint64_t id{1}; id <= 8; ++id) {
+    create_mod(dir / std::to_string(id), 8, 2 * 1024 * 1024);
+    ids.push_back(id);
+  }
+  constexpr int num_runs{3};
+  const auto report{[&](const char *name, bool prefetch,
+                        std::chrono::milliseconds head_start) {
+    double total{};
+    for (int i{}; i < num_runs; ++i) {
+      total += measure(dir, ids, prefetch, head_start);
+    }
+    test::report(name, total / num_runs, "ms");
+  }};
+  report("128 MiB cold load, no prefetch", false, {});
+  report("128 MiB cold load, prefetch started with load", true, {});
+  report("128 MiB cold load, prefetch 500 ms head start", true,
+         std::chrono::milliseconds{500});
+  // Upper bound of the gain, with everything already cached
+  const auto warm{test::time_s(
+      [&] { load_mods(dir, ids, parse_time); })};
+  test::report("128 MiB warm load", warm * 1000, "ms");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto dir{fs::temp_directory_path() /
+                 ("tek-gr-prefetch-test-" + std::to_string(getpid()))};
+  fs::create_directories(dir);
+  if (test::bench_mode(argc, argv)) {
+    bench(dir);
+  } else {
+    test_run(dir);
+  }
+  fs::remove_all(dir);
+  return test::result();
+}
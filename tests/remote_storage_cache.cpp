@@ -0,0 +1,348 @@
+//===-- remote_storage_cache.cpp - tests for the remote storage cache -----===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of the remote storage cache against a fake backend: reads of cached
+///    files, coalescing of writes made during a flush, deletions, retries of
+///    failed writes with backoff, flushing at process exit and shutdown. The
+///    benchmark compares save-path latency of the game, with the cache and
+///    with writes made directly to a backend that is as slow as Steam.
+///
+//===----------------------------------------------------------------------===//
+#include "remote_storage_cache.hpp"
+
+#include "test.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace tek::game_runtime;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// In-memory backend that can block, fail or slow down writes.
+struct fake_storage {
+  std::mutex mtx;
+  std::condition_variable cv;
+  /// Files that have been written, keyed by name.
+  std::map<std::string, std::string, std::less<>> files;
+  /// Times of all write attempts, keyed by file name.
+  std::map<std::string, std::vector<std::chrono::steady_clock::time_point>,
+           std::less<>>
+      attempts;
+  /// Number of upcoming write attempts that fail.
+  int num_failures{};
+  /// Value indicating whether writes are blocked until it's reset.
+  bool blocked{};
+  /// Number of writes currently waiting for @ref blocked to be reset.
+  int num_blocked{};
+  /// Duration of each write.
+  std::chrono::microseconds delay{};
+  /// Number of begun batches.
+  int num_batches{};
+};
+
+fake_storage storage;
+
+constexpr remote_storage_cache::backend fake_backend{
+    .write =
+        [](const char *name, std::span<const std::byte> data) {
+          std::unique_lock lock{storage.mtx};
+          storage.attempts[name].emplace_back(std::chrono::steady_clock::now());
+          ++storage.num_blocked;
+          storage.cv.notify_all();
+          storage.cv.wait(lock, [] { return !storage.blocked; });
+          --storage.num_blocked;
+          if (storage.delay.count()) {
+            lock.unlock();
+            std::this_thread::sleep_for(storage.delay);
+            lock.lock();
+          }
+          if (storage.num_failures) {
+            --storage.num_failures;
+            return false;
+          }
+          storage.files.insert_or_assign(
+              name, std::string{reinterpret_cast<const char *>(data.data()),
+                                data.size()});
+          return true;
+        },
+    .remove =
+        [](const char *name) {
+          const std::scoped_lock lock{storage.mtx};
+          if (const auto it{storage.files.find(std::string_view{name})};
+              it != storage.files.end()) {
+            storage.files.erase(it);
+          }
+        },
+    .begin_batch =
+        [] {
+          const std::scoped_lock lock{storage.mtx};
+          ++storage.num_batches;
+        },
+    .end_batch = nullptr};
+
+/// Get a byte span of a string.
+std::span<const std::byte> bytes(std::string_view str) {
+  return {reinterpret_cast<const std::byte *>(str.data()), str.size()};
+}
+
+/// Read a file from the cache as a string.
+std::optional<std::string> read(const char *name) {
+  std::string buf(64, '\0');
+  const auto res{remote_storage_cache::read(
+      name, {reinterpret_cast<std::byte *>(buf.data()), buf.size()})};
+  if (!res) {
+    return {};
+  }
+  buf.resize(*res);
+  return buf;
+}
+
+/// Get contents of a file in the fake backend.
+std::optional<std::string> stored(std::string_view name) {
+  const std::scoped_lock lock{storage.mtx};
+  if (const auto it{storage.files.find(name)}; it != storage.files.end()) {
+    return it->second;
+  }
+  return {};
+}
+
+/// Get the number of write attempts made for a file.
+std::size_t num_attempts(std::string_view name) {
+  const std::scoped_lock lock{storage.mtx};
+  const auto it{storage.attempts.find(name)};
+  return it == storage.attempts.end() ? 0 : it->second.size();
+}
+
+/// Block writes to the fake backend and wait until one of them is waiting.
+void block_and_wait_for_write() {
+  std::unique_lock lock{storage.mtx};
+  storage.cv.wait(lock, [] { return storage.num_blocked > 0; });
+}
+
+/// Unblock writes to the fake backend.
+void unblock() {
+  {
+    const std::scoped_lock lock{storage.mtx};
+    storage.blocked = false;
+  }
+  storage.cv.notify_all();
+}
+
+/// Check reads, sizes and existence of cached and uncached files.
+void test_reads() {
+  CHECK(!read("missing"));
+  CHECK(!remote_storage_cache::exists("missing"));
+  CHECK(!remote_storage_cache::size("missing"));
+  remote_storage_cache::fill("filled", bytes("from steam"));
+  CHECK(read("filled") == "from steam");
+  CHECK(remote_storage_cache::exists("filled") == true);
+  CHECK(remote_storage_cache::size("filled") == 10);
+  // Reads into smaller buffers are truncated
+  std::string small(4, '\0');
+  CHECK(remote_storage_cache::read(
+            "filled", {reinterpret_cast<std::byte *>(small.data()), 4}) == 4);
+  CHECK(small == "from");
+  // Filling doesn't overwrite changes made by the game
+  remote_storage_cache::write("written", bytes("new"));
+  remote_storage_cache::fill("written", bytes("stale"));
+  CHECK(read("written") == "new");
+  remote_storage_cache::flush();
+  CHECK(stored("written") == "new");
+  // Cached files are still served after they're flushed
+  CHECK(read("written") == "new");
+  CHECK(!stored("filled"));
+}
+
+/// Check that writes made while a flush is in progress are coalesced into
+///    the next one.
+void test_coalescing() {
+  {
+    const std::scoped_lock lock{storage.mtx};
+    storage.blocked = true;
+  }
+  remote_storage_cache::write("save", bytes("v1"));
+  block_and_wait_for_write();
+  // The game sees its own writes immediately
+  for (const auto version : {"v2", "v3", "v4"}) {
+    remote_storage_cache::write("save", bytes(version));
+    CHECK(read("save") == version);
+  }
+  unblock();
+  remote_storage_cache::flush();
+  CHECK(stored("save") == "v4");
+  CHECK(num_attempts("save") == 2);
+  // Nothing is written again if there are no changes
+  remote_storage_cache::flush();
+  CHECK(num_attempts("save") == 2);
+}
+
+/// Check deletions of cached and uncached files.
+void test_delete() {
+  // Uncached files have to be deleted directly
+  CHECK(!remote_storage_cache::remove("uncached"));
+  remote_storage_cache::write("deleted", bytes("data"));
+  remote_storage_cache::flush();
+  CHECK(stored("deleted") == "data");
+  // Keep background flushes busy, so the deletion stays pending
+  {
+    const std::scoped_lock lock{storage.mtx};
+    storage.blocked = true;
+  }
+  remote_storage_cache::write("blocker", bytes("data"));
+  block_and_wait_for_write();
+  CHECK(remote_storage_cache::remove("deleted") == true);
+  // Deleted files are reported as missing before the deletion is flushed
+  CHECK(remote_storage_cache::exists("deleted") == false);
+  CHECK(remote_storage_cache::size("deleted") == 0);
+  CHECK(read("deleted") == "");
+  CHECK(remote_storage_cache::remove("deleted") == false);
+  unblock();
+  remote_storage_cache::flush();
+  CHECK(!stored("deleted"));
+  // Once the deletion is flushed, requests go to the backend again
+  CHECK(!remote_storage_cache::exists("deleted"));
+  // Writing a file after deleting it keeps the new contents
+  remote_storage_cache::write("recreated", bytes("old"));
+  CHECK(remote_storage_cache::remove("recreated") == true);
+  remote_storage_cache::write("recreated", bytes("new"));
+  remote_storage_cache::flush();
+  CHECK(stored("recreated") == "new");
+  // Dropping a file writes its pending changes first
+  remote_storage_cache::write("dropped", bytes("pending"));
+  remote_storage_cache::drop("dropped");
+  CHECK(stored("dropped") == "pending");
+  CHECK(!remote_storage_cache::exists("dropped"));
+}
+
+/// Check that failed writes are retried with exponential backoff, and that
+///    the delay is reset after a successful flush.
+void test_retry() {
+  {
+    const std::scoped_lock lock{storage.mtx};
+    storage.num_failures = 2;
+  }
+  remote_storage_cache::write("retried", bytes("data"));
+  const auto deadline{std::chrono::steady_clock::now() +
+                      remote_storage_cache::initial_retry_delay * 8};
+  while (!stored("retried") && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(10ms);
+  }
+  CHECK(stored("retried") == "data");
+  {
+    const std::scoped_lock lock{storage.mtx};
+    const auto &times{storage.attempts["retried"]};
+    CHECK(times.size() == 3);
+    if (times.size() == 3) {
+      CHECK(times[1] - times[0] >= remote_storage_cache::initial_retry_delay);
+      CHECK(times[2] - times[1] >=
+            remote_storage_cache::initial_retry_delay * 2);
+    }
+    storage.num_failures = 1;
+  }
+  // The game doesn't see failures, and the next retry comes after the
+  //    initial delay again
+  remote_storage_cache::write("retried2", bytes("data2"));
+  CHECK(read("retried2") == "data2");
+  std::this_thread::sleep_for(remote_storage_cache::initial_retry_delay * 2);
+  CHECK(stored("retried2") == "data2");
+  CHECK(num_attempts("retried2") == 2);
+}
+
+/// Check that the backing storage isn't touched at process exit, when Steam
+///    may already be unloaded, and that nothing waits for locks held by
+///    threads that may have been terminated.
+void test_exit_flush() {
+  {
+    const std::scoped_lock lock{storage.mtx};
+    storage.blocked = true;
+  }
+  remote_storage_cache::write("exit", bytes("v1"));
+  block_and_wait_for_write();
+  remote_storage_cache::write("exit", bytes("v2"));
+  remote_storage_cache::write("exit_idle", bytes("v1"));
+  const auto time{test::time_s([] {
+    remote_storage_cache::flush_at_exit(true);
+  })};
+  CHECK(time < 0.1);
+  // Only the background write that was already blocked has been attempted
+  CHECK(num_attempts("exit") == 1);
+  CHECK(num_attempts("exit_idle") == 0);
+  unblock();
+  // Without process exit, pending changes are written
+  remote_storage_cache::flush_at_exit(false);
+  CHECK(stored("exit") == "v2");
+}
+
+/// Check that nothing is written after shutdown, but pending changes are
+///    written before it.
+void test_shut_down() {
+  remote_storage_cache::write("last", bytes("save"));
+  remote_storage_cache::shut_down();
+  CHECK(stored("last") == "save");
+  remote_storage_cache::write("after", bytes("shutdown"));
+  remote_storage_cache::flush();
+  CHECK(!stored("after"));
+  CHECK(read("after") == "shutdown");
+}
+
+/// Measure the time the game spends in a save call, with the cache and with
+///    direct writes to a backend that takes 2 ms per write.
+void bench_save_latency() {
+  storage.delay = 2ms;
+  const std::string data(64 * 1024, 'x');
+  constexpr int num_saves{200};
+  const auto direct{test::time_s([&] {
+    for (int i{}; i < num_saves; ++i) {
+      fake_backend.write("direct", bytes(data));
+    }
+  })};
+  test::report("direct backend write latency", direct / num_saves * 1e6,
+               "us");
+  const auto cached{test::time_s([&] {
+    for (int i{}; i < num_saves; ++i) {
+      remote_storage_cache::write("cached", bytes(data));
+    }
+  })};
+  test::report("remote_storage_cache write latency", cached / num_saves * 1e6,
+               "us");
+  remote_storage_cache::flush();
+  test::report("backend writes per 200 cached saves",
+               static_cast<double>(num_attempts("cached")), "writes");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  remote_storage_cache::init(fake_backend);
+  if (test::bench_mode(argc, argv)) {
+    bench_save_latency();
+  } else {
+    test_reads();
+    test_coalescing();
+    test_delete();
+    test_retry();
+    test_exit_flush();
+    test_shut_down();
+    CHECK(storage.num_batches > 0);
+  }
+  return test::result();
+}
@@ -0,0 +1,267 @@
+//===-- settings_index.cpp - tests for multi-app settings files -----------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of reading sections of multi-app settings files with and without a
+///    valid index, of writing sections back, including by concurrent writers,
+///    and of rejecting malformed files. The benchmark measures the time to
+///    read one section as the file grows, via the index and by rebuilding it,
+///    compared to reading the whole file.
+///
+//===----------------------------------------------------------------------===//
+#include "settings_index.hpp"
+
+#include "test.hpp"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace tek::game_runtime;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// Write a file with specified contents.
+///
+/// @param [in] path
+///    Path to the file.
+/// @param contents
+///    Contents of the file.
+void write_file(const fs::path &path, std::string_view contents) {
+  std::ofstream{path, std::ios::binary | std::ios::trunc}.write(
+      contents.data(), contents.size());
+}
+
+/// Read a whole file.
+///
+/// @param [in] path
+///    Path to the file.
+/// @return Contents of the file.
+std::string read_file(const fs::path &path) {
+  std::ifstream file{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>{file}, {}};
+}
+
+/// Get the object of a generated section.
+///
+/// @param name
+///    Name of the section.
+/// @param dlc_count
+///    Number of DLC entries in the section.
+/// @return JSON object of the section.
+std::string make_section(std::string_view name, int dlc_count) {
+  std::string section{std::format("{{\"app_id\": {}, \"dlc\": {{", name)};
+  for (int i{}; i < dlc_count; ++i) {
+    section += std::format("{}\"{}\": \"DLC {} \\\"{{}}\\\"\"",
+                           i ? ", " : "", 1000000 + i, i);
+  }
+  section += "}}";
+  return section;
+}
+
+/// Get contents of a generated multi-app settings file.
+///
+/// @param num_sections
+///    Number of sections, named after their indices.
+/// @param dlc_count
+///    Number of DLC entries in each section.
+/// @return Contents of the file.
+std::string make_file(int num_sections, int dlc_count) {
+  std::string text{"{\n  \"comment\": \"{\\\"apps\\\": []}\",\n  \"apps\": {"};
+  for (int i{}; i < num_sections; ++i) {
+    const auto name{std::to_string(i)};
+    text += std::format("{}\n    \"{}\": {}", i ? "," : "", name,
+                        make_section(name, dlc_count));
+  }
+  text += "\n  },\n  \"version\": [1, 2]\n}\n";
+  return text;
+}
+
+/// Check that sections are read with and without a valid index.
+void test_read(const fs::path &dir) {
+  const auto path{dir / "read.json"};
+  write_file(path, make_file(3, 2));
+  std::string buf;
+  // The first read builds the index
+  CHECK(settings_index::read_section(path, "1", buf));
+  CHECK(buf == make_section("1", 2));
+  CHECK(fs::exists(dir / "read.json.idx"));
+  CHECK(settings_index::read_section(path, "2", buf));
+  CHECK(buf == make_section("2", 2));
+  CHECK(settings_index::read_section(path, "0", buf));
+  CHECK(buf == make_section("0", 2));
+  CHECK(!settings_index::read_section(path, "3", buf));
+  // An edit invalidates the index
+  write_file(path, make_file(4, 5));
+  CHECK(settings_index::read_section(path, "3", buf));
+  CHECK(buf == make_section("3", 5));
+  CHECK(settings_index::read_section(path, "1", buf));
+  CHECK(buf == make_section("1", 5));
+}
+
+/// Check that malformed files are rejected.
+void test_malformed(const fs::path &dir) {
+  const auto path{dir / "malformed.json"};
+  std::string buf;
+  CHECK(!settings_index::read_section(path, "0", buf));
+  for (const auto text :
+       {"", "[]", R"({"apps": {"0": {"a": "b}})", R"({"apps": {"0" {}}})",
+        R"({"apps": [{"0": {}}]})", R"({"apps": {"0": {"a": [1, 2}}})"}) {
+    write_file(path, text);
+    CHECK(!settings_index::read_section(path, "0", buf));
+  }
+  // Sections must be objects
+  write_file(path, R"({"apps": {"0": [], "1": {}}})");
+  CHECK(!settings_index::read_section(path, "0", buf));
+  CHECK(settings_index::read_section(path, "1", buf));
+  CHECK(buf == "{}");
+}
+
+/// Check that written sections replace only themselves, and that the index
+///    stays valid.
+void test_write(const fs::path &dir) {
+  const auto path{dir / "write.json"};
+  write_file(path, make_file(3, 3));
+  const auto small{make_section("1", 1)};
+  CHECK(settings_index::write_section(path, "1", small));
+  std::string buf;
+  CHECK(settings_index::read_section(path, "2", buf));
+  CHECK(buf == make_section("2", 3));
+  CHECK(settings_index::read_section(path, "1", buf));
+  CHECK(buf == small);
+  CHECK(settings_index::read_section(path, "0", buf));
+  CHECK(buf == make_section("0", 3));
+  const auto large{make_section("0", 10)};
+  CHECK(settings_index::write_section(path, "0", large));
+  CHECK(settings_index::read_section(path, "2", buf));
+  CHECK(buf == make_section("2", 3));
+  CHECK(settings_index::read_section(path, "0", buf));
+  CHECK(buf == large);
+  // Members other than sections are preserved
+  const auto text{read_file(path)};
+  CHECK(text.starts_with("{\n  \"comment\": \"{\\\"apps\\\": []}\""));
+  CHECK(text.ends_with("\"version\": [1, 2]\n}\n"));
+  CHECK(!settings_index::write_section(path, "3", small));
+}
+
+/// Check that concurrent writers of different sections don't lose each
+///    other's changes, and don't leave temporary files behind.
+void test_concurrent_writes(const fs::path &dir) {
+  constexpr int num_writers{4};
+  constexpr int num_writes{50};
+  const auto path{dir / "concurrent.json"};
+  write_file(path, make_file(num_writers, 1));
+  {
+    std::vector<std::jthread> threads;
+    for (int i{}; i < num_writers; ++i) {
+      threads.emplace_back([&path, i] {
+        const auto name{std::to_string(i)};
+        for (int j{1}; j <= num_writes; ++j) {
+          // Vary section size so offsets of following sections change
+          settings_index::write_section(path, name, make_section(name, j % 7));
+        }
+      });
+    }
+  }
+  std::string buf;
+  bool all_written{true};
+  for (int i{}; i < num_writers; ++i) {
+    const auto name{std::to_string(i)};
+    if (!settings_index::read_section(path, name, buf) ||
+        buf != make_section(name, num_writes % 7)) {
+      all_written = false;
+    }
+  }
+  CHECK(all_written);
+  bool tmp_left{};
+  for (const auto &entry : fs::directory_iterator{dir}) {
+    if (entry.path().extension() == ".tmp") {
+      tmp_left = true;
+    }
+  }
+  CHECK(!tmp_left);
+}
+
+/// Check that temporary file paths are unique.
+void test_tmp_path(const fs::path &dir) {
+  const auto path{dir / "settings.json"};
+  const auto first{settings_index::tmp_path(path)};
+  const auto second{settings_index::tmp_path(path)};
+  CHECK(first != second);
+  CHECK(first.parent_path() == dir);
+  CHECK(first.filename().string().starts_with(
+      std::format("settings.json.{}-", getpid())));
+}
+
+/// Measure section read time as the settings file grows.
+void bench_read(const fs::path &dir) {
+  // Roughly the size of a section with a big DLC catalog
+  constexpr int dlc_count{40};
+  for (const int num_sections : {10, 100, 1000, 10000}) {
+    const auto path{dir / std::format("bench-{}.json", num_sections)};
+    const auto text{make_file(num_sections, dlc_count)};
+    write_file(path, text);
+    const auto name{std::to_string(num_sections / 2)};
+    std::string buf;
+    constexpr int num_reads{200};
+    const auto rebuild_time{test::time_s([&] {
+      for (int i{}; i < num_reads / 10; ++i) {
+        fs::remove(dir / std::format("bench-{}.json.idx", num_sections));
+        settings_index::read_section(path, name, buf);
+      }
+    })};
+    const auto indexed_time{test::time_s([&] {
+      for (int i{}; i < num_reads; ++i) {
+        settings_index::read_section(path, name, buf);
+      }
+    })};
+    const auto whole_time{test::time_s([&] {
+      for (int i{}; i < num_reads; ++i) {
+        buf = read_file(path);
+      }
+    })};
+    const auto size_label{
+        std::format("{} apps, {} KiB", num_sections, text.size() / 1024)};
+    test::report("indexed read, " + size_label,
+                 indexed_time / num_reads * 1e6, "us");
+    test::report("index rebuild, " + size_label,
+                 rebuild_time / (num_reads / 10) * 1e6, "us");
+    test::report("full read (reference), " + size_label,
+                 whole_time / num_reads * 1e6, "us");
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto dir{fs::temp_directory_path() /
+                 std::format("tek-gr-settings-index-test-{}", getpid())};
+  fs::remove_all(dir);
+  fs::create_directories(dir);
+  if (test::bench_mode(argc, argv)) {
+    bench_read(dir);
+  } else {
+    test_read(dir);
+    test_malformed(dir);
+    test_write(dir);
+    test_concurrent_writes(dir);
+    test_tmp_path(dir);
+  }
+  fs::remove_all(dir);
+  return test::result();
+}
@@ -0,0 +1,293 @@
+//===-- shared_cache.cpp - tests for the cross-process cache --------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of the shared cache in a single process and across several forked
+///    processes that open the same region and concurrently read and write
+///    overlapping records, and a benchmark of get/put rates with and without
+///    contention.
+///
+//===----------------------------------------------------------------------===//
+#include "shared_cache.hpp"
+
+#include "test.hpp"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string>
+
+using namespace tek::game_runtime;
+using shared_cache::record_type;
+
+namespace {
+
+/// Number of child processes in multi-process tests.
+constexpr int num_procs{4};
+/// Number of keys that all processes write concurrently.
+constexpr std::uint64_t num_hot_keys{16};
+
+/// Fill a buffer with a pattern derived from a key and a writer ID, whose
+///    size also depends on them, so torn reads can be detected.
+///
+/// @param key
+///    Key of the record.
+/// @param writer
+///    ID of the writer.
+/// @param buf
+///    Buffer that receives the pattern.
+/// @return Size of the pattern.
+std::size_t make_pattern(std::uint64_t key, int writer,
+                         std::span<std::byte> buf) {
+  const auto size{
+      static_cast<std::size_t>(16 + (key * 37 + writer * 101) % 900)};
+  const auto value{static_cast<std::byte>(key * 7 + writer)};
+  for (std::size_t i{}; i < size; ++i) {
+    buf[i] = value;
+  }
+  return size;
+}
+
+/// Check whether data read from the cache is a complete pattern written by
+///    any writer for specified key.
+///
+/// @param key
+///    Key of the record.
+/// @param data
+///    Data read from the cache.
+/// @return Value indicating whether @p data is consistent.
+bool pattern_valid(std::uint64_t key, std::span<const std::byte> data) {
+  std::array<std::byte, shared_cache::max_record_size> expected;
+  for (int writer{}; writer <= num_procs; ++writer) {
+    const auto size{make_pattern(key, writer, expected)};
+    if (size == data.size() &&
+        std::ranges::equal(data, std::span{expected.data(), size})) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Get the name of the shared memory object used for specified app ID.
+std::string shm_name(std::uint32_t app_id) {
+  return std::format("/tek-game-runtime-cache-{}", app_id);
+}
+
+/// Check basic record operations in the current process.
+void test_single_process() {
+  std::array<std::byte, shared_cache::max_record_size> buf;
+  std::size_t size;
+  CHECK(!shared_cache::get(record_type::dlc_name, 1, std::chrono::hours{1},
+                           buf, size));
+  const std::array data{std::byte{1}, std::byte{2}, std::byte{3}};
+  shared_cache::put(record_type::dlc_name, 1, data);
+  CHECK(shared_cache::get(record_type::dlc_name, 1, std::chrono::hours{1}, buf,
+                          size));
+  CHECK(size == 3 && std::ranges::equal(std::span{buf.data(), size}, data));
+  // Same key with different type is a different record
+  CHECK(!shared_cache::get(record_type::ws_index, 1, std::chrono::hours{1},
+                           buf, size));
+  // Too old records are treated as missing
+  CHECK(!shared_cache::get(record_type::dlc_name, 1, std::chrono::seconds{-1},
+                           buf, size));
+  // Buffer too small for the record
+  std::array<std::byte, 2> small;
+  CHECK(!shared_cache::get(record_type::dlc_name, 1, std::chrono::hours{1},
+                           small, size));
+  // Replacement keeps a single record
+  const std::array data2{std::byte{9}};
+  shared_cache::put(record_type::dlc_name, 1, data2);
+  CHECK(shared_cache::get(record_type::dlc_name, 1, std::chrono::hours{1}, buf,
+                          size));
+  CHECK(size == 1 && buf[0] == std::byte{9});
+  // Oversized records are ignored
+  std::array<std::byte, shared_cache::max_record_size + 1> big{};
+  shared_cache::put(record_type::dlc_name, 2, big);
+  CHECK(!shared_cache::get(record_type::dlc_name, 2, std::chrono::hours{1},
+                           buf, size));
+  // Filling far more keys than there are slots evicts old records but keeps
+  //    recent ones readable
+  for (std::uint64_t key{100}; key < 5100; ++key) {
+    const auto sz{make_pattern(key, 0, buf)};
+    shared_cache::put(record_type::rules_verdict, key, {buf.data(), sz});
+  }
+  int found{};
+  for (std::uint64_t key{5000}; key < 5100; ++key) {
+    if (shared_cache::get(record_type::rules_verdict, key,
+                          std::chrono::hours{1}, buf, size)) {
+      ++found;
+      CHECK(pattern_valid(key, {buf.data(), size}));
+    }
+  }
+  CHECK(found >= 95);
+}
+
+/// Body of a child process in @ref test_multi_process.
+///
+/// @param app_id
+///    Application ID to open the cache for.
+/// @param writer
+///    ID of the process.
+/// @return Number of detected inconsistencies.
+int child_proc(std::uint32_t app_id, int writer) {
+  shared_cache::open(app_id);
+  if (!shared_cache::opened) {
+    return 1;
+  }
+  int errors{};
+  std::array<std::byte, shared_cache::max_record_size> buf;
+  // Private keys of this process
+  const auto own_base{std::uint64_t{1000} * (writer + 1)};
+  for (std::uint64_t i{}; i < 32; ++i) {
+    const auto size{make_pattern(own_base + i, writer, buf)};
+    shared_cache::put(record_type::ws_index, own_base + i, {buf.data(), size});
+  }
+  // Hot keys written and read by all processes at once
+  const auto deadline{std::chrono::steady_clock::now() +
+                      std::chrono::milliseconds{500}};
+  for (std::uint64_t i{}; std::chrono::steady_clock::now() < deadline; ++i) {
+    const auto key{i % num_hot_keys};
+    if (i % 3 == 0) {
+      const auto size{make_pattern(key, writer, buf)};
+      shared_cache::put(record_type::dlc_ids, key, {buf.data(), size});
+    } else if (std::size_t size; shared_cache::get(record_type::dlc_ids, key,
+                                                   std::chrono::hours{1}, buf,
+                                                   size) &&
+                                 !pattern_valid(key, {buf.data(), size})) {
+      ++errors;
+    }
+  }
+  return errors;
+}
+
+/// Check that concurrently running processes share records without torn
+///    reads.
+void test_multi_process() {
+  const auto app_id{static_cast<std::uint32_t>(getpid()) | 0x80000000};
+  const auto name{shm_name(app_id)};
+  shm_unlink(name.data());
+  std::array<pid_t, num_procs> pids;
+  for (int i{}; i < num_procs; ++i) {
+    pids[i] = fork();
+    if (!pids[i]) {
+      _exit(child_proc(app_id, i + 1));
+    }
+  }
+  for (const auto pid : pids) {
+    int status;
+    CHECK(waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+  // Records written by the children must be visible to a later instance
+  shared_cache::open(app_id);
+  CHECK(shared_cache::opened);
+  std::array<std::byte, shared_cache::max_record_size> buf;
+  std::array<std::byte, shared_cache::max_record_size> expected;
+  for (int writer{1}; writer <= num_procs; ++writer) {
+    const auto base{std::uint64_t{1000} * (writer + 1)};
+    for (std::uint64_t i{}; i < 32; ++i) {
+      std::size_t size;
+      CHECK(shared_cache::get(record_type::ws_index, base + i,
+                              std::chrono::hours{1}, buf, size));
+      const auto exp_size{make_pattern(base + i, writer, expected)};
+      CHECK(size == exp_size && std::ranges::equal(
+                                    std::span{buf.data(), size},
+                                    std::span{expected.data(), exp_size}));
+    }
+  }
+  for (std::uint64_t key{}; key < num_hot_keys; ++key) {
+    std::size_t size;
+    CHECK(shared_cache::get(record_type::dlc_ids, key, std::chrono::hours{1},
+                            buf, size));
+    CHECK(pattern_valid(key, {buf.data(), size}));
+  }
+  test_single_process();
+  shm_unlink(name.data());
+}
+
+/// Body of a process measuring get/put rate.
+///
+/// @param app_id
+///    Application ID to open the cache for.
+/// @param writer
+///    ID of the process.
+/// @return Number of operations performed per second.
+double bench_proc(std::uint32_t app_id, int writer) {
+  shared_cache::open(app_id);
+  std::array<std::byte, shared_cache::max_record_size> buf;
+  const auto size{make_pattern(1, writer, buf)};
+  constexpr int num_ops{1000000};
+  const auto time{test::time_s([&] {
+    for (int i{}; i < num_ops; ++i) {
+      const auto key{static_cast<std::uint64_t>(i % 512)};
+      if (i % 8 == 0) {
+        shared_cache::put(record_type::rules_verdict, key,
+                          {buf.data(), size % 64});
+      } else {
+        std::size_t read_size;
+        shared_cache::get(record_type::rules_verdict, key,
+                          std::chrono::hours{1}, buf, read_size);
+      }
+    }
+  })};
+  return num_ops / time;
+}
+
+/// Measure operation rate with 1 and @ref num_procs processes.
+void bench() {
+  const auto app_id{static_cast<std::uint32_t>(getpid()) | 0x80000000};
+  const auto name{shm_name(app_id)};
+  shm_unlink(name.data());
+  test::report("shared_cache 1 process, 7:1 get:put",
+               bench_proc(app_id, 0), "ops/s");
+  std::array<pid_t, num_procs> pids;
+  std::array<int, 2> fds;
+  CHECK(pipe(fds.data()) == 0);
+  for (int i{}; i < num_procs; ++i) {
+    pids[i] = fork();
+    if (!pids[i]) {
+      const auto rate{bench_proc(app_id, i + 1)};
+      write(fds[1], &rate, sizeof rate);
+      _exit(0);
+    }
+  }
+  double total{};
+  for (const auto pid : pids) {
+    double rate;
+    if (read(fds[0], &rate, sizeof rate) == sizeof rate) {
+      total += rate;
+    }
+    waitpid(pid, nullptr, 0);
+  }
+  close(fds[0]);
+  close(fds[1]);
+  test::report(std::format("shared_cache {} processes, 7:1 get:put", num_procs),
+               total, "ops/s");
+  shm_unlink(name.data());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (test::bench_mode(argc, argv)) {
+    bench();
+  } else {
+    test_multi_process();
+  }
+  return test::result();
+}
@@ -0,0 +1,575 @@
+//===-- steam_http.cpp - tests for ISteamHTTP response caching ------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of ISteamHTTP wrappers against a stand-in for Steam's HTTP client:
+///    coalescing of identical requests in flight, serving from the cache on
+///    disk, requests that may not be cached, cancellation and release of
+///    requests. Results of synthetic calls are checked both the way games
+///    registering call result receivers get them and the way games polling
+///    ISteamUtils do. The benchmark measures the cost of each path a request
+///    may take through the wrappers.
+///
+//===----------------------------------------------------------------------===//
+#include "steam_http.hpp"
+
+#include "call_results.hpp"
+#include "http_cache.hpp"
+#include "steam_api.hpp"
+#include "test.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace tek::game_runtime;
+using steam_api::CCallbackBase;
+using steam_api::http_request_completed;
+
+namespace {
+
+//===-- Stand-in for Steam ------------------------------------------------===//
+
+/// `EHTTPMethod` values.
+constexpr int method_get{1};
+constexpr int method_post{3};
+
+/// Response that the stand-in server returns for a URL.
+struct server_response {
+  std::string body;
+  std::map<std::string, std::string> headers;
+};
+
+/// Request created via the stand-in.
+struct fake_request {
+  std::string url;
+  std::uint64_t context_value;
+  /// Handle of the API call returned by SendHTTPRequest, or `0` if it hasn't
+  ///    been sent.
+  std::uint64_t call;
+  /// Response, once the request has completed.
+  const server_response *_Nullable response;
+};
+
+/// Responses of the stand-in server, keyed by URL.
+std::map<std::string, server_response> server;
+/// Requests created via the stand-in, keyed by handle.
+std::map<std::uint32_t, fake_request> requests;
+/// Handle of the next request.
+std::uint32_t next_request{1};
+/// Handle of the next API call, in the range used by Steam.
+std::uint64_t next_call{1};
+/// Call result receivers registered with the stand-in, keyed by API call
+///    handle.
+std::map<std::uint64_t, CCallbackBase *> receivers;
+/// Number of requests sent to the stand-in server.
+int num_sent;
+/// Value that the stand-in passes as the interface pointer.
+int iface_obj;
+void *const iface{&iface_obj};
+
+/// Stand-in for `SteamAPI_RegisterCallResult`, wrapped like the runtime
+///    wraps it.
+void register_call_result(CCallbackBase &receiver, std::uint64_t call) {
+  if (call_results::is_synthetic(call)) {
+    call_results::set_receiver(call, &receiver);
+  } else {
+    receivers[call] = steam_http::attach_receiver(call, &receiver);
+  }
+}
+
+/// Stand-in for `SteamAPI_UnregisterCallResult`, wrapped like the runtime
+///    wraps it.
+void unregister_call_result(std::uint64_t call) {
+  if (call_results::is_synthetic(call)) {
+    call_results::set_receiver(call, nullptr);
+  } else if (!steam_http::detach_receiver(call)) {
+    receivers.erase(call);
+  }
+}
+
+/// Complete all sent requests, running call result receivers registered for
+///    them like `SteamAPI_RunCallbacks` does.
+void complete_sent() {
+  for (auto &[handle, req] : requests) {
+    if (!req.call || req.response) {
+      continue;
+    }
+    const auto it{server.find(req.url)};
+    req.response = it == server.end() ? nullptr : &it->second;
+    http_request_completed data{
+        .request = handle,
+        .context_value = req.context_value,
+        .successful = req.response != nullptr,
+        .status_code = req.response ? 200 : 0,
+        .body_size = req.response ? static_cast<std::uint32_t>(
+                                        req.response->body.size())
+                                  : 0};
+    if (const auto rec{receivers.find(req.call)}; rec != receivers.end()) {
+      const auto receiver{rec->second};
+      receivers.erase(rec);
+      receiver->Run(&data, false, req.call);
+    }
+  }
+}
+
+/// Get the response of a completed stand-in request.
+const server_response *_Nullable response_of(std::uint32_t request) {
+  const auto it{requests.find(request)};
+  return it == requests.end() ? nullptr : it->second.response;
+}
+
+constexpr steam_http::backend fake_backend{
+    .CreateHTTPRequest =
+        [](void *, int, const char *url) {
+          const auto handle{next_request++};
+          requests.emplace(handle, fake_request{.url = url,
+                                                .context_value = 0,
+                                                .call = 0,
+                                                .response = nullptr});
+          return handle;
+        },
+    .SetHTTPRequestContextValue =
+        [](void *, std::uint32_t request, std::uint64_t value) {
+          const auto it{requests.find(request)};
+          if (it == requests.end()) {
+            return false;
+          }
+          it->second.context_value = value;
+          return true;
+        },
+    .SetHTTPRequestHeaderValue =
+        [](void *, std::uint32_t request, const char *, const char *) {
+          return requests.contains(request);
+        },
+    .SetHTTPRequestGetOrPostParameter =
+        [](void *, std::uint32_t request, const char *, const char *) {
+          return requests.contains(request);
+        },
+    .SendHTTPRequest =
+        [](void *, std::uint32_t request, std::uint64_t *call) {
+          const auto it{requests.find(request)};
+          if (it == requests.end() || it->second.call) {
+            return false;
+          }
+          it->second.call = next_call++;
+          if (call) {
+            *call = it->second.call;
+          }
+          ++num_sent;
+          return true;
+        },
+    .GetHTTPResponseHeaderSize =
+        [](void *, std::uint32_t request, const char *name,
+           std::uint32_t *size) {
+          const auto resp{response_of(request)};
+          if (!resp) {
+            return false;
+          }
+          const auto it{resp->headers.find(name)};
+          if (it == resp->headers.end()) {
+            return false;
+          }
+          // Steam reports header values with the null terminator
+          *size = it->second.size() + 1;
+          return true;
+        },
+    .GetHTTPResponseHeaderValue =
+        [](void *, std::uint32_t request, const char *name, std::uint8_t *buf,
+           std::uint32_t size) {
+          const auto resp{response_of(request)};
+          if (!resp) {
+            return false;
+          }
+          const auto it{resp->headers.find(name)};
+          if (it == resp->headers.end() || size < it->second.size() + 1) {
+            return false;
+          }
+          std::memcpy(buf, it->second.c_str(), it->second.size() + 1);
+          return true;
+        },
+    .GetHTTPResponseBodySize =
+        [](void *, std::uint32_t request, std::uint32_t *size) {
+          const auto resp{response_of(request)};
+          if (!resp) {
+            return false;
+          }
+          *size = resp->body.size();
+          return true;
+        },
+    .GetHTTPResponseBodyData =
+        [](void *, std::uint32_t request, std::uint8_t *buf,
+           std::uint32_t size) {
+          const auto resp{response_of(request)};
+          if (!resp || size < resp->body.size()) {
+            return false;
+          }
+          std::memcpy(buf, resp->body.data(), resp->body.size());
+          return true;
+        },
+    .ReleaseHTTPRequest =
+        [](void *, std::uint32_t request) {
+          return requests.erase(request) > 0;
+        },
+    .GetHTTPDownloadProgressPct =
+        [](void *, std::uint32_t request, float *pct) {
+          *pct = response_of(request) ? 100.0f : 0.0f;
+          return requests.contains(request);
+        },
+    .SetHTTPRequestRawPostBody =
+        [](void *, std::uint32_t request, const char *, std::uint8_t *,
+           std::uint32_t) { return requests.contains(request); },
+    .SetHTTPRequestCookieContainer =
+        [](void *, std::uint32_t request, std::uint32_t) {
+          return requests.contains(request);
+        }};
+
+//===-- Game side ---------------------------------------------------------===//
+
+/// Call result receiver of the game, like CCallResult.
+struct game_receiver final : CCallbackBase {
+  /// Number of delivered results.
+  int runs{};
+  /// The last delivered result.
+  http_request_completed last{};
+
+  game_receiver() { callback = http_request_completed::callback; }
+  void Run(void *param) override { Run(param, false, 0); }
+  void Run(void *param, bool, std::uint64_t) override {
+    ++runs;
+    last = *static_cast<const http_request_completed *>(param);
+  }
+  int GetCallbackSizeBytes() override {
+    return sizeof(http_request_completed);
+  }
+};
+
+/// Create and send a request like the game does.
+///
+/// @param url
+///    URL of the request.
+/// @param context_value
+///    Context value to set.
+/// @param method
+///    `EHTTPMethod` value of the request.
+/// @return Handles of the request and its API call, the latter is `0` if the
+///    request couldn't be sent.
+std::pair<std::uint32_t, std::uint64_t> send(const char *url,
+                                             std::uint64_t context_value,
+                                             int method = method_get) {
+  const auto request{steam_http::CreateHTTPRequest(iface, method, url)};
+  steam_http::SetHTTPRequestContextValue(iface, request, context_value);
+  steam_http::SetHTTPRequestHeaderValue(iface, request, "Accept",
+                                        "application/json");
+  std::uint64_t call{};
+  if (!steam_http::SendHTTPRequest(iface, request, &call)) {
+    call = 0;
+  }
+  return {request, call};
+}
+
+/// Poll a synthetic call like games polling ISteamUtils do.
+///
+/// @param call
+///    Handle of the call.
+/// @param [out] result
+///    Variable that receives the result.
+/// @return Value indicating whether the result has been fetched.
+bool poll(std::uint64_t call, http_request_completed &result) {
+  bool failed;
+  if (!call_results::is_completed(call, &failed) || failed) {
+    return false;
+  }
+  return call_results::get_result(call, &result, sizeof result,
+                                  http_request_completed::callback,
+                                  &failed) &&
+         !failed;
+}
+
+/// Read the body of a completed request via the wrappers.
+std::string read_body(std::uint32_t request) {
+  std::uint32_t size;
+  if (!steam_http::GetHTTPResponseBodySize(iface, request, &size)) {
+    return "<no body>";
+  }
+  std::string body(size, '\0');
+  if (!steam_http::GetHTTPResponseBodyData(
+          iface, request, reinterpret_cast<std::uint8_t *>(body.data()),
+          size)) {
+    return "<no body>";
+  }
+  return body;
+}
+
+/// Read a header of a completed request via the wrappers.
+std::string read_header(std::uint32_t request, const char *name) {
+  std::uint32_t size;
+  if (!steam_http::GetHTTPResponseHeaderSize(iface, request, name, &size)) {
+    return "<no header>";
+  }
+  std::string value(size, '\0');
+  if (!steam_http::GetHTTPResponseHeaderValue(
+          iface, request, name, reinterpret_cast<std::uint8_t *>(value.data()),
+          size)) {
+    return "<no header>";
+  }
+  return value;
+}
+
+/// Wait until the background job has written the response for a URL to the
+///    cache.
+///
+/// @return Value indicating whether the response has appeared in time.
+bool wait_cached(std::string_view url) {
+  const auto key{std::string{"GET "}.append(url).append(
+      "\nH:Accept:application/json")};
+  for (int i{}; i < 500; ++i) {
+    if (http_cache::get(key)) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+  return false;
+}
+
+//===-- Tests -------------------------------------------------------------===//
+
+/// Check that identical requests in flight are sent once, that followers get
+///    the response via receivers and via polling, and that the response is
+///    then served from the cache without reaching Steam.
+void test_coalescing() {
+  constexpr auto url{"https://api.example.com/mods?page=1"};
+  server[url] = {.body = R"({"mods":[1,2,3]})",
+                 .headers = {{"Cache-Control", "public, max-age=60"},
+                             {"Content-Type", "application/json"},
+                             {"X-Not-Stored", "1"}}};
+  num_sent = 0;
+  // The leader goes to Steam and gets a proxy in front of its receiver
+  const auto [leader, leader_call]{send(url, 11)};
+  CHECK(leader_call && !call_results::is_synthetic(leader_call));
+  game_receiver leader_rec;
+  register_call_result(leader_rec, leader_call);
+  CHECK(receivers[leader_call] != &leader_rec);
+  // A follower polled via ISteamUtils, and one with a receiver
+  const auto [polled, polled_call]{send(url, 22)};
+  const auto [received, received_call]{send(url, 33)};
+  CHECK(call_results::is_synthetic(polled_call));
+  CHECK(call_results::is_synthetic(received_call));
+  CHECK(num_sent == 1);
+  game_receiver follower_rec;
+  register_call_result(follower_rec, received_call);
+  bool failed{true};
+  CHECK(!call_results::is_completed(polled_call, &failed) && !failed);
+  http_request_completed result;
+  CHECK(!poll(polled_call, result));
+  complete_sent();
+  // The game's receiver gets the leader's result through the proxy
+  CHECK(leader_rec.runs == 1);
+  CHECK(leader_rec.last.request == leader);
+  CHECK(leader_rec.last.context_value == 11);
+  // Polling game gets the result without any dispatch
+  CHECK(call_results::is_completed(polled_call, &failed) && !failed);
+  // Wrong callback ID is rejected and doesn't consume the result
+  CHECK(!call_results::get_result(polled_call, &result, sizeof result, 2102,
+                                  &failed) &&
+        failed);
+  CHECK(poll(polled_call, result));
+  CHECK(result.request == polled && result.context_value == 22);
+  CHECK(result.successful && result.status_code == 200);
+  CHECK(result.body_size == server[url].body.size());
+  // The result is consumed by fetching it
+  CHECK(!call_results::is_completed(polled_call, &failed) && failed);
+  CHECK(read_body(polled) == server[url].body);
+  CHECK(read_header(polled, "content-type") == "application/json");
+  CHECK(read_header(polled, "X-Not-Stored") == "<no header>");
+  float pct{};
+  CHECK(steam_http::GetHTTPDownloadProgressPct(iface, polled, &pct) &&
+        pct == 100.0f);
+  // Receivers get results on the callback thread only
+  CHECK(follower_rec.runs == 0);
+  CHECK(call_results::dispatch() == 1);
+  CHECK(follower_rec.runs == 1);
+  CHECK(follower_rec.last.request == received);
+  CHECK(follower_rec.last.context_value == 33);
+  CHECK(call_results::dispatch() == 0);
+  for (const auto request : {leader, polled, received}) {
+    steam_http::ReleaseHTTPRequest(iface, request);
+  }
+  // Later requests are served from the cache and complete immediately
+  CHECK(wait_cached(url));
+  const auto [cached, cached_call]{send(url, 44)};
+  CHECK(call_results::is_synthetic(cached_call));
+  CHECK(poll(cached_call, result));
+  CHECK(result.request == cached && result.context_value == 44);
+  CHECK(result.body_size == server[url].body.size());
+  CHECK(read_body(cached) == server[url].body);
+  CHECK(read_header(cached, "Cache-Control") == "public, max-age=60");
+  // A receiver registered after completion still gets the result
+  const auto [late, late_call]{send(url, 55)};
+  game_receiver late_rec;
+  register_call_result(late_rec, late_call);
+  CHECK(call_results::dispatch() == 1);
+  CHECK(late_rec.runs == 1 && late_rec.last.request == late);
+  CHECK(num_sent == 1);
+  steam_http::ReleaseHTTPRequest(iface, cached);
+  steam_http::ReleaseHTTPRequest(iface, late);
+}
+
+/// Check that requests that may not be cached always reach Steam.
+void test_not_cacheable() {
+  constexpr auto url{"https://api.example.com/session"};
+  server[url] = {.body = "token",
+                 .headers = {{"Cache-Control", "no-store"}}};
+  num_sent = 0;
+  // POST requests
+  const auto [post, post_call]{send(url, 1, method_post)};
+  CHECK(post_call && !call_results::is_synthetic(post_call));
+  // Requests with cookies
+  const auto cookie{steam_http::CreateHTTPRequest(iface, method_get, url)};
+  steam_http::SetHTTPRequestCookieContainer(iface, cookie, 7);
+  std::uint64_t cookie_call{};
+  CHECK(steam_http::SendHTTPRequest(iface, cookie, &cookie_call));
+  CHECK(!call_results::is_synthetic(cookie_call));
+  // Requests without a call handle
+  const auto no_call{steam_http::CreateHTTPRequest(iface, method_get, url)};
+  CHECK(steam_http::SendHTTPRequest(iface, no_call, nullptr));
+  CHECK(num_sent == 3);
+  // Responses that forbid caching are not served to later requests
+  const auto [first, first_call]{send(url, 2)};
+  game_receiver rec;
+  register_call_result(rec, first_call);
+  complete_sent();
+  CHECK(rec.runs == 1);
+  // The game reads responses of requests handled by Steam from Steam
+  CHECK(read_body(first) == "token");
+  const auto [second, second_call]{send(url, 3)};
+  CHECK(!call_results::is_synthetic(second_call));
+  CHECK(num_sent == 5);
+  for (const auto request : {post, cookie, no_call, first, second}) {
+    steam_http::ReleaseHTTPRequest(iface, request);
+  }
+}
+
+/// Check cancellation of synthetic calls and release of requests that others
+///    wait for.
+void test_cancel() {
+  constexpr auto url{"https://api.example.com/slow"};
+  server[url] = {.body = "slow",
+                 .headers = {{"Cache-Control", "max-age=60"}}};
+  const auto [leader, leader_call]{send(url, 1)};
+  game_receiver leader_rec;
+  register_call_result(leader_rec, leader_call);
+  const auto [cancelled, cancelled_call]{send(url, 2)};
+  game_receiver cancelled_rec;
+  register_call_result(cancelled_rec, cancelled_call);
+  unregister_call_result(cancelled_call);
+  const auto [waiting, waiting_call]{send(url, 3)};
+  CHECK(call_results::is_synthetic(waiting_call));
+  // Releasing the leader fails requests waiting for it
+  steam_http::ReleaseHTTPRequest(iface, leader);
+  http_request_completed result;
+  CHECK(poll(waiting_call, result));
+  CHECK(result.request == waiting && !result.successful);
+  // The cancelled call is dropped, and nothing reaches its receiver
+  bool failed{};
+  CHECK(!call_results::is_completed(cancelled_call, &failed) && failed);
+  CHECK(call_results::dispatch() == 0);
+  CHECK(cancelled_rec.runs == 0);
+  // The game cancelling the leader's call detaches its receiver
+  const auto [next, next_call]{send(url, 4)};
+  game_receiver next_rec;
+  register_call_result(next_rec, next_call);
+  unregister_call_result(next_call);
+  complete_sent();
+  CHECK(next_rec.runs == 0);
+  steam_http::ReleaseHTTPRequest(iface, cancelled);
+  steam_http::ReleaseHTTPRequest(iface, waiting);
+  steam_http::ReleaseHTTPRequest(iface, next);
+}
+
+//===-- Benchmark ---------------------------------------------------------===//
+
+/// Measure the cost of each path a request may take through the wrappers:
+///    forwarded to Steam, waiting for an identical request, and served from
+///    the cache on disk.
+void bench() {
+  constexpr auto url{"https://api.example.com/bench"};
+  server[url] = {.body = std::string(16 * 1024, 'b'),
+                 .headers = {{"Cache-Control", "max-age=600"}}};
+  constexpr int num_requests{2000};
+  /// Run the game's side of a request and report average time per request.
+  const auto measure{[](const char *name, auto &&fn) {
+    const auto time{test::time_s([&] {
+      for (int i{}; i < num_requests; ++i) {
+        fn();
+      }
+    })};
+    test::report(name, time / num_requests * 1e6, "us/request");
+  }};
+  measure("forwarded to Steam (POST)", [&] {
+    const auto [request, call]{send(url, 0, method_post)};
+    steam_http::ReleaseHTTPRequest(iface, request);
+  });
+  const auto [leader, leader_call]{send(url, 0)};
+  game_receiver leader_rec;
+  register_call_result(leader_rec, leader_call);
+  std::vector<std::uint32_t> followers;
+  followers.reserve(num_requests);
+  measure("coalesced with a request in flight", [&] {
+    followers.emplace_back(send(url, 0).first);
+  });
+  const auto complete_time{test::time_s(complete_sent)};
+  test::report("completing coalesced requests",
+               complete_time / num_requests * 1e6, "us/request");
+  http_request_completed result;
+  bool failed;
+  for (const auto request : followers) {
+    steam_http::ReleaseHTTPRequest(iface, request);
+  }
+  steam_http::ReleaseHTTPRequest(iface, leader);
+  if (!wait_cached(url)) {
+    return;
+  }
+  measure("served from the cache, polled", [&] {
+    const auto [request, call]{send(url, 0)};
+    call_results::get_result(call, &result, sizeof result,
+                             http_request_completed::callback, &failed);
+    read_body(request);
+    steam_http::ReleaseHTTPRequest(iface, request);
+  });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const auto dir{std::filesystem::temp_directory_path() /
+                 ("tek-gr-http-test-" + std::to_string(getpid()))};
+  http_cache::open(dir);
+  steam_http::init(fake_backend);
+  if (test::bench_mode(argc, argv)) {
+    bench();
+  } else {
+    test_coalescing();
+    test_not_cacheable();
+    test_cancel();
+  }
+  std::filesystem::remove_all(dir);
+  return test::result();
+}
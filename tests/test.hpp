@@ -0,0 +1,105 @@
+//===-- test.hpp - helpers shared by test executables ---------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Minimal check and timing helpers for test and benchmark executables. Each
+///    executable runs its checks in `main` and returns @ref test::result(),
+///    which is non-zero if any check has failed. Benchmarks are the same
+///    executables run with `--bench` argument.
+///
+//===----------------------------------------------------------------------===//
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <source_location>
+#include <string_view>
+
+namespace tek::game_runtime::test {
+
+/// Number of failed checks.
+inline int failures;
+
+/// Record the result of a check, printing its location if it has failed.
+///
+/// @param passed
+///    Value indicating whether the check has passed.
+/// @param expr
+///    Text of the checked expression.
+/// @param loc
+///    Location of the check.
+inline void check(bool passed, std::string_view expr,
+                  std::source_location loc = std::source_location::current()) {
+  if (!passed) {
+    ++failures;
+    std::fprintf(stderr, "%s:%u: check failed: %.*s\n", loc.file_name(),
+                 static_cast<unsigned>(loc.line()),
+                 static_cast<int>(expr.size()), expr.data());
+  }
+}
+
+/// Get the exit status of the test executable.
+///
+/// @return `0` if all checks have passed, `1` otherwise.
+inline int result() {
+  if (failures) {
+    std::fprintf(stderr, "%d check(s) failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
+
+/// Check whether the executable has been run as a benchmark.
+///
+/// @param argc
+///    `argc` argument of `main`.
+/// @param argv
+///    `argv` argument of `main`.
+/// @return Value indicating whether `--bench` argument is present.
+inline bool bench_mode(int argc, char **argv) {
+  for (int i{1}; i < argc; ++i) {
+    if (std::string_view{argv[i]} == "--bench") {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Measure wall-clock time of a function call.
+///
+/// @param fn
+///    The function to call.
+/// @return Elapsed time in seconds.
+template <typename Fn> double time_s(Fn &&fn) {
+  const auto start{std::chrono::steady_clock::now()};
+  fn();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+/// Print a benchmark result line.
+///
+/// @param name
+///    Name of the measured case.
+/// @param value
+///    Measured value.
+/// @param unit
+///    Unit of @p value.
+inline void report(std::string_view name, double value, std::string_view unit) {
+  std::printf("%-48.*s %12.3f %.*s\n", static_cast<int>(name.size()),
+              name.data(), value, static_cast<int>(unit.size()), unit.data());
+}
+
+} // namespace tek::game_runtime::test
+
+/// Check that an expression is true, see @ref tek::game_runtime::test::check.
+#define CHECK(expr)                                                            \
+  ::tek::game_runtime::test::check(static_cast<bool>(expr), #expr)
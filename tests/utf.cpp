@@ -0,0 +1,382 @@
+//===-- utf.cpp - tests for UTF-8/UTF-16 transcoding ----------------------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of the transcoders against a per-code-point scalar reference on
+///    random well-formed strings, including non-ASCII characters at every
+///    position around SSE2 chunk boundaries, and against known replacements
+///    of ill-formed sequences. The benchmark compares throughput with the
+///    scalar reference on ASCII paths and mixed text.
+///
+//===----------------------------------------------------------------------===//
+#include "utf.hpp"
+
+#include "test.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace tek::game_runtime;
+
+namespace {
+
+//===-- Scalar reference --------------------------------------------------===//
+
+/// Encode a code point as UTF-8.
+///
+/// @param cp
+///    The code point.
+/// @param [out] dst
+///    Buffer that receives encoded code point.
+/// @return Number of bytes written.
+std::size_t encode_utf8(std::uint32_t cp, char *dst) {
+  if (cp < 0x80) {
+    dst[0] = static_cast<char>(cp);
+    return 1;
+  }
+  if (cp < 0x800) {
+    dst[0] = static_cast<char>(0xC0 | (cp >> 6));
+    dst[1] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    dst[0] = static_cast<char>(0xE0 | (cp >> 12));
+    dst[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    dst[2] = static_cast<char>(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  dst[0] = static_cast<char>(0xF0 | (cp >> 18));
+  dst[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+  dst[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+  dst[3] = static_cast<char>(0x80 | (cp & 0x3F));
+  return 4;
+}
+
+/// Encode a code point as UTF-16.
+///
+/// @param cp
+///    The code point.
+/// @param [out] dst
+///    Buffer that receives encoded code point.
+/// @return Number of code units written.
+std::size_t encode_utf16(std::uint32_t cp, char16_t *dst) {
+  if (cp < 0x10000) {
+    dst[0] = static_cast<char16_t>(cp);
+    return 1;
+  }
+  cp -= 0x10000;
+  dst[0] = static_cast<char16_t>(0xD800 | (cp >> 10));
+  dst[1] = static_cast<char16_t>(0xDC00 | (cp & 0x3FF));
+  return 2;
+}
+
+/// Append a code point to a UTF-8 string.
+void append_utf8(std::string &str, std::uint32_t cp) {
+  char buf[4];
+  str.append(buf, encode_utf8(cp, buf));
+}
+
+/// Append a code point to a UTF-16 string.
+void append_utf16(std::u16string &str, std::uint32_t cp) {
+  char16_t buf[2];
+  str.append(buf, encode_utf16(cp, buf));
+}
+
+/// Scalar reference conversion of a well-formed UTF-8 string to UTF-16, one
+///    code point at a time.
+std::size_t ref_to_utf16(std::string_view src, char16_t *dst) {
+  std::size_t len{};
+  for (std::size_t i{}; i < src.size();) {
+    const auto lead{static_cast<unsigned char>(src[i])};
+    const std::size_t seq_len{lead < 0x80   ? 1u
+                              : lead < 0xE0 ? 2u
+                              : lead < 0xF0 ? 3u
+                                            : 4u};
+    std::uint32_t cp{seq_len == 1 ? lead : lead & (0x7Fu >> seq_len)};
+    for (std::size_t j{1}; j < seq_len; ++j) {
+      cp = (cp << 6) | (static_cast<unsigned char>(src[i + j]) & 0x3F);
+    }
+    len += encode_utf16(cp, &dst[len]);
+    i += seq_len;
+  }
+  return len;
+}
+
+/// Scalar reference conversion of a well-formed UTF-16 string to UTF-8, one
+///    code point at a time.
+std::size_t ref_to_utf8(std::u16string_view src, char *dst) {
+  std::size_t len{};
+  for (std::size_t i{}; i < src.size(); ++i) {
+    std::uint32_t cp{src[i]};
+    if (cp >= 0xD800 && cp <= 0xDBFF) {
+      cp = 0x10000 + ((cp - 0xD800) << 10) + (src[++i] - 0xDC00);
+    }
+    len += encode_utf8(cp, &dst[len]);
+  }
+  return len;
+}
+
+//===-- Helpers -----------------------------------------------------------===//
+
+/// Convert a UTF-8 string with the tested transcoder.
+utf::result convert(std::string_view src, std::u16string &dst) {
+  dst.resize(src.size());
+  const auto res{utf::to_utf16(src, dst.data())};
+  dst.resize(res.length);
+  return res;
+}
+
+/// Convert a UTF-16 string with the tested transcoder.
+utf::result convert(std::u16string_view src, std::string &dst) {
+  dst.resize(src.size() * 3);
+  const auto res{utf::to_utf8(src, dst.data())};
+  dst.resize(res.length);
+  return res;
+}
+
+/// Generate a random code point from a mix of ASCII, 2-, 3- and 4-byte
+///    ranges, excluding surrogates.
+std::uint32_t random_cp(std::mt19937 &rng, int ascii_percent) {
+  std::uniform_int_distribution<int> pct{0, 99};
+  if (pct(rng) < ascii_percent) {
+    return std::uniform_int_distribution<std::uint32_t>{0, 0x7F}(rng);
+  }
+  switch (pct(rng) % 3) {
+  case 0:
+    return std::uniform_int_distribution<std::uint32_t>{0x80, 0x7FF}(rng);
+  case 1: {
+    const auto cp{
+        std::uniform_int_distribution<std::uint32_t>{0x800, 0xFFFF}(rng)};
+    return cp >= 0xD800 && cp <= 0xDFFF ? cp - 0x1000 : cp;
+  }
+  default:
+    return std::uniform_int_distribution<std::uint32_t>{0x10000,
+                                                        0x10FFFF}(rng);
+  }
+}
+
+/// Check conversion of a well-formed string, given as code points, in both
+///    directions.
+void check_valid(const std::vector<std::uint32_t> &cps) {
+  std::string utf8;
+  std::u16string utf16;
+  for (const auto cp : cps) {
+    append_utf8(utf8, cp);
+    append_utf16(utf16, cp);
+  }
+  std::u16string out16;
+  auto res{convert(utf8, out16)};
+  CHECK(res.valid);
+  CHECK(out16 == utf16);
+  std::string out8;
+  res = convert(utf16, out8);
+  CHECK(res.valid);
+  CHECK(out8 == utf8);
+  // The reference agrees on the same input
+  std::u16string ref16(utf8.size(), u'\0');
+  ref16.resize(ref_to_utf16(utf8, ref16.data()));
+  CHECK(ref16 == utf16);
+  std::string ref8(utf16.size() * 3, '\0');
+  ref8.resize(ref_to_utf8(utf16, ref8.data()));
+  CHECK(ref8 == utf8);
+}
+
+//===-- Tests -------------------------------------------------------------===//
+
+/// Check random well-formed strings of various lengths and compositions.
+void test_random_valid() {
+  std::mt19937 rng{12345};
+  for (int i{}; i < 20000; ++i) {
+    const auto len{std::uniform_int_distribution<std::size_t>{0, 80}(rng)};
+    const int ascii_percent{i % 4 * 33};
+    std::vector<std::uint32_t> cps;
+    for (std::size_t j{}; j < len; ++j) {
+      cps.push_back(random_cp(rng, ascii_percent));
+    }
+    check_valid(cps);
+  }
+}
+
+/// Check a single non-ASCII character at every position of ASCII strings
+///    around SSE2 chunk sizes, so that every exit from the vector loops is
+///    exercised.
+void test_chunk_boundaries() {
+  for (const std::uint32_t special : {0xE9u, 0x4E2Du, 0x1F600u}) {
+    for (std::size_t len{1}; len <= 40; ++len) {
+      for (std::size_t pos{}; pos < len; ++pos) {
+        std::vector<std::uint32_t> cps(len, 'a' + len % 26);
+        cps[pos] = special;
+        check_valid(cps);
+      }
+    }
+  }
+}
+
+/// Check replacement of ill-formed UTF-8 sequences.
+void test_invalid_utf8() {
+  struct test_case {
+    std::string_view input;
+    std::u16string_view expected;
+  };
+  constexpr test_case cases[]{
+      // Stray continuation byte
+      {"a\x80z", u"a\uFFFDz"},
+      // Invalid lead bytes
+      {"\xFF\xFE", u"\uFFFD\uFFFD"},
+      // Truncated sequences, at the end and before another character
+      {"ab\xE4\xB8", u"ab\uFFFD"},
+      {"\xE4\xB8z", u"\uFFFDz"},
+      {"\xF0\x9F\x98", u"\uFFFD"},
+      // Overlong encodings
+      {"\xC0\x80", u"\uFFFD"},
+      {"\xE0\x80\xAF", u"\uFFFD"},
+      {"\xF0\x80\x80\xAF", u"\uFFFD"},
+      // Encoded surrogate
+      {"\xED\xA0\x80", u"\uFFFD"},
+      // Beyond U+10FFFF
+      {"\xF4\x90\x80\x80", u"\uFFFD"},
+      // Ill-formed sequence after a full SSE2 chunk
+      {"0123456789abcdef\x80", u"0123456789abcdef\uFFFD"},
+  };
+  for (const auto &[input, expected] : cases) {
+    std::u16string out;
+    const auto res{convert(input, out)};
+    CHECK(!res.valid);
+    CHECK(out == expected);
+  }
+}
+
+/// Check replacement of unpaired surrogates in UTF-16.
+void test_invalid_utf16() {
+  struct test_case {
+    std::u16string input;
+    std::string_view expected;
+  };
+  const test_case cases[]{
+      {{u'a', char16_t{0xD800}}, "a\xEF\xBF\xBD"},
+      {{char16_t{0xDC00}, u'b'}, "\xEF\xBF\xBD" "b"},
+      {{char16_t{0xD800}, char16_t{0xD800}, char16_t{0xDC00}},
+       "\xEF\xBF\xBD\xF0\x90\x80\x80"},
+      {{u'0', u'1', u'2', u'3', u'4', u'5', u'6', u'7', char16_t{0xDFFF}},
+       "01234567\xEF\xBF\xBD"},
+  };
+  for (const auto &[input, expected] : cases) {
+    std::string out;
+    const auto res{convert(input, out)};
+    CHECK(!res.valid);
+    CHECK(out == expected);
+  }
+}
+
+/// Check that random byte strings always produce well-formed output within
+///    buffer bounds.
+void test_random_bytes() {
+  std::mt19937 rng{54321};
+  std::uniform_int_distribution<int> byte{0, 255};
+  for (int i{}; i < 20000; ++i) {
+    std::string input(std::uniform_int_distribution<int>{0, 64}(rng), '\0');
+    for (auto &c : input) {
+      // Bias towards ASCII to exercise the vector loops too
+      c = static_cast<char>(byte(rng) < 128 ? byte(rng) % 0x80 : byte(rng));
+    }
+    std::u16string out16;
+    const auto res{convert(input, out16)};
+    CHECK(out16.size() <= input.size());
+    std::string out8;
+    CHECK(convert(out16, out8).valid);
+    // Well-formed input must round-trip unchanged
+    if (res.valid) {
+      CHECK(out8 == input);
+    }
+  }
+}
+
+//===-- Benchmark ---------------------------------------------------------===//
+
+/// Measure throughput of the transcoders and the scalar reference on a
+///    string.
+///
+/// @param name
+///    Name of the input kind.
+/// @param utf8
+///    The input string.
+void bench_input(std::string_view name, const std::string &utf8) {
+  constexpr int num_iters{2000};
+  const auto total_bytes{static_cast<double>(utf8.size()) * num_iters};
+  std::u16string out16(utf8.size(), u'\0');
+  std::size_t sink{};
+  auto time{test::time_s([&] {
+    for (int i{}; i < num_iters; ++i) {
+      sink += utf::to_utf16(utf8, out16.data()).length;
+    }
+  })};
+  test::report(std::string{"utf::to_utf16, "}.append(name),
+               total_bytes / time / 1e9, "GB/s");
+  time = test::time_s([&] {
+    for (int i{}; i < num_iters; ++i) {
+      sink += ref_to_utf16(utf8, out16.data());
+    }
+  });
+  test::report(std::string{"scalar reference to UTF-16, "}.append(name),
+               total_bytes / time / 1e9, "GB/s");
+  std::u16string utf16(utf8.size(), u'\0');
+  utf16.resize(ref_to_utf16(utf8, utf16.data()));
+  std::string out8(utf16.size() * 3, '\0');
+  time = test::time_s([&] {
+    for (int i{}; i < num_iters; ++i) {
+      sink += utf::to_utf8(utf16, out8.data()).length;
+    }
+  });
+  test::report(std::string{"utf::to_utf8, "}.append(name),
+               total_bytes / time / 1e9, "GB/s");
+  time = test::time_s([&] {
+    for (int i{}; i < num_iters; ++i) {
+      sink += ref_to_utf8(utf16, out8.data());
+    }
+  });
+  test::report(std::string{"scalar reference to UTF-8, "}.append(name),
+               total_bytes / time / 1e9, "GB/s");
+  CHECK(sink > 0);
+}
+
+/// Run the benchmark on ASCII paths and mixed text of 64 KiB.
+void bench() {
+  std::string paths;
+  while (paths.size() < 64 * 1024) {
+    paths += "C:/Program Files (x86)/Steam/steamapps/workshop/content/346110/"
+             "2473890245/Mods/Structures/";
+  }
+  bench_input("ASCII paths", paths);
+  std::mt19937 rng{1};
+  std::string mixed;
+  while (mixed.size() < 64 * 1024) {
+    append_utf8(mixed, random_cp(rng, 80));
+  }
+  bench_input("80% ASCII text", mixed);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (test::bench_mode(argc, argv)) {
+    bench();
+  } else {
+    test_random_valid();
+    test_chunk_boundaries();
+    test_invalid_utf8();
+    test_invalid_utf16();
+    test_random_bytes();
+  }
+  return test::result();
+}
@@ -0,0 +1,478 @@
+//===-- ws_jobs.cpp - tests for Steam Workshop item job scheduling --------===//
+//
+// Copyright (c) 2025 Nuclearist <nuclearist@teknology-hub.com>
+// Part of tek-game-runtime, under the GNU General Public License v3.0 or later
+// See https://github.com/teknology-hub/tek-game-runtime/blob/main/COPYING for
+//    license information.
+// SPDX-License-Identifier: GPL-3.0-or-later
+//
+//===----------------------------------------------------------------------===//
+///
+/// @file
+/// Tests of Steam Workshop item job scheduling against a fake application
+///    manager backend: batching of install requests, handling of up-to-date
+///    items and failures, parallel downloads, background update checks, and
+///    installation into a store shared by two processes, like two dedicated
+///    server instances on one host. The benchmark measures cold-start time of
+///    a server that needs a set of mods, with downloads made one by one and
+///    with the scheduler.
+///
+//===----------------------------------------------------------------------===//
+#include "ws_jobs.hpp"
+
+#include "test.hpp"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <ranges>
+#include <string>
+#include <tek-steamclient/am.h>
+#include <tek-steamclient/error.h>
+#include <thread>
+#include <vector>
+
+using namespace tek::game_runtime;
+using namespace std::chrono_literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+/// State of an item in the fake application manager.
+struct fake_item {
+  /// Descriptor of the item, handed out to the scheduler.
+  tek_sc_am_item_desc desc{};
+  /// Value indicating whether the installed version is the latest one.
+  bool up_to_date{};
+  /// Value indicating whether job creation fails.
+  bool create_fails{};
+  /// Value indicating whether the job fails.
+  bool run_fails{};
+  /// Number of jobs created.
+  int creates{};
+  /// Number of jobs run.
+  int runs{};
+};
+
+/// In-memory application manager with items that take time to download.
+struct fake_am {
+  std::mutex mtx;
+  std::condition_variable cv;
+  /// Items, keyed by Steam Workshop item ID.
+  std::map<std::uint64_t, fake_item> items;
+  /// Value indicating whether creation of the instance fails.
+  bool init_fails{};
+  /// Duration of each job.
+  std::chrono::milliseconds run_time{};
+  /// Number of jobs currently running.
+  int running{};
+  /// Highest number of jobs that have been running at the same time.
+  int max_running{};
+  /// Shared store directory, which marks installed items with files, or empty
+  ///    if items are tracked in @ref items only.
+  fs::path store;
+};
+
+fake_am am;
+
+/// Get the item with specified ID, creating it if it doesn't exist. Must be
+///    called with the mutex locked.
+fake_item &item(std::uint64_t id) {
+  auto &item{am.items[id]};
+  item.desc.id = {.app_id = 346110, .depot_id = 346110, .ws_item_id = id};
+  return item;
+}
+
+/// Get path to the file that marks an item as installed in the shared store.
+fs::path marker(std::uint64_t id) {
+  return am.store / std::to_string(id);
+}
+
+constexpr ws_jobs::backend fake_backend{
+    .init =
+        [](const tek_sc_os_char *, const tek_sc_os_char *) {
+          const std::scoped_lock lock{am.mtx};
+          return !am.init_fails;
+        },
+    .get_item_desc =
+        [](const tek_sc_item_id *item_id) -> tek_sc_am_item_desc * {
+          const std::scoped_lock lock{am.mtx};
+          const auto it{am.items.find(item_id->ws_item_id)};
+          return it == am.items.end() ? nullptr : &it->second.desc;
+        },
+    .create_job =
+        [](const tek_sc_item_id *item_id, tek_sc_am_item_desc **item_desc) {
+          const std::scoped_lock lock{am.mtx};
+          auto &entry{item(item_id->ws_item_id)};
+          ++entry.creates;
+          *item_desc = &entry.desc;
+          tek_sc_err res{};
+          if (entry.create_fails) {
+            // Any error code other than TEK_SC_ERRC_up_to_date
+            res.primary = static_cast<tek_sc_errc>(1);
+            *item_desc = nullptr;
+          } else if (entry.up_to_date ||
+                     (!am.store.empty() &&
+                      fs::exists(marker(item_id->ws_item_id)))) {
+            res.primary = TEK_SC_ERRC_up_to_date;
+          } else {
+            entry.desc.status |= TEK_SC_AM_ITEM_STATUS_job;
+          }
+          am.cv.notify_all();
+          return res;
+        },
+    .run_job =
+        [](tek_sc_am_item_desc *desc, tek_sc_am_job_upd_func *upd_handler) {
+          std::unique_lock lock{am.mtx};
+          am.max_running = std::max(am.max_running, ++am.running);
+          const auto run_time{am.run_time};
+          lock.unlock();
+          desc->job.stage = TEK_SC_AM_JOB_STAGE_downloading;
+          upd_handler(desc, TEK_SC_AM_UPD_TYPE_stage);
+          std::this_thread::sleep_for(run_time);
+          desc->job.progress_current = 1024;
+          upd_handler(desc, TEK_SC_AM_UPD_TYPE_progress);
+          lock.lock();
+          const auto id{desc->id.ws_item_id};
+          if (!am.store.empty()) {
+            std::ofstream{marker(id), std::ios::app} << "run\n";
+          }
+          auto &entry{item(id)};
+          entry.desc.status &= ~TEK_SC_AM_ITEM_STATUS_job;
+          ++entry.runs;
+          --am.running;
+          am.cv.notify_all();
+          tek_sc_err res{};
+          if (entry.run_fails) {
+            res.primary = static_cast<tek_sc_errc>(1);
+          } else {
+            entry.up_to_date = true;
+          }
+          return res;
+        }};
+
+/// Number of calls to @ref on_finish.
+std::atomic_int finishes;
+/// Number of calls to @ref on_finish with a result other than success or
+///    `TEK_SC_ERRC_up_to_date`.
+std::atomic_int failures;
+
+/// Finish handler of the game.
+void on_finish(tek_sc_am_item_desc *, const tek_sc_err &result) {
+  finishes.fetch_add(1, std::memory_order::relaxed);
+  if (!tek_sc_err_success(&result) &&
+      result.primary != TEK_SC_ERRC_up_to_date) {
+    failures.fetch_add(1, std::memory_order::relaxed);
+  }
+}
+
+/// Wait until a condition on the fake application manager becomes true.
+///
+/// @param pred
+///    The condition, checked with the mutex locked.
+/// @return Value indicating whether the condition has become true within 10
+///    seconds.
+template <typename Pred> bool wait_for(Pred &&pred) {
+  std::unique_lock lock{am.mtx};
+  return am.cv.wait_for(lock, 10s, pred);
+}
+
+/// Wait until install requests are resolved.
+///
+/// @param ids
+///    IDs of the requested items.
+/// @return Value indicating whether all requests have been resolved within 10
+///    seconds.
+bool wait_resolved(std::initializer_list<std::uint64_t> ids) {
+  const auto deadline{std::chrono::steady_clock::now() + 10s};
+  while (std::ranges::any_of(ids, ws_jobs::install_pending)) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+/// Wait until @ref on_finish has been called a number of times.
+///
+/// @param n
+///    The number of calls.
+/// @return Value indicating whether the handler has been called @p n times
+///    within 10 seconds.
+bool wait_finishes(int n) {
+  const auto deadline{std::chrono::steady_clock::now() + 10s};
+  while (finishes < n) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+  return true;
+}
+
+/// Check that requests made within the install window are resolved together,
+///    and that their jobs are run.
+void test_install() {
+  std::array<tek_sc_am_item_desc *, 3> descs;
+  finishes = 0;
+  const auto start{std::chrono::steady_clock::now()};
+  for (int i{}; i < 3; ++i) {
+    ws_jobs::install("am", "ws", 101 + i, on_finish, &descs[i]);
+  }
+  CHECK(ws_jobs::install_pending(101));
+  CHECK(wait_resolved({101, 102, 103}));
+  CHECK(std::chrono::steady_clock::now() - start >= ws_jobs::install_window);
+  CHECK(wait_for([] {
+    return item(101).runs && item(102).runs && item(103).runs;
+  }));
+  CHECK(wait_finishes(3));
+  const std::scoped_lock lock{am.mtx};
+  for (int i{}; i < 3; ++i) {
+    CHECK(descs[i] == &item(101 + i).desc);
+    CHECK(item(101 + i).creates == 1);
+  }
+}
+
+/// Check requests for up-to-date items, items that fail job creation, items
+///    that already have a job, and items which job fails.
+void test_install_outcomes() {
+  {
+    const std::scoped_lock lock{am.mtx};
+    item(201).up_to_date = true;
+    item(202).create_fails = true;
+    item(203).desc.status |= TEK_SC_AM_ITEM_STATUS_job;
+    item(204).run_fails = true;
+  }
+  tek_sc_am_item_desc *up_to_date;
+  tek_sc_am_item_desc *failed;
+  tek_sc_am_item_desc *existing;
+  tek_sc_am_item_desc *run_failed;
+  finishes = 0;
+  failures = 0;
+  ws_jobs::install("am", "ws", 201, on_finish, &up_to_date);
+  ws_jobs::install("am", "ws", 202, on_finish, &failed);
+  ws_jobs::install("am", "ws", 203, on_finish, &existing);
+  ws_jobs::install("am", "ws", 204, on_finish, &run_failed);
+  CHECK(wait_resolved({201, 202, 203, 204}));
+  CHECK(wait_for([] { return item(203).runs == 1 && item(204).runs == 1; }));
+  // The handler is called after the job function returns
+  CHECK(wait_finishes(3));
+  const std::scoped_lock lock{am.mtx};
+  // Up-to-date items get their descriptor and a finish call, but no job
+  CHECK(up_to_date == &item(201).desc);
+  CHECK(item(201).runs == 0);
+  // Items which job fails get the failure passed to the handler
+  CHECK(run_failed == &item(204).desc);
+  CHECK(finishes == 3);
+  CHECK(failures == 1);
+  CHECK(!failed);
+  CHECK(item(202).runs == 0);
+  // Existing jobs are run without creating new ones
+  CHECK(existing == &item(203).desc);
+  CHECK(item(203).creates == 0);
+}
+
+/// Check that requests are resolved even if the application manager is not
+///    available.
+void test_init_failure() {
+  {
+    const std::scoped_lock lock{am.mtx};
+    am.init_fails = true;
+  }
+  auto desc{reinterpret_cast<tek_sc_am_item_desc *>(1)};
+  ws_jobs::install("am", "ws", 301, on_finish, &desc);
+  CHECK(wait_resolved({301}));
+  CHECK(!desc);
+  const std::scoped_lock lock{am.mtx};
+  CHECK(!am.items.contains(301));
+  am.init_fails = false;
+}
+
+/// Check that downloads run in parallel on the install pool.
+void test_parallel() {
+  {
+    const std::scoped_lock lock{am.mtx};
+    am.run_time = 200ms;
+    am.max_running = 0;
+  }
+  std::array<tek_sc_am_item_desc *, 4> descs;
+  for (int i{}; i < 4; ++i) {
+    ws_jobs::install("am", "ws", 401 + i, on_finish, &descs[i]);
+  }
+  CHECK(wait_for([] {
+    return std::ranges::all_of(std::views::iota(401, 405),
+                               [](auto id) { return item(id).runs == 1; });
+  }));
+  const std::scoped_lock lock{am.mtx};
+  CHECK(am.max_running == 2);
+  am.run_time = {};
+}
+
+/// IDs passed to @ref on_check.
+std::vector<std::uint64_t> checked;
+/// IDs and descriptors passed to @ref on_update.
+std::map<std::uint64_t, tek_sc_am_item_desc *> updated;
+/// Mutex for locking concurrent access to @ref checked and @ref updated.
+std::mutex callbacks_mtx;
+
+/// Update check callback, declining updates of item 503.
+bool on_check(std::uint64_t id) {
+  const std::scoped_lock lock{callbacks_mtx};
+  checked.push_back(id);
+  return id != 503;
+}
+
+/// Update callback, declining to start the job of item 504.
+bool on_update(std::uint64_t id, tek_sc_am_item_desc *desc) {
+  const std::scoped_lock lock{callbacks_mtx};
+  updated.emplace(id, desc);
+  return id != 504;
+}
+
+/// Check background update checks: up-to-date items, outdated ones, ones
+///    declined before and after job creation, and ones that already have a
+///    job.
+void test_update() {
+  {
+    const std::scoped_lock lock{am.mtx};
+    item(501).up_to_date = true;
+    item(505).desc.status |= TEK_SC_AM_ITEM_STATUS_job;
+  }
+  std::vector<std::uint64_t> ids;
+  // More than one batch
+  for (std::uint64_t id{501}; id < 506 + ws_jobs::upd_batch_size; ++id) {
+    ids.push_back(id);
+  }
+  ws_jobs::update("am", "ws", ids, on_finish, on_check, on_update);
+  CHECK(wait_for([] { return item(502).runs && item(506).runs; }));
+  CHECK(wait_for([&] { return item(ids.back()).runs == 1; }));
+  const std::scoped_lock lock{am.mtx, callbacks_mtx};
+  // Items with jobs are skipped without asking
+  CHECK(std::ranges::find(checked, 505) == checked.end());
+  CHECK(checked.size() == ids.size() - 1);
+  // Declined items don't get a job created
+  CHECK(item(503).creates == 0);
+  CHECK(!updated.contains(503));
+  CHECK(updated.contains(501) && !updated[501]);
+  CHECK(updated[502] == &item(502).desc);
+  // Jobs declined after creation are left to the caller
+  CHECK(item(504).creates == 1 && item(504).runs == 0);
+  CHECK(item(501).runs == 0);
+  CHECK(item(505).runs == 0);
+}
+
+/// Install an item into the shared store and wait until it's done. Run in
+///    two processes at once.
+///
+/// @param id
+///    ID of the item.
+/// @return Value indicating whether the item has been installed.
+bool install_into_store(std::uint64_t id) {
+  tek_sc_am_item_desc *desc;
+  finishes = 0;
+  ws_jobs::install("am", "ws", id, on_finish, &desc);
+  if (!wait_resolved({id})) {
+    return false;
+  }
+  // Either this process runs the job, or it finds the item up to date after
+  //    waiting for the other one
+  return wait_for([&] { return item(id).runs == 1 || finishes == 1; }) &&
+         fs::exists(marker(id));
+}
+
+/// Check that two processes installing the same item into a shared store
+///    download it only once. Must be run before any other test, as it forks.
+///
+/// @param dir
+///    Path to the shared store.
+void test_shared_store(const fs::path &dir) {
+  am.store = dir;
+  am.run_time = 500ms;
+  ws_jobs::shared_dir = true;
+  // Item IDs name the cross-process locks, so they must be unique per test
+  //    run
+  const auto id{static_cast<std::uint64_t>(getpid())};
+  const auto child{fork()};
+  if (child == 0) {
+    _exit(install_into_store(id) ? 0 : 1);
+  }
+  CHECK(child > 0);
+  CHECK(install_into_store(id));
+  int status{};
+  CHECK(waitpid(child, &status, 0) == child);
+  CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  // Exactly one of the processes has run the job
+  std::ifstream marker_file{marker(id)};
+  CHECK(std::distance(std::istreambuf_iterator<char>{marker_file},
+                      std::istreambuf_iterator<char>{}) == 4);
+  fs::remove(fs::temp_directory_path() /
+             ("tek-game-runtime-ws-346110-" + std::to_string(id) + ".lock"));
+  am.store.clear();
+  am.run_time = {};
+  ws_jobs::shared_dir = false;
+}
+
+/// Measure the time a server takes to get 16 mods that take 100 ms each to
+///    download, with downloads made one by one like Steam does, and with the
+///    scheduler.
+void bench_cold_start() {
+  static constexpr int num_mods{16};
+  am.run_time = 100ms;
+  const auto serial{test::time_s([] {
+    for (std::uint64_t id{1001}; id <= 1000 + num_mods; ++id) {
+      const tek_sc_item_id item_id{
+          .app_id = 346110, .depot_id = 346110, .ws_item_id = id};
+      tek_sc_am_item_desc *desc;
+      fake_backend.create_job(&item_id, &desc);
+      fake_backend.run_job(desc, [](tek_sc_am_item_desc *,
+                                    tek_sc_am_upd_type) {});
+    }
+  })};
+  test::report("16 mods, serial downloads", serial * 1000, "ms");
+  std::array<tek_sc_am_item_desc *, num_mods> descs;
+  const auto scheduled{test::time_s([&] {
+    for (int i{}; i < num_mods; ++i) {
+      ws_jobs::install("am", "ws", 2001 + i, on_finish, &descs[i]);
+    }
+    wait_for([] {
+      return std::ranges::all_of(
+          std::views::iota(2001, 2001 + num_mods),
+          [](auto id) { return item(id).runs == 1; });
+    });
+  })};
+  test::report("16 mods, ws_jobs", scheduled * 1000, "ms");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  ws_jobs::init(fake_backend, 346110);
+  if (test::bench_mode(argc, argv)) {
+    bench_cold_start();
+    return test::result();
+  }
+  const auto dir{fs::temp_directory_path() /
+                 ("tek-gr-ws-jobs-test-" + std::to_string(getpid()))};
+  fs::create_directories(dir);
+  test_shared_store(dir);
+  fs::remove_all(dir);
+  test_install();
+  test_install_outcomes();
+  test_init_failure();
+  test_parallel();
+  test_update();
+  return test::result();
+}